@@ -11,6 +11,7 @@
 
 #include "solid/frame/service.hpp"
 
+#include "solid/frame/file/fileasync.hpp"
 #include "solid/frame/file/filestream.hpp"
 
 #include "solid/utility/dynamictype.hpp"
@@ -80,7 +81,8 @@ void               term_handler(int signum)
 
 typedef DynamicPointer<frame::file::Store<>> FileStoreSharedPointerT;
 
-FileStoreSharedPointerT filestoreptr;
+FileStoreSharedPointerT   filestoreptr;
+frame::file::AsyncEngine* pasyncengine = nullptr;
 
 } //namespace
 
@@ -131,6 +133,8 @@ private:
     /*virtual*/ void onEvent(frame::aio::ReactorContext& _rctx, Event&& _revent);
     static void      onRecv(frame::aio::ReactorContext& _rctx, size_t _sz);
     static void      onSend(frame::aio::ReactorContext& _rctx);
+    static void      onSendFile(frame::aio::ReactorContext& _rctx);
+    void             onRead(frame::aio::ReactorContext& _rctx, std::string&& _ubuf, ErrorCodeT const& _rerr);
     const char*      findEnd(const char* _p);
     void             doExecuteCommand(frame::aio::ReactorContext& _rctx);
     void             doRun(frame::aio::ReactorContext& _rctx);
@@ -146,6 +150,7 @@ private:
         WaitRead,
         WaitWrite,
         RunRead,
+        RunSendFile,
         RunWrite,
         CloseFileError,
     };
@@ -156,9 +161,12 @@ private:
     char*         bpos;
     char*         bend;
     char          cmd;
-    std::string   path;
-    IOFileStreamT iofs;
-    const char*   crtpat;
+    std::string            path;
+    IOFileStreamT          iofs;
+    frame::file::AsyncFile afile;
+    std::string            rbuf;
+    int64_t                roff;
+    const char*            crtpat;
 };
 
 //------------------------------------------------------------------
@@ -198,8 +206,11 @@ int main(int argc, char* argv[])
         AioSchedulerT aiosched;
         SchedulerT    sched;
 
-        frame::Manager  m;
-        frame::ServiceT svc(m);
+        frame::Manager           m;
+        frame::ServiceT          svc(m);
+        frame::file::AsyncEngine asyncengine;
+
+        pasyncengine = &asyncengine;
 
         if (!sched.start(1) && !aiosched.start(1)) {
             {
@@ -210,6 +221,9 @@ int main(int argc, char* argv[])
 
                 const char* homedir = getenv("HOME");
 
+                //popular files are served from memory
+                utf8cfg.blockcacheptr = std::make_shared<frame::file::BlockCache>();
+
                 utf8cfg.storagevec.push_back(frame::file::Utf8Configuration::Storage());
                 utf8cfg.storagevec.back().globalprefix = "/";
                 utf8cfg.storagevec.back().localprefix  = homedir;
@@ -376,6 +390,8 @@ static frame::UniqueId tempuid;
 
 Connection::Connection(SocketDevice& _rsd)
     : sock(this->proxy(), std::move(_rsd))
+    , afile(this->proxy(), *pasyncengine)
+    , roff(0)
     , crtpat(patt)
 {
     state = ReadInit;
@@ -421,6 +437,7 @@ const char* Connection::findEnd(const char* _p)
         FilePointerMessage* pfileptrmsg = _revent.any().cast<FilePointerMessage>();
         if (pfileptrmsg) {
             this->handle(*pfileptrmsg);
+            this->doRun(_rctx);
         }
     }
 }
@@ -473,15 +490,22 @@ void Connection::doRun(frame::aio::ReactorContext& _rctx)
         solid_log(generic_logger, Info, "keep waiting");
         break;
     case RunRead:
-        if (!iofs.eof()) {
-            iofs.read(bbeg, BufferCapacity);
-
-            sock.postSendAll(_rctx, bbeg, iofs.gcount(), onSend);
-        } else {
-            iofs.close();
+        //read on the file's disk thread pool - do not block the reactor
+        if (afile.postRead(
+                _rctx, std::move(rbuf), BufferCapacity, roff,
+                [this](frame::aio::ReactorContext& _rctx, std::string&& _ubuf, ErrorCodeT const& _rerr) {
+                    onRead(_rctx, std::move(_ubuf), _rerr);
+                })) {
+            solid_log(generic_logger, Error, "postRead: " << _rctx.error().message());
+            afile.clear();
             postStop(_rctx);
         }
         break;
+    case RunSendFile: {
+        //regular files go from the kernel straight to the socket
+        const frame::file::File& rfile = *afile.file();
+        sock.postSendFile(_rctx, *rfile.device(), 0, rfile.size(), onSendFile);
+    } break;
     case RunWrite: {
         const char* p = findEnd(bpos);
         iofs.write(bpos, p - bpos);
@@ -614,14 +638,39 @@ void Connection::doExecuteCommand(frame::aio::ReactorContext& _rctx)
     }
 }
 
+/*static*/ void Connection::onSendFile(frame::aio::ReactorContext& _rctx)
+{
+    Connection& rthis = static_cast<Connection&>(_rctx.object());
+    if (_rctx.error()) {
+        solid_log(generic_logger, Error, "sendFile: " << _rctx.error().message());
+    }
+    rthis.afile.clear();
+    rthis.postStop(_rctx);
+}
+
+void Connection::onRead(frame::aio::ReactorContext& _rctx, std::string&& _ubuf, ErrorCodeT const& _rerr)
+{
+    rbuf = std::move(_ubuf);
+
+    if (!_rerr && !rbuf.empty()) {
+        roff += rbuf.size();
+        sock.postSendAll(_rctx, rbuf.data(), rbuf.size(), onSend);
+    } else {
+        afile.clear();
+        postStop(_rctx);
+    }
+}
+
 void Connection::handle(FilePointerMessage& _rmsgptr)
 {
     solid_log(generic_logger, Info, "");
     if (!_rmsgptr.ptr.empty()) {
-        iofs.device(_rmsgptr.ptr);
         if (state == WaitRead) {
-            state = RunRead;
+            afile.reset(_rmsgptr.ptr);
+            roff  = 0;
+            state = afile.file()->device() != nullptr ? RunSendFile : RunRead;
         } else if (state == WaitWrite) {
+            iofs.device(_rmsgptr.ptr);
             state = RunWrite;
         }
     } else {
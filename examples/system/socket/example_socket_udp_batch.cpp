@@ -0,0 +1,207 @@
+//Loopback UDP throughput: one datagram per system call vs recvmmsg/sendmmsg batches vs UDP GSO/GRO
+//Usage: example_socket_udp_batch [single|batch|gso] [DATAGRAM_COUNT] [DATAGRAM_SIZE] [BATCH_SIZE]
+#include "solid/system/socketaddress.hpp"
+#include "solid/system/socketdevice.hpp"
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std;
+using namespace solid;
+
+namespace {
+
+enum struct Mode {
+    Single,
+    Batch,
+    Gso,
+};
+
+struct Params {
+    Mode   mode           = Mode::Batch;
+    size_t datagram_count = 1000000;
+    size_t datagram_size  = 64;
+    size_t batch_size     = datagram_batch_capacity;
+};
+
+SocketDevice create_socket()
+{
+    ResolveData  rd = synchronous_resolve("127.0.0.1", "0", 0, SocketInfo::Inet4, SocketInfo::Datagram);
+    SocketDevice sd;
+
+    sd.create(rd.begin());
+    sd.bind(rd.begin());
+    return sd;
+}
+
+double rate(const size_t _count, const chrono::steady_clock::duration _duration)
+{
+    const double seconds = chrono::duration<double>(_duration).count();
+    return seconds > 0 ? _count / seconds : 0;
+}
+
+void run_sender(const Params& _params, SocketDevice& _rsd, const SocketAddress& _raddr)
+{
+    vector<char> buf(_params.batch_size * _params.datagram_size, 'a');
+    bool         can_retry;
+    ErrorCodeT   err;
+    size_t       sent_count = 0;
+    const auto   start      = chrono::steady_clock::now();
+
+    if (_params.mode == Mode::Single) {
+        while (sent_count < _params.datagram_count) {
+            if (_rsd.send(buf.data(), _params.datagram_size, _raddr, can_retry, err) < 0) {
+                cout << "send error: " << err.message() << endl;
+                break;
+            }
+            ++sent_count;
+        }
+    } else {
+        vector<DatagramStub> dgs;
+
+        if (_params.mode == Mode::Gso) {
+            //a single buffer split by the kernel into batch_size datagrams
+            dgs.emplace_back(buf.data(), buf.size());
+            dgs.back().size_         = buf.size();
+            dgs.back().segment_size_ = _params.datagram_size;
+            dgs.back().address_      = _raddr;
+        } else {
+            for (size_t i = 0; i < _params.batch_size; ++i) {
+                dgs.emplace_back(buf.data() + i * _params.datagram_size, _params.datagram_size);
+                dgs.back().size_    = _params.datagram_size;
+                dgs.back().address_ = _raddr;
+            }
+        }
+
+        const size_t datagrams_per_stub = _params.mode == Mode::Gso ? _params.batch_size : 1;
+
+        while (sent_count < _params.datagram_count) {
+            const ssize_t rv = _rsd.send(dgs.data(), dgs.size(), can_retry, err);
+            if (rv < 0) {
+                cout << "send error: " << err.message() << endl;
+                break;
+            }
+            sent_count += rv * datagrams_per_stub;
+        }
+    }
+
+    const auto duration = chrono::steady_clock::now() - start;
+    cout << "sent " << sent_count << " datagrams: " << static_cast<size_t>(rate(sent_count, duration)) << " datagrams/s" << endl;
+}
+
+size_t run_receiver(const Params& _params, SocketDevice& _rsd, chrono::steady_clock::time_point& _rlast_time)
+{
+    const size_t         capacity = _params.mode == Mode::Gso ? 64 * 1024 : _params.datagram_size;
+    const size_t         count    = _params.mode == Mode::Single ? 1 : _params.batch_size;
+    vector<char>         buf(count * capacity);
+    vector<DatagramStub> dgs;
+    SocketAddress        addr;
+    bool                 can_retry;
+    ErrorCodeT           err;
+    size_t               recv_count = 0;
+
+    for (size_t i = 0; i < count; ++i) {
+        dgs.emplace_back(buf.data() + i * capacity, capacity);
+    }
+
+    while (recv_count < _params.datagram_count) {
+        if (_params.mode == Mode::Single) {
+            if (_rsd.recv(buf.data(), capacity, addr, can_retry, err) < 0) {
+                break; //timeout - the rest was dropped
+            }
+            ++recv_count;
+        } else {
+            const ssize_t rv = _rsd.recv(dgs.data(), dgs.size(), can_retry, err);
+            if (rv < 0) {
+                break;
+            }
+            for (ssize_t i = 0; i < rv; ++i) {
+                const DatagramStub& rdg = dgs[i];
+                recv_count += rdg.segment_size_ != 0 ? (rdg.size_ + rdg.segment_size_ - 1) / rdg.segment_size_ : 1;
+            }
+        }
+        _rlast_time = chrono::steady_clock::now();
+    }
+    return recv_count;
+}
+
+bool parse_arguments(Params& _rparams, int argc, char* argv[])
+{
+    if (argc > 1) {
+        const string mode = argv[1];
+        if (mode == "single") {
+            _rparams.mode = Mode::Single;
+        } else if (mode == "batch") {
+            _rparams.mode = Mode::Batch;
+        } else if (mode == "gso") {
+            _rparams.mode = Mode::Gso;
+        } else {
+            return false;
+        }
+    }
+    if (argc > 2) {
+        _rparams.datagram_count = atoi(argv[2]);
+    }
+    if (argc > 3) {
+        _rparams.datagram_size = atoi(argv[3]);
+    }
+    if (argc > 4) {
+        _rparams.batch_size = atoi(argv[4]);
+    }
+    if (_rparams.mode == Mode::Batch && _rparams.batch_size > datagram_batch_capacity) {
+        _rparams.batch_size = datagram_batch_capacity;
+    }
+    return _rparams.datagram_size >= sizeof(uint64_t) && _rparams.batch_size != 0;
+}
+
+} //namespace
+
+int main(int argc, char* argv[])
+{
+    Params params;
+
+    if (!parse_arguments(params, argc, argv)) {
+        cout << "Usage: " << argv[0] << " [single|batch|gso] [DATAGRAM_COUNT] [DATAGRAM_SIZE] [BATCH_SIZE]" << endl;
+        return 1;
+    }
+
+    SocketDevice  send_sd = create_socket();
+    SocketDevice  recv_sd = create_socket();
+    SocketAddress recv_addr;
+    int           recv_buf_sz = 8 * 1024 * 1024;
+
+    if (!send_sd || !recv_sd) {
+        cout << "Error creating sockets" << endl;
+        return 1;
+    }
+
+    recv_sd.localAddress(recv_addr);
+    recv_sd.recvBufferSize(recv_buf_sz);
+    recv_sd.makeBlocking(1000); //the receiver stops after one second without datagrams
+
+    if (params.mode == Mode::Gso) {
+        const ErrorCodeT err = recv_sd.enableGenericReceiveOffload();
+        if (err) {
+            cout << "GRO not available: " << err.message() << endl;
+        }
+    }
+
+    chrono::steady_clock::time_point last_time;
+    size_t                           recv_count = 0;
+    const auto                       start      = chrono::steady_clock::now();
+
+    thread recv_thr([&params, &recv_sd, &recv_count, &last_time]() {
+        recv_count = run_receiver(params, recv_sd, last_time);
+    });
+
+    run_sender(params, send_sd, recv_addr);
+
+    recv_thr.join();
+
+    cout << "received " << recv_count << " datagrams: " << static_cast<size_t>(rate(recv_count, last_time - start)) << " datagrams/s" << endl;
+    return 0;
+}
@@ -0,0 +1,105 @@
+// example_workpool_stealing.cpp
+//
+// Copyright (c) 2018 Valentin Palade (vipalade @ gmail . com)
+//
+// This file is part of SolidFrame framework.
+//
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt.
+//
+// Compares WorkPool against StealingWorkPool for fine grained jobs:
+//  * "flat": a single producer pushes JOB_COUNT tiny jobs
+//  * "tree": jobs push two sub-jobs each until TREE_DEPTH is reached
+//
+#include "solid/system/log.hpp"
+#include "solid/utility/workpool.hpp"
+#include "solid/utility/workpool_stealing.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+
+using namespace std;
+using namespace solid;
+
+namespace {
+
+using ClockT = std::chrono::steady_clock;
+
+std::atomic<size_t> val{0};
+
+size_t elapsed_msecs(const ClockT::time_point& _start)
+{
+    return std::chrono::duration_cast<std::chrono::milliseconds>(ClockT::now() - _start).count();
+}
+
+template <class Pool>
+size_t run_flat(const size_t _job_count, const size_t _worker_count)
+{
+    const auto start = ClockT::now();
+    {
+        Pool wp{
+            _worker_count,
+            WorkPoolConfiguration(_worker_count),
+            [](const size_t _v) {
+                val += _v;
+            }};
+
+        for (size_t i = 0; i < _job_count; ++i) {
+            wp.push(i);
+        }
+    }
+    return elapsed_msecs(start);
+}
+
+template <class Pool>
+size_t run_tree(const size_t _depth, const size_t _worker_count)
+{
+    std::atomic<Pool*> pwp{nullptr};
+    const auto         start = ClockT::now();
+    {
+        Pool wp{
+            _worker_count,
+            WorkPoolConfiguration(_worker_count),
+            [&pwp](const size_t _depth) {
+                ++val;
+                if (_depth != 0) {
+                    pwp.load()->push(_depth - 1);
+                    pwp.load()->push(_depth - 1);
+                }
+            }};
+        pwp = &wp;
+        wp.push(_depth);
+    }
+    return elapsed_msecs(start);
+}
+
+} //namespace
+
+int main(int argc, char* argv[])
+{
+    solid::log_start(std::cerr, {".*:EW"});
+
+    cout << "usage: " << argv[0] << " JOB_COUNT WORKER_COUNT TREE_DEPTH" << endl;
+
+    size_t job_count    = 10000000;
+    size_t worker_count = thread::hardware_concurrency();
+    size_t tree_depth   = 20;
+
+    if (argc > 1) {
+        job_count = atoi(argv[1]);
+    }
+    if (argc > 2) {
+        worker_count = atoi(argv[2]);
+    }
+    if (argc > 3) {
+        tree_depth = atoi(argv[3]);
+    }
+
+    cout << "flat WorkPool:         " << run_flat<WorkPool<size_t>>(job_count, worker_count) << " msecs" << endl;
+    cout << "flat StealingWorkPool: " << run_flat<StealingWorkPool<size_t>>(job_count, worker_count) << " msecs" << endl;
+    cout << "tree WorkPool:         " << run_tree<WorkPool<size_t>>(tree_depth, worker_count) << " msecs" << endl;
+    cout << "tree StealingWorkPool: " << run_tree<StealingWorkPool<size_t>>(tree_depth, worker_count) << " msecs" << endl;
+    return 0;
+}
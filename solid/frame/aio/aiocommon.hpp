@@ -30,6 +30,7 @@ enum ReactorEventsE {
     ReactorEventClear      = 128,
     ReactorEventInit       = 256,
     ReactorEventTimer      = 512,
+    ReactorEventResume     = 1024,
 };
 
 enum ReactorWaitRequestsE {
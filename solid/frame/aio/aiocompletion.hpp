@@ -74,6 +74,13 @@ protected:
     void           addTimer(ReactorContext& _rctx, NanoTime const& _rt, size_t& _storedidx);
     void           remTimer(ReactorContext& _rctx, size_t const& _storedidx);
     size_t         indexWithinReactor() const;
+    UniqueId       uid(ReactorContext& _rctx) const;
+
+    //true if the I/O budget for the current reactor turn was used up
+    //- see ReactorConfiguration
+    bool ioBudgetExhausted(ReactorContext& _rctx);
+    //accounts a successful I/O operation of _sz bytes
+    void ioBudgetConsume(ReactorContext& _rctx, const size_t _sz);
 
 private:
     friend class Reactor;
@@ -90,6 +97,9 @@ private:
     ForwardCompletionHandler* pprev;
     size_t                    idxreactor; //index within reactor
     CallbackT                 call;
+    uint64_t                  io_turn; //reactor turn of the I/O accounted below
+    size_t                    io_op_cnt;
+    size_t                    io_byte_cnt;
 };
 
 inline void CompletionHandler::completionCallback(CallbackT _pcbk)
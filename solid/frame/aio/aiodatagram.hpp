@@ -239,6 +239,69 @@ class Datagram : public CompletionHandler {
         }
     };
 
+    template <class F>
+    struct RecvBatchFunctor {
+        F f;
+
+        RecvBatchFunctor(F& _rf)
+            : f{std::move(_rf)}
+        {
+        }
+
+        void operator()(ThisT& _rthis, ReactorContext& _rctx)
+        {
+            size_t recv_cnt = 0;
+
+            if (!_rctx.error()) {
+                bool       can_retry;
+                ErrorCodeT err;
+                ssize_t    rv = _rthis.s.recvFrom(_rctx, _rthis.recv_dgs, _rthis.recv_dgs_cnt, can_retry, err);
+
+                if (rv > 0) {
+                    recv_cnt = rv;
+                    _rthis.ioBudgetConsume(_rctx, batch_size(_rthis.recv_dgs, recv_cnt));
+                } else if (rv == 0) {
+                    _rthis.error(_rctx, error_datagram_shutdown);
+                } else if (rv == -1) {
+                    if (can_retry) {
+                        return;
+                    } else {
+                        _rthis.error(_rctx, error_datagram_system);
+                        _rthis.systemError(_rctx, err);
+                        solid_assert(err);
+                    }
+                }
+            }
+
+            F tmp{std::move(f)};
+            _rthis.doClearRecv(_rctx);
+            tmp(_rctx, recv_cnt);
+        }
+    };
+
+    template <class F>
+    struct SendBatchFunctor {
+        F f;
+
+        SendBatchFunctor(F& _rf)
+            : f{std::move(_rf)}
+        {
+        }
+
+        void operator()(ThisT& _rthis, ReactorContext& _rctx)
+        {
+            if (!_rctx.error()) {
+                if (!_rthis.doSendBatch(_rctx)) {
+                    return;
+                }
+            }
+
+            F tmp{std::move(f)};
+            _rthis.doClearSend(_rctx);
+            tmp(_rctx);
+        }
+    };
+
     template <class F>
     struct ConnectFunctor {
         F f;
@@ -267,6 +330,10 @@ public:
         , send_buf(nullptr)
         , send_buf_cp(0)
         , send_is_posted(false)
+        , recv_dgs(nullptr)
+        , recv_dgs_cnt(0)
+        , send_dgs(nullptr)
+        , send_dgs_cnt(0)
     {
     }
 
@@ -279,6 +346,10 @@ public:
         , send_buf(nullptr)
         , send_buf_cp(0)
         , send_is_posted(false)
+        , recv_dgs(nullptr)
+        , recv_dgs_cnt(0)
+        , send_dgs(nullptr)
+        , send_dgs_cnt(0)
     {
     }
 
@@ -574,7 +645,182 @@ public:
         return true;
     }
 
+    //! Receive up to _count datagrams into the caller's slots, with as few system calls as possible
+    /*!
+     * On completion _f(ReactorContext&, size_t _recv_count) is called, with
+     * _pdgs[0, _recv_count) filled - see DatagramStub.
+     * The slots must be valid until completion.
+     */
+    template <typename F>
+    bool postRecvBatch(
+        ReactorContext& _rctx,
+        DatagramStub* _pdgs, size_t _count,
+        F _f)
+    {
+        if (solid_function_empty(recv_fnc)) {
+            recv_fnc       = RecvBatchFunctor<F>(_f);
+            recv_dgs       = _pdgs;
+            recv_dgs_cnt   = _count;
+            recv_is_posted = true;
+            doPostRecvSome(_rctx);
+            errorClear(_rctx);
+            return false;
+        } else {
+            error(_rctx, error_already);
+            return true;
+        }
+    }
+
+    //! Returns true when datagrams were received right away, with _rrecv_count set, false when _f will be called.
+    template <typename F>
+    bool recvBatch(
+        ReactorContext& _rctx,
+        DatagramStub* _pdgs, size_t _count,
+        F       _f,
+        size_t& _rrecv_count)
+    {
+        _rrecv_count = 0;
+        if (solid_function_empty(recv_fnc)) {
+            contextBind(_rctx);
+
+            if (ioBudgetExhausted(_rctx)) {
+                //let the other ready handlers run first
+                recv_fnc       = RecvBatchFunctor<F>(_f);
+                recv_dgs       = _pdgs;
+                recv_dgs_cnt   = _count;
+                recv_is_posted = true;
+                doPostRecvSome(_rctx);
+                errorClear(_rctx);
+                return false;
+            }
+
+            bool       can_retry;
+            ErrorCodeT err;
+            ssize_t    rv = s.recvFrom(_rctx, _pdgs, _count, can_retry, err);
+
+            if (rv > 0) {
+                _rrecv_count = rv;
+                ioBudgetConsume(_rctx, batch_size(_pdgs, _rrecv_count));
+                errorClear(_rctx);
+            } else if (rv == 0) {
+                error(_rctx, error_datagram_shutdown);
+            } else if (rv == -1) {
+                if (can_retry) {
+                    recv_dgs     = _pdgs;
+                    recv_dgs_cnt = _count;
+                    recv_fnc     = RecvBatchFunctor<F>(_f);
+                    errorClear(_rctx);
+                    return false;
+                } else {
+                    error(_rctx, error_datagram_system);
+                    systemError(_rctx, err);
+                    solid_assert(err);
+                }
+            }
+        } else {
+            error(_rctx, error_already);
+        }
+        return true;
+    }
+
+    //! Send all the _count datagrams, up to datagram_batch_capacity per system call
+    /*!
+     * On completion _f(ReactorContext&) is called.
+     * The slots and their buffers must be valid until completion.
+     */
+    template <typename F>
+    bool postSendBatch(
+        ReactorContext& _rctx,
+        const DatagramStub* _pdgs, size_t _count,
+        F _f)
+    {
+        if (solid_function_empty(send_fnc)) {
+            send_fnc       = SendBatchFunctor<F>(_f);
+            send_dgs       = _pdgs;
+            send_dgs_cnt   = _count;
+            send_is_posted = true;
+            doPostSendAll(_rctx);
+            errorClear(_rctx);
+            return false;
+        } else {
+            error(_rctx, error_already);
+            solid_assert(false);
+            return true;
+        }
+    }
+
+    //! Returns true when all the datagrams were sent right away, false when _f will be called.
+    template <typename F>
+    bool sendBatch(
+        ReactorContext& _rctx,
+        const DatagramStub* _pdgs, size_t _count,
+        F _f)
+    {
+        if (solid_function_empty(send_fnc)) {
+            contextBind(_rctx);
+            errorClear(_rctx);
+
+            send_dgs     = _pdgs;
+            send_dgs_cnt = _count;
+
+            if (doSendBatch(_rctx)) {
+                send_dgs     = nullptr;
+                send_dgs_cnt = 0;
+            } else {
+                send_fnc = SendBatchFunctor<F>(_f);
+                return false;
+            }
+        } else {
+            error(_rctx, error_already);
+        }
+        return true;
+    }
+
 private:
+    static size_t batch_size(const DatagramStub* _pdgs, const size_t _count)
+    {
+        size_t sz = 0;
+        for (size_t i = 0; i < _count; ++i) {
+            sz += _pdgs[i].size_;
+        }
+        return sz;
+    }
+
+    //returns false when it must wait for the socket to become writable or,
+    //with the I/O budget exhausted, for the next reactor turn
+    bool doSendBatch(ReactorContext& _rctx)
+    {
+        while (send_dgs_cnt != 0) {
+            if (ioBudgetExhausted(_rctx)) {
+                //let the other ready handlers run first
+                send_is_posted = true;
+                doPostSendAll(_rctx);
+                return false;
+            }
+
+            bool       can_retry;
+            ErrorCodeT err;
+            ssize_t    rv = s.sendTo(_rctx, send_dgs, send_dgs_cnt, can_retry, err);
+
+            if (rv > 0) {
+                ioBudgetConsume(_rctx, batch_size(send_dgs, rv));
+                send_dgs += rv;
+                send_dgs_cnt -= rv;
+            } else if (rv == 0) {
+                error(_rctx, error_datagram_shutdown);
+                break;
+            } else if (can_retry) {
+                return false;
+            } else {
+                error(_rctx, error_datagram_system);
+                systemError(_rctx, err);
+                solid_assert(err);
+                break;
+            }
+        }
+        return true;
+    }
+
     void doPostRecvSome(ReactorContext& _rctx)
     {
         reactor(_rctx).post(_rctx, on_posted_recv, Event(), *this);
@@ -616,15 +862,19 @@ private:
     void doClearRecv(ReactorContext& _rctx)
     {
         solid_function_clear(recv_fnc);
-        recv_buf    = nullptr;
-        recv_buf_cp = 0;
+        recv_buf     = nullptr;
+        recv_buf_cp  = 0;
+        recv_dgs     = nullptr;
+        recv_dgs_cnt = 0;
     }
 
     void doClearSend(ReactorContext& _rctx)
     {
         solid_function_clear(send_fnc);
-        send_buf    = nullptr;
-        recv_buf_cp = 0;
+        send_buf     = nullptr;
+        recv_buf_cp  = 0;
+        send_dgs     = nullptr;
+        send_dgs_cnt = 0;
     }
     void doClear(ReactorContext& _rctx)
     {
@@ -647,6 +897,11 @@ private:
     SendFunctionT send_fnc;
     SocketAddress send_addr;
     bool          send_is_posted;
+
+    DatagramStub*       recv_dgs;
+    size_t              recv_dgs_cnt;
+    const DatagramStub* send_dgs;
+    size_t              send_dgs_cnt;
 };
 
 } //namespace aio
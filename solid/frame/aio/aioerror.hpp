@@ -29,9 +29,12 @@ extern const ErrorConditionT error_datagram_socket;
 extern const ErrorConditionT error_stream_system;
 extern const ErrorConditionT error_stream_socket;
 extern const ErrorConditionT error_stream_shutdown;
+extern const ErrorConditionT error_stream_file_end;
 
 extern const ErrorConditionT error_timer_cancel;
 
+extern const ErrorConditionT error_offload_full;
+
 extern const ErrorConditionT error_listener_system;
 extern const ErrorConditionT error_listener_hangup;
 
@@ -0,0 +1,184 @@
+// solid/frame/aio/aiooffload.hpp
+//
+// Copyright (c) 2018 Valentin Palade (vipalade @ gmail . com)
+//
+// This file is part of SolidFrame framework.
+//
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt.
+//
+
+#pragma once
+
+#include <functional>
+#include <memory>
+
+#include "solid/system/common.hpp"
+#include "solid/utility/function.hpp"
+
+#include "aiocompletion.hpp"
+#include "aioerror.hpp"
+#include "aioreactor.hpp"
+#include "aioreactorcontext.hpp"
+
+namespace solid {
+namespace frame {
+namespace aio {
+
+struct ObjectProxy;
+struct ReactorContext;
+
+//! Run a blocking job on a WorkPool and resume on the owner's reactor
+/*!
+ * The job runs on a WorkPool thread and its result is handed to the
+ * completion function on the reactor thread of the owning Object,
+ * through Reactor::resume - no Event, no Manager lookup.
+ *
+ * The result slot is allocated once, with the Offload, and shared with
+ * the in-flight job, so the Object can stop while its job is running:
+ * the late completion is dropped by the reactor.
+ * At most one job can be in flight per Offload.
+ *
+ * The WorkPool must accept std::function<void()> like jobs (e.g.
+ * FunctionWorkPool) and must be stopped before the Scheduler.
+ */
+template <class Result>
+class Offload : public CompletionHandler {
+    typedef Offload<Result> ThisT;
+
+    struct Slot {
+        Reactor* preactor_;
+        UniqueId objuid_;
+        UniqueId chnuid_;
+        Result   result_;
+
+        Slot()
+            : preactor_(nullptr)
+        {
+        }
+
+        void complete(Result&& _uresult)
+        {
+            result_ = std::move(_uresult);
+            //the reactor mutex orders the result write with the read on reactor
+            preactor_->resume(objuid_, chnuid_);
+        }
+    };
+
+    using SlotPointerT = std::shared_ptr<Slot>;
+
+    static void on_init_completion(CompletionHandler& _rch, ReactorContext& _rctx)
+    {
+        ThisT& rthis = static_cast<ThisT&>(_rch);
+        rthis.completionCallback(ThisT::on_completion);
+    }
+
+    static void on_completion(CompletionHandler& _rch, ReactorContext& _rctx)
+    {
+        ThisT& rthis = static_cast<ThisT&>(_rch);
+
+        switch (rthis.reactorEvent(_rctx)) {
+        case ReactorEventResume:
+            rthis.doExec(_rctx);
+            break;
+        case ReactorEventClear:
+            solid_function_clear(rthis.f);
+            break;
+        default:
+            solid_assert(false);
+        }
+    }
+
+public:
+    Offload(
+        ObjectProxy const& _robj)
+        : CompletionHandler(_robj, ThisT::on_init_completion)
+        , slot_ptr(std::make_shared<Slot>())
+    {
+    }
+
+    ~Offload()
+    {
+        //MUST call here and not in the ~CompletionHandler
+        this->deactivate();
+    }
+
+    bool isPending() const
+    {
+        return !solid_function_empty(f);
+    }
+
+    //Returns true, with error_already on _rctx, when a job is in flight.
+    bool checkPending(ReactorContext& _rctx) const
+    {
+        if (isPending()) {
+            error(_rctx, error_already);
+            return true;
+        }
+        return false;
+    }
+
+    //Returns false when the job is scheduled. On completion _f(_rctx, Result&&) will be called
+    //on the reactor thread.
+    //Returns true when the job could not be scheduled - a job is already in flight.
+    template <class WorkPoolT, typename JobF, typename F>
+    bool post(ReactorContext& _rctx, WorkPoolT& _rwp, JobF _jobf, F _f)
+    {
+        if (checkPending(_rctx)) {
+            return true;
+        }
+        _rwp.push(doPrepare(_rctx, std::move(_jobf), std::move(_f)));
+        return false;
+    }
+
+    //Same as post but never blocks on a WorkPool with bounded queue.
+    //Returns true with error_offload_full when the WorkPool queue is full.
+    template <class WorkPoolT, typename JobF, typename F>
+    bool tryPost(ReactorContext& _rctx, WorkPoolT& _rwp, JobF _jobf, F _f)
+    {
+        if (checkPending(_rctx)) {
+            return true;
+        }
+        if (_rwp.tryPush(doPrepare(_rctx, std::move(_jobf), std::move(_f)))) {
+            return false;
+        }
+        solid_function_clear(f);
+        error(_rctx, error_offload_full);
+        return true;
+    }
+
+private:
+    template <typename JobF, typename F>
+    std::function<void()> doPrepare(ReactorContext& _rctx, JobF&& _ujobf, F&& _uf)
+    {
+        f = std::move(_uf);
+
+        slot_ptr->preactor_ = &reactor(_rctx);
+        slot_ptr->objuid_   = _rctx.objectUid();
+        slot_ptr->chnuid_   = this->uid(_rctx);
+
+        SlotPointerT tmp_slot_ptr = slot_ptr;
+
+        return [tmp_slot_ptr, _jobf = std::move(_ujobf)]() mutable {
+            tmp_slot_ptr->complete(_jobf());
+        };
+    }
+
+    void doExec(ReactorContext& _rctx)
+    {
+        FunctionT tmpf;
+        std::swap(tmpf, f);
+        Result result(std::move(slot_ptr->result_));
+        tmpf(_rctx, std::move(result));
+    }
+
+private:
+    typedef solid_function_t(void(ReactorContext&, Result&&)) FunctionT;
+
+    FunctionT    f;
+    SlotPointerT slot_ptr;
+};
+
+} //namespace aio
+} //namespace frame
+} //namespace solid
@@ -16,7 +16,10 @@
 #include "solid/frame/reactorbase.hpp"
 #include "solid/system/nanotime.hpp"
 #include "solid/system/pimpl.hpp"
+#include "solid/system/statistic.hpp"
 #include "solid/utility/dynamicpointer.hpp"
+#include <atomic>
+#include <memory>
 
 namespace solid {
 
@@ -39,6 +42,67 @@ struct ExecStub;
 
 typedef DynamicPointer<Object> ObjectPointerT;
 
+//! Counters shared by the reactors of a Scheduler
+/*!
+ * Only filled when given through ReactorConfiguration::statistic_ptr_.
+ */
+struct ReactorStatistic : solid::Statistic {
+    std::atomic<uint64_t> turn_count_;
+    std::atomic<uint64_t> device_add_count_; //epoll_ctl(EPOLL_CTL_ADD) or equivalent
+    std::atomic<uint64_t> device_mod_count_; //epoll_ctl(EPOLL_CTL_MOD) or equivalent
+    std::atomic<uint64_t> device_rem_count_; //epoll_ctl(EPOLL_CTL_DEL) or equivalent
+    std::atomic<uint64_t> io_budget_exhausted_count_;
+    std::atomic<uint64_t> busy_poll_hit_count_; //the busy polling found work
+    std::atomic<uint64_t> busy_poll_miss_count_; //the busy polling ended in a blocking wait
+
+    ReactorStatistic();
+
+    std::ostream& print(std::ostream& _ros) const override;
+};
+
+using ReactorStatisticPointerT = std::shared_ptr<ReactorStatistic>;
+
+//! Reactor configuration
+/*!
+ * The devices are registered once, edge triggered, for both directions
+ * (epoll and kqueue). A CompletionHandler that keeps finding its device
+ * ready could monopolize the reactor, so the I/O done synchronously by
+ * a completion handler within one reactor turn is limited by:
+ * - io_operation_budget_: number of successful send/recv calls;
+ * - io_byte_budget_: number of bytes sent and received.
+ * When any budget is exhausted, the next synchronous operation
+ * (e.g. Stream::recvSome, Stream::sendAll) is posted to the next reactor turn,
+ * after the other ready handlers were served.
+ * A zero budget means unlimited.
+ *
+ * For latency critical reactors:
+ * - busy_poll_microseconds_: before blocking in epoll_wait (kevent/WSAPoll)
+ *  the reactor keeps polling, with zero timeout, the devices and its inbox
+ *  (the events, objects and resumes from other threads) for at most that
+ *  long. While it polls, the other threads do not need to wake it through
+ *  the event device. The polling burns a CPU - use it with a dedicated core.
+ * - socket_busy_poll_microseconds_: SO_BUSY_POLL on the stream and datagram
+ *  sockets of the reactor (only on Linux, may need CAP_NET_ADMIN).
+ * Zero disables them.
+ */
+struct ReactorConfiguration {
+    size_t                   io_operation_budget_;
+    size_t                   io_byte_budget_;
+    size_t                   busy_poll_microseconds_;
+    size_t                   socket_busy_poll_microseconds_;
+    ReactorStatisticPointerT statistic_ptr_;
+
+    ReactorConfiguration(
+        const size_t _io_operation_budget = 64,
+        const size_t _io_byte_budget      = 1024 * 1024)
+        : io_operation_budget_(_io_operation_budget)
+        , io_byte_budget_(_io_byte_budget)
+        , busy_poll_microseconds_(0)
+        , socket_busy_poll_microseconds_(0)
+    {
+    }
+};
+
 //!
 /*!
 
@@ -71,10 +135,11 @@ class Reactor : public frame::ReactorBase {
     };
 
 public:
-    typedef ObjectPointerT TaskT;
-    typedef Object         ObjectT;
+    typedef ObjectPointerT       TaskT;
+    typedef Object               ObjectT;
+    typedef ReactorConfiguration ConfigurationT;
 
-    Reactor(SchedulerBase& _rsched, const size_t _schedidx);
+    Reactor(SchedulerBase& _rsched, const size_t _schedidx, ConfigurationT const& _rcfg = ConfigurationT());
     ~Reactor();
 
     template <typename Function>
@@ -119,6 +184,12 @@ public:
     bool raise(UniqueId const& _robjuid, Event&& _uevt) override;
     void stop() override;
 
+    //Can be called from any thread.
+    //Schedules the completion handler _rchuid of object _robjuid
+    //with ReactorEventResume - no Event is involved.
+    //Silently ignored if either the object or the handler are gone.
+    void resume(UniqueId const& _robjuid, UniqueId const& _rchuid);
+
     void registerCompletionHandler(CompletionHandler& _rch, Object const& _robj);
     void unregisterCompletionHandler(CompletionHandler& _rch);
 
@@ -131,6 +202,8 @@ public:
 
     CompletionHandler* completionHandler(ReactorContext const& _rctx) const;
 
+    ConfigurationT const& configuration() const;
+
 private:
     friend struct EventHandler;
     friend class CompletionHandler;
@@ -156,13 +229,18 @@ private:
 
     void doStopObject(ReactorContext& _rctx);
 
+    bool ioBudgetExhausted(CompletionHandler& _rch);
+    void ioBudgetConsume(CompletionHandler& _rch, const size_t _sz);
+
     void        onTimer(ReactorContext& _rctx, const size_t _tidx, const size_t _chidx);
     static void call_object_on_event(ReactorContext& _rctx, Event&& _uev);
+    static void call_completion_on_resume(ReactorContext& _rctx, Event&& _uev);
     static void increase_event_vector_size(ReactorContext& _rctx, Event&& _uev);
     static void stop_object(ReactorContext& _rctx, Event&& _uevent);
     static void stop_object_repost(ReactorContext& _rctx, Event&& _uevent);
 
     UniqueId objectUid(ReactorContext const& _rctx) const;
+    UniqueId completionHandlerUid(CompletionHandler const& _rch) const;
 
 private: //data
     struct Data;
@@ -63,6 +63,9 @@ struct ReactorContext {
 
     std::mutex& objectMutex() const;
 
+    //! The NUMA node of the reactor - see Scheduler::start(CpuSetVectorT const&)
+    size_t numaNode() const;
+
     void clearError()
     {
         error_.clear();
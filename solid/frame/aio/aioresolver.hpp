@@ -13,8 +13,13 @@
 #include "aioerror.hpp"
 #include "solid/system/pimpl.hpp"
 #include "solid/system/socketaddress.hpp"
+#include "solid/system/statistic.hpp"
 #include "solid/utility/dynamictype.hpp"
+#include "solid/utility/function.hpp"
 #include "solid/utility/workpool.hpp"
+#include <atomic>
+#include <chrono>
+#include <memory>
 #include <string>
 
 namespace solid {
@@ -122,13 +127,70 @@ struct ReverseResolveCbk : ReverseResolve {
     }
 };
 
-class Resolver {
-public:
-    Resolver(FunctionWorkPool& _rfwp)
-        : rfwp_(_rfwp)
+//! Counters of a Resolver
+/*!
+ * Only filled when given through ResolverConfiguration::statistic_ptr_.
+ */
+struct ResolverStatistic : solid::Statistic {
+    std::atomic<uint64_t> request_count_;
+    std::atomic<uint64_t> lookup_count_; //synchronous_resolve (getaddrinfo) calls
+    std::atomic<uint64_t> cache_hit_count_;
+    std::atomic<uint64_t> cache_negative_hit_count_; //cache hits with no address
+    std::atomic<uint64_t> coalesced_count_; //requests waiting for a lookup already in flight
+    std::atomic<uint64_t> refresh_count_; //background lookups for entries about to expire
+    std::atomic<uint64_t> evict_count_;
+
+    ResolverStatistic();
+
+    std::ostream& print(std::ostream& _ros) const override;
+};
+
+using ResolverStatisticPointerT = std::shared_ptr<ResolverStatistic>;
+
+//! Resolver configuration - the cache for direct resolve requests
+/*!
+ * Direct resolve results, keyed by host, service, flags, family, type and
+ * protocol, are kept:
+ * - cache_ttl_: for results with addresses - getaddrinfo does not expose
+ *  the DNS record TTL;
+ * - cache_negative_ttl_: for results with no address (failed lookups).
+ * Requests for an entry with a lookup in flight wait for that lookup
+ * instead of starting another one.
+ * A request for an entry that expires within cache_refresh_ahead_ is served
+ * from the cache and triggers a lookup in background, so that busy entries
+ * never expire. Should the background lookup fail, the previous addresses
+ * are kept until they expire.
+ * At most cache_capacity_ entries are kept.
+ *
+ * All requests, the ones served from the cache included, complete on a
+ * thread of the work pool - never before requestResolve returns.
+ *
+ * A zero cache_ttl_ disables the cache.
+ */
+struct ResolverConfiguration {
+    std::chrono::milliseconds cache_ttl_;
+    std::chrono::milliseconds cache_negative_ttl_;
+    std::chrono::milliseconds cache_refresh_ahead_;
+    size_t                    cache_capacity_;
+    ResolverStatisticPointerT statistic_ptr_;
+
+    ResolverConfiguration(
+        const std::chrono::milliseconds _cache_ttl          = std::chrono::seconds(30),
+        const std::chrono::milliseconds _cache_negative_ttl = std::chrono::seconds(1))
+        : cache_ttl_(_cache_ttl)
+        , cache_negative_ttl_(_cache_negative_ttl)
+        , cache_refresh_ahead_(_cache_ttl / 4)
+        , cache_capacity_(1024)
     {
     }
-    ~Resolver() {}
+};
+
+class Resolver {
+public:
+    using ConfigurationT = ResolverConfiguration;
+
+    Resolver(FunctionWorkPool& _rfwp, ConfigurationT const& _rcfg = ConfigurationT());
+    ~Resolver();
 
     template <class Cbk>
     void requestResolve(
@@ -140,7 +202,11 @@ public:
         int         _type   = -1,
         int         _proto  = -1)
     {
-        rfwp_.push(DirectResolveCbk<Cbk>(_cbk, _host, _srvc, _flags, _family, _type, _proto));
+        if (cache_ptr_) {
+            doRequestResolve(CompleteFunctionT(std::move(_cbk)), DirectResolve(_host, _srvc, _flags, _family, _type, _proto));
+        } else {
+            rfwp_.push(DirectResolveCbk<Cbk>(_cbk, _host, _srvc, _flags, _family, _type, _proto));
+        }
     }
 
     template <class Cbk>
@@ -153,7 +219,15 @@ public:
     }
 
 private:
-    FunctionWorkPool& rfwp_;
+    using CompleteFunctionT = solid_function_t(void(ResolveData&, ErrorCodeT const&));
+
+    struct Cache;
+
+    void doRequestResolve(CompleteFunctionT&& _ucbk, DirectResolve&& _udr);
+
+private:
+    FunctionWorkPool&      rfwp_;
+    std::shared_ptr<Cache> cache_ptr_;
 };
 
 } //namespace aio
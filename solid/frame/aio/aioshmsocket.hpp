@@ -0,0 +1,102 @@
+// solid/frame/aio/aioshmsocket.hpp
+//
+// Copyright (c) 2018 Valentin Palade (vipalade @ gmail . com)
+//
+// This file is part of SolidFrame framework.
+//
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt.
+//
+
+#pragma once
+
+#include "solid/frame/aio/aiosocketbase.hpp"
+#include "solid/system/socketdevice.hpp"
+#include <string>
+
+namespace solid {
+namespace frame {
+namespace aio {
+
+struct ReactorContext;
+
+namespace shm {
+
+struct Context {
+    //! Capacity of each direction ring - rounded up to a power of two
+    size_t ring_capacity_;
+
+    Context(const size_t _ring_capacity = 4 * 1024 * 1024)
+        : ring_capacity_(_ring_capacity)
+    {
+    }
+};
+
+//! Stream socket moving the bytes through a pair of shared memory rings
+/*!
+    For peers on the same host. The connecting side creates a shared memory
+    segment with two single producer/single consumer byte rings, one per
+    direction, and sends its name over the connected (usually unix domain)
+    socket. The accepting side maps the segment and unlinks its name.
+
+    The socket itself only carries doorbells: a byte is sent when the peer
+    waits for data, on an empty ring, or for space, on a full ring. So the
+    reactor, aio::Stream and its users see an ordinary stream socket - a
+    doorbell is a read event on the socket.
+
+    Use it as aio::Stream<aio::shm::Socket>.
+*/
+class Socket : public SocketBase {
+public:
+    using VerifyMaskT = unsigned long;
+
+    Socket(const Context& _rctx, SocketDevice&& _rsd);
+
+    Socket(const Context& _rctx);
+
+    ~Socket();
+
+    ReactorEventsE filterReactorEvents(
+        const ReactorEventsE _evt) const;
+
+    ErrorCodeT checkConnect(ReactorContext& _rctx);
+
+    ssize_t recv(ReactorContext& _rctx, char* _pb, size_t _bl, bool& _can_retry, ErrorCodeT& _rerr);
+
+    ssize_t send(ReactorContext& _rctx, const char* _pb, size_t _bl, bool& _can_retry, ErrorCodeT& _rerr);
+
+    //! True once both peers share the rings
+    bool isNegotiated() const
+    {
+        return pshared_ != nullptr;
+    }
+
+private:
+    struct Shared;
+    struct Ring;
+    struct Hello;
+
+    ErrorCodeT doCreate();
+    bool       doAccept(bool& _can_retry, ErrorCodeT& _rerr);
+    void       doDrainDoorbells() const;
+    void       doRingDoorbell();
+    void       doUnmap();
+
+private:
+    size_t          ring_capacity_;
+    Shared*         pshared_;
+    size_t          shared_size_;
+    Ring*           precv_ring_;
+    char*           precv_data_;
+    Ring*           psend_ring_;
+    char*           psend_data_;
+    std::string     name_;
+    size_t          hello_size_;
+    char*           phello_;
+    mutable bool    peer_closed_;
+};
+
+} //namespace shm
+} //namespace aio
+} //namespace frame
+} //namespace solid
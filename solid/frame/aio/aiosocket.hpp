@@ -57,6 +57,17 @@ public:
         return rv;
     }
 
+    ssize_t sendFile(ReactorContext& _rctx, const Device& _rfile, int64_t _off, size_t _bl, bool& _can_retry, ErrorCodeT& _rerr)
+    {
+        const ssize_t rv = device().sendFile(_rfile, _off, _bl, _can_retry, _rerr);
+#if defined(SOLID_USE_WSAPOLL)
+        if (rv < 0 && _can_retry) {
+            modifyReactorRequestEvents(_rctx, ReactorWaitWrite);
+        }
+#endif
+        return rv;
+    }
+
     ssize_t recvFrom(ReactorContext& _rctx, char* _pb, size_t _bl, SocketAddress& _addr, bool& _can_retry, ErrorCodeT& _rerr)
     {
         const ssize_t rv = device().recv(_pb, _bl, _addr, _can_retry, _rerr);
@@ -75,6 +86,28 @@ public:
         if (rv < 0 && _can_retry) {
             modifyReactorRequestEvents(_rctx, ReactorWaitWrite);
         }
+#endif
+        return rv;
+    }
+
+    ssize_t recvFrom(ReactorContext& _rctx, DatagramStub* _pdgs, size_t _count, bool& _can_retry, ErrorCodeT& _rerr)
+    {
+        const ssize_t rv = device().recv(_pdgs, _count, _can_retry, _rerr);
+#if defined(SOLID_USE_WSAPOLL)
+        if (rv < 0 && _can_retry) {
+            modifyReactorRequestEvents(_rctx, ReactorWaitRead);
+        }
+#endif
+        return rv;
+    }
+
+    ssize_t sendTo(ReactorContext& _rctx, const DatagramStub* _pdgs, size_t _count, bool& _can_retry, ErrorCodeT& _rerr)
+    {
+        const ssize_t rv = device().send(_pdgs, _count, _can_retry, _rerr);
+#if defined(SOLID_USE_WSAPOLL)
+        if (rv < 0 && _can_retry) {
+            modifyReactorRequestEvents(_rctx, ReactorWaitWrite);
+        }
 #endif
         return rv;
     }
@@ -75,6 +75,7 @@ public:
 
     void init(ReactorContext& _rctx)
     {
+        initBusyPoll(_rctx);
 #if defined(SOLID_USE_EPOLL) || defined(SOLID_USE_KQUEUE)
         addReactorRequestEvents(_rctx, ReactorWaitReadOrWrite);
 #else
@@ -98,10 +99,13 @@ public:
         _rerr = device().create(_rsas.family());
         if (!_rerr) {
             _rerr = device().makeNonBlocking();
+            initBusyPoll(_rctx);
 #if defined(SOLID_USE_WSAPOLL)
             addReactorRequestEvents(_rctx, ReactorWaitNone);
 #else
-            addReactorRequestEvents(_rctx, ReactorWaitWrite);
+            //registered once for both directions - edge triggered, the
+            //connect completion is signaled by the write event
+            addReactorRequestEvents(_rctx, ReactorWaitReadOrWrite);
 #endif
         }
         return !_rerr;
@@ -122,13 +126,11 @@ public:
     ErrorCodeT checkConnect(ReactorContext& _rctx) const
     {
         ErrorCodeT err = device().error();
+#if defined(SOLID_USE_WSAPOLL)
         if (!err) {
-#if defined(SOLID_USE_EPOLL) || defined(SOLID_USE_KQUEUE)
-            modifyReactorRequestEvents(_rctx, ReactorWaitReadOrWrite);
-#else
             modifyReactorRequestEvents(_rctx, ReactorWaitNone);
-#endif
         }
+#endif
         return err;
     }
 
@@ -143,6 +145,14 @@ public:
     }
 
 protected:
+    //best effort - SO_BUSY_POLL may need CAP_NET_ADMIN
+    void initBusyPoll(ReactorContext& _rctx)
+    {
+        const size_t busy_poll_microseconds = _rctx.reactor().configuration().socket_busy_poll_microseconds_;
+        if (busy_poll_microseconds != 0) {
+            device().enableBusyPoll(busy_poll_microseconds);
+        }
+    }
     void addReactorRequestEvents(ReactorContext& _rctx, const ReactorWaitRequestsE _req) const
     {
         _rctx.reactor().addDevice(_rctx, device(), _req);
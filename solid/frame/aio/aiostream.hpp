@@ -130,6 +130,40 @@ class Stream : public CompletionHandler {
                     tmp(_rctx);
                     break;
                 }
+                if (_rthis.ioBudgetExhausted(_rctx)) {
+                    //let the other ready handlers run first
+                    _rthis.send_is_posted = true;
+                    _rthis.doPostSendAll(_rctx);
+                    break;
+                }
+            }
+        }
+    };
+
+    template <class F>
+    struct SendFileFunctor {
+        F f;
+
+        SendFileFunctor(F& _rf)
+            : f{std::move(_rf)}
+        {
+        }
+
+        void operator()(ThisT& _rthis, ReactorContext& _rctx)
+        {
+            while (_rthis.doTrySendFile(_rctx)) {
+                if (_rthis.send_buf_sz == _rthis.send_buf_cp) {
+                    F tmp{std::move(f)};
+                    _rthis.doClearSend(_rctx);
+                    tmp(_rctx);
+                    break;
+                }
+                if (_rthis.ioBudgetExhausted(_rctx)) {
+                    //let the other ready handlers run first
+                    _rthis.send_is_posted = true;
+                    _rthis.doPostSendAll(_rctx);
+                    break;
+                }
             }
         }
     };
@@ -274,6 +308,8 @@ public:
         , send_buf_sz(0)
         , send_buf_cp(0)
         , send_is_posted(false)
+        , send_file(nullptr)
+        , send_file_off(0)
     {
     }
 
@@ -290,6 +326,8 @@ public:
         , send_buf_sz(0)
         , send_buf_cp(0)
         , send_is_posted(false)
+        , send_file(nullptr)
+        , send_file_off(0)
     {
     }
 
@@ -304,6 +342,8 @@ public:
         , send_buf_sz(0)
         , send_buf_cp(0)
         , send_is_posted(false)
+        , send_file(nullptr)
+        , send_file_off(0)
     {
     }
 
@@ -320,6 +360,8 @@ public:
         , send_buf_sz(0)
         , send_buf_cp(0)
         , send_is_posted(false)
+        , send_file(nullptr)
+        , send_file_off(0)
     {
     }
 
@@ -338,6 +380,20 @@ public:
     {
         return !solid_function_empty(send_fnc);
     }
+
+    //Replaces the buffer of the pending recv operation.
+    //Returns false if there is no pending recv.
+    bool resetRecvBuffer(char* _buf, size_t _bufcp)
+    {
+        if (hasPendingRecv()) {
+            solid_assert(recv_buf_sz == 0);
+            recv_buf    = _buf;
+            recv_buf_cp = _bufcp;
+            return true;
+        }
+        return false;
+    }
+
     SocketDevice& device()
     {
         return s.device();
@@ -396,6 +452,14 @@ public:
             recv_buf_cp = _bufcp;
             recv_buf_sz = 0;
 
+            if (ioBudgetExhausted(_rctx)) {
+                //let the other ready handlers run first
+                recv_fnc       = RecvSomeFunctor<F>(_f);
+                recv_is_posted = true;
+                doPostRecvSome(_rctx);
+                return false;
+            }
+
             if (doTryRecv(_rctx)) {
                 _sz = recv_buf_sz;
                 return true;
@@ -429,6 +493,65 @@ public:
         }
     }
 
+    //Sends _len bytes of _rfile starting at offset _off, using sendfile where
+    //available so the data does not pass through user space buffers.
+    //The file must stay open until _f(ReactorContext&) is called.
+    //A _len of 0 completes right away, with success; a file ending before
+    //_off + _len fails with error_stream_file_end.
+    //Only for plain sockets: the data cannot bypass a secure socket.
+    template <typename F>
+    bool postSendFile(ReactorContext& _rctx, const Device& _rfile, int64_t _off, size_t _len, F _f)
+    {
+        if (solid_function_empty(send_fnc)) {
+            send_fnc       = SendFileFunctor<F>(_f);
+            send_file      = &_rfile;
+            send_file_off  = _off;
+            send_buf_cp    = _len;
+            send_buf_sz    = 0;
+            send_is_posted = true;
+            doPostSendAll(_rctx);
+            errorClear(_rctx);
+            return false;
+        } else {
+            error(_rctx, error_already);
+            solid_assert(false);
+            return true;
+        }
+    }
+
+    template <typename F>
+    bool sendFile(ReactorContext& _rctx, const Device& _rfile, int64_t _off, size_t _len, F _f)
+    {
+        if (solid_function_empty(send_fnc)) {
+            errorClear(_rctx);
+            contextBind(_rctx);
+
+            send_file     = &_rfile;
+            send_file_off = _off;
+            send_buf_cp   = _len;
+            send_buf_sz   = 0;
+
+            if (ioBudgetExhausted(_rctx)) {
+                send_fnc       = SendFileFunctor<F>(_f);
+                send_is_posted = true;
+                doPostSendAll(_rctx);
+                return false;
+            }
+
+            if (doTrySendFile(_rctx)) {
+                if (send_buf_sz == send_buf_cp) {
+                    send_file = nullptr;
+                    return true;
+                }
+            }
+            send_fnc = SendFileFunctor<F>(_f);
+            return false;
+        } else {
+            error(_rctx, error_already);
+        }
+        return true;
+    }
+
     template <typename F>
     bool sendAll(ReactorContext& _rctx, char* _buf, size_t _bufcp, F _f)
     {
@@ -440,6 +563,13 @@ public:
             send_buf_cp = _bufcp;
             send_buf_sz = 0;
 
+            if (ioBudgetExhausted(_rctx)) {
+                send_fnc       = SendAllFunctor<F>(_f);
+                send_is_posted = true;
+                doPostSendAll(_rctx);
+                return false;
+            }
+
             if (doTrySend(_rctx)) {
                 if (send_buf_sz == send_buf_cp) {
                     return true;
@@ -563,6 +693,12 @@ public:
         return true;
     }
 
+    //Continue a secure handshake after a step run off the reactor - see openssl::Socket::setHandshakeOffload
+    void secureResume(ReactorContext& _rctx)
+    {
+        doRecv(_rctx);
+    }
+
     void secureRenegotiate(ReactorContext& _rctx)
     {
         ErrorCodeT err = s.renegotiate();
@@ -615,6 +751,16 @@ public:
         }
     }
 
+    void secureSetSessionKey(ReactorContext& _rctx, const std::string& _val)
+    {
+        ErrorCodeT err = s.setSessionKey(_val);
+        if (err) {
+            error(_rctx, error_stream_system);
+            systemError(_rctx, err);
+            solid_assert(err);
+        }
+    }
+
 private:
     void doPostRecvSome(ReactorContext& _rctx)
     {
@@ -654,6 +800,7 @@ private:
         solid_dbg(logger, Verbose, "recv (" << (recv_buf_cp - recv_buf_sz) << ") = " << rv);
 
         if (rv > 0) {
+            ioBudgetConsume(_rctx, rv);
             recv_buf_sz += rv;
             recv_buf += rv;
         } else if (rv == 0) {
@@ -681,6 +828,7 @@ private:
         solid_dbg(logger, Verbose, "send (" << (send_buf_cp - send_buf_sz) << ") = " << rv << ' ' << can_retry);
 
         if (rv > 0) {
+            ioBudgetConsume(_rctx, rv);
             send_buf_sz += rv;
             send_buf += rv;
         } else if (rv == 0) {
@@ -699,6 +847,37 @@ private:
         return true;
     }
 
+    bool doTrySendFile(ReactorContext& _rctx)
+    {
+        if (send_buf_sz == send_buf_cp) {
+            return true; //nothing to send
+        }
+        bool       can_retry;
+        ErrorCodeT err;
+        ssize_t    rv = s.sendFile(_rctx, *send_file, send_file_off, send_buf_cp - send_buf_sz, can_retry, err);
+
+        solid_dbg(logger, Verbose, "sendFile (" << (send_buf_cp - send_buf_sz) << ") = " << rv << ' ' << can_retry);
+
+        if (rv > 0) {
+            ioBudgetConsume(_rctx, rv);
+            send_buf_sz += rv;
+            send_file_off += rv;
+        } else if (rv == 0) {
+            error(_rctx, error_stream_file_end);
+            send_buf_sz = send_buf_cp = 0;
+        } else if (rv < 0) {
+            if (can_retry) {
+                return false;
+            } else {
+                send_buf_sz = send_buf_cp = 0;
+                error(_rctx, error_stream_system);
+                systemError(_rctx, err);
+                solid_assert(err);
+            }
+        }
+        return true;
+    }
+
     void doCheckConnect(ReactorContext& _rctx)
     {
         ErrorCodeT err = s.checkConnect(_rctx);
@@ -736,6 +915,7 @@ private:
         solid_function_clear(send_fnc);
         solid_assert(solid_function_empty(send_fnc));
         send_buf    = nullptr;
+        send_file   = nullptr;
         send_buf_sz = send_buf_cp = 0;
     }
 
@@ -762,6 +942,8 @@ private:
     size_t        send_buf_cp;
     SendFunctionT send_fnc;
     bool          send_is_posted;
+    const Device* send_file;
+    int64_t       send_file_off;
 };
 
 } //namespace aio
@@ -13,6 +13,7 @@
 #include "openssl/ssl.h"
 #include "solid/system/error.hpp"
 #include "solid/utility/function.hpp"
+#include <memory>
 
 namespace solid {
 namespace frame {
@@ -30,6 +31,8 @@ enum struct FileFormat {
 };
 
 class Socket;
+struct SessionStore;
+
 class Context {
     Context();
 
@@ -72,6 +75,20 @@ public:
     ErrorCodeT loadPrivateKey(const unsigned char* _data, const size_t _data_size, const FileFormat _fformat = FileFormat::Pem);
     ErrorCodeT loadPrivateKey(const std::string& _str, const FileFormat _fformat = FileFormat::Pem);
 
+    //!Use it on client side to keep the last TLS session of every peer,
+    //!so that reconnecting resumes it instead of doing a full handshake.
+    //!Peers are identified by the key given to Socket::setSessionKey.
+    ErrorCodeT enableSessionCache();
+
+    //!Use it on server side to encrypt the TLS session tickets with keys owned by the context.
+    //!The first call should be made before any handshake.
+    //!Call it again to rotate the key: tickets encrypted with the previous key
+    //!are still accepted (and renewed), older tickets fall back to a full handshake.
+    ErrorCodeT rotateSessionTicketKey();
+
+    //!Use it on server side - needed for resuming sessions when peers are verified
+    ErrorCodeT setSessionIdContext(const std::string& _id);
+
     template <typename F>
     ErrorCodeT passwordCallback(F _f)
     {
@@ -87,13 +104,15 @@ public:
 private:
     static int on_password_cb(char* buf, int size, int rwflag, void* u);
     ErrorCodeT doSetPasswordCallback();
+    SessionStore& doSessionStore();
 
 private:
     using PasswordFunctionT = solid_function_t(std::string(std::size_t, PasswordPurpose));
 
     friend class Socket;
-    SSL_CTX*          pctx;
-    PasswordFunctionT pwdfnc;
+    SSL_CTX*                      pctx;
+    PasswordFunctionT             pwdfnc;
+    std::unique_ptr<SessionStore> session_store_ptr;
 };
 
 } //namespace openssl
@@ -15,6 +15,9 @@
 #include "solid/system/socketdevice.hpp"
 #include "solid/utility/function.hpp"
 #include <cerrno>
+#include <functional>
+#include <memory>
+#include <string>
 
 namespace solid {
 namespace frame {
@@ -36,6 +39,7 @@ enum VerifyMode {
 using VerifyMaskT = unsigned long;
 
 class Socket;
+struct HandshakeOffload;
 
 struct VerifyContext {
     using NativeContextT = X509_STORE_CTX;
@@ -67,6 +71,10 @@ public:
     using VerifyMaskT    = openssl::VerifyMaskT;
     using VerifyContextT = openssl::VerifyContext;
 
+    using HandshakeJobT             = std::function<void()>;
+    using HandshakeOffloadFunctionT = solid_function_t(void(HandshakeJobT&&));
+    using HandshakeResumeFunctionT  = solid_function_t(void());
+
     Socket(const Context& _rctx, SocketDevice&& _rsd);
 
     Socket(const Context& _rctx);
@@ -111,6 +119,18 @@ public:
     ErrorCodeT setCheckEmail(const std::string& _hostname);
     ErrorCodeT setCheckIP(const std::string& _hostname);
 
+    //!Use it on client side, before secureConnect, to resume the session
+    //!cached under _key - see Context::enableSessionCache
+    ErrorCodeT setSessionKey(const std::string& _key);
+
+    bool isSessionReused() const;
+
+    //!Use it on server side, before secureAccept, to run the handshake step with
+    //!the private key operation off the reactor: _offload_fnc must call the job on another thread.
+    //!When the step is done, _resume_fnc is called on that thread and must get
+    //!secureAccept called again on the reactor - see Stream::secureResume.
+    void setHandshakeOffload(HandshakeOffloadFunctionT _offload_fnc, HandshakeResumeFunctionT _resume_fnc);
+
 private:
     static int thisSSLDataIndex();
     static int contextPointerSSLDataIndex();
@@ -123,17 +143,21 @@ private:
 
     ErrorCodeT doPrepareVerifyCallback(VerifyMaskT _verify_mask);
 
+    bool doStartOffloadAccept(bool& _rwait_read);
+
     static int on_verify(int preverify_ok, X509_STORE_CTX* x509_ctx);
 
 private:
     using VerifyFunctionT = solid_function_t(bool(void*, bool, VerifyContextT&));
 
-    SSL*            pssl;
-    bool            want_read_on_recv;
-    bool            want_read_on_send;
-    bool            want_write_on_recv;
-    bool            want_write_on_send;
-    VerifyFunctionT verify_cbk;
+    SSL*                              pssl;
+    bool                              want_read_on_recv;
+    bool                              want_read_on_send;
+    bool                              want_write_on_recv;
+    bool                              want_write_on_send;
+    VerifyFunctionT                   verify_cbk;
+    std::string                       session_key;
+    std::shared_ptr<HandshakeOffload> offload_ptr;
 };
 
 inline Socket::NativeHandleT Socket::nativeHandle() const
@@ -16,8 +16,10 @@
 #include "solid/system/error.hpp"
 #include "solid/system/exception.hpp"
 #include "solid/system/log.hpp"
+#include <condition_variable>
 #include <mutex>
 #include <thread>
+#include <unordered_map>
 
 //#include <cstdio>
 
@@ -25,8 +27,16 @@
 #include "openssl/conf.h"
 #include "openssl/err.h"
 #include "openssl/evp.h"
+#include "openssl/rand.h"
 #include "openssl/ssl.h"
 
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L && !defined(OPENSSL_IS_BORINGSSL)
+#define SOLID_OPENSSL_TICKET_EVP_MAC
+#include "openssl/core_names.h"
+#else
+#include "openssl/hmac.h"
+#endif
+
 #ifdef SOLID_ON_WINDOWS
 #pragma comment(lib, "crypt32")
 #endif
@@ -66,6 +76,7 @@ enum struct WrapperError : int {
     SetCheckHostName,
     SetCheckEmail,
     SetCheckIP,
+    SetSessionIdContext,
 };
 
 class ErrorCategory : public solid::ErrorCategoryT {
@@ -103,6 +114,9 @@ std::string ErrorCategory::message(int _ev) const
     case WrapperError::SetCheckIP:
         oss << "Setting IP used for verification";
         break;
+    case WrapperError::SetSessionIdContext:
+        oss << "Setting session id context";
+        break;
     default:
         oss << "Unknown error";
         break;
@@ -155,6 +169,57 @@ struct Starter {
 
 //=============================================================================
 
+struct SessionStore {
+    struct TicketKey {
+        unsigned char name[16];
+        unsigned char aes_key[32];
+        unsigned char hmac_key[32];
+    };
+
+    using SessionMapT = std::unordered_map<std::string, SSL_SESSION*>;
+
+    std::mutex  mutex;
+    SessionMapT session_map;
+    TicketKey   ticket_key_arr[2]; //current and previous
+    size_t      ticket_key_count = 0;
+
+    ~SessionStore()
+    {
+        for (auto& session : session_map) {
+            SSL_SESSION_free(session.second);
+        }
+    }
+
+    static int contextDataIndex()
+    {
+        static int idx = SSL_CTX_get_ex_new_index(0, (void*)"session_store", nullptr, nullptr, nullptr);
+        return idx;
+    }
+
+    static int keySSLDataIndex()
+    {
+        static int idx = SSL_get_ex_new_index(0, (void*)"session_key", nullptr, nullptr, nullptr);
+        return idx;
+    }
+
+    //OpenSSL invalidates the session of a connection freed without a TLS shutdown,
+    //which is how most connections end, so cached sessions are never shared with connections.
+    static SSL_SESSION* copy(SSL_SESSION* _psession)
+    {
+#ifdef OPENSSL_IS_BORINGSSL
+        SSL_SESSION_up_ref(_psession);
+        return _psession;
+#else
+        return SSL_SESSION_dup(_psession);
+#endif
+    }
+
+    static SessionStore* get(SSL* _pssl)
+    {
+        return static_cast<SessionStore*>(SSL_CTX_get_ex_data(SSL_get_SSL_CTX(_pssl), contextDataIndex()));
+    }
+};
+
 /*static*/ Context Context::create(const SSL_METHOD* _pm /*= nullptr*/)
 {
     Starter::the();
@@ -181,6 +246,7 @@ bool Context::empty() const
 }
 
 Context::Context(Context&& _rctx) noexcept
+    : session_store_ptr(std::move(_rctx.session_store_ptr))
 {
     pctx       = _rctx.pctx;
     _rctx.pctx = nullptr;
@@ -188,11 +254,16 @@ Context::Context(Context&& _rctx) noexcept
 Context& Context::operator=(Context&& _rctx) noexcept
 {
     if (isValid()) {
+        if (session_store_ptr) {
+            //sockets might keep the SSL_CTX alive
+            SSL_CTX_set_ex_data(pctx, SessionStore::contextDataIndex(), nullptr);
+        }
         SSL_CTX_free(pctx);
         pctx = nullptr;
     }
-    pctx       = _rctx.pctx;
-    _rctx.pctx = nullptr;
+    pctx              = _rctx.pctx;
+    _rctx.pctx        = nullptr;
+    session_store_ptr = std::move(_rctx.session_store_ptr);
     return *this;
 }
 Context::Context()
@@ -202,6 +273,10 @@ Context::Context()
 Context::~Context()
 {
     if (isValid()) {
+        if (session_store_ptr) {
+            //sockets might keep the SSL_CTX alive
+            SSL_CTX_set_ex_data(pctx, SessionStore::contextDataIndex(), nullptr);
+        }
         SSL_CTX_free(pctx);
         pctx = nullptr;
     }
@@ -422,6 +497,165 @@ ErrorCodeT Context::doSetPasswordCallback()
     return static_cast<int>(strlen(buf));
 }
 
+//=============================================================================
+//  Session resumption
+//=============================================================================
+
+namespace {
+
+int on_new_session(SSL* _pssl, SSL_SESSION* _psession)
+{
+    const std::string* pkey   = static_cast<const std::string*>(SSL_get_ex_data(_pssl, SessionStore::keySSLDataIndex()));
+    SessionStore*      pstore = SessionStore::get(_pssl);
+
+    if (pkey == nullptr || pstore == nullptr) {
+        return 0;
+    }
+
+    SSL_SESSION* psession = SessionStore::copy(_psession);
+
+    if (psession == nullptr) {
+        return 0;
+    }
+
+    std::lock_guard<std::mutex> lock(pstore->mutex);
+    SSL_SESSION*&               rpsession = pstore->session_map[*pkey];
+
+    if (rpsession != nullptr) {
+        SSL_SESSION_free(rpsession);
+    }
+    rpsession = psession;
+    return 0;
+}
+
+#ifdef SOLID_OPENSSL_TICKET_EVP_MAC
+using TicketMacContextT = EVP_MAC_CTX;
+
+bool init_ticket_mac(TicketMacContextT* _pmac_ctx, unsigned char* _key, const size_t _key_size)
+{
+    OSSL_PARAM params[3];
+    params[0] = OSSL_PARAM_construct_octet_string(OSSL_MAC_PARAM_KEY, _key, _key_size);
+    params[1] = OSSL_PARAM_construct_utf8_string(OSSL_MAC_PARAM_DIGEST, const_cast<char*>("SHA256"), 0);
+    params[2] = OSSL_PARAM_construct_end();
+    return EVP_MAC_CTX_set_params(_pmac_ctx, params) == 1;
+}
+#else
+using TicketMacContextT = HMAC_CTX;
+
+bool init_ticket_mac(TicketMacContextT* _pmac_ctx, unsigned char* _key, const size_t _key_size)
+{
+    return HMAC_Init_ex(_pmac_ctx, _key, static_cast<int>(_key_size), EVP_sha256(), nullptr) == 1;
+}
+#endif
+
+//returns: -1 error, 0 unknown key (full handshake), 1 ok, 2 ok but renew the ticket
+int on_ticket_key(SSL* _pssl, unsigned char* _key_name, unsigned char* _iv, EVP_CIPHER_CTX* _pcipher_ctx, TicketMacContextT* _pmac_ctx, int _encrypt)
+{
+    SessionStore* pstore = SessionStore::get(_pssl);
+
+    if (pstore == nullptr) {
+        return -1;
+    }
+
+    SessionStore::TicketKey key;
+    bool                    is_previous = false;
+    {
+        std::lock_guard<std::mutex> lock(pstore->mutex);
+
+        if (_encrypt != 0) {
+            key = pstore->ticket_key_arr[0];
+        } else {
+            size_t i = 0;
+            for (; i < pstore->ticket_key_count; ++i) {
+                if (memcmp(_key_name, pstore->ticket_key_arr[i].name, sizeof(key.name)) == 0) {
+                    break;
+                }
+            }
+            if (i == pstore->ticket_key_count) {
+                return 0;
+            }
+            key         = pstore->ticket_key_arr[i];
+            is_previous = i != 0;
+        }
+    }
+
+    if (_encrypt != 0) {
+        memcpy(_key_name, key.name, sizeof(key.name));
+        if (RAND_bytes(_iv, EVP_CIPHER_iv_length(EVP_aes_256_cbc())) != 1) {
+            return -1;
+        }
+        if (EVP_EncryptInit_ex(_pcipher_ctx, EVP_aes_256_cbc(), nullptr, key.aes_key, _iv) != 1) {
+            return -1;
+        }
+    } else if (EVP_DecryptInit_ex(_pcipher_ctx, EVP_aes_256_cbc(), nullptr, key.aes_key, _iv) != 1) {
+        return -1;
+    }
+
+    if (!init_ticket_mac(_pmac_ctx, key.hmac_key, sizeof(key.hmac_key))) {
+        return -1;
+    }
+    return is_previous ? 2 : 1;
+}
+
+} //namespace
+
+SessionStore& Context::doSessionStore()
+{
+    if (!session_store_ptr) {
+        session_store_ptr.reset(new SessionStore);
+        SSL_CTX_set_ex_data(pctx, SessionStore::contextDataIndex(), session_store_ptr.get());
+    }
+    return *session_store_ptr;
+}
+
+ErrorCodeT Context::enableSessionCache()
+{
+    doSessionStore();
+
+    SSL_CTX_set_session_cache_mode(pctx, SSL_SESS_CACHE_CLIENT | SSL_SESS_CACHE_NO_INTERNAL_STORE);
+    SSL_CTX_sess_set_new_cb(pctx, on_new_session);
+    return ErrorCodeT();
+}
+
+ErrorCodeT Context::rotateSessionTicketKey()
+{
+    SessionStore&           rstore = doSessionStore();
+    SessionStore::TicketKey key;
+
+    ::ERR_clear_error();
+
+    if (RAND_bytes(key.name, sizeof(key.name)) != 1 || RAND_bytes(key.aes_key, sizeof(key.aes_key)) != 1 || RAND_bytes(key.hmac_key, sizeof(key.hmac_key)) != 1) {
+        return ssl_category.makeError(::ERR_get_error());
+    }
+
+    bool is_first;
+    {
+        std::lock_guard<std::mutex> lock(rstore.mutex);
+
+        is_first                 = rstore.ticket_key_count == 0;
+        rstore.ticket_key_arr[1] = rstore.ticket_key_arr[0];
+        rstore.ticket_key_arr[0] = key;
+        rstore.ticket_key_count  = is_first ? 1 : 2;
+    }
+
+    if (is_first) {
+#ifdef SOLID_OPENSSL_TICKET_EVP_MAC
+        SSL_CTX_set_tlsext_ticket_key_evp_cb(pctx, on_ticket_key);
+#else
+        SSL_CTX_set_tlsext_ticket_key_cb(pctx, on_ticket_key);
+#endif
+    }
+    return ErrorCodeT();
+}
+
+ErrorCodeT Context::setSessionIdContext(const std::string& _id)
+{
+    if (SSL_CTX_set_session_id_context(pctx, reinterpret_cast<const unsigned char*>(_id.data()), static_cast<unsigned>(_id.size())) == 1) {
+        return ErrorCodeT();
+    }
+    return wrapper_category.makeError(WrapperError::SetSessionIdContext);
+}
+
 //=============================================================================
 
 /*static*/ int Socket::thisSSLDataIndex()
@@ -435,6 +669,46 @@ ErrorCodeT Context::doSetPasswordCallback()
     return idx;
 }
 
+//=============================================================================
+//  Handshake offload
+//=============================================================================
+
+struct HandshakeStep {
+    int           err_cond = SSL_ERROR_NONE;
+    ErrorCodeT    err_sys;
+    unsigned long err_code = 0;
+};
+
+struct HandshakeOffload {
+    enum struct StatusE {
+        Idle,
+        Queued,
+        Running,
+        Done,
+        Canceled,
+    };
+
+    std::mutex                        mutex;
+    std::condition_variable           cnd;
+    StatusE                           status    = StatusE::Idle;
+    bool                              notifying = false;
+    HandshakeStep                     step;
+    Socket::HandshakeOffloadFunctionT offload_fnc;
+    Socket::HandshakeResumeFunctionT  resume_fnc;
+
+    //called from ~Socket - the job must not touch the socket afterwards
+    void cancel()
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        if (status == StatusE::Queued) {
+            status = StatusE::Canceled;
+        }
+        cnd.wait(lock, [this]() { return status != StatusE::Running && !notifying; });
+    }
+};
+
+//=============================================================================
+
 Socket::Socket(
     const Context& _rctx, SocketDevice&& _rsd)
     : SocketBase(std::move(_rsd))
@@ -465,6 +739,9 @@ Socket::Socket(const Context& _rctx)
 
 Socket::~Socket()
 {
+    if (offload_ptr) {
+        offload_ptr->cancel();
+    }
     SSL_free(pssl);
 }
 
@@ -662,22 +939,202 @@ ssize_t Socket::send(ReactorContext& _rctx, const char* _pb, size_t _bl, bool& _
     return -1;
 }
 
+void Socket::setHandshakeOffload(HandshakeOffloadFunctionT _offload_fnc, HandshakeResumeFunctionT _resume_fnc)
+{
+    offload_ptr = std::make_shared<HandshakeOffload>();
+
+    offload_ptr->offload_fnc = std::move(_offload_fnc);
+    offload_ptr->resume_fnc  = std::move(_resume_fnc);
+}
+
+//Only the ClientHello processing - with the server's first flight and its private key
+//operation - is offloaded. The job gets exactly the next TLS record through a memory BIO,
+//so it never reads the client's next flight, whose processing calls the verify callback
+//which needs the ReactorContext.
+bool Socket::doStartOffloadAccept(bool& _rwait_read)
+{
+#ifdef OPENSSL_IS_BORINGSSL
+    return false;
+#else
+    const OSSL_HANDSHAKE_STATE state = SSL_get_state(pssl);
+
+    if (state != TLS_ST_BEFORE && state != TLS_ST_SR_CLNT_HELLO) {
+        return false;
+    }
+
+    const size_t  header_size = SSL3_RT_HEADER_LENGTH;
+    unsigned char header[header_size];
+
+    const auto rv = ::recv(device().descriptor(), reinterpret_cast<char*>(header), header_size, MSG_PEEK);
+
+    if (rv < 0) {
+        const ErrorCodeT err = last_socket_error();
+        if (err == std::errc::resource_unavailable_try_again || err == std::errc::operation_would_block) {
+            _rwait_read = true; //nothing received yet
+        }
+        return false;
+    } else if (rv == 0) {
+        return false; //let SSL_accept report the error
+    } else if (static_cast<size_t>(rv) < header_size) {
+        _rwait_read = true;
+        return false;
+    }
+
+    const size_t record_size = header_size + ((static_cast<size_t>(header[3]) << 8) | header[4]);
+
+    if (record_size > SSL3_RT_MAX_PACKET_SIZE) {
+        return false;
+    }
+
+    std::unique_ptr<char[]> record_buf(new char[record_size]);
+
+    if (::recv(device().descriptor(), record_buf.get(), record_size, MSG_PEEK) != static_cast<ssize_t>(record_size)) {
+        _rwait_read = true; //wait for the entire record
+        return false;
+    }
+
+    BIO* precord_bio = BIO_new(BIO_s_mem());
+
+    if (precord_bio == nullptr) {
+        return false;
+    }
+
+    BIO_set_mem_eof_return(precord_bio, -1); //empty means retry
+
+    //the job gets the peeked record - only then is it consumed from the socket
+    if (BIO_write(precord_bio, record_buf.get(), static_cast<int>(record_size)) != static_cast<int>(record_size)) {
+        BIO_free(precord_bio);
+        return false;
+    }
+
+    size_t consumed_size = 0;
+
+    while (consumed_size < record_size) {
+        const auto consume_rv = ::recv(device().descriptor(), record_buf.get() + consumed_size, record_size - consumed_size, 0);
+
+        if (consume_rv > 0) {
+            consumed_size += consume_rv;
+        } else if (consume_rv < 0 && last_socket_error() == std::errc::interrupted) {
+            continue;
+        } else {
+            //the record was peeked whole, so this is a socket error - let SSL_accept report it
+            BIO_free(precord_bio);
+            return false;
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(offload_ptr->mutex);
+        offload_ptr->status = HandshakeOffload::StatusE::Queued;
+    }
+
+    auto job = [poffload = offload_ptr, pthis = this, precord_bio]() {
+        {
+            std::lock_guard<std::mutex> lock(poffload->mutex);
+            if (poffload->status != HandshakeOffload::StatusE::Queued) {
+                BIO_free(precord_bio);
+                return;
+            }
+            poffload->status = HandshakeOffload::StatusE::Running;
+        }
+
+        HandshakeStep step;
+        BIO*          psocket_bio = SSL_get_rbio(pthis->pssl);
+
+        BIO_up_ref(psocket_bio);
+        SSL_set0_rbio(pthis->pssl, precord_bio);
+
+        pthis->storeThisPointer();
+
+        ::ERR_clear_error();
+
+        const int retval = ::SSL_accept(pthis->pssl);
+        step.err_sys     = last_socket_error();
+        step.err_cond    = ::SSL_get_error(pthis->pssl, retval);
+        step.err_code    = ::ERR_get_error();
+
+        pthis->clearThisPointer();
+
+        SSL_set0_rbio(pthis->pssl, psocket_bio);
+
+        {
+            std::lock_guard<std::mutex> lock(poffload->mutex);
+            poffload->step      = step;
+            poffload->status    = HandshakeOffload::StatusE::Done;
+            poffload->notifying = true;
+        }
+
+        poffload->resume_fnc();
+
+        std::lock_guard<std::mutex> lock(poffload->mutex);
+        poffload->notifying = false;
+        poffload->cnd.notify_all();
+    };
+
+    offload_ptr->offload_fnc(std::move(job));
+    return true;
+#endif
+}
+
 bool Socket::secureAccept(ReactorContext& _rctx, bool& _can_retry, ErrorCodeT& _rerr)
 {
     want_read_on_recv = want_write_on_recv = false;
 
-    storeThisPointer();
-    storeContextPointer(&_rctx);
+    HandshakeStep step;
+    bool          has_step = false;
+
+    if (offload_ptr) {
+        {
+            std::lock_guard<std::mutex> lock(offload_ptr->mutex);
+
+            switch (offload_ptr->status) {
+            case HandshakeOffload::StatusE::Queued:
+            case HandshakeOffload::StatusE::Running:
+                _can_retry = true; //the SSL object belongs to the offload job
+                return false;
+            case HandshakeOffload::StatusE::Done:
+                offload_ptr->status = HandshakeOffload::StatusE::Idle;
+                step                = offload_ptr->step;
+                //while the step was running, readiness notifications were dropped:
+                //we retry right away instead of waiting for another one
+                has_step = step.err_cond != SSL_ERROR_WANT_READ && step.err_cond != SSL_ERROR_WANT_WRITE;
+                break;
+            default:
+                break;
+            }
+        }
 
-    ::ERR_clear_error();
+        if (!has_step) {
+            bool wait_read = false;
 
-    const int           retval   = ::SSL_accept(pssl);
-    const ErrorCodeT    err_sys  = last_socket_error();
-    const int           err_cond = ::SSL_get_error(pssl, retval);
-    const unsigned long err_code = ::ERR_get_error();
+            if (doStartOffloadAccept(wait_read)) {
+                _can_retry = true;
+                return false;
+            } else if (wait_read) {
+                step.err_cond = SSL_ERROR_WANT_READ;
+                has_step      = true;
+            }
+        }
+    }
 
-    clearThisPointer();
-    clearContextPointer();
+    if (!has_step) {
+        storeThisPointer();
+        storeContextPointer(&_rctx);
+
+        ::ERR_clear_error();
+
+        const int retval = ::SSL_accept(pssl);
+        step.err_sys     = last_socket_error();
+        step.err_cond    = ::SSL_get_error(pssl, retval);
+        step.err_code    = ::ERR_get_error();
+
+        clearThisPointer();
+        clearContextPointer();
+    }
+
+    const int           err_cond = step.err_cond;
+    const ErrorCodeT&   err_sys  = step.err_sys;
+    const unsigned long err_code = step.err_code;
 
     switch (err_cond) {
     case SSL_ERROR_NONE:
@@ -903,6 +1360,10 @@ ErrorCodeT Socket::doPrepareVerifyCallback(VerifyMaskT _verify_mask)
     solid_check(ssl);
     solid_check(pthis);
 
+    if (pctx == nullptr) {
+        return 0; //not on the reactor - see Socket::doStartOffloadAccept
+    }
+
     if (!solid_function_empty(pthis->verify_cbk)) {
         VerifyContext vctx(x509_ctx);
 
@@ -959,6 +1420,36 @@ ErrorCodeT Socket::setCheckIP(const std::string& _ip)
     return wrapper_category.makeError(WrapperError::SetCheckIP);
 }
 
+ErrorCodeT Socket::setSessionKey(const std::string& _key)
+{
+    session_key = _key;
+    SSL_set_ex_data(pssl, SessionStore::keySSLDataIndex(), &session_key);
+
+    SessionStore* pstore = SessionStore::get(pssl);
+
+    if (pstore != nullptr) {
+        std::lock_guard<std::mutex> lock(pstore->mutex);
+        const auto                  it = pstore->session_map.find(session_key);
+
+        if (it != pstore->session_map.end() && SSL_SESSION_is_resumable(it->second) != 0) {
+            SSL_SESSION* psession = SessionStore::copy(it->second);
+
+            ::ERR_clear_error();
+            if (psession == nullptr || SSL_set_session(pssl, psession) != 1) {
+                SSL_SESSION_free(psession);
+                return ssl_category.makeError(::ERR_get_error());
+            }
+            SSL_SESSION_free(psession); //the SSL keeps its own reference
+        }
+    }
+    return ErrorCodeT();
+}
+
+bool Socket::isSessionReused() const
+{
+    return SSL_session_reused(pssl) != 0;
+}
+
 } //namespace openssl
 } //namespace aio
 } //namespace frame
@@ -29,6 +29,9 @@ CompletionHandler::CompletionHandler(
     : pprev(nullptr)
     , idxreactor(InvalidIndex())
     , call(_pcall)
+    , io_turn(0)
+    , io_op_cnt(0)
+    , io_byte_cnt(0)
 {
     if (_rop.object().registerCompletionHandler(*this)) {
         this->activate(_rop.object());
@@ -41,6 +44,9 @@ CompletionHandler::CompletionHandler(
     : pprev(nullptr)
     , idxreactor(InvalidIndex())
     , call(_pcall)
+    , io_turn(0)
+    , io_op_cnt(0)
+    , io_byte_cnt(0)
 {
 }
 
@@ -112,6 +118,22 @@ void CompletionHandler::remTimer(ReactorContext& _rctx, size_t const& _storedidx
     }
 }
 
+bool CompletionHandler::ioBudgetExhausted(ReactorContext& _rctx)
+{
+    return _rctx.reactor().ioBudgetExhausted(*this);
+}
+
+void CompletionHandler::ioBudgetConsume(ReactorContext& _rctx, const size_t _sz)
+{
+    _rctx.reactor().ioBudgetConsume(*this, _sz);
+}
+
+UniqueId CompletionHandler::uid(ReactorContext& _rctx) const
+{
+    solid_assert(isActive());
+    return _rctx.reactor().completionHandlerUid(*this);
+}
+
 SocketDevice& dummy_socket_device()
 {
     static SocketDevice sd;
@@ -28,7 +28,9 @@ enum {
     ErrorStreamSystemE,
     ErrorStreamSocketE,
     ErrorStreamShutdownE,
+    ErrorStreamFileEndE,
     ErrorTimerCancelE,
+    ErrorOffloadFullE,
     ErrorListenerSystemE,
     ErrorListenerHangupE,
     ErrorSecureContextE,
@@ -92,9 +94,15 @@ std::string ErrorCategory::message(int _ev) const
     case ErrorStreamShutdownE:
         oss << "Stream: peer shutdown";
         break;
+    case ErrorStreamFileEndE:
+        oss << "Stream: end of file reached before sending all data";
+        break;
     case ErrorTimerCancelE:
         oss << "Timer: canceled";
         break;
+    case ErrorOffloadFullE:
+        oss << "Offload: work pool queue full";
+        break;
     case ErrorListenerSystemE:
         oss << "Listener: system";
         break;
@@ -144,9 +152,12 @@ std::string ErrorCategory::message(int _ev) const
 /*extern*/ const ErrorConditionT error_stream_system(ErrorStreamSystemE, category);
 /*extern*/ const ErrorConditionT error_stream_socket(ErrorStreamSocketE, category);
 /*extern*/ const ErrorConditionT error_stream_shutdown(ErrorStreamShutdownE, category);
+/*extern*/ const ErrorConditionT error_stream_file_end(ErrorStreamFileEndE, category);
 
 /*extern*/ const ErrorConditionT error_timer_cancel(ErrorTimerCancelE, category);
 
+/*extern*/ const ErrorConditionT error_offload_full(ErrorOffloadFullE, category);
+
 /*extern*/ const ErrorConditionT error_listener_system(ErrorListenerSystemE, category);
 /*extern*/ const ErrorConditionT error_listener_hangup(ErrorListenerHangupE, category);
 
@@ -294,6 +294,20 @@ struct RaiseEventStub {
 
 //=============================================================================
 
+struct ResumeStub {
+    ResumeStub(
+        UniqueId const& _robjuid, UniqueId const& _rchnuid)
+        : objuid(_robjuid)
+        , chnuid(_rchnuid)
+    {
+    }
+
+    UniqueId objuid;
+    UniqueId chnuid;
+};
+
+//=============================================================================
+
 struct CompletionHandlerStub {
     CompletionHandlerStub(
         CompletionHandler* _pch    = nullptr,
@@ -386,6 +400,7 @@ struct ExecStub {
 
 typedef std::vector<NewTaskStub>    NewTaskVectorT;
 typedef std::vector<RaiseEventStub> RaiseEventVectorT;
+typedef std::vector<ResumeStub>     ResumeVectorT;
 
 #if defined(SOLID_USE_EPOLL)
 
@@ -424,14 +439,18 @@ using SizeTVectorT            = std::vector<size_t>;
 //=============================================================================
 struct Reactor::Data {
     Data(
-
-        )
-        : reactor_fd(-1)
+        ReactorConfiguration const& _rcfg)
+        : config(_rcfg)
+        , pstatistic(_rcfg.statistic_ptr_.get())
+        , io_turn(0)
+        , polling(false)
+        , reactor_fd(-1)
         , running(false)
         , crtpushtskvecidx(0)
         , crtraisevecidx(0)
         , crtpushvecsz(0)
         , crtraisevecsz(0)
+        , crtresumevecsz(0)
         , devcnt(0)
         , objcnt(0)
         , timestore(MinEventCapacity)
@@ -522,18 +541,99 @@ struct Reactor::Data {
     }
 #endif
 
+    bool timerDue(NanoTime const& _rcrt) const
+    {
+        return timestore.size() != 0u && !(_rcrt < timestore.next());
+    }
+
+    bool inboxPending() const
+    {
+        return crtpushvecsz != 0u || crtraisevecsz != 0u || crtresumevecsz != 0u;
+    }
+
+    long pollNoWait()
+    {
+#if defined(SOLID_USE_EPOLL)
+        return epoll_wait(reactor_fd, eventvec.data(), static_cast<int>(eventvec.size()), 0);
+#elif defined(SOLID_USE_KQUEUE)
+        const NanoTime waittime;
+        return kevent(reactor_fd, nullptr, 0, eventvec.data(), static_cast<int>(eventvec.size()), &waittime);
+#elif defined(SOLID_USE_WSAPOLL)
+        return WSAPoll(eventvec.data(), eventvec.size(), 0);
+#endif
+    }
+
+    //Polls the devices and the inbox for at most config.busy_poll_microseconds_.
+    //Returns the number of ready devices or -1 if the reactor must
+    //block waiting for them.
+    long busyPoll(NanoTime& _rcrt)
+    {
+        if (!exeq.empty() || timerDue(_rcrt)) {
+            return -1; //the wait would not block
+        }
+        const auto end_tp = std::chrono::steady_clock::now() + std::chrono::microseconds(config.busy_poll_microseconds_);
+        long       selcnt = 0;
+
+        polling = true;
+        do {
+            selcnt = pollNoWait();
+            if (selcnt != 0) {
+                break;
+            }
+            if (inboxPending()) {
+                break;
+            }
+            _rcrt = std::chrono::steady_clock::now();
+            if (timerDue(_rcrt)) {
+                break;
+            }
+            std::this_thread::yield(); //let the peer run when sharing the CPU
+        } while (_rcrt.timePointCast<std::chrono::steady_clock::time_point>() < end_tp);
+
+        //from now on, the other threads must wake the reactor
+        polling = false;
+
+        if (selcnt > 0 || inboxPending() || timerDue(_rcrt)) {
+            if (pstatistic != nullptr) {
+                ++pstatistic->busy_poll_hit_count_;
+            }
+            return selcnt > 0 ? selcnt : 0;
+        }
+        if (pstatistic != nullptr) {
+            ++pstatistic->busy_poll_miss_count_;
+        }
+        return -1;
+    }
+
+    //No need to wake the reactor while it polls the inbox.
+    //polling is stored before and the inbox sizes are loaded after by the
+    //reactor, the other way around by the other threads, so that, with
+    //sequentially consistent atomics, at least one of them sees the other.
+    void wake(Reactor& _rreactor)
+    {
+        if (!polling) {
+            eventobj.eventhandler.write(_rreactor);
+        }
+    }
+
     UniqueId dummyCompletionHandlerUid() const
     {
         const size_t idx = eventobj.dummyhandler.idxreactor;
         return UniqueId(idx, chdq[idx].unique);
     }
 
+    const ReactorConfiguration config;
+    ReactorStatistic* const    pstatistic;
+    uint64_t                   io_turn;
+    AtomicBoolT                polling;
+
     int                     reactor_fd;
     AtomicBoolT             running;
     size_t                  crtpushtskvecidx;
     size_t                  crtraisevecidx;
     AtomicSizeT             crtpushvecsz;
     AtomicSizeT             crtraisevecsz;
+    AtomicSizeT             crtresumevecsz;
     size_t                  devcnt;
     size_t                  objcnt;
     TimeStoreT              timestore;
@@ -541,6 +641,7 @@ struct Reactor::Data {
     EventVectorT            eventvec;
     NewTaskVectorT          pushtskvec[2];
     RaiseEventVectorT       raisevec[2];
+    ResumeVectorT           resumevec[2]; //indexed by crtraisevecidx too
     EventObject             eventobj;
     CompletionHandlerDequeT chdq;
     UidVectorT              freeuidvec;
@@ -580,11 +681,37 @@ void EventHandler::write(Reactor& _rreactor)
 //  Reactor
 //-----------------------------------------------------------------------------
 
+ReactorStatistic::ReactorStatistic()
+    : turn_count_(0)
+    , device_add_count_(0)
+    , device_mod_count_(0)
+    , device_rem_count_(0)
+    , io_budget_exhausted_count_(0)
+    , busy_poll_hit_count_(0)
+    , busy_poll_miss_count_(0)
+{
+}
+
+std::ostream& ReactorStatistic::print(std::ostream& _ros) const
+{
+    _ros << " turn_count_ = " << turn_count_;
+    _ros << " device_add_count_ = " << device_add_count_;
+    _ros << " device_mod_count_ = " << device_mod_count_;
+    _ros << " device_rem_count_ = " << device_rem_count_;
+    _ros << " io_budget_exhausted_count_ = " << io_budget_exhausted_count_;
+    _ros << " busy_poll_hit_count_ = " << busy_poll_hit_count_;
+    _ros << " busy_poll_miss_count_ = " << busy_poll_miss_count_;
+    return _ros;
+}
+
+//-----------------------------------------------------------------------------
+
 Reactor::Reactor(
-    SchedulerBase& _rsched,
-    const size_t   _idx)
+    SchedulerBase&        _rsched,
+    const size_t          _idx,
+    ConfigurationT const& _rcfg)
     : ReactorBase(_rsched, _idx)
-    , impl_(make_pimpl<Data>())
+    , impl_(make_pimpl<Data>(_rcfg))
 {
     solid_dbg(logger, Verbose, "");
 }
@@ -652,7 +779,7 @@ bool Reactor::start()
         impl_->crtraisevecsz = raisevecsz;
     }
     if (raisevecsz == 1) {
-        impl_->eventobj.eventhandler.write(*this);
+        impl_->wake(*this);
     }
     return rv;
 }
@@ -672,13 +799,31 @@ bool Reactor::start()
         impl_->crtraisevecsz = raisevecsz;
     }
     if (raisevecsz == 1) {
-        impl_->eventobj.eventhandler.write(*this);
+        impl_->wake(*this);
     }
     return rv;
 }
 
 //-----------------------------------------------------------------------------
 
+void Reactor::resume(UniqueId const& _robjuid, UniqueId const& _rchuid)
+{
+    solid_dbg(logger, Verbose, (void*)this << " uid = " << _robjuid.index << ',' << _robjuid.unique << " chuid = " << _rchuid.index << ',' << _rchuid.unique);
+    size_t resumevecsz = 0;
+    {
+        lock_guard<std::mutex> lock(impl_->mtx);
+
+        impl_->resumevec[impl_->crtraisevecidx].emplace_back(_robjuid, _rchuid);
+        resumevecsz           = impl_->resumevec[impl_->crtraisevecidx].size();
+        impl_->crtresumevecsz = resumevecsz;
+    }
+    if (resumevecsz == 1) {
+        impl_->wake(*this);
+    }
+}
+
+//-----------------------------------------------------------------------------
+
 /*virtual*/ void Reactor::stop()
 {
     solid_dbg(logger, Verbose, "");
@@ -706,7 +851,7 @@ bool Reactor::push(TaskT& _robj, Service& _rsvc, Event&& _uevent)
     }
 
     if (pushvecsz == 1) {
-        impl_->eventobj.eventhandler.write(*this);
+        impl_->wake(*this);
     }
     return rv;
 }
@@ -737,24 +882,34 @@ void Reactor::run()
     while (running) {
         crttime = std::chrono::steady_clock::now();
 
+        ++impl_->io_turn; //renews the I/O budgets of all completion handlers
+        if (impl_->pstatistic != nullptr) {
+            ++impl_->pstatistic->turn_count_;
+        }
+
         crtload = impl_->objcnt + impl_->devcnt + impl_->exeq.size();
+
+        selcnt = impl_->config.busy_poll_microseconds_ != 0 ? impl_->busyPoll(crttime) : -1;
+
+        if (selcnt < 0) {
 #if defined(SOLID_USE_EPOLL)
-        waitmsec = impl_->computeWaitTimeMilliseconds(crttime);
+            waitmsec = impl_->computeWaitTimeMilliseconds(crttime);
 
-        solid_dbg(logger, Verbose, "epoll_wait msec = " << waitmsec);
+            solid_dbg(logger, Verbose, "epoll_wait msec = " << waitmsec);
 
-        selcnt = epoll_wait(impl_->reactor_fd, impl_->eventvec.data(), static_cast<int>(impl_->eventvec.size()), waitmsec);
+            selcnt = epoll_wait(impl_->reactor_fd, impl_->eventvec.data(), static_cast<int>(impl_->eventvec.size()), waitmsec);
 #elif defined(SOLID_USE_KQUEUE)
-        waittime = impl_->computeWaitTimeMilliseconds(crttime);
+            waittime = impl_->computeWaitTimeMilliseconds(crttime);
 
-        solid_dbg(logger, Verbose, "kqueue msec = " << waittime.seconds() << ':' << waittime.nanoSeconds());
+            solid_dbg(logger, Verbose, "kqueue msec = " << waittime.seconds() << ':' << waittime.nanoSeconds());
 
-        selcnt = kevent(impl_->reactor_fd, nullptr, 0, impl_->eventvec.data(), static_cast<int>(impl_->eventvec.size()), waittime != NanoTime::maximum ? &waittime : nullptr);
+            selcnt = kevent(impl_->reactor_fd, nullptr, 0, impl_->eventvec.data(), static_cast<int>(impl_->eventvec.size()), waittime != NanoTime::maximum ? &waittime : nullptr);
 #elif defined(SOLID_USE_WSAPOLL)
-        waitmsec = impl_->computeWaitTimeMilliseconds(crttime);
-        solid_dbg(logger, Verbose, "wsapoll wait msec = " << waitmsec);
-        selcnt = WSAPoll(impl_->eventvec.data(), impl_->eventvec.size(), waitmsec);
+            waitmsec = impl_->computeWaitTimeMilliseconds(crttime);
+            solid_dbg(logger, Verbose, "wsapoll wait msec = " << waitmsec);
+            selcnt = WSAPoll(impl_->eventvec.data(), impl_->eventvec.size(), waitmsec);
 #endif
+        }
         crttime = std::chrono::steady_clock::now();
 
 #if defined(SOLID_USE_WSAPOLL)
@@ -944,6 +1099,13 @@ inline UniqueId Reactor::objectUid(ReactorContext const& _rctx) const
 
 //-----------------------------------------------------------------------------
 
+UniqueId Reactor::completionHandlerUid(CompletionHandler const& _rch) const
+{
+    return UniqueId(_rch.idxreactor, impl_->chdq[_rch.idxreactor].unique);
+}
+
+//-----------------------------------------------------------------------------
+
 Service& Reactor::service(ReactorContext const& _rctx) const
 {
     return *impl_->objdq[_rctx.object_index_].psvc;
@@ -958,6 +1120,13 @@ Object& Reactor::object(ReactorContext const& _rctx) const
 
 //-----------------------------------------------------------------------------
 
+Reactor::ConfigurationT const& Reactor::configuration() const
+{
+    return impl_->config;
+}
+
+//-----------------------------------------------------------------------------
+
 CompletionHandler* Reactor::completionHandler(ReactorContext const& _rctx) const
 {
     return impl_->chdq[_rctx.channel_index_].pch;
@@ -1034,6 +1203,40 @@ void Reactor::doStopObject(ReactorContext& _rctx)
 
 //-----------------------------------------------------------------------------
 
+bool Reactor::ioBudgetExhausted(CompletionHandler& _rch)
+{
+    if (_rch.io_turn != impl_->io_turn) {
+        _rch.io_turn     = impl_->io_turn;
+        _rch.io_op_cnt   = 0;
+        _rch.io_byte_cnt = 0;
+        return false;
+    }
+    if (
+        (impl_->config.io_operation_budget_ != 0 && _rch.io_op_cnt >= impl_->config.io_operation_budget_) || (impl_->config.io_byte_budget_ != 0 && _rch.io_byte_cnt >= impl_->config.io_byte_budget_)) {
+        solid_dbg(logger, Verbose, "io budget exhausted ops = " << _rch.io_op_cnt << " bytes = " << _rch.io_byte_cnt);
+        if (impl_->pstatistic != nullptr) {
+            ++impl_->pstatistic->io_budget_exhausted_count_;
+        }
+        return true;
+    }
+    return false;
+}
+
+//-----------------------------------------------------------------------------
+
+void Reactor::ioBudgetConsume(CompletionHandler& _rch, const size_t _sz)
+{
+    if (_rch.io_turn != impl_->io_turn) {
+        _rch.io_turn     = impl_->io_turn;
+        _rch.io_op_cnt   = 0;
+        _rch.io_byte_cnt = 0;
+    }
+    ++_rch.io_op_cnt;
+    _rch.io_byte_cnt += _sz;
+}
+
+//-----------------------------------------------------------------------------
+
 void Reactor::doCompleteIo(NanoTime const& _rcrttime, const size_t _sz)
 {
     ReactorContext ctx(*this, _rcrttime);
@@ -1210,7 +1413,7 @@ void Reactor::doCompleteEvents(ReactorContext const& _rctx)
 {
     solid_dbg(logger, Verbose, "");
 
-    if (impl_->crtpushvecsz != 0u || impl_->crtraisevecsz != 0u) {
+    if (impl_->crtpushvecsz != 0u || impl_->crtraisevecsz != 0u || impl_->crtresumevecsz != 0u) {
         size_t crtpushvecidx;
         size_t crtraisevecidx;
         {
@@ -1227,11 +1430,12 @@ void Reactor::doCompleteEvents(ReactorContext const& _rctx)
             }
             impl_->freeuidvec.clear();
 
-            impl_->crtpushvecsz = impl_->crtraisevecsz = 0;
+            impl_->crtpushvecsz = impl_->crtraisevecsz = impl_->crtresumevecsz = 0;
         }
 
         NewTaskVectorT&    crtpushvec  = impl_->pushtskvec[crtpushvecidx];
-        RaiseEventVectorT& crtraisevec = impl_->raisevec[crtraisevecidx];
+        RaiseEventVectorT& crtraisevec  = impl_->raisevec[crtraisevecidx];
+        ResumeVectorT&     crtresumevec = impl_->resumevec[crtraisevecidx];
 
         ReactorContext ctx(_rctx);
 
@@ -1276,6 +1480,12 @@ void Reactor::doCompleteEvents(ReactorContext const& _rctx)
         solid_dbg(logger, Verbose, impl_->exeq.size());
 
         crtraisevec.clear();
+
+        for (const auto& rresume : crtresumevec) {
+            impl_->exeq.push(ExecStub(rresume.objuid, &call_completion_on_resume, rresume.chnuid));
+        }
+
+        crtresumevec.clear();
     }
 }
 
@@ -1288,6 +1498,15 @@ void Reactor::doCompleteEvents(ReactorContext const& _rctx)
 
 //-----------------------------------------------------------------------------
 
+/*static*/ void Reactor::call_completion_on_resume(ReactorContext& _rctx, Event&& /*_uevent*/)
+{
+    _rctx.reactor_event_ = ReactorEventResume;
+    _rctx.completionHandler()->handleCompletion(_rctx);
+    _rctx.reactor_event_ = ReactorEventNone;
+}
+
+//-----------------------------------------------------------------------------
+
 /*static*/ void Reactor::increase_event_vector_size(ReactorContext& _rctx, Event&& /*_rev*/)
 {
     Reactor& rthis = _rctx.reactor();
@@ -1383,6 +1602,9 @@ bool Reactor::addDevice(ReactorContext& _rctx, Device const& _rsd, const Reactor
     impl_->eventvec[_rctx.channel_index_].fd = reinterpret_cast<SocketDevice::DescriptorT>(_rsd.descriptor());
     impl_->eventvec[_rctx.channel_index_].events = reactorRequestsToSystemEvents(_req);
 #endif
+    if (impl_->pstatistic != nullptr) {
+        ++impl_->pstatistic->device_add_count_;
+    }
     return true;
 }
 
@@ -1466,6 +1688,9 @@ bool Reactor::modDevice(ReactorContext& _rctx, Device const& _rsd, const Reactor
         impl_->eventvec[_rctx.channel_index_].events = reactorRequestsToSystemEvents(_req);
     }
 #endif
+    if (impl_->pstatistic != nullptr) {
+        ++impl_->pstatistic->device_mod_count_;
+    }
     return true;
 }
 
@@ -1517,6 +1742,9 @@ bool Reactor::remDevice(CompletionHandler const& _rch, Device const& _rsd)
     }
     impl_->eventvec[_rch.idxreactor].clear();
 #endif
+    if (impl_->pstatistic != nullptr) {
+        ++impl_->pstatistic->device_rem_count_;
+    }
     return true;
 }
 
@@ -1668,6 +1896,13 @@ std::mutex& ReactorContext::objectMutex() const
 
 //-----------------------------------------------------------------------------
 
+size_t ReactorContext::numaNode() const
+{
+    return reactor().numaNode();
+}
+
+//-----------------------------------------------------------------------------
+
 UniqueId ReactorContext::objectUid() const
 {
     return reactor().objectUid(*this);
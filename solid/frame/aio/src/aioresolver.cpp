@@ -12,6 +12,9 @@
 #include "solid/utility/dynamicpointer.hpp"
 
 #include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
 
 namespace solid {
 namespace frame {
@@ -28,6 +31,241 @@ void ReverseResolve::doRun(std::string& _rhost, std::string& _rsrvc)
     synchronous_resolve(_rhost, _rsrvc, addr, flags);
 }
 //-----------------------------------------------------------------------------
+//  ResolverStatistic
+//-----------------------------------------------------------------------------
+ResolverStatistic::ResolverStatistic()
+    : request_count_(0)
+    , lookup_count_(0)
+    , cache_hit_count_(0)
+    , cache_negative_hit_count_(0)
+    , coalesced_count_(0)
+    , refresh_count_(0)
+    , evict_count_(0)
+{
+}
+//-----------------------------------------------------------------------------
+std::ostream& ResolverStatistic::print(std::ostream& _ros) const
+{
+    _ros << " request_count_ = " << request_count_;
+    _ros << " lookup_count_ = " << lookup_count_;
+    _ros << " cache_hit_count_ = " << cache_hit_count_;
+    _ros << " cache_negative_hit_count_ = " << cache_negative_hit_count_;
+    _ros << " coalesced_count_ = " << coalesced_count_;
+    _ros << " refresh_count_ = " << refresh_count_;
+    _ros << " evict_count_ = " << evict_count_;
+    return _ros;
+}
+//-----------------------------------------------------------------------------
+//  Resolver::Cache
+//-----------------------------------------------------------------------------
+namespace {
+
+using TimePointT = std::chrono::steady_clock::time_point;
+
+std::string cache_key(DirectResolve const& _rdr)
+{
+    std::string key;
+    key.reserve(_rdr.host.size() + _rdr.srvc.size() + 32);
+    key += _rdr.host;
+    key += '\0';
+    key += _rdr.srvc;
+    key += '\0';
+    key += std::to_string(_rdr.flags);
+    key += ',';
+    key += std::to_string(_rdr.family);
+    key += ',';
+    key += std::to_string(_rdr.type);
+    key += ',';
+    key += std::to_string(_rdr.proto);
+    return key;
+}
+
+} //namespace
+
+struct Resolver::Cache {
+    struct Entry {
+        ResolveData                    data;
+        ErrorCodeT                     error;
+        TimePointT                     expire_time;
+        TimePointT                     refresh_time;
+        bool                           in_flight = false;
+        std::vector<CompleteFunctionT> waiters;
+
+        bool valid(const TimePointT& _now) const
+        {
+            return _now < expire_time;
+        }
+    };
+    using EntryMapT = std::unordered_map<std::string, Entry>;
+
+    const ResolverConfiguration config_;
+    ResolverStatistic           dummy_statistic_;
+    ResolverStatistic&          rstatistic_;
+    std::mutex                  mtx_;
+    EntryMapT                   entry_map_;
+
+    Cache(ResolverConfiguration const& _rcfg)
+        : config_(_rcfg)
+        , rstatistic_(_rcfg.statistic_ptr_ ? *_rcfg.statistic_ptr_ : dummy_statistic_)
+    {
+    }
+
+    //returns true if _rdr must be looked up; on a hit, _rcbk is kept and
+    //_rhit set together with the cached result
+    bool request(CompleteFunctionT& _rcbk, const std::string& _key, bool& _rhit, ResolveData& _rrd, ErrorCodeT& _rerr);
+
+    void complete(const std::string& _key, ResolveData& _rrd, ErrorCodeT const& _rerr);
+
+    void evict(const TimePointT& _now);
+};
+//-----------------------------------------------------------------------------
+void Resolver::Cache::evict(const TimePointT& _now)
+{
+    for (auto it = entry_map_.begin(); it != entry_map_.end();) {
+        if (!it->second.in_flight && !it->second.valid(_now)) {
+            it = entry_map_.erase(it);
+            ++rstatistic_.evict_count_;
+        } else {
+            ++it;
+        }
+    }
+    //still full of valid entries - drop any entry not waited for
+    for (auto it = entry_map_.begin(); entry_map_.size() >= config_.cache_capacity_ && it != entry_map_.end();) {
+        if (!it->second.in_flight) {
+            it = entry_map_.erase(it);
+            ++rstatistic_.evict_count_;
+        } else {
+            ++it;
+        }
+    }
+}
+//-----------------------------------------------------------------------------
+bool Resolver::Cache::request(CompleteFunctionT& _rcbk, const std::string& _key, bool& _rhit, ResolveData& _rrd, ErrorCodeT& _rerr)
+{
+    const TimePointT now    = std::chrono::steady_clock::now();
+    bool             lookup = false;
+
+    ++rstatistic_.request_count_;
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+
+        auto it = entry_map_.find(_key);
+
+        if (it == entry_map_.end()) {
+            if (entry_map_.size() >= config_.cache_capacity_) {
+                evict(now);
+            }
+            it = entry_map_.emplace(_key, Entry()).first;
+        }
+
+        Entry& rentry = it->second;
+
+        if (!rentry.valid(now)) {
+            rentry.waiters.emplace_back(std::move(_rcbk));
+            if (rentry.in_flight) {
+                ++rstatistic_.coalesced_count_;
+                return false;
+            }
+            rentry.in_flight = true;
+            ++rstatistic_.lookup_count_;
+            return true;
+        }
+
+        if (!rentry.in_flight && now >= rentry.refresh_time) {
+            rentry.in_flight = true;
+            lookup           = true;
+            ++rstatistic_.lookup_count_;
+            ++rstatistic_.refresh_count_;
+        }
+        _rrd  = rentry.data;
+        _rerr = rentry.error;
+    }
+
+    ++rstatistic_.cache_hit_count_;
+    if (_rrd.empty()) {
+        ++rstatistic_.cache_negative_hit_count_;
+    }
+    _rhit = true;
+    return lookup;
+}
+//-----------------------------------------------------------------------------
+void Resolver::Cache::complete(const std::string& _key, ResolveData& _rrd, ErrorCodeT const& _rerr)
+{
+    const TimePointT               now = std::chrono::steady_clock::now();
+    std::vector<CompleteFunctionT> waiters;
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+
+        auto it = entry_map_.find(_key);
+        if (it == entry_map_.end()) {
+            return;
+        }
+
+        Entry&     rentry   = it->second;
+        const bool negative = _rrd.empty() || _rerr;
+
+        rentry.in_flight = false;
+
+        //a failed refresh keeps the addresses until they expire
+        if (!negative || !rentry.valid(now) || rentry.data.empty()) {
+            const auto ttl = negative ? config_.cache_negative_ttl_ : config_.cache_ttl_;
+
+            rentry.data         = _rrd;
+            rentry.error        = _rerr;
+            rentry.expire_time  = now + ttl;
+            rentry.refresh_time = config_.cache_refresh_ahead_ < ttl ? rentry.expire_time - config_.cache_refresh_ahead_ : rentry.expire_time;
+        }
+        waiters.swap(rentry.waiters);
+    }
+
+    for (auto& rcbk : waiters) {
+        ResolveData rd(_rrd);
+        rcbk(rd, _rerr);
+    }
+}
+//-----------------------------------------------------------------------------
+//  Resolver
+//-----------------------------------------------------------------------------
+Resolver::Resolver(FunctionWorkPool& _rfwp, ConfigurationT const& _rcfg)
+    : rfwp_(_rfwp)
+{
+    if (_rcfg.cache_ttl_.count() != 0) {
+        cache_ptr_ = std::make_shared<Cache>(_rcfg);
+    }
+}
+//-----------------------------------------------------------------------------
+Resolver::~Resolver()
+{
+}
+//-----------------------------------------------------------------------------
+void Resolver::doRequestResolve(CompleteFunctionT&& _ucbk, DirectResolve&& _udr)
+{
+    const std::string key = cache_key(_udr);
+    bool              hit = false;
+    ResolveData       hit_rd;
+    ErrorCodeT        hit_err;
+
+    if (cache_ptr_->request(_ucbk, key, hit, hit_rd, hit_err)) {
+        //the lookup job keeps the cache alive beyond the Resolver
+        std::shared_ptr<Cache> cache_ptr = cache_ptr_;
+        DirectResolve          dr(std::move(_udr));
+
+        rfwp_.push(
+            [cache_ptr, dr, key]() mutable {
+                ResolveData rd = dr.doRun();
+                cache_ptr->complete(key, rd, dr.error);
+            });
+    }
+
+    if (hit) {
+        //like the lookups, never complete on the calling thread
+        rfwp_.push(
+            [cbk = std::move(_ucbk), hit_rd, hit_err]() mutable {
+                cbk(hit_rd, hit_err);
+            });
+    }
+}
+//-----------------------------------------------------------------------------
 } // namespace aio
 } //namespace frame
 } //namespace solid
@@ -0,0 +1,488 @@
+// solid/frame/aio/src/aioshmsocket.cpp
+//
+// Copyright (c) 2018 Valentin Palade (vipalade @ gmail . com)
+//
+// This file is part of SolidFrame framework.
+//
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt.
+//
+#include "solid/frame/aio/aioshmsocket.hpp"
+#include "solid/system/error.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <new>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+static_assert(ATOMIC_LLONG_LOCK_FREE == 2 && ATOMIC_INT_LOCK_FREE == 2, "shared memory rings need lock free - address free - atomics");
+
+namespace solid {
+namespace frame {
+namespace aio {
+namespace shm {
+
+namespace {
+
+constexpr uint64_t shm_magic         = 0x314d48535f444c53ULL; //"SLD_SHM1"
+constexpr size_t   name_capacity     = 64;
+constexpr size_t   page_size         = 4096;
+constexpr size_t   min_ring_capacity = 4096;
+constexpr size_t   max_ring_capacity = size_t(1) << 30;
+constexpr char     name_prefix[]     = "/solid_shm_";
+
+std::atomic<size_t> name_counter{0};
+
+size_t ring_capacity(const size_t _cp)
+{
+    size_t cp = min_ring_capacity;
+    while (cp < _cp && cp < max_ring_capacity) {
+        cp <<= 1;
+    }
+    return cp;
+}
+
+size_t round_up(const size_t _sz, const size_t _align)
+{
+    return ((_sz + _align - 1) / _align) * _align;
+}
+
+} //namespace
+
+//each index on its own cache line - the producer and the consumer do not share lines
+struct Socket::Ring {
+    alignas(64) std::atomic<uint64_t> head_; //consumed bytes - written by the consumer
+    alignas(64) std::atomic<uint64_t> tail_; //produced bytes - written by the producer
+    alignas(64) std::atomic<uint32_t> reader_waiting_;
+    std::atomic<uint32_t> writer_waiting_;
+
+    void init()
+    {
+        head_.store(0);
+        tail_.store(0);
+        reader_waiting_.store(0);
+        writer_waiting_.store(0);
+    }
+};
+
+struct Socket::Shared {
+    uint64_t magic_;
+    uint64_t ring_capacity_;
+    Ring     ring_[2]; //[0] connecting -> accepting side, [1] accepting -> connecting side
+
+    static size_t dataOffset()
+    {
+        return round_up(sizeof(Shared), page_size);
+    }
+
+    static size_t size(const size_t _ring_capacity)
+    {
+        return dataOffset() + 2 * _ring_capacity;
+    }
+
+    char* data(const size_t _idx)
+    {
+        return reinterpret_cast<char*>(this) + dataOffset() + _idx * ring_capacity_;
+    }
+};
+
+struct Socket::Hello {
+    uint64_t magic_;
+    uint64_t ring_capacity_;
+    char     name_[name_capacity];
+};
+
+Socket::Socket(const Context& _rctx, SocketDevice&& _rsd)
+    : SocketBase(std::move(_rsd))
+    , ring_capacity_(ring_capacity(_rctx.ring_capacity_))
+    , pshared_(nullptr)
+    , shared_size_(0)
+    , precv_ring_(nullptr)
+    , precv_data_(nullptr)
+    , psend_ring_(nullptr)
+    , psend_data_(nullptr)
+    , hello_size_(0)
+    , phello_(new char[sizeof(Hello)])
+    , peer_closed_(false)
+{
+}
+
+Socket::Socket(const Context& _rctx)
+    : ring_capacity_(ring_capacity(_rctx.ring_capacity_))
+    , pshared_(nullptr)
+    , shared_size_(0)
+    , precv_ring_(nullptr)
+    , precv_data_(nullptr)
+    , psend_ring_(nullptr)
+    , psend_data_(nullptr)
+    , hello_size_(0)
+    , phello_(nullptr)
+    , peer_closed_(false)
+{
+}
+
+Socket::~Socket()
+{
+    doUnmap();
+    if (!name_.empty()) {
+        //the accepting side unlinks it once mapped - this covers a peer that never did
+        shm_unlink(name_.c_str());
+    }
+    delete[] phello_;
+}
+
+ReactorEventsE Socket::filterReactorEvents(
+    const ReactorEventsE _evt) const
+{
+    switch (_evt) {
+    case ReactorEventRecv:
+    case ReactorEventRecvSend:
+    case ReactorEventSendRecv:
+        if (pshared_ != nullptr) {
+            doDrainDoorbells();
+        }
+        //a doorbell means data for the receiver or space for the sender
+        return ReactorEventRecvSend;
+    case ReactorEventHangup:
+    case ReactorEventRecvHangup:
+    case ReactorEventError:
+        if (pshared_ != nullptr) {
+            //let the receiver consume what is left in the ring
+            peer_closed_ = true;
+            return ReactorEventRecvSend;
+        }
+        return _evt;
+    default:
+        return _evt;
+    }
+}
+
+ErrorCodeT Socket::checkConnect(ReactorContext& _rctx)
+{
+    ErrorCodeT err = SocketBase::checkConnect(_rctx);
+    if (!err) {
+        err = doCreate();
+    }
+    return err;
+}
+
+ssize_t Socket::recv(ReactorContext& /*_rctx*/, char* _pb, size_t _bl, bool& _can_retry, ErrorCodeT& _rerr)
+{
+    _can_retry = false;
+
+    if (pshared_ == nullptr && !doAccept(_can_retry, _rerr)) {
+        return _rerr || _can_retry ? -1 : 0;
+    }
+
+    const size_t   mask = ring_capacity_ - 1;
+    const uint64_t head = precv_ring_->head_.load(std::memory_order_relaxed);
+    uint64_t       tail = precv_ring_->tail_.load(std::memory_order_acquire);
+
+    if (tail == head) {
+        //announce the wait, then look again - see send
+        precv_ring_->reader_waiting_.store(1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        tail = precv_ring_->tail_.load(std::memory_order_acquire);
+
+        if (tail == head) {
+            if (peer_closed_) {
+                return 0;
+            }
+            _can_retry = true;
+            return -1;
+        }
+        precv_ring_->reader_waiting_.store(0, std::memory_order_relaxed);
+    }
+
+    //the indexes live in memory the peer writes to
+    if (tail - head > ring_capacity_) {
+        _rerr = ErrorCodeT(EPROTO, std::system_category());
+        return -1;
+    }
+
+    const size_t sz    = static_cast<size_t>(std::min<uint64_t>(_bl, tail - head));
+    const size_t off   = static_cast<size_t>(head) & mask;
+    const size_t first = std::min(sz, ring_capacity_ - off);
+
+    memcpy(_pb, precv_data_ + off, first);
+    memcpy(_pb + first, precv_data_, sz - first);
+
+    precv_ring_->head_.store(head + sz, std::memory_order_release);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    if (precv_ring_->writer_waiting_.load(std::memory_order_relaxed) != 0 && precv_ring_->writer_waiting_.exchange(0) != 0) {
+        doRingDoorbell();
+    }
+    return static_cast<ssize_t>(sz);
+}
+
+ssize_t Socket::send(ReactorContext& /*_rctx*/, const char* _pb, size_t _bl, bool& _can_retry, ErrorCodeT& _rerr)
+{
+    _can_retry = false;
+
+    if (pshared_ == nullptr && !doAccept(_can_retry, _rerr)) {
+        return _rerr || _can_retry ? -1 : 0;
+    }
+
+    if (peer_closed_) {
+        _rerr = ErrorCodeT(EPIPE, std::system_category());
+        return -1;
+    }
+
+    const size_t   mask = ring_capacity_ - 1;
+    const uint64_t tail = psend_ring_->tail_.load(std::memory_order_relaxed);
+    uint64_t       head = psend_ring_->head_.load(std::memory_order_acquire);
+
+    if (tail - head > ring_capacity_) {
+        _rerr = ErrorCodeT(EPROTO, std::system_category());
+        return -1;
+    }
+
+    if (tail - head == ring_capacity_) {
+        //the reader rings the doorbell when it sees writer_waiting_ after consuming -
+        //the fences make sure that at least one of us sees the other's update
+        psend_ring_->writer_waiting_.store(1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        head = psend_ring_->head_.load(std::memory_order_acquire);
+
+        if (tail - head > ring_capacity_) {
+            _rerr = ErrorCodeT(EPROTO, std::system_category());
+            return -1;
+        }
+        if (tail - head == ring_capacity_) {
+            _can_retry = true;
+            return -1;
+        }
+        psend_ring_->writer_waiting_.store(0, std::memory_order_relaxed);
+    }
+
+    const size_t sz    = static_cast<size_t>(std::min<uint64_t>(_bl, ring_capacity_ - (tail - head)));
+    const size_t off   = static_cast<size_t>(tail) & mask;
+    const size_t first = std::min(sz, ring_capacity_ - off);
+
+    memcpy(psend_data_ + off, _pb, first);
+    memcpy(psend_data_, _pb + first, sz - first);
+
+    psend_ring_->tail_.store(tail + sz, std::memory_order_release);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    if (psend_ring_->reader_waiting_.load(std::memory_order_relaxed) != 0 && psend_ring_->reader_waiting_.exchange(0) != 0) {
+        doRingDoorbell();
+    }
+    return static_cast<ssize_t>(sz);
+}
+
+//connecting side: create the segment and send its name
+ErrorCodeT Socket::doCreate()
+{
+    name_ = name_prefix + std::to_string(getpid()) + '_' + std::to_string(name_counter.fetch_add(1));
+
+    const size_t shared_size = Shared::size(ring_capacity_);
+    const int    fd          = shm_open(name_.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+
+    if (fd < 0) {
+        const ErrorCodeT err = last_system_error();
+        name_.clear();
+        return err;
+    }
+
+    if (ftruncate(fd, static_cast<off_t>(shared_size)) != 0) {
+        const ErrorCodeT err = last_system_error();
+        close(fd);
+        return err;
+    }
+
+    void* pmem = mmap(nullptr, shared_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+
+    if (pmem == MAP_FAILED) {
+        return last_system_error();
+    }
+
+    pshared_                 = new (pmem) Shared;
+    shared_size_             = shared_size;
+    pshared_->magic_         = shm_magic;
+    pshared_->ring_capacity_ = ring_capacity_;
+    pshared_->ring_[0].init();
+    pshared_->ring_[1].init();
+
+    psend_ring_ = &pshared_->ring_[0];
+    psend_data_ = pshared_->data(0);
+    precv_ring_ = &pshared_->ring_[1];
+    precv_data_ = pshared_->data(1);
+
+    Hello hello;
+
+    memset(&hello, 0, sizeof(hello));
+    hello.magic_         = shm_magic;
+    hello.ring_capacity_ = ring_capacity_;
+    memcpy(hello.name_, name_.c_str(), name_.size());
+
+    //a fresh connection always has room for the few bytes of hello
+    bool          can_retry;
+    ErrorCodeT    err;
+    const ssize_t rv = device().send(reinterpret_cast<const char*>(&hello), sizeof(hello), can_retry, err);
+
+    if (rv != static_cast<ssize_t>(sizeof(hello))) {
+        doUnmap();
+        return err ? err : ErrorCodeT(EPROTO, std::system_category());
+    }
+    return ErrorCodeT();
+}
+
+//accepting side: receive the segment name and map it
+bool Socket::doAccept(bool& _can_retry, ErrorCodeT& _rerr)
+{
+    if (phello_ == nullptr) {
+        //connecting side, not connected yet
+        _rerr = ErrorCodeT(ENOTCONN, std::system_category());
+        return false;
+    }
+
+    while (hello_size_ < sizeof(Hello)) {
+        const ssize_t rv = device().recv(phello_ + hello_size_, sizeof(Hello) - hello_size_, _can_retry, _rerr);
+        if (rv <= 0) {
+            return false;
+        }
+        hello_size_ += rv;
+    }
+
+    Hello hello;
+
+    memcpy(&hello, phello_, sizeof(hello));
+    hello.name_[name_capacity - 1] = '\0';
+
+    //only segments created by doCreate are accepted - the name comes from the peer
+    if (hello.magic_ != shm_magic || hello.ring_capacity_ != ring_capacity(hello.ring_capacity_) || strncmp(hello.name_, name_prefix, sizeof(name_prefix) - 1) != 0 || strchr(hello.name_ + 1, '/') != nullptr) {
+        _rerr = ErrorCodeT(EPROTO, std::system_category());
+        return false;
+    }
+
+    const size_t shared_size = Shared::size(hello.ring_capacity_);
+    struct stat  st;
+
+    //check the size and the header on a read-only mapping, before touching the segment
+    {
+        const int fd = shm_open(hello.name_, O_RDONLY, 0);
+
+        if (fd < 0) {
+            _rerr = last_system_error();
+            return false;
+        }
+
+        if (fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) != shared_size) {
+            close(fd);
+            _rerr = ErrorCodeT(EPROTO, std::system_category());
+            return false;
+        }
+
+        void* pmem = mmap(nullptr, sizeof(Shared), PROT_READ, MAP_SHARED, fd, 0);
+        close(fd);
+
+        if (pmem == MAP_FAILED) {
+            _rerr = last_system_error();
+            return false;
+        }
+
+        const Shared* pshared = static_cast<const Shared*>(pmem);
+        const bool    valid   = pshared->magic_ == shm_magic && pshared->ring_capacity_ == hello.ring_capacity_;
+
+        munmap(pmem, sizeof(Shared));
+
+        if (!valid) {
+            _rerr = ErrorCodeT(EPROTO, std::system_category());
+            return false;
+        }
+    }
+
+    const int fd = shm_open(hello.name_, O_RDWR, 0);
+
+    if (fd < 0) {
+        _rerr = last_system_error();
+        return false;
+    }
+
+    struct stat rw_st;
+
+    //the very segment checked above
+    if (fstat(fd, &rw_st) != 0 || rw_st.st_ino != st.st_ino || rw_st.st_dev != st.st_dev || static_cast<size_t>(rw_st.st_size) != shared_size) {
+        close(fd);
+        _rerr = ErrorCodeT(EPROTO, std::system_category());
+        return false;
+    }
+
+    void* pmem = mmap(nullptr, shared_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+
+    if (pmem == MAP_FAILED) {
+        _rerr = last_system_error();
+        return false;
+    }
+
+    shm_unlink(hello.name_);
+
+    pshared_       = static_cast<Shared*>(pmem);
+    shared_size_   = shared_size;
+    ring_capacity_ = hello.ring_capacity_;
+
+    psend_ring_ = &pshared_->ring_[1];
+    psend_data_ = pshared_->data(1);
+    precv_ring_ = &pshared_->ring_[0];
+    precv_data_ = pshared_->data(0);
+
+    delete[] phello_;
+    phello_ = nullptr;
+
+    //doorbells sent right after hello
+    doDrainDoorbells();
+    return true;
+}
+
+void Socket::doDrainDoorbells() const
+{
+    char       buf[256];
+    bool       can_retry;
+    ErrorCodeT err;
+    //reading does not change the logical state of the socket
+    SocketDevice& rsd = const_cast<SocketDevice&>(device());
+
+    while (true) {
+        const ssize_t rv = rsd.recv(buf, sizeof(buf), can_retry, err);
+        if (rv > 0) {
+            continue;
+        }
+        if (rv == 0 || !can_retry) {
+            peer_closed_ = true;
+        }
+        break;
+    }
+}
+
+void Socket::doRingDoorbell()
+{
+    const char b = 0;
+    bool       can_retry;
+    ErrorCodeT err;
+    //a full socket buffer already holds doorbells the peer did not consume - dropping is fine
+    device().send(&b, 1, can_retry, err);
+}
+
+void Socket::doUnmap()
+{
+    if (pshared_ != nullptr) {
+        munmap(pshared_, shared_size_);
+        pshared_    = nullptr;
+        precv_ring_ = psend_ring_ = nullptr;
+        precv_data_ = psend_data_ = nullptr;
+    }
+}
+
+} //namespace shm
+} //namespace aio
+} //namespace frame
+} //namespace solid
@@ -0,0 +1,218 @@
+#include "solid/frame/manager.hpp"
+#include "solid/frame/scheduler.hpp"
+#include "solid/frame/service.hpp"
+
+#include "solid/frame/aio/aiodatagram.hpp"
+#include "solid/frame/aio/aioobject.hpp"
+#include "solid/frame/aio/aioreactor.hpp"
+#include "solid/frame/aio/aiosocket.hpp"
+
+#include "solid/system/exception.hpp"
+#include "solid/system/log.hpp"
+#include "solid/system/socketdevice.hpp"
+
+#include "solid/utility/event.hpp"
+
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <iostream>
+#include <mutex>
+#include <vector>
+
+using namespace std;
+using namespace solid;
+
+using AioSchedulerT   = frame::Scheduler<frame::aio::Reactor>;
+using DatagramSocketT = frame::aio::Datagram<frame::aio::Socket>;
+
+namespace {
+const LoggerT logger("test_datagram_batch");
+
+mutex              mtx;
+condition_variable cnd;
+bool               done = false;
+
+SocketDevice create_loopback_socket()
+{
+    ResolveData  rd = synchronous_resolve("127.0.0.1", "0", 0, SocketInfo::Inet4, SocketInfo::Datagram);
+    SocketDevice sd;
+
+    sd.create(rd.begin());
+    sd.bind(rd.begin());
+    solid_check(sd, "creating datagram socket");
+    return sd;
+}
+
+//-----------------------------------------------------------------------------
+// Sends batches of numbered datagrams from one socket to the other and
+// checks that they are all received, in order.
+class Object final : public Dynamic<Object, frame::aio::Object> {
+    static constexpr size_t datagram_size = sizeof(uint64_t) + 32;
+
+public:
+    Object(
+        SocketDevice&& _usend_sd, SocketDevice&& _urecv_sd,
+        const size_t _batch_size, const size_t _batch_count)
+        : send_sock_(this->proxy(), std::move(_usend_sd))
+        , recv_sock_(this->proxy(), std::move(_urecv_sd))
+        , batch_size_(_batch_size)
+        , batch_count_(_batch_count)
+        , send_buf_(_batch_size * datagram_size)
+        , recv_buf_(_batch_size * datagram_size)
+        , send_dgs_(_batch_size)
+        , recv_dgs_(_batch_size)
+        , sent_count_(0)
+        , recv_count_(0)
+    {
+        for (size_t i = 0; i < batch_size_; ++i) {
+            send_dgs_[i].buffer_   = send_buf_.data() + i * datagram_size;
+            send_dgs_[i].capacity_ = datagram_size;
+            send_dgs_[i].size_     = datagram_size;
+            recv_dgs_[i].buffer_   = recv_buf_.data() + i * datagram_size;
+            recv_dgs_[i].capacity_ = datagram_size;
+        }
+    }
+
+    void destination(SocketAddress const& _raddr)
+    {
+        for (auto& rdg : send_dgs_) {
+            rdg.address_ = _raddr;
+        }
+    }
+
+private:
+    void onEvent(frame::aio::ReactorContext& _rctx, Event&& _revent) override
+    {
+        if (generic_event_start == _revent) {
+            solid_check(!recv_sock_.postRecvBatch(_rctx, recv_dgs_.data(), recv_dgs_.size(), [this](frame::aio::ReactorContext& _rctx, size_t _count) { onRecv(_rctx, _count); }), "postRecvBatch failed");
+            doSend(_rctx, true);
+        } else if (generic_event_kill == _revent) {
+            postStop(_rctx);
+        }
+    }
+
+    void doSend(frame::aio::ReactorContext& _rctx, const bool _post)
+    {
+        for (size_t i = 0; i < batch_size_; ++i) {
+            const uint64_t value = sent_count_ + i;
+            memcpy(send_dgs_[i].buffer_, &value, sizeof(value));
+        }
+        sent_count_ += batch_size_;
+
+        auto on_send = [this](frame::aio::ReactorContext& _rctx) {
+            solid_check(!_rctx.error(), "send batch: " << _rctx.error().message() << " " << _rctx.systemError().message());
+        };
+
+        if (_post) {
+            solid_check(!send_sock_.postSendBatch(_rctx, send_dgs_.data(), send_dgs_.size(), on_send), "postSendBatch failed");
+        } else if (send_sock_.sendBatch(_rctx, send_dgs_.data(), send_dgs_.size(), on_send)) {
+            on_send(_rctx);
+        }
+    }
+
+    void onRecv(frame::aio::ReactorContext& _rctx, size_t _count)
+    {
+        do {
+            solid_check(!_rctx.error(), "recv batch: " << _rctx.error().message() << " " << _rctx.systemError().message());
+
+            for (size_t i = 0; i < _count; ++i) {
+                uint64_t value;
+                solid_check(recv_dgs_[i].size_ == datagram_size, "wrong datagram size " << recv_dgs_[i].size_);
+                memcpy(&value, recv_dgs_[i].buffer_, sizeof(value));
+                solid_check(value == recv_count_, "wrong datagram " << value << " expected " << recv_count_);
+                ++recv_count_;
+            }
+
+            if (recv_count_ == batch_size_ * batch_count_) {
+                solid_log(logger, Verbose, "received all " << recv_count_ << " datagrams");
+                postStop(_rctx);
+                lock_guard<mutex> lock(mtx);
+                done = true;
+                cnd.notify_one();
+                return;
+            }
+
+            if (recv_count_ == sent_count_ && !send_sock_.hasPendingSend()) {
+                doSend(_rctx, false);
+            }
+        } while (recv_sock_.recvBatch(_rctx, recv_dgs_.data(), recv_dgs_.size(), [this](frame::aio::ReactorContext& _rctx, size_t _count) { onRecv(_rctx, _count); }, _count));
+    }
+
+    DatagramSocketT           send_sock_;
+    DatagramSocketT           recv_sock_;
+    const size_t              batch_size_;
+    const size_t              batch_count_;
+    std::vector<char>         send_buf_;
+    std::vector<char>         recv_buf_;
+    std::vector<DatagramStub> send_dgs_;
+    std::vector<DatagramStub> recv_dgs_;
+    size_t                    sent_count_;
+    size_t                    recv_count_;
+};
+
+} //namespace
+
+// Usage: test_datagram_batch [BATCH_SIZE] [BATCH_COUNT] [OPERATION_BUDGET]
+int test_datagram_batch(int argc, char* argv[])
+{
+    solid::log_start(std::cerr, {"solid::frame::aio.*:EW", "test_datagram_batch:VIEW"});
+
+    size_t batch_size       = 64;
+    size_t batch_count      = 1000;
+    size_t operation_budget = 0;
+
+    if (argc > 1) {
+        batch_size = atoi(argv[1]);
+    }
+    if (argc > 2) {
+        batch_count = atoi(argv[2]);
+    }
+    if (argc > 3) {
+        operation_budget = atoi(argv[3]);
+    }
+
+    frame::aio::ReactorConfiguration reactor_cfg;
+
+    if (operation_budget != 0) {
+        reactor_cfg.io_operation_budget_ = operation_budget;
+        reactor_cfg.io_byte_budget_      = 0;
+    }
+    reactor_cfg.statistic_ptr_ = std::make_shared<frame::aio::ReactorStatistic>();
+
+    {
+        AioSchedulerT   sch{reactor_cfg};
+        frame::Manager  mgr;
+        frame::ServiceT svc{mgr};
+
+        solid_check(!sch.start(1), "Error starting scheduler");
+
+        SocketDevice  send_sd = create_loopback_socket();
+        SocketDevice  recv_sd = create_loopback_socket();
+        SocketAddress recv_addr;
+
+        recv_sd.localAddress(recv_addr);
+
+        DynamicPointer<Object> objptr(new Object(std::move(send_sd), std::move(recv_sd), batch_size, batch_count));
+        objptr->destination(recv_addr);
+
+        DynamicPointer<frame::aio::Object> aioobjptr(objptr);
+        ErrorConditionT                    err;
+
+        const frame::ObjectIdT objuid = sch.startObject(aioobjptr, svc, make_event(GenericEvents::Start), err);
+        solid_check(!objuid.isInvalid(), "Error starting object: " << err.message());
+
+        unique_lock<mutex> lock(mtx);
+
+        solid_check(cnd.wait_for(lock, chrono::seconds(100), []() { return done; }), "Process is taking too long.");
+    }
+
+    const frame::aio::ReactorStatistic& rstatistic = *reactor_cfg.statistic_ptr_;
+
+    cout << "Reactor statistic:" << rstatistic << endl;
+
+    if (operation_budget != 0) {
+        solid_check(rstatistic.io_budget_exhausted_count_ != 0, "the I/O budget was never exhausted");
+    }
+    return 0;
+}
@@ -470,8 +470,13 @@ int test_echo_tcp_stress(int argc, char* argv[])
         }
     }
 
+    frame::aio::ReactorConfiguration reactor_cfg;
+
+    //shared by the server, relay and client reactors
+    reactor_cfg.statistic_ptr_ = std::make_shared<frame::aio::ReactorStatistic>();
+
     {
-        AioSchedulerT        srv_sch;
+        AioSchedulerT        srv_sch{reactor_cfg};
         frame::Manager       srv_mgr;
         SecureContextT       srv_secure_ctx{SecureContextT::create()};
         frame::ServiceT      srv_svc{srv_mgr};
@@ -524,7 +529,7 @@ int test_echo_tcp_stress(int argc, char* argv[])
             }
         }
 
-        AioSchedulerT   rly_sch;
+        AioSchedulerT   rly_sch{reactor_cfg};
         frame::Manager  rly_mgr;
         frame::ServiceT rly_svc{rly_mgr};
 
@@ -564,7 +569,7 @@ int test_echo_tcp_stress(int argc, char* argv[])
             }
         }
 
-        AioSchedulerT   clt_sch;
+        AioSchedulerT   clt_sch{reactor_cfg};
         frame::Manager  clt_mgr;
         SecureContextT  clt_secure_ctx{SecureContextT::create()};
         frame::ServiceT clt_svc{clt_mgr};
@@ -613,6 +618,13 @@ int test_echo_tcp_stress(int argc, char* argv[])
         }
     }
 
+    const frame::aio::ReactorStatistic& rstatistic = *reactor_cfg.statistic_ptr_;
+
+    cout << "Reactor statistic:" << rstatistic << endl;
+#if defined(SOLID_USE_EPOLL) || defined(SOLID_USE_KQUEUE)
+    //the sockets are registered once, for both directions
+    solid_check(rstatistic.device_mod_count_ == 0, "unexpected device modifications: " << rstatistic.device_mod_count_);
+#endif
     return 0;
 }
 
@@ -0,0 +1,241 @@
+#include "solid/frame/manager.hpp"
+#include "solid/frame/scheduler.hpp"
+#include "solid/frame/service.hpp"
+
+#include "solid/frame/aio/aioobject.hpp"
+#include "solid/frame/aio/aioreactor.hpp"
+
+#include "solid/system/exception.hpp"
+#include "solid/system/log.hpp"
+
+#include "solid/utility/event.hpp"
+#include "solid/utility/function.hpp"
+#include "solid/utility/recycler.hpp"
+
+#include <chrono>
+#include <condition_variable>
+#include <iostream>
+#include <mutex>
+#include <string>
+
+using namespace std;
+using namespace solid;
+
+using AioSchedulerT = frame::Scheduler<frame::aio::Reactor>;
+
+namespace {
+const LoggerT logger("test_event_allocation");
+
+mutex              mtx;
+condition_variable cnd;
+size_t             handled_count = 0;
+
+enum struct ConnectionEvents {
+    NewConnMessage,
+    EnterActive,
+    SendRaw,
+};
+
+const EventCategory<ConnectionEvents> connection_event_category{
+    "::connection_event_category",
+    [](const ConnectionEvents _evt) {
+        switch (_evt) {
+        case ConnectionEvents::NewConnMessage:
+            return "newconnmessage";
+        case ConnectionEvents::EnterActive:
+            return "enteractive";
+        case ConnectionEvents::SendRaw:
+            return "sendraw";
+        default:
+            return "unknown";
+        }
+    }};
+
+struct Context {
+    size_t value_ = 0;
+};
+
+//shapes of the mpipc connection event payloads
+struct MessageId {
+    size_t   index_;
+    uint32_t unique_;
+};
+
+using CompleteFunctionT = solid_function_t(void(Context&));
+
+struct EnterActive {
+    CompleteFunctionT complete_fnc_;
+    size_t            send_buffer_capacity_;
+
+    EnterActive(CompleteFunctionT&& _ucomplete_fnc, const size_t _send_buffer_capacity)
+        : complete_fnc_(std::move(_ucomplete_fnc))
+        , send_buffer_capacity_(_send_buffer_capacity)
+    {
+    }
+};
+
+struct SendRaw {
+    CompleteFunctionT complete_fnc_;
+    std::string       data_;
+
+    SendRaw(CompleteFunctionT&& _ucomplete_fnc, std::string&& _udata)
+        : complete_fnc_(std::move(_ucomplete_fnc))
+        , data_(std::move(_udata))
+    {
+    }
+};
+
+//-----------------------------------------------------------------------------
+// Gets the events notified from the main thread and handles them in closures
+// posted to the reactor, like the mpipc Connection does.
+class Object final : public Dynamic<Object, frame::aio::Object> {
+public:
+    Object() {}
+
+private:
+    void onEvent(frame::aio::ReactorContext& _rctx, Event&& _revent) override
+    {
+        if (_revent == generic_event_kill) {
+            postStop(_rctx);
+        } else if (!_revent.any().empty()) { //only the connection events carry data
+            const uint64_t a = ctx_.value_;
+            const uint64_t b = a + 1;
+            const uint64_t c = a + 2;
+            //a closure larger than the inline storage of the function
+            post(
+                _rctx,
+                [this, a, b, c](frame::aio::ReactorContext& _rctx, Event&& _revent) {
+                    onConnectionEvent(_revent, (a + b + c) % 3);
+                },
+                std::move(_revent));
+        }
+    }
+
+    void onConnectionEvent(Event& _revent, const size_t _inc)
+    {
+        if (_revent == connection_event_category.event(ConnectionEvents::EnterActive)) {
+            EnterActive* pdata = _revent.any().cast<EnterActive>();
+            solid_check(pdata != nullptr, "EnterActive payload expected");
+            pdata->complete_fnc_(ctx_);
+        } else if (_revent == connection_event_category.event(ConnectionEvents::SendRaw)) {
+            SendRaw* pdata = _revent.any().cast<SendRaw>();
+            solid_check(pdata != nullptr, "SendRaw payload expected");
+            pdata->complete_fnc_(ctx_);
+        } else {
+            solid_check(_revent.any().cast<MessageId>() != nullptr, "MessageId payload expected");
+        }
+        ctx_.value_ += _inc;
+
+        lock_guard<mutex> lock(mtx);
+        ++handled_count;
+        cnd.notify_one();
+    }
+
+    Context ctx_;
+};
+
+//notifies the object _count times each connection event - 4 events
+void round(frame::Manager& _rm, const frame::ObjectIdT& _robjuid, const size_t _count)
+{
+    for (size_t i = 0; i < _count; ++i) {
+        {
+            Event event = connection_event_category.event(ConnectionEvents::NewConnMessage);
+            event.any() = MessageId{i, static_cast<uint32_t>(i)};
+            _rm.notify(_robjuid, std::move(event));
+        }
+        {
+            const size_t capacity = 1024 + i;
+            Event        event    = connection_event_category.event(ConnectionEvents::EnterActive);
+            event.any()           = EnterActive(
+                [capacity](Context& _rctx) {
+                    _rctx.value_ += capacity;
+                },
+                capacity);
+            //the Manager copies the events it notifies to many objects
+            Event event_copy(event);
+            _rm.notify(_robjuid, std::move(event));
+            _rm.notify(_robjuid, std::move(event_copy));
+        }
+        {
+            std::string data;
+            Event       event = connection_event_category.event(ConnectionEvents::SendRaw);
+            event.any()       = SendRaw(
+                [](Context& _rctx) {
+                    ++_rctx.value_;
+                },
+                std::move(data));
+            _rm.notify(_robjuid, std::move(event));
+        }
+    }
+}
+
+void wait_handled(const size_t _count)
+{
+    unique_lock<mutex> lock(mtx);
+    solid_check(cnd.wait_for(lock, chrono::seconds(100), [_count]() { return handled_count == _count; }), "Process is taking too long: " << handled_count << " of " << _count);
+}
+
+} //namespace
+
+// Events with payloads not fitting the Event inline storage, notified to an
+// object from another thread and handled in closures posted on its reactor,
+// must not hit the heap in steady state - see solid/utility/recycler.hpp.
+// Usage: test_event_allocation [ROUND_COUNT] [BATCH_COUNT]
+int test_event_allocation(int argc, char* argv[])
+{
+    solid::log_start(std::cerr, {"solid::frame::aio.*:EW", "test_event_allocation:VIEW"});
+
+    size_t round_count = 1000;
+    size_t batch_count = 64;
+
+    if (argc > 1) {
+        round_count = atoi(argv[1]);
+    }
+    if (argc > 2) {
+        batch_count = atoi(argv[2]);
+    }
+
+    cout << "Event::any_size = " << Event::any_size << " sizeof(EnterActive) = " << sizeof(EnterActive) << " sizeof(SendRaw) = " << sizeof(SendRaw) << endl;
+
+    solid_check(sizeof(EnterActive) > Event::any_size - any_min_data_size, "EnterActive must not fit the Event inline storage");
+
+    size_t count = 0;
+    {
+        AioSchedulerT   sch;
+        frame::Manager  m;
+        frame::ServiceT svc{m};
+        ErrorConditionT err;
+
+        solid_check(!sch.start(1), "Error starting scheduler");
+
+        DynamicPointer<frame::aio::Object> objptr(new Object);
+        const frame::ObjectIdT             objuid = sch.startObject(objptr, svc, make_event(GenericEvents::Start), err);
+        solid_check(!objuid.isInvalid(), "Error starting object: " << err.message());
+
+        size_t expected_count = 0;
+
+        //warm up the recycled storage of both threads
+        for (size_t i = 0; i < 16; ++i) {
+            round(m, objuid, batch_count);
+            expected_count += 4 * batch_count;
+            wait_handled(expected_count);
+        }
+
+        const size_t start_count = impl::recycler_heap_allocation_count();
+
+        for (size_t i = 0; i < round_count; ++i) {
+            round(m, objuid, batch_count);
+            expected_count += 4 * batch_count;
+            wait_handled(expected_count);
+        }
+
+        count = impl::recycler_heap_allocation_count() - start_count;
+
+        m.stop();
+    }
+
+    cout << "recycler heap allocations on " << round_count * batch_count * 4 << " events: " << count << endl;
+
+    solid_check(count == 0, "event path allocated " << count << " times");
+    return 0;
+}
@@ -0,0 +1,204 @@
+#include "solid/frame/manager.hpp"
+#include "solid/frame/scheduler.hpp"
+#include "solid/frame/service.hpp"
+
+#include "solid/frame/aio/aioobject.hpp"
+#include "solid/frame/aio/aiooffload.hpp"
+#include "solid/frame/aio/aioreactor.hpp"
+
+#include "solid/system/exception.hpp"
+#include "solid/system/log.hpp"
+
+#include "solid/utility/event.hpp"
+#include "solid/utility/workpool.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <iostream>
+#include <mutex>
+#include <thread>
+
+using namespace std;
+using namespace solid;
+
+using AioSchedulerT = frame::Scheduler<frame::aio::Reactor>;
+using OffloadT      = frame::aio::Offload<size_t>;
+
+namespace {
+const LoggerT logger("test_offload");
+
+mutex              mtx;
+condition_variable cnd;
+size_t             done_count = 0;
+atomic<size_t>     late_count{0};
+atomic<size_t>     drop_job_count{0};
+
+void object_done()
+{
+    lock_guard<mutex> lock(mtx);
+    ++done_count;
+    cnd.notify_one();
+}
+
+//-----------------------------------------------------------------------------
+// Round trips _repeat_count jobs, one at a time, checking that every
+// continuation runs on the reactor thread with the owning object.
+class Object final : public Dynamic<Object, frame::aio::Object> {
+public:
+    Object(FunctionWorkPool& _rwp, const size_t _repeat_count)
+        : rwp_(_rwp)
+        , offload_(this->proxy())
+        , repeat_count_(_repeat_count)
+        , crt_count_(0)
+        , reactor_thread_id_()
+    {
+    }
+
+private:
+    void onEvent(frame::aio::ReactorContext& _rctx, Event&& _revent) override
+    {
+        if (generic_event_start == _revent) {
+            reactor_thread_id_ = this_thread::get_id();
+            doPost(_rctx);
+        } else if (generic_event_kill == _revent) {
+            postStop(_rctx);
+        }
+    }
+
+    void doPost(frame::aio::ReactorContext& _rctx)
+    {
+        const size_t     value             = crt_count_;
+        const thread::id reactor_thread_id = reactor_thread_id_;
+        const bool       rv                = offload_.post(
+            _rctx, rwp_,
+            [value, reactor_thread_id]() {
+                solid_check(this_thread::get_id() != reactor_thread_id, "job executed on reactor thread");
+                return value * 2;
+            },
+            [this](frame::aio::ReactorContext& _rctx, size_t&& _rvalue) {
+                onResume(_rctx, _rvalue);
+            });
+        solid_check(!rv, "offload already in flight");
+        solid_check(offload_.post(_rctx, rwp_, []() { return size_t(0); }, [](frame::aio::ReactorContext&, size_t&&) {}), "second offload must fail");
+        _rctx.clearError();
+    }
+
+    void onResume(frame::aio::ReactorContext& _rctx, const size_t _value)
+    {
+        solid_check(this_thread::get_id() == reactor_thread_id_, "continuation not on reactor thread");
+        solid_check(&_rctx.object() == this, "continuation on wrong object");
+        solid_check(_value == crt_count_ * 2, "wrong value " << _value << " != " << crt_count_ * 2);
+
+        ++crt_count_;
+
+        if (crt_count_ < repeat_count_) {
+            doPost(_rctx);
+        } else {
+            postStop(_rctx);
+            object_done();
+        }
+    }
+
+    FunctionWorkPool& rwp_;
+    OffloadT          offload_;
+    const size_t      repeat_count_;
+    size_t            crt_count_;
+    thread::id        reactor_thread_id_;
+};
+
+//-----------------------------------------------------------------------------
+// Stops while its job is still running: the continuation must be dropped.
+class StopObject final : public Dynamic<StopObject, frame::aio::Object> {
+public:
+    StopObject(FunctionWorkPool& _rwp)
+        : rwp_(_rwp)
+        , offload_(this->proxy())
+    {
+    }
+
+private:
+    void onEvent(frame::aio::ReactorContext& _rctx, Event&& _revent) override
+    {
+        if (generic_event_start == _revent) {
+            offload_.post(
+                _rctx, rwp_,
+                []() {
+                    this_thread::sleep_for(chrono::milliseconds(100));
+                    ++drop_job_count;
+                    return size_t(0);
+                },
+                [](frame::aio::ReactorContext& /*_rctx*/, size_t&& /*_rvalue*/) {
+                    ++late_count;
+                });
+            postStop(_rctx);
+            object_done();
+        }
+    }
+
+    FunctionWorkPool& rwp_;
+    OffloadT          offload_;
+};
+
+} //namespace
+
+int test_offload(int argc, char* argv[])
+{
+    solid::log_start(std::cerr, {"solid::frame::aio.*:EW", "test_offload:VIEW"});
+
+    size_t object_count  = 100;
+    size_t repeat_count  = 1000;
+    size_t reactor_count = 2;
+    int    wait_seconds  = 100;
+
+    if (argc > 1) {
+        object_count = atoi(argv[1]);
+    }
+    if (argc > 2) {
+        repeat_count = atoi(argv[2]);
+    }
+    if (argc > 3) {
+        reactor_count = atoi(argv[3]);
+    }
+
+    const size_t stop_object_count = 10;
+    {
+        AioSchedulerT    sch;
+        frame::Manager   mgr;
+        frame::ServiceT  svc{mgr};
+        FunctionWorkPool fwp{WorkPoolConfiguration()};
+
+        solid_check(!sch.start(reactor_count), "Error starting scheduler");
+
+        for (size_t i = 0; i < object_count + stop_object_count; ++i) {
+            DynamicPointer<frame::aio::Object> objptr;
+            ErrorConditionT                    err;
+
+            if (i < object_count) {
+                objptr.reset(new Object(fwp, repeat_count));
+            } else {
+                objptr.reset(new StopObject(fwp));
+            }
+
+            const frame::ObjectIdT objuid = sch.startObject(objptr, svc, make_event(GenericEvents::Start), err);
+            solid_check(!objuid.isInvalid(), "Error starting object: " << err.message());
+        }
+
+        {
+            unique_lock<mutex> lock(mtx);
+
+            solid_check(
+                cnd.wait_for(lock, chrono::seconds(wait_seconds), [object_count, stop_object_count]() { return done_count == (object_count + stop_object_count); }),
+                "Process is taking too long.");
+        }
+        //let the stop objects' jobs complete against their stopped owners
+        while (drop_job_count != stop_object_count) {
+            this_thread::sleep_for(chrono::milliseconds(10));
+        }
+        this_thread::sleep_for(chrono::milliseconds(100));
+    }
+
+    solid_log(logger, Verbose, "late_count = " << late_count);
+    solid_check(late_count == 0, "continuation called for stopped object");
+    return 0;
+}
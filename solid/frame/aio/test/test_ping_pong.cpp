@@ -0,0 +1,256 @@
+#include "solid/frame/manager.hpp"
+#include "solid/frame/scheduler.hpp"
+#include "solid/frame/service.hpp"
+
+#include "solid/frame/aio/aioobject.hpp"
+#include "solid/frame/aio/aioreactor.hpp"
+#include "solid/frame/aio/aiosocket.hpp"
+#include "solid/frame/aio/aiostream.hpp"
+
+#include "solid/system/exception.hpp"
+#include "solid/system/log.hpp"
+#include "solid/system/socketdevice.hpp"
+
+#include "solid/utility/event.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <iostream>
+#include <mutex>
+#include <vector>
+
+using namespace std;
+using namespace solid;
+
+using AioSchedulerT   = frame::Scheduler<frame::aio::Reactor>;
+using StreamSocketT   = frame::aio::Stream<frame::aio::Socket>;
+using DurationVectorT = std::vector<std::chrono::steady_clock::duration>;
+
+namespace {
+const LoggerT logger("test_ping_pong");
+
+constexpr size_t message_size = 64;
+
+mutex              mtx;
+condition_variable cnd;
+bool               done = false;
+
+void connect_pair(SocketDevice& _rsd1, SocketDevice& _rsd2)
+{
+    ResolveData  rd = synchronous_resolve("127.0.0.1", "0", 0, SocketInfo::Inet4, SocketInfo::Stream);
+    SocketDevice listen_sd;
+
+    listen_sd.create(rd.begin());
+    listen_sd.prepareAccept(rd.begin(), 1);
+    solid_check(listen_sd, "creating listener socket");
+
+    SocketAddress local_address;
+    listen_sd.localAddress(local_address);
+
+    _rsd1.create(rd.begin());
+    solid_check(!_rsd1.connect(local_address), "connecting");
+    solid_check(!listen_sd.accept(_rsd2), "accepting");
+
+    _rsd1.enableNoDelay();
+    _rsd2.enableNoDelay();
+    _rsd1.makeNonBlocking();
+    _rsd2.makeNonBlocking();
+}
+
+//-----------------------------------------------------------------------------
+// Sends back everything it receives.
+class Server final : public Dynamic<Server, frame::aio::Object> {
+    static constexpr size_t buffer_capacity = 4 * 1024;
+
+public:
+    Server(SocketDevice&& _usd)
+        : sock_(this->proxy(), std::move(_usd))
+    {
+    }
+
+private:
+    void onEvent(frame::aio::ReactorContext& _rctx, Event&& _revent) override
+    {
+        if (generic_event_start == _revent) {
+            sock_.postRecvSome(_rctx, buf_, buffer_capacity, [this](frame::aio::ReactorContext& _rctx, size_t _sz) { onRecv(_rctx, _sz); });
+        } else if (generic_event_kill == _revent) {
+            postStop(_rctx);
+        }
+    }
+
+    void onRecv(frame::aio::ReactorContext& _rctx, size_t _sz)
+    {
+        if (_rctx.error()) {
+            postStop(_rctx);
+            return;
+        }
+        if (sock_.sendAll(_rctx, buf_, _sz, [this](frame::aio::ReactorContext& _rctx) { onSend(_rctx); })) {
+            onSend(_rctx);
+        }
+    }
+
+    void onSend(frame::aio::ReactorContext& _rctx)
+    {
+        if (_rctx.error()) {
+            postStop(_rctx);
+            return;
+        }
+        size_t sz;
+        if (sock_.recvSome(_rctx, buf_, buffer_capacity, [this](frame::aio::ReactorContext& _rctx, size_t _sz) { onRecv(_rctx, _sz); }, sz)) {
+            onRecv(_rctx, sz);
+        }
+    }
+
+    StreamSocketT sock_;
+    char          buf_[buffer_capacity];
+};
+
+//-----------------------------------------------------------------------------
+// Sends a message, waits for it to come back and records the round trip time.
+class Client final : public Dynamic<Client, frame::aio::Object> {
+public:
+    Client(SocketDevice&& _usd, DurationVectorT& _rrtt_vec, const size_t _count)
+        : sock_(this->proxy(), std::move(_usd))
+        , rrtt_vec_(_rrtt_vec)
+        , count_(_count)
+        , recv_sz_(0)
+    {
+        std::fill(send_buf_, send_buf_ + message_size, 'a');
+    }
+
+private:
+    void onEvent(frame::aio::ReactorContext& _rctx, Event&& _revent) override
+    {
+        if (generic_event_start == _revent) {
+            doSend(_rctx);
+        } else if (generic_event_kill == _revent) {
+            postStop(_rctx);
+        }
+    }
+
+    void doSend(frame::aio::ReactorContext& _rctx)
+    {
+        start_tp_ = std::chrono::steady_clock::now();
+        recv_sz_  = 0;
+        if (sock_.sendAll(_rctx, send_buf_, message_size, [this](frame::aio::ReactorContext& _rctx) { doRecv(_rctx); })) {
+            doRecv(_rctx);
+        }
+    }
+
+    void doRecv(frame::aio::ReactorContext& _rctx)
+    {
+        solid_check(!_rctx.error(), "send: " << _rctx.error().message());
+        size_t sz;
+        if (sock_.recvSome(_rctx, recv_buf_ + recv_sz_, message_size - recv_sz_, [this](frame::aio::ReactorContext& _rctx, size_t _sz) { onRecv(_rctx, _sz); }, sz)) {
+            onRecv(_rctx, sz);
+        }
+    }
+
+    void onRecv(frame::aio::ReactorContext& _rctx, size_t _sz)
+    {
+        solid_check(!_rctx.error(), "recv: " << _rctx.error().message());
+        recv_sz_ += _sz;
+        if (recv_sz_ < message_size) {
+            doRecv(_rctx);
+            return;
+        }
+        rrtt_vec_.push_back(std::chrono::steady_clock::now() - start_tp_);
+
+        if (rrtt_vec_.size() == count_) {
+            postStop(_rctx);
+            lock_guard<mutex> lock(mtx);
+            done = true;
+            cnd.notify_one();
+            return;
+        }
+        doSend(_rctx);
+    }
+
+    StreamSocketT                         sock_;
+    DurationVectorT&                      rrtt_vec_;
+    const size_t                          count_;
+    size_t                                recv_sz_;
+    std::chrono::steady_clock::time_point start_tp_;
+    char                                  send_buf_[message_size];
+    char                                  recv_buf_[message_size];
+};
+
+uint64_t to_microseconds(const std::chrono::steady_clock::duration _d)
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(_d).count();
+}
+
+} //namespace
+
+// Ping-pong round trip latency between two reactors.
+// Usage: test_ping_pong [COUNT] [BUSY_POLL_MICROSECONDS] [SOCKET_BUSY_POLL_MICROSECONDS]
+int test_ping_pong(int argc, char* argv[])
+{
+    solid::log_start(std::cerr, {"solid::frame::aio.*:EW", "test_ping_pong:VIEW"});
+
+    size_t count                         = 10000;
+    size_t busy_poll_microseconds        = 0;
+    size_t socket_busy_poll_microseconds = 0;
+
+    if (argc > 1) {
+        count = atoi(argv[1]);
+    }
+    if (argc > 2) {
+        busy_poll_microseconds = atoi(argv[2]);
+    }
+    if (argc > 3) {
+        socket_busy_poll_microseconds = atoi(argv[3]);
+    }
+
+    frame::aio::ReactorConfiguration reactor_cfg;
+
+    reactor_cfg.busy_poll_microseconds_        = busy_poll_microseconds;
+    reactor_cfg.socket_busy_poll_microseconds_ = socket_busy_poll_microseconds;
+    reactor_cfg.statistic_ptr_                 = std::make_shared<frame::aio::ReactorStatistic>();
+
+    DurationVectorT rtt_vec;
+
+    rtt_vec.reserve(count);
+
+    {
+        AioSchedulerT   srv_sch{reactor_cfg};
+        AioSchedulerT   clt_sch{reactor_cfg};
+        frame::Manager  mgr;
+        frame::ServiceT svc{mgr};
+
+        solid_check(!srv_sch.start(1), "Error starting server scheduler");
+        solid_check(!clt_sch.start(1), "Error starting client scheduler");
+
+        SocketDevice srv_sd;
+        SocketDevice clt_sd;
+
+        connect_pair(clt_sd, srv_sd);
+
+        ErrorConditionT err;
+        {
+            DynamicPointer<frame::aio::Object> objptr(new Server(std::move(srv_sd)));
+            solid_check(!srv_sch.startObject(objptr, svc, make_event(GenericEvents::Start), err).isInvalid(), "Error starting server: " << err.message());
+        }
+        {
+            DynamicPointer<frame::aio::Object> objptr(new Client(std::move(clt_sd), rtt_vec, count));
+            solid_check(!clt_sch.startObject(objptr, svc, make_event(GenericEvents::Start), err).isInvalid(), "Error starting client: " << err.message());
+        }
+
+        unique_lock<mutex> lock(mtx);
+
+        solid_check(cnd.wait_for(lock, chrono::seconds(100), []() { return done; }), "Process is taking too long.");
+    }
+
+    solid_check(rtt_vec.size() == count);
+
+    std::sort(rtt_vec.begin(), rtt_vec.end());
+
+    cout << "busy_poll = " << busy_poll_microseconds << "us socket_busy_poll = " << socket_busy_poll_microseconds << "us";
+    cout << " round trips = " << count;
+    cout << " p50 = " << to_microseconds(rtt_vec[count / 2]) << "us";
+    cout << " p99 = " << to_microseconds(rtt_vec[(count * 99) / 100]) << "us";
+    cout << " max = " << to_microseconds(rtt_vec.back()) << "us" << endl;
+    cout << "Reactor statistic:" << *reactor_cfg.statistic_ptr_ << endl;
+    return 0;
+}
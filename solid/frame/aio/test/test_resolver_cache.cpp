@@ -0,0 +1,132 @@
+#include "solid/frame/aio/aioresolver.hpp"
+
+#include "solid/system/exception.hpp"
+#include "solid/system/log.hpp"
+
+#include <chrono>
+#include <condition_variable>
+#include <iostream>
+#include <mutex>
+#include <thread>
+
+using namespace std;
+using namespace solid;
+
+namespace {
+const LoggerT logger("test_resolver_cache");
+
+mutex              mtx;
+condition_variable cnd;
+size_t             done_count   = 0;
+size_t             empty_count  = 0;
+size_t             caller_count = 0; //completions on the requesting thread
+thread::id         caller_id;
+
+//takes the lock the requester holds across requestResolve
+struct ResolveF {
+    void operator()(ResolveData& _rrd, ErrorCodeT const& /*_rerr*/)
+    {
+        lock_guard<mutex> lock(mtx);
+        ++done_count;
+        if (_rrd.empty()) {
+            ++empty_count;
+        }
+        if (this_thread::get_id() == caller_id) {
+            ++caller_count;
+        }
+        cnd.notify_one();
+    }
+};
+
+void request(frame::aio::Resolver& _rresolver, const char* _host, const int _flags = 0, const int _family = -1, const int _type = -1)
+{
+    lock_guard<mutex> lock(mtx);
+    _rresolver.requestResolve(ResolveF(), _host, "1234", _flags, _family, _type);
+}
+
+void wait_done(const size_t _count)
+{
+    unique_lock<mutex> lock(mtx);
+    solid_check(cnd.wait_for(lock, chrono::seconds(100), [_count]() { return done_count == _count; }), "Process is taking too long: " << done_count << " of " << _count);
+}
+
+} //namespace
+
+int test_resolver_cache(int argc, char* argv[])
+{
+    solid::log_start(std::cerr, {"solid::frame::aio.*:EW", "test_resolver_cache:VIEW"});
+
+    size_t request_count = 100;
+
+    caller_id = this_thread::get_id();
+
+    if (argc > 1) {
+        request_count = atoi(argv[1]);
+    }
+
+    FunctionWorkPool                  fwp{WorkPoolConfiguration()};
+    frame::aio::ResolverConfiguration cfg(chrono::milliseconds(500), chrono::milliseconds(200));
+
+    cfg.cache_refresh_ahead_ = chrono::milliseconds(300);
+    cfg.statistic_ptr_       = std::make_shared<frame::aio::ResolverStatistic>();
+
+    frame::aio::ResolverStatistic& rstatistic = *cfg.statistic_ptr_;
+    frame::aio::Resolver           resolver(fwp, cfg);
+
+    //requests for the same name - while the lookup is in flight or after - share one lookup
+    for (size_t i = 0; i < request_count; ++i) {
+        request(resolver, "127.0.0.1", 0, SocketInfo::Inet4, SocketInfo::Stream);
+    }
+    wait_done(request_count);
+    solid_check(empty_count == 0, "empty resolve results");
+    solid_check(rstatistic.lookup_count_ == 1, "lookups for coalesced requests: " << rstatistic.lookup_count_);
+
+    //served from the cache, on the work pool like the lookups
+    const size_t hit_count = rstatistic.cache_hit_count_;
+    {
+        const auto start = chrono::steady_clock::now();
+        for (size_t i = 0; i < request_count; ++i) {
+            request(resolver, "127.0.0.1", 0, SocketInfo::Inet4, SocketInfo::Stream);
+        }
+        const auto duration = chrono::steady_clock::now() - start;
+
+        wait_done(2 * request_count);
+        solid_check(rstatistic.cache_hit_count_ == hit_count + request_count, "cache hits: " << rstatistic.cache_hit_count_);
+        solid_check(rstatistic.lookup_count_ == 1, "lookups for cached requests: " << rstatistic.lookup_count_);
+        cout << "cached resolve: " << chrono::duration_cast<chrono::nanoseconds>(duration).count() / request_count << "ns" << endl;
+    }
+
+    //entries about to expire are refreshed in background
+    this_thread::sleep_for(chrono::milliseconds(250));
+    request(resolver, "127.0.0.1", 0, SocketInfo::Inet4, SocketInfo::Stream);
+    wait_done(2 * request_count + 1);
+    this_thread::sleep_for(chrono::milliseconds(100));
+    solid_check(rstatistic.refresh_count_ == 1, "refreshes: " << rstatistic.refresh_count_);
+
+    //the refresh extended the entry lifetime
+    this_thread::sleep_for(chrono::milliseconds(250));
+    request(resolver, "127.0.0.1", 0, SocketInfo::Inet4, SocketInfo::Stream);
+    wait_done(2 * request_count + 2);
+    solid_check(rstatistic.cache_hit_count_ == hit_count + request_count + 2, "refreshed entry was not served from cache: " << rstatistic.cache_hit_count_);
+
+    //negative caching: numeric resolve of a host name fails without network access
+    const size_t lookup_count = rstatistic.lookup_count_;
+
+    request(resolver, "not.an.address", DirectResoveInfo::NumericHost);
+    wait_done(2 * request_count + 3);
+    request(resolver, "not.an.address", DirectResoveInfo::NumericHost);
+    wait_done(2 * request_count + 4);
+    solid_check(empty_count == 2, "expected two empty results: " << empty_count);
+    solid_check(rstatistic.cache_negative_hit_count_ == 1, "negative hits: " << rstatistic.cache_negative_hit_count_);
+
+    //negative entries expire sooner
+    this_thread::sleep_for(chrono::milliseconds(250));
+    request(resolver, "not.an.address", DirectResoveInfo::NumericHost);
+    wait_done(2 * request_count + 5);
+    solid_check(rstatistic.lookup_count_ == lookup_count + 2, "negative entry did not expire: " << rstatistic.lookup_count_);
+
+    solid_check(caller_count == 0, "requests completed on the requesting thread: " << caller_count);
+
+    cout << "Resolver statistic:" << rstatistic << endl;
+    return 0;
+}
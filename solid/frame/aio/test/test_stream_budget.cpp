@@ -0,0 +1,203 @@
+#include "solid/frame/manager.hpp"
+#include "solid/frame/scheduler.hpp"
+#include "solid/frame/service.hpp"
+
+#include "solid/frame/aio/aioobject.hpp"
+#include "solid/frame/aio/aioreactor.hpp"
+#include "solid/frame/aio/aiosocket.hpp"
+#include "solid/frame/aio/aiostream.hpp"
+
+#include "solid/system/exception.hpp"
+#include "solid/system/log.hpp"
+#include "solid/system/socketdevice.hpp"
+
+#include "solid/utility/event.hpp"
+
+#include <chrono>
+#include <condition_variable>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace std;
+using namespace solid;
+
+using AioSchedulerT = frame::Scheduler<frame::aio::Reactor>;
+using StreamSocketT = frame::aio::Stream<frame::aio::Socket>;
+
+namespace {
+const LoggerT logger("test_stream_budget");
+
+mutex              mtx;
+condition_variable cnd;
+size_t             done_count = 0;
+
+char pattern(const uint64_t _offset)
+{
+    return static_cast<char>(_offset % 251);
+}
+
+void connect_pair(SocketDevice& _rsd1, SocketDevice& _rsd2)
+{
+    ResolveData  rd = synchronous_resolve("127.0.0.1", "0", 0, SocketInfo::Inet4, SocketInfo::Stream);
+    SocketDevice listen_sd;
+
+    listen_sd.create(rd.begin());
+    listen_sd.prepareAccept(rd.begin(), 1);
+    solid_check(listen_sd, "creating listener socket");
+
+    SocketAddress local_address;
+    listen_sd.localAddress(local_address);
+
+    _rsd1.create(rd.begin());
+    solid_check(!_rsd1.connect(local_address), "connecting");
+    solid_check(!listen_sd.accept(_rsd2), "accepting");
+}
+
+//-----------------------------------------------------------------------------
+// Receives, with a small buffer, everything a blocking sender thread writes.
+// The socket is never drained within the recvSome loop so, without the
+// reactor I/O budget, the loop would hold the reactor until the sender ends.
+class Object final : public Dynamic<Object, frame::aio::Object> {
+    static constexpr size_t buffer_capacity = 4 * 1024;
+
+public:
+    Object(SocketDevice&& _usd, const uint64_t _expect_size)
+        : sock_(this->proxy(), std::move(_usd))
+        , expect_size_(_expect_size)
+        , recv_size_(0)
+    {
+    }
+
+private:
+    void onEvent(frame::aio::ReactorContext& _rctx, Event&& _revent) override
+    {
+        if (generic_event_start == _revent) {
+            sock_.postRecvSome(_rctx, buf_, buffer_capacity, [this](frame::aio::ReactorContext& _rctx, size_t _sz) { onRecv(_rctx, _sz); });
+        } else if (generic_event_kill == _revent) {
+            postStop(_rctx);
+        }
+    }
+
+    void onRecv(frame::aio::ReactorContext& _rctx, size_t _sz)
+    {
+        do {
+            solid_check(!_rctx.error(), "recv: " << _rctx.error().message() << " " << _rctx.systemError().message());
+
+            for (size_t i = 0; i < _sz; ++i) {
+                solid_check(buf_[i] == pattern(recv_size_ + i), "wrong data at offset " << (recv_size_ + i));
+            }
+            recv_size_ += _sz;
+
+            if (recv_size_ == expect_size_) {
+                solid_log(logger, Verbose, "received all " << recv_size_ << " bytes");
+                postStop(_rctx);
+                lock_guard<mutex> lock(mtx);
+                ++done_count;
+                cnd.notify_one();
+                return;
+            }
+        } while (sock_.recvSome(_rctx, buf_, buffer_capacity, [this](frame::aio::ReactorContext& _rctx, size_t _sz) { onRecv(_rctx, _sz); }, _sz));
+    }
+
+    StreamSocketT  sock_;
+    const uint64_t expect_size_;
+    uint64_t       recv_size_;
+    char           buf_[buffer_capacity];
+};
+
+void run_sender(SocketDevice& _rsd, const uint64_t _size)
+{
+    vector<char> buf(64 * 1024);
+    uint64_t     offset = 0;
+
+    while (offset < _size) {
+        const size_t sz = static_cast<size_t>(std::min(static_cast<uint64_t>(buf.size()), _size - offset));
+        for (size_t i = 0; i < sz; ++i) {
+            buf[i] = pattern(offset + i);
+        }
+        size_t sent = 0;
+        while (sent < sz) {
+            bool       can_retry;
+            ErrorCodeT err;
+            ssize_t    rv = _rsd.send(buf.data() + sent, sz - sent, can_retry, err);
+            solid_check(rv > 0, "send: " << err.message());
+            sent += rv;
+        }
+        offset += sz;
+    }
+}
+
+} //namespace
+
+int test_stream_budget(int argc, char* argv[])
+{
+    solid::log_start(std::cerr, {"solid::frame::aio.*:EW", "test_stream_budget:VIEW"});
+
+    size_t   connection_count = 2;
+    uint64_t size             = 64 * 1024 * 1024;
+    size_t   operation_budget = 4;
+
+    if (argc > 1) {
+        connection_count = atoi(argv[1]);
+    }
+    if (argc > 2) {
+        size = atoi(argv[2]) * 1024ULL * 1024ULL;
+    }
+    if (argc > 3) {
+        operation_budget = atoi(argv[3]);
+    }
+
+    frame::aio::ReactorConfiguration reactor_cfg(operation_budget, 0);
+
+    reactor_cfg.statistic_ptr_ = std::make_shared<frame::aio::ReactorStatistic>();
+
+    {
+        AioSchedulerT   sch{reactor_cfg};
+        frame::Manager  mgr;
+        frame::ServiceT svc{mgr};
+
+        solid_check(!sch.start(1), "Error starting scheduler");
+
+        vector<SocketDevice> send_sds(connection_count);
+        vector<thread>       send_thrs;
+
+        for (size_t i = 0; i < connection_count; ++i) {
+            SocketDevice recv_sd;
+
+            connect_pair(send_sds[i], recv_sd);
+            recv_sd.makeNonBlocking();
+
+            DynamicPointer<frame::aio::Object> objptr(new Object(std::move(recv_sd), size));
+            ErrorConditionT                    err;
+
+            const frame::ObjectIdT objuid = sch.startObject(objptr, svc, make_event(GenericEvents::Start), err);
+            solid_check(!objuid.isInvalid(), "Error starting object: " << err.message());
+        }
+
+        for (size_t i = 0; i < connection_count; ++i) {
+            SocketDevice& rsd = send_sds[i];
+            send_thrs.emplace_back([&rsd, size]() { run_sender(rsd, size); });
+        }
+
+        {
+            unique_lock<mutex> lock(mtx);
+
+            solid_check(cnd.wait_for(lock, chrono::seconds(100), [connection_count]() { return done_count == connection_count; }), "Process is taking too long.");
+        }
+
+        for (auto& rthr : send_thrs) {
+            rthr.join();
+        }
+    }
+
+    const frame::aio::ReactorStatistic& rstatistic = *reactor_cfg.statistic_ptr_;
+
+    cout << "Reactor statistic:" << rstatistic << endl;
+
+    if (operation_budget != 0) {
+        solid_check(rstatistic.io_budget_exhausted_count_ != 0, "the I/O budget was never exhausted");
+    }
+    return 0;
+}
@@ -0,0 +1,248 @@
+#include "solid/frame/manager.hpp"
+#include "solid/frame/scheduler.hpp"
+#include "solid/frame/service.hpp"
+
+#include "solid/frame/aio/aioerror.hpp"
+#include "solid/frame/aio/aioobject.hpp"
+#include "solid/frame/aio/aioreactor.hpp"
+#include "solid/frame/aio/aiosocket.hpp"
+#include "solid/frame/aio/aiostream.hpp"
+
+#include "solid/system/exception.hpp"
+#include "solid/system/filedevice.hpp"
+#include "solid/system/log.hpp"
+#include "solid/system/socketdevice.hpp"
+
+#include "solid/utility/event.hpp"
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <unistd.h>
+
+using namespace std;
+using namespace solid;
+
+using AioSchedulerT = frame::Scheduler<frame::aio::Reactor>;
+using StreamSocketT = frame::aio::Stream<frame::aio::Socket>;
+
+namespace {
+const LoggerT logger("test_stream_send_file");
+
+constexpr size_t tail_size = 10;
+
+mutex              mtx;
+condition_variable cnd;
+bool               done = false;
+
+char pattern(const uint64_t _offset)
+{
+    return static_cast<char>(_offset % 251);
+}
+
+void connect_pair(SocketDevice& _rsd1, SocketDevice& _rsd2)
+{
+    ResolveData  rd = synchronous_resolve("127.0.0.1", "0", 0, SocketInfo::Inet4, SocketInfo::Stream);
+    SocketDevice listen_sd;
+
+    listen_sd.create(rd.begin());
+    listen_sd.prepareAccept(rd.begin(), 1);
+    solid_check(listen_sd, "creating listener socket");
+
+    SocketAddress local_address;
+    listen_sd.localAddress(local_address);
+
+    _rsd1.create(rd.begin());
+    solid_check(!_rsd1.connect(local_address), "connecting");
+    solid_check(!listen_sd.accept(_rsd2), "accepting");
+}
+
+void create_file(const std::string& _path, const uint64_t _size)
+{
+    FileDevice   fd;
+    vector<char> buf(64 * 1024);
+    uint64_t     offset = 0;
+
+    solid_check(fd.create(_path.c_str(), FileDevice::WriteOnlyE), "Error creating " << _path);
+
+    while (offset < _size) {
+        const size_t sz = static_cast<size_t>(std::min(static_cast<uint64_t>(buf.size()), _size - offset));
+        for (size_t i = 0; i < sz; ++i) {
+            buf[i] = pattern(offset + i);
+        }
+        solid_check(fd.write(buf.data(), sz) == static_cast<ssize_t>(sz), "Error writing " << _path);
+        offset += sz;
+    }
+}
+
+//-----------------------------------------------------------------------------
+// Sends nothing - synchronously and posted - then the whole file and then
+// tail_size bytes more than its tail, which must end with error_stream_file_end.
+class Object final : public Dynamic<Object, frame::aio::Object> {
+public:
+    Object(SocketDevice&& _usd, FileDevice& _rfile, const uint64_t _size)
+        : sock_(this->proxy(), std::move(_usd))
+        , rfile_(_rfile)
+        , size_(_size)
+    {
+    }
+
+private:
+    void onEvent(frame::aio::ReactorContext& _rctx, Event&& _revent) override
+    {
+        if (generic_event_start == _revent) {
+            solid_check(sock_.sendFile(_rctx, rfile_, 0, 0, [](frame::aio::ReactorContext&) {
+                solid_throw("completion called for an empty synchronous send");
+            }),
+                "empty sendFile did not complete right away");
+            solid_check(!_rctx.error(), "empty sendFile: " << _rctx.error().message());
+
+            solid_check(!sock_.postSendFile(_rctx, rfile_, 0, 0, [this](frame::aio::ReactorContext& _rctx) {
+                solid_check(!_rctx.error(), "empty postSendFile: " << _rctx.error().message());
+                doSendAll(_rctx);
+            }),
+                "postSendFile failed: " << _rctx.error().message());
+        } else if (generic_event_kill == _revent) {
+            postStop(_rctx);
+        }
+    }
+
+    void doSendAll(frame::aio::ReactorContext& _rctx)
+    {
+        solid_check(!sock_.postSendFile(_rctx, rfile_, 0, size_, [this](frame::aio::ReactorContext& _rctx) {
+            solid_check(!_rctx.error(), "postSendFile: " << _rctx.error().message() << " " << _rctx.systemError().message());
+            doSendPastEnd(_rctx);
+        }),
+            "postSendFile failed: " << _rctx.error().message());
+    }
+
+    void doSendPastEnd(frame::aio::ReactorContext& _rctx)
+    {
+        const auto on_done = [this](frame::aio::ReactorContext& _rctx) { onSendPastEnd(_rctx); };
+
+        if (sock_.sendFile(_rctx, rfile_, size_ - tail_size, 10 * tail_size, on_done)) {
+            onSendPastEnd(_rctx);
+        }
+    }
+
+    void onSendPastEnd(frame::aio::ReactorContext& _rctx)
+    {
+        solid_check(_rctx.error() == frame::aio::error_stream_file_end, "expected file end, got: " << _rctx.error().message());
+        solid_log(logger, Verbose, "file sent");
+        postStop(_rctx);
+
+        lock_guard<mutex> lock(mtx);
+        done = true;
+        cnd.notify_one();
+    }
+
+    StreamSocketT  sock_;
+    FileDevice&    rfile_;
+    const uint64_t size_;
+};
+
+//receives till the object closes the socket
+uint64_t run_receiver(SocketDevice& _rsd, const uint64_t _size)
+{
+    vector<char> buf(64 * 1024);
+    uint64_t     offset = 0;
+
+    while (true) {
+        bool       can_retry;
+        ErrorCodeT err;
+        ssize_t    rv = _rsd.recv(buf.data(), buf.size(), can_retry, err);
+        solid_check(rv >= 0, "recv: " << err.message());
+        if (rv == 0) {
+            break;
+        }
+        for (ssize_t i = 0; i < rv; ++i) {
+            const uint64_t off = offset + i;
+            //the whole file, then its tail
+            const uint64_t file_off = off < _size ? off : off - tail_size;
+            solid_check(buf[i] == pattern(file_off), "wrong data at offset " << off);
+        }
+        offset += rv;
+    }
+    return offset;
+}
+
+} //namespace
+
+// Stream::sendFile and postSendFile: empty sends, a large file sent over
+// many reactor turns and a send running past the end of the file.
+// With an I/O budget of one operation per turn, every sendfile call but
+// the last of a file send must give the reactor turn up.
+// Usage: test_stream_send_file [FILE_SIZE_MB]
+int test_stream_send_file(int argc, char* argv[])
+{
+    solid::log_start(std::cerr, {"solid::frame::aio.*:EW", "test_stream_send_file:VIEW"});
+
+    uint64_t size = 16 * 1024 * 1024;
+
+    if (argc > 1) {
+        size = atoi(argv[1]) * 1024ULL * 1024ULL;
+    }
+
+    frame::aio::ReactorConfiguration reactor_cfg(1, 0);
+
+    reactor_cfg.statistic_ptr_ = std::make_shared<frame::aio::ReactorStatistic>();
+
+    const std::string path = "/tmp/test_stream_send_file_" + std::to_string(getpid()) + ".bin";
+
+    create_file(path, size);
+
+    uint64_t recv_size = 0;
+    {
+        FileDevice file;
+
+        solid_check(file.open(path.c_str(), FileDevice::ReadOnlyE), "Error opening " << path);
+
+        AioSchedulerT   sch{reactor_cfg};
+        frame::Manager  mgr;
+        frame::ServiceT svc{mgr};
+
+        solid_check(!sch.start(1), "Error starting scheduler");
+
+        SocketDevice send_sd;
+        SocketDevice recv_sd;
+
+        connect_pair(recv_sd, send_sd);
+        send_sd.makeNonBlocking();
+
+        thread recv_thr{[&recv_sd, &recv_size, size]() { recv_size = run_receiver(recv_sd, size); }};
+
+        {
+            DynamicPointer<frame::aio::Object> objptr(new Object(std::move(send_sd), file, size));
+            ErrorConditionT                    err;
+
+            const frame::ObjectIdT objuid = sch.startObject(objptr, svc, make_event(GenericEvents::Start), err);
+            solid_check(!objuid.isInvalid(), "Error starting object: " << err.message());
+        }
+
+        {
+            unique_lock<mutex> lock(mtx);
+
+            solid_check(cnd.wait_for(lock, chrono::seconds(100), []() { return done; }), "Process is taking too long.");
+        }
+
+        //closes the socket, ending the receiver
+        mgr.stop();
+        recv_thr.join();
+    }
+    std::remove(path.c_str());
+
+    solid_check(recv_size == size + tail_size, "received " << recv_size << " instead of " << (size + tail_size));
+
+    const frame::aio::ReactorStatistic& rstatistic = *reactor_cfg.statistic_ptr_;
+
+    cout << "Reactor statistic:" << rstatistic << endl;
+
+    //the send past the end of the file, right after the completion, gives up one
+    solid_check(rstatistic.io_budget_exhausted_count_ > 1, "the file send never gave the reactor turn up");
+    return 0;
+}
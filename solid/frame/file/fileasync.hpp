@@ -0,0 +1,219 @@
+// solid/frame/file/fileasync.hpp
+//
+// Copyright (c) 2018 Valentin Palade (vipalade @ gmail . com)
+//
+// This file is part of SolidFrame framework.
+//
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt.
+//
+
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include "solid/frame/aio/aiooffload.hpp"
+#include "solid/frame/file/filestore.hpp"
+#include "solid/system/error.hpp"
+#include "solid/system/pimpl.hpp"
+#include "solid/utility/workpool.hpp"
+
+namespace solid {
+namespace frame {
+namespace file {
+
+struct AsyncConfiguration {
+    size_t thread_count_; //per disk
+    size_t max_pending_count_; //per disk
+
+    AsyncConfiguration(
+        const size_t _thread_count      = 2,
+        const size_t _max_pending_count = 64)
+        : thread_count_(_thread_count)
+        , max_pending_count_(_max_pending_count)
+    {
+    }
+};
+
+//! I/O thread pools for AsyncFile, one per disk
+/*!
+ * Files are mapped to disks by their device id, temporary files by their
+ * temp storage. Every disk has its own bounded FunctionWorkPool so a slow
+ * disk cannot stall requests for the others and the number of in-flight
+ * requests per disk is limited by max_pending_count_.
+ * The AsyncEngine must outlive the Objects using it.
+ */
+class AsyncEngine {
+public:
+    AsyncEngine(const AsyncConfiguration& _rcfg = AsyncConfiguration());
+    AsyncEngine(const AsyncEngine&) = delete;
+    AsyncEngine& operator=(const AsyncEngine&) = delete;
+    ~AsyncEngine();
+
+    FunctionWorkPool& workPool(const File& _rfile);
+
+private:
+    struct Data;
+    PimplT<Data> impl_;
+};
+
+//! Asynchronous read/write of a File, completing on the owner's reactor
+/*!
+ * The blocking File::read/write calls run on the AsyncEngine pool of the
+ * file's disk and the completion is called on the reactor thread of the
+ * owning aio::Object (see aio::Offload).
+ * While a request is in flight, the file pointer and the buffer are shared
+ * with the job, so the Object may stop at any time.
+ * At most one request can be in flight per AsyncFile.
+ */
+class AsyncFile {
+    struct Request {
+        FilePointerT file_ptr_;
+        std::string  buffer_;
+    };
+
+    using RequestPointerT = std::shared_ptr<Request>;
+    using OffloadT        = aio::Offload<ErrorCodeT>;
+
+public:
+    AsyncFile(
+        aio::ObjectProxy const& _robj,
+        AsyncEngine&            _rengine)
+        : rengine_(_rengine)
+        , pwp_(nullptr)
+        , req_ptr_(std::make_shared<Request>())
+        , offload_(_robj)
+    {
+    }
+
+    //Takes the ownership of the file pointer (see shared::Pointer).
+    void reset(FilePointerT const& _rfile_ptr)
+    {
+        solid_assert(!isPending());
+        req_ptr_->file_ptr_ = _rfile_ptr;
+        pwp_                = req_ptr_->file_ptr_.empty() ? nullptr : &rengine_.workPool(*req_ptr_->file_ptr_);
+    }
+
+    void clear()
+    {
+        solid_assert(!isPending());
+        req_ptr_->file_ptr_.clear();
+        pwp_ = nullptr;
+    }
+
+    //NOTE: the file is not accessible while a request is pending
+    FilePointerT const& file() const
+    {
+        return req_ptr_->file_ptr_;
+    }
+
+    bool isPending() const
+    {
+        return offload_.isPending();
+    }
+
+    //Reads up to _len bytes from offset _off into _ubuf.
+    //On completion _f(ReactorContext&, std::string&& _ubuf, ErrorCodeT const&) is called
+    //on the reactor thread with _ubuf.size() the number of bytes read - 0 at end of file.
+    //Returns true when the request could not be scheduled - see aio::Offload::tryPost -
+    //_ubuf being left untouched.
+    template <class F>
+    bool postRead(aio::ReactorContext& _rctx, std::string&& _ubuf, const size_t _len, const int64_t _off, F _f)
+    {
+        if (doCheck(_rctx)) {
+            return true;
+        }
+
+        RequestPointerT tmp_req_ptr = req_ptr_;
+
+        tmp_req_ptr->buffer_.swap(_ubuf);
+
+        const bool rv = offload_.tryPost(
+            _rctx, *pwp_,
+            [tmp_req_ptr, _len, _off]() {
+                std::string& rbuf = tmp_req_ptr->buffer_;
+                rbuf.resize(_len);
+
+                const ssize_t rv = _len != 0 ? tmp_req_ptr->file_ptr_->read(&rbuf[0], _len, _off) : 0;
+
+                if (rv >= 0) {
+                    rbuf.resize(rv);
+                    return ErrorCodeT();
+                }
+                rbuf.clear();
+                return last_system_error();
+            },
+            [this, _f = std::move(_f)](aio::ReactorContext& _rctx, ErrorCodeT&& _rerr) mutable {
+                F tmpf{std::move(_f)};
+                tmpf(_rctx, std::move(req_ptr_->buffer_), _rerr);
+            });
+
+        if (rv) {
+            tmp_req_ptr->buffer_.swap(_ubuf);
+        }
+        return rv;
+    }
+
+    //Writes all of _ubuf at offset _off.
+    //On completion _f(ReactorContext&, std::string&& _ubuf, ErrorCodeT const&) is called
+    //on the reactor thread, giving back the buffer for reuse.
+    template <class F>
+    bool postWrite(aio::ReactorContext& _rctx, std::string&& _ubuf, const int64_t _off, F _f)
+    {
+        if (doCheck(_rctx)) {
+            return true;
+        }
+
+        RequestPointerT tmp_req_ptr = req_ptr_;
+
+        tmp_req_ptr->buffer_.swap(_ubuf);
+
+        const bool rv = offload_.tryPost(
+            _rctx, *pwp_,
+            [tmp_req_ptr, _off]() {
+                const std::string& rbuf = tmp_req_ptr->buffer_;
+                size_t             off  = 0;
+
+                while (off < rbuf.size()) {
+                    const ssize_t rv = tmp_req_ptr->file_ptr_->write(rbuf.data() + off, rbuf.size() - off, _off + off);
+                    if (rv < 0) {
+                        return last_system_error();
+                    }
+                    if (rv == 0) {
+                        //no progress and no errno to report - e.g. a full temp storage
+                        return std::make_error_code(std::errc::io_error);
+                    }
+                    off += rv;
+                }
+                return ErrorCodeT();
+            },
+            [this, _f = std::move(_f)](aio::ReactorContext& _rctx, ErrorCodeT&& _rerr) mutable {
+                F tmpf{std::move(_f)};
+                tmpf(_rctx, std::move(req_ptr_->buffer_), _rerr);
+            });
+
+        if (rv) {
+            tmp_req_ptr->buffer_.swap(_ubuf);
+        }
+        return rv;
+    }
+
+private:
+    bool doCheck(aio::ReactorContext& _rctx)
+    {
+        solid_assert(pwp_ != nullptr);
+        //the buffer is in use by the pending request
+        return offload_.checkPending(_rctx);
+    }
+
+private:
+    AsyncEngine&      rengine_;
+    FunctionWorkPool* pwp_;
+    RequestPointerT   req_ptr_;
+    OffloadT          offload_;
+};
+
+} //namespace file
+} //namespace frame
+} //namespace solid
@@ -0,0 +1,111 @@
+// solid/frame/file/filecache.hpp
+//
+// Copyright (c) 2018 Valentin Palade (vipalade @ gmail . com)
+//
+// This file is part of SolidFrame framework.
+//
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt.
+//
+
+#pragma once
+
+#include "solid/system/common.hpp"
+#include "solid/system/pimpl.hpp"
+
+namespace solid {
+namespace frame {
+namespace file {
+
+struct File;
+
+struct BlockCacheConfiguration {
+    size_t page_size_; //rounded up to a power of two
+    size_t memory_budget_; //for all the shards
+    size_t shard_count_; //rounded up to a power of two
+    size_t readahead_page_count_; //pages loaded ahead on sequential reads, at most 15 - 0 disables readahead
+
+    BlockCacheConfiguration(
+        const size_t _page_size            = 64 * 1024,
+        const size_t _memory_budget        = 64 * 1024 * 1024,
+        const size_t _shard_count          = 16,
+        const size_t _readahead_page_count = 4)
+        : page_size_(_page_size)
+        , memory_budget_(_memory_budget)
+        , shard_count_(_shard_count)
+        , readahead_page_count_(_readahead_page_count)
+    {
+    }
+};
+
+//! Identifies the content of a regular file in the BlockCache
+struct BlockCacheKey {
+    uint64_t device_;
+    uint64_t inode_;
+    uint64_t mtime_; //nanoseconds, at open: a file changed by others gets a new key
+    uint64_t size_;
+
+    BlockCacheKey()
+        : device_(0)
+        , inode_(0)
+        , mtime_(0)
+        , size_(0)
+    {
+    }
+
+    bool sameFile(const BlockCacheKey& _rkey) const
+    {
+        return device_ == _rkey.device_ && inode_ == _rkey.inode_;
+    }
+
+    bool operator==(const BlockCacheKey& _rkey) const
+    {
+        return sameFile(_rkey) && mtime_ == _rkey.mtime_ && size_ == _rkey.size_;
+    }
+};
+
+//! Shared page cache in front of File::read
+/*!
+ * Regular files attached to the cache are read in fixed size pages, kept
+ * in shards selected by the hash of (file, page index). Every shard has its
+ * own mutex and a fixed number of page slots - memory_budget_ / page_size_
+ * split over the shards - recycled with the CLOCK algorithm.
+ *
+ * Every shard also keeps the end offsets of the last reads of the files
+ * mapped onto it. A read starting where a previous one ended is considered
+ * part of a sequential stream and its miss loads readahead_page_count_ more
+ * pages with the same pread, so many streams over the same popular files
+ * cost a fraction of the disk requests. The pages are read straight into
+ * cache slots reserved for the load.
+ *
+ * Writes and truncates through File invalidate the affected pages of every
+ * handle of the file - same device and inode - and keep the loads in
+ * flight on their shards from caching what they read. Changes made by
+ * others are only seen after the file is reopened.
+ * The BlockCache must outlive the attached files.
+ */
+class BlockCache {
+public:
+    BlockCache(const BlockCacheConfiguration& _rcfg = BlockCacheConfiguration());
+    BlockCache(const BlockCache&) = delete;
+    BlockCache& operator=(const BlockCache&) = delete;
+    ~BlockCache();
+
+    //Called on an opened File - only regular files are attached.
+    bool attach(File& _rfile);
+
+    ssize_t read(File& _rfile, char* _pb, size_t _bl, int64_t _off);
+
+    void invalidate(const File& _rfile, int64_t _off, size_t _len);
+    void invalidate(const File& _rfile);
+
+    void dumpStatistics() const;
+
+private:
+    struct Data;
+    PimplT<Data> impl_;
+};
+
+} //namespace file
+} //namespace frame
+} //namespace solid
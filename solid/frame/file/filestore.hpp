@@ -10,6 +10,7 @@
 
 #pragma once
 
+#include "solid/frame/file/filecache.hpp"
 #include "solid/frame/file/tempbase.hpp"
 #include "solid/frame/sharedstore.hpp"
 #include "solid/system/filedevice.hpp"
@@ -69,6 +70,7 @@ struct Utf8Controller;
 struct File {
     File()
         : ptmp(nullptr)
+        , pcache(nullptr)
     {
     }
     ~File()
@@ -79,7 +81,8 @@ struct File {
     {
         fd.close();
         delete ptmp;
-        ptmp = nullptr;
+        ptmp   = nullptr;
+        pcache = nullptr;
     }
     bool open(const char* _path, const int _openflags)
     {
@@ -92,7 +95,10 @@ struct File {
     ssize_t read(char* _pb, size_t _bl, int64_t _off)
     {
         if (!ptmp) {
-            return fd.read(_pb, _bl, _off);
+            if (pcache == nullptr) {
+                return fd.read(_pb, _bl, _off);
+            }
+            return pcache->read(*this, _pb, _bl, _off);
         } else {
             return ptmp->read(_pb, _bl, _off);
         }
@@ -100,7 +106,11 @@ struct File {
     ssize_t write(const char* _pb, size_t _bl, int64_t _off)
     {
         if (!ptmp) {
-            return fd.write(_pb, _bl, _off);
+            const ssize_t rv = fd.write(_pb, _bl, _off);
+            if (pcache != nullptr && rv > 0) {
+                pcache->invalidate(*this, _off, rv);
+            }
+            return rv;
         } else {
             return ptmp->write(_pb, _bl, _off);
         }
@@ -116,6 +126,9 @@ struct File {
     bool truncate(int64_t _len = 0)
     {
         if (!ptmp) {
+            if (pcache != nullptr) {
+                pcache->invalidate(*this);
+            }
             return fd.truncate(_len);
         } else {
             return ptmp->truncate(_len);
@@ -147,11 +160,29 @@ struct File {
     {
         return ptmp;
     }
+    //Identifies the disk of the file: the device id or, for temporary
+    //files, the temp storage.
+    uint64_t diskId() const;
+    //The device of a regular file for zero-copy transfers - e.g.
+    //aio::Stream::postSendFile - nullptr for temporary files.
+    //The FilePointerT must be kept while the device is in use.
+    const FileDevice* device() const
+    {
+        return ptmp == nullptr && fd ? &fd : nullptr;
+    }
+    //The BlockCache the reads go through, if any - see BlockCache::attach.
+    BlockCache* cache() const
+    {
+        return pcache;
+    }
 
 private:
     friend struct Utf8Controller;
-    FileDevice fd;
-    TempBase*  ptmp;
+    friend class BlockCache;
+    FileDevice    fd;
+    TempBase*     ptmp;
+    BlockCache*   pcache;
+    BlockCacheKey cachekey;
 };
 
 typedef shared::Pointer<File> FilePointerT;
@@ -227,6 +258,8 @@ struct Utf8Configuration {
     typedef std::vector<Storage> StorageVectorT;
 
     StorageVectorT storagevec;
+    //optional, shared by all the opened files
+    std::shared_ptr<BlockCache> blockcacheptr;
 };
 
 struct Utf8OpenCommandBase;
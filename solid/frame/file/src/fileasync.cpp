@@ -0,0 +1,64 @@
+// solid/frame/file/src/fileasync.cpp
+//
+// Copyright (c) 2018 Valentin Palade (vipalade @ gmail . com)
+//
+// This file is part of SolidFrame framework.
+//
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt.
+//
+
+#include "solid/frame/file/fileasync.hpp"
+
+#include <mutex>
+#include <unordered_map>
+
+using namespace std;
+
+namespace solid {
+namespace frame {
+namespace file {
+
+//---------------------------------------------------------------------------
+//      AsyncEngine
+//---------------------------------------------------------------------------
+struct AsyncEngine::Data {
+    using WorkPoolPointerT = std::unique_ptr<FunctionWorkPool>;
+    using WorkPoolMapT     = std::unordered_map<uint64_t, WorkPoolPointerT>;
+
+    const AsyncConfiguration config_;
+    std::mutex               mutex_;
+    WorkPoolMapT             wp_map_;
+
+    Data(const AsyncConfiguration& _rcfg)
+        : config_(_rcfg)
+    {
+    }
+};
+//---------------------------------------------------------------------------
+AsyncEngine::AsyncEngine(const AsyncConfiguration& _rcfg)
+    : impl_(make_pimpl<Data>(_rcfg))
+{
+}
+//---------------------------------------------------------------------------
+AsyncEngine::~AsyncEngine()
+{
+    solid_log(logger, Verbose, this << " disk count = " << impl_->wp_map_.size());
+}
+//---------------------------------------------------------------------------
+FunctionWorkPool& AsyncEngine::workPool(const File& _rfile)
+{
+    const uint64_t         disk_id = _rfile.diskId();
+    lock_guard<std::mutex> lock(impl_->mutex_);
+    Data::WorkPoolPointerT& rwp_ptr = impl_->wp_map_[disk_id];
+
+    if (!rwp_ptr) {
+        solid_log(logger, Info, this << " new disk " << disk_id);
+        rwp_ptr.reset(new FunctionWorkPool(WorkPoolConfiguration(impl_->config_.thread_count_, impl_->config_.max_pending_count_)));
+    }
+    return *rwp_ptr;
+}
+//---------------------------------------------------------------------------
+} //namespace file
+} //namespace frame
+} //namespace solid
@@ -0,0 +1,559 @@
+// solid/frame/file/src/filecache.cpp
+//
+// Copyright (c) 2018 Valentin Palade (vipalade @ gmail . com)
+//
+// This file is part of SolidFrame framework.
+//
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt.
+//
+
+#include "solid/frame/file/filecache.hpp"
+#include "solid/frame/file/filestore.hpp"
+
+#include "solid/system/statistic.hpp"
+#include "solid/utility/common.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#ifndef SOLID_ON_WINDOWS
+#include <sys/stat.h>
+#include <sys/uio.h>
+#endif
+
+using namespace std;
+
+namespace solid {
+namespace frame {
+namespace file {
+
+namespace {
+
+size_t round_up_power_of_two(const size_t _v)
+{
+    size_t v = 1;
+    while (v < _v) {
+        v <<= 1;
+    }
+    return v;
+}
+
+inline size_t hash_combine(size_t _h, const uint64_t _v)
+{
+    return _h ^ (std::hash<uint64_t>()(_v) + 0x9e3779b9 + (_h << 6) + (_h >> 2));
+}
+
+inline size_t file_hash(const BlockCacheKey& _rkey)
+{
+    return hash_combine(std::hash<uint64_t>()(_rkey.device_), _rkey.inode_);
+}
+
+struct PageKey {
+    BlockCacheKey file_;
+    uint64_t      index_;
+
+    PageKey()
+        : index_(0)
+    {
+    }
+
+    PageKey(const BlockCacheKey& _rfile, const uint64_t _index)
+        : file_(_rfile)
+        , index_(_index)
+    {
+    }
+
+    bool operator==(const PageKey& _rkey) const
+    {
+        return index_ == _rkey.index_ && file_ == _rkey.file_;
+    }
+};
+
+//Only the device and the inode of the file are hashed, so the pages with
+//the same index of all the keys of a file share the shard and the bucket.
+struct PageKeyHash {
+    size_t operator()(const PageKey& _rkey) const
+    {
+        return hash_combine(file_hash(_rkey.file_), _rkey.index_);
+    }
+};
+
+struct Page {
+    PageKey                 key_;
+    std::unique_ptr<char[]> data_; //allocated on first use
+    size_t                  size_; //less than page size for the last page of the file
+    bool                    used_;
+    bool                    referenced_;
+    bool                    loading_; //reserved for a load in progress
+
+    Page()
+        : size_(0)
+        , used_(false)
+        , referenced_(false)
+        , loading_(false)
+    {
+    }
+};
+
+//the end of the last read of a stream
+struct Cursor {
+    BlockCacheKey file_;
+    int64_t       end_;
+
+    Cursor()
+        : end_(-1)
+    {
+    }
+};
+
+using PageMapT    = std::unordered_map<PageKey, size_t, PageKeyHash>;
+using PageVectorT = std::vector<Page>;
+
+constexpr size_t shard_cursor_count   = 8;
+constexpr size_t max_readahead_count = 15;
+
+struct Shard {
+    std::mutex  mutex_;
+    PageMapT    page_map_;
+    PageVectorT page_vec_;
+    size_t      clock_hand_;
+    Cursor      cursor_arr_[shard_cursor_count];
+    size_t      cursor_next_;
+    uint64_t    generation_; //bumped by every invalidation - see BlockCache::Data::load
+
+    Shard()
+        : clock_hand_(0)
+        , cursor_next_(0)
+        , generation_(0)
+    {
+    }
+
+    //CLOCK: pages referenced since the hand's last pass get a second chance.
+    //Returns InvalidIndex when all the pages are being loaded.
+    size_t evict()
+    {
+        for (size_t i = 0; i < 2 * page_vec_.size(); ++i) {
+            const size_t idx   = clock_hand_;
+            Page&        rpage = page_vec_[idx];
+
+            clock_hand_ = (clock_hand_ + 1) % page_vec_.size();
+
+            if (rpage.loading_) {
+                continue;
+            }
+            if (!rpage.used_) {
+                return idx;
+            }
+            if (rpage.referenced_) {
+                rpage.referenced_ = false;
+                continue;
+            }
+            page_map_.erase(rpage.key_);
+            rpage.used_ = false;
+            return idx;
+        }
+        return InvalidIndex();
+    }
+
+    //Takes a page out of the CLOCK, for a load to read straight into it
+    size_t reserve(const size_t _page_size)
+    {
+        const size_t idx = evict();
+        if (idx != InvalidIndex()) {
+            Page& rpage = page_vec_[idx];
+            if (!rpage.data_) {
+                rpage.data_.reset(new char[_page_size]);
+            }
+            rpage.loading_ = true;
+        }
+        return idx;
+    }
+
+    void erase(const size_t _idx)
+    {
+        Page& rpage = page_vec_[_idx];
+        page_map_.erase(rpage.key_);
+        rpage.used_       = false;
+        rpage.referenced_ = false;
+    }
+
+    //Erases the page with the index of _rkey, under any key of the file
+    size_t eraseFilePage(const PageKey& _rkey)
+    {
+        const size_t bucket = page_map_.bucket(_rkey);
+        size_t       count  = 0;
+
+        for (auto it = page_map_.begin(bucket); it != page_map_.end(bucket);) {
+            const size_t idx  = it->second;
+            const bool   same = it->first.index_ == _rkey.index_ && it->first.file_.sameFile(_rkey.file_);
+            ++it;
+            if (same) {
+                erase(idx);
+                ++count;
+            }
+        }
+        return count;
+    }
+};
+
+//Reads _count consecutive pages, from _off, into the _pdata_arr pages.
+//Returns the number of bytes read, less than asked at the end of the file.
+ssize_t read_pages(FileDevice& _rfd, char* const* _pdata_arr, const size_t _count, const size_t _page_size, const int64_t _off)
+{
+    const size_t load_size = _count * _page_size;
+    size_t       load_len  = 0;
+
+    while (load_len < load_size) {
+        const size_t first    = load_len / _page_size;
+        const size_t page_off = load_len % _page_size;
+#ifndef SOLID_ON_WINDOWS
+        struct iovec iov[max_readahead_count + 1];
+        size_t       iov_count = 0;
+
+        for (size_t i = first; i < _count; ++i, ++iov_count) {
+            const size_t skip       = i == first ? page_off : 0;
+            iov[iov_count].iov_base = _pdata_arr[i] + skip;
+            iov[iov_count].iov_len  = _page_size - skip;
+        }
+
+        const ssize_t rv = ::preadv(_rfd.descriptor(), iov, static_cast<int>(iov_count), _off + load_len);
+#else
+        const ssize_t rv = _rfd.read(_pdata_arr[first] + page_off, _page_size - page_off, _off + load_len);
+#endif
+        if (rv < 0) {
+            return rv;
+        }
+        if (rv == 0) {
+            break;
+        }
+        load_len += rv;
+    }
+    return load_len;
+}
+
+} //namespace
+
+//---------------------------------------------------------------------------
+//      BlockCache
+//---------------------------------------------------------------------------
+struct BlockCache::Data {
+    const size_t             page_size_;
+    const size_t             page_mask_;
+    const size_t             shard_mask_;
+    const size_t             readahead_page_count_;
+    const size_t             page_capacity_;
+    std::unique_ptr<Shard[]> shards_;
+#ifdef SOLID_HAS_STATISTICS
+    struct Statistic : solid::Statistic {
+        std::atomic<size_t> hit_count_;
+        std::atomic<size_t> miss_count_;
+        std::atomic<size_t> load_count_;
+        std::atomic<size_t> readahead_page_count_;
+        std::atomic<size_t> invalidate_page_count_;
+        std::atomic<size_t> invalidate_load_count_; //loaded pages not cached because of an invalidation
+
+        Statistic()
+            : hit_count_(0)
+            , miss_count_(0)
+            , load_count_(0)
+            , readahead_page_count_(0)
+            , invalidate_page_count_(0)
+            , invalidate_load_count_(0)
+        {
+        }
+
+        std::ostream& print(std::ostream& _ros) const override
+        {
+            _ros << " hit_count_ = " << hit_count_;
+            _ros << " miss_count_ = " << miss_count_;
+            _ros << " load_count_ = " << load_count_;
+            _ros << " readahead_page_count_ = " << readahead_page_count_;
+            _ros << " invalidate_page_count_ = " << invalidate_page_count_;
+            _ros << " invalidate_load_count_ = " << invalidate_load_count_;
+            return _ros;
+        }
+    } statistic_;
+#endif
+
+    Data(const BlockCacheConfiguration& _rcfg)
+        : page_size_(round_up_power_of_two(std::max(_rcfg.page_size_, static_cast<size_t>(512))))
+        , page_mask_(page_size_ - 1)
+        , shard_mask_(round_up_power_of_two(std::max(_rcfg.shard_count_, static_cast<size_t>(1))) - 1)
+        , readahead_page_count_(std::min(_rcfg.readahead_page_count_, max_readahead_count))
+        , page_capacity_(std::max(_rcfg.memory_budget_ / page_size_ / (shard_mask_ + 1), static_cast<size_t>(1)))
+        , shards_(new Shard[shard_mask_ + 1])
+    {
+        for (size_t i = 0; i <= shard_mask_; ++i) {
+            shards_[i].page_vec_.resize(page_capacity_);
+            shards_[i].page_map_.reserve(page_capacity_);
+        }
+    }
+
+    Shard& shard(const PageKey& _rkey)
+    {
+        return shards_[PageKeyHash()(_rkey) & shard_mask_];
+    }
+
+    bool isSequential(const BlockCacheKey& _rkey, const int64_t _off, const size_t _len);
+
+    size_t copy(const PageKey& _rkey, const size_t _off, char* _pb, const size_t _bl, bool& _rhit);
+
+    ssize_t load(FileDevice& _rfd, const BlockCacheKey& _rkey, const uint64_t _page, const size_t _off, char* _pb, const size_t _bl, const bool _sequential);
+};
+
+//Track the streams of the file: a read continuing a previous one is sequential.
+bool BlockCache::Data::isSequential(const BlockCacheKey& _rkey, const int64_t _off, const size_t _len)
+{
+    if (readahead_page_count_ == 0) {
+        return false;
+    }
+    Shard&            rshard = shards_[file_hash(_rkey) & shard_mask_];
+    lock_guard<mutex> lock(rshard.mutex_);
+
+    for (Cursor& rcursor : rshard.cursor_arr_) {
+        if (rcursor.end_ == _off && rcursor.file_ == _rkey) {
+            rcursor.end_ = _off + _len;
+            return true;
+        }
+    }
+    Cursor& rcursor     = rshard.cursor_arr_[rshard.cursor_next_];
+    rshard.cursor_next_ = (rshard.cursor_next_ + 1) % shard_cursor_count;
+    rcursor.file_       = _rkey;
+    rcursor.end_        = _off + _len;
+    //the first read from the start of a file is very likely a stream
+    return _off == 0;
+}
+
+//Copies from a cached page, returns the number of bytes copied
+size_t BlockCache::Data::copy(const PageKey& _rkey, const size_t _off, char* _pb, const size_t _bl, bool& _rhit)
+{
+    Shard&            rshard = shard(_rkey);
+    lock_guard<mutex> lock(rshard.mutex_);
+    const auto        it = rshard.page_map_.find(_rkey);
+
+    if (it == rshard.page_map_.end()) {
+        _rhit = false;
+        return 0;
+    }
+
+    Page& rpage = rshard.page_vec_[it->second];
+
+    _rhit             = true;
+    rpage.referenced_ = true;
+
+    if (_off >= rpage.size_) {
+        return 0; //end of file
+    }
+    const size_t len = std::min(_bl, rpage.size_ - _off);
+    memcpy(_pb, rpage.data_.get() + _off, len);
+    return len;
+}
+
+//Loads _page - and the readahead pages for sequential reads - with a single
+//read, straight into reserved cache pages, then copies the requested range
+//from the first one and publishes the pages.
+ssize_t BlockCache::Data::load(FileDevice& _rfd, const BlockCacheKey& _rkey, const uint64_t _page, const size_t _off, char* _pb, const size_t _bl, const bool _sequential)
+{
+    const size_t max_count = _sequential ? readahead_page_count_ + 1 : 1;
+    Shard*       shard_arr[max_readahead_count + 1];
+    size_t       idx_arr[max_readahead_count + 1];
+    uint64_t     generation_arr[max_readahead_count + 1];
+    char*        data_arr[max_readahead_count + 1];
+    size_t       page_count = 0;
+
+    solid_statistic_inc(statistic_.load_count_);
+
+    for (; page_count < max_count; ++page_count) {
+        const PageKey     key(_rkey, _page + page_count);
+        Shard&            rshard = shard(key);
+        lock_guard<mutex> lock(rshard.mutex_);
+
+        if (page_count != 0 && rshard.page_map_.find(key) != rshard.page_map_.end()) {
+            break; //already cached - readahead stops here
+        }
+
+        const size_t idx = rshard.reserve(page_size_);
+
+        if (idx == InvalidIndex()) {
+            break;
+        }
+        shard_arr[page_count]      = &rshard;
+        idx_arr[page_count]        = idx;
+        generation_arr[page_count] = rshard.generation_;
+        data_arr[page_count]       = rshard.page_vec_[idx].data_.get();
+    }
+
+    if (page_count == 0) {
+        //all the pages are being loaded - read uncached
+        return _rfd.read(_pb, std::min(_bl, page_size_ - _off), (_page * page_size_) + _off);
+    }
+
+    const ssize_t rv       = read_pages(_rfd, data_arr, page_count, page_size_, _page * page_size_);
+    const size_t  load_len = rv < 0 ? 0 : rv;
+    size_t        len      = 0;
+
+    if (_off < load_len) {
+        len = std::min(_bl, std::min(page_size_, load_len) - _off);
+        memcpy(_pb, data_arr[0] + _off, len);
+    }
+
+    for (size_t i = 0; i < page_count; ++i) {
+        const PageKey     key(_rkey, _page + i);
+        const size_t      page_off = i * page_size_;
+        Shard&            rshard   = *shard_arr[i];
+        lock_guard<mutex> lock(rshard.mutex_);
+        Page&             rpage = rshard.page_vec_[idx_arr[i]];
+
+        rpage.loading_ = false;
+
+        if (rshard.generation_ != generation_arr[i]) {
+            //the read might have raced with a write - the data goes to the
+            //caller, who read concurrently with the write, but not to the cache
+            solid_statistic_inc(statistic_.invalidate_load_count_);
+            continue;
+        }
+
+        if (rv < 0 || (page_off >= load_len && i != 0) || rshard.page_map_.find(key) != rshard.page_map_.end()) {
+            //failed, past the end of file or concurrently loaded
+            continue;
+        }
+        rshard.page_map_[key] = idx_arr[i];
+        rpage.key_            = key;
+        rpage.size_           = std::min(page_size_, load_len - std::min(page_off, load_len));
+        rpage.used_           = true;
+        rpage.referenced_     = i == 0;
+        if (i != 0) {
+            solid_statistic_inc(statistic_.readahead_page_count_);
+        }
+    }
+
+    if (rv < 0) {
+        return rv;
+    }
+    return len;
+}
+//---------------------------------------------------------------------------
+BlockCache::BlockCache(const BlockCacheConfiguration& _rcfg)
+    : impl_(make_pimpl<Data>(_rcfg))
+{
+}
+//---------------------------------------------------------------------------
+BlockCache::~BlockCache()
+{
+}
+//---------------------------------------------------------------------------
+bool BlockCache::attach(File& _rfile)
+{
+#ifndef SOLID_ON_WINDOWS
+    struct stat st;
+    if (_rfile.ptmp == nullptr && _rfile.fd && fstat(_rfile.fd.descriptor(), &st) == 0 && S_ISREG(st.st_mode)) {
+        _rfile.cachekey.device_ = static_cast<uint64_t>(st.st_dev);
+        _rfile.cachekey.inode_  = static_cast<uint64_t>(st.st_ino);
+#ifdef SOLID_ON_DARWIN
+        _rfile.cachekey.mtime_ = static_cast<uint64_t>(st.st_mtimespec.tv_sec) * 1000000000ULL + st.st_mtimespec.tv_nsec;
+#else
+        _rfile.cachekey.mtime_ = static_cast<uint64_t>(st.st_mtim.tv_sec) * 1000000000ULL + st.st_mtim.tv_nsec;
+#endif
+        _rfile.cachekey.size_   = static_cast<uint64_t>(st.st_size);
+        _rfile.pcache           = this;
+        return true;
+    }
+#endif
+    return false;
+}
+//---------------------------------------------------------------------------
+ssize_t BlockCache::read(File& _rfile, char* _pb, size_t _bl, int64_t _off)
+{
+    Data&      rd         = *impl_;
+    const bool sequential = rd.isSequential(_rfile.cachekey, _off, _bl);
+    size_t     done       = 0;
+
+    while (done < _bl) {
+        const uint64_t off      = static_cast<uint64_t>(_off) + done;
+        const uint64_t page     = off / rd.page_size_;
+        const size_t   page_off = static_cast<size_t>(off & rd.page_mask_);
+        bool           hit;
+        size_t         len = rd.copy(PageKey(_rfile.cachekey, page), page_off, _pb + done, _bl - done, hit);
+
+        if (hit) {
+            solid_statistic_inc(rd.statistic_.hit_count_);
+        } else {
+            solid_statistic_inc(rd.statistic_.miss_count_);
+
+            const ssize_t rv = rd.load(_rfile.fd, _rfile.cachekey, page, page_off, _pb + done, _bl - done, sequential);
+
+            if (rv < 0) {
+                return done != 0 ? done : rv;
+            }
+            len = rv;
+        }
+
+        done += len;
+
+        if (len == 0 || (page_off + len) < rd.page_size_) {
+            //end of file or the request is fulfilled
+            break;
+        }
+    }
+    return done;
+}
+//---------------------------------------------------------------------------
+void BlockCache::invalidate(const File& _rfile, int64_t _off, size_t _len)
+{
+    Data&          rd    = *impl_;
+    const uint64_t first = static_cast<uint64_t>(_off) / rd.page_size_;
+    const uint64_t last  = (static_cast<uint64_t>(_off) + _len + rd.page_mask_) / rd.page_size_;
+
+    if ((last - first) > (rd.page_capacity_ * (rd.shard_mask_ + 1))) {
+        invalidate(_rfile);
+        return;
+    }
+
+    //other handles to the file may have cached the pages under other keys
+    for (uint64_t page = first; page < last; ++page) {
+        const PageKey     key(_rfile.cachekey, page);
+        Shard&            rshard = rd.shard(key);
+        lock_guard<mutex> lock(rshard.mutex_);
+        const size_t      count = rshard.eraseFilePage(key);
+
+        ++rshard.generation_;
+
+        solid_statistic_add(rd.statistic_.invalidate_page_count_, count);
+    }
+}
+//---------------------------------------------------------------------------
+void BlockCache::invalidate(const File& _rfile)
+{
+    Data& rd = *impl_;
+
+    for (size_t i = 0; i <= rd.shard_mask_; ++i) {
+        Shard&            rshard = rd.shards_[i];
+        lock_guard<mutex> lock(rshard.mutex_);
+
+        ++rshard.generation_;
+
+        for (size_t idx = 0; idx < rshard.page_vec_.size(); ++idx) {
+            const Page& rpage = rshard.page_vec_[idx];
+            if (rpage.used_ && rpage.key_.file_.sameFile(_rfile.cachekey)) {
+                rshard.erase(idx);
+                solid_statistic_inc(rd.statistic_.invalidate_page_count_);
+            }
+        }
+    }
+}
+//---------------------------------------------------------------------------
+void BlockCache::dumpStatistics() const
+{
+#ifdef SOLID_HAS_STATISTICS
+    solid_log(logger, Statistic, "BlockCache " << this << " statistic:" << impl_->statistic_);
+#endif
+}
+
+} //namespace file
+} //namespace frame
+} //namespace solid
@@ -25,6 +25,10 @@
 #include <algorithm>
 #include <cstdio>
 
+#ifndef SOLID_ON_WINDOWS
+#include <sys/stat.h>
+#endif
+
 using namespace std;
 
 namespace solid {
@@ -33,6 +37,24 @@ namespace file {
 
 const LoggerT logger("solid::frame::file");
 
+//---------------------------------------------------------------------------
+//      File
+//---------------------------------------------------------------------------
+uint64_t File::diskId() const
+{
+    if (ptmp != nullptr) {
+        //keep temp storages apart from device ids
+        return (static_cast<uint64_t>(1) << 63) | ptmp->tempstorageid;
+    }
+#ifndef SOLID_ON_WINDOWS
+    struct stat st;
+    if (fd && fstat(fd.descriptor(), &st) == 0) {
+        return static_cast<uint64_t>(st.st_dev);
+    }
+#endif
+    return 0;
+}
+
 //---------------------------------------------------------------------------
 //      Utf8Controller::Data
 //---------------------------------------------------------------------------
@@ -141,6 +163,7 @@ struct Utf8ConfigurationImpl {
 
     Utf8ConfigurationImpl() {}
     Utf8ConfigurationImpl(Utf8Configuration const& _cfg)
+        : blockcacheptr(_cfg.blockcacheptr)
     {
         storagevec.reserve(_cfg.storagevec.size());
 
@@ -151,7 +174,8 @@ struct Utf8ConfigurationImpl {
 
     typedef std::vector<Storage> StorageVectorT;
 
-    StorageVectorT storagevec;
+    StorageVectorT              storagevec;
+    std::shared_ptr<BlockCache> blockcacheptr;
 };
 
 struct TempConfigurationImpl {
@@ -392,6 +416,8 @@ void Utf8Controller::openFile(Utf8OpenCommandBase& _rcmd, FilePointerT& _rptr, E
     path.append(_rcmd.outpath.path);
     if (!_rptr->open(path.c_str(), static_cast<int>(_rcmd.openflags))) {
         _rerr = last_system_error();
+    } else if (impl_->filecfg.blockcacheptr) {
+        impl_->filecfg.blockcacheptr->attach(*_rptr);
     }
 }
 
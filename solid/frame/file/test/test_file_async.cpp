@@ -0,0 +1,229 @@
+#include "solid/frame/manager.hpp"
+#include "solid/frame/reactor.hpp"
+#include "solid/frame/scheduler.hpp"
+#include "solid/frame/service.hpp"
+
+#include "solid/frame/aio/aioerror.hpp"
+#include "solid/frame/aio/aioobject.hpp"
+#include "solid/frame/aio/aioreactor.hpp"
+
+#include "solid/frame/file/fileasync.hpp"
+#include "solid/frame/file/filestore.hpp"
+
+#include "solid/system/exception.hpp"
+#include "solid/system/log.hpp"
+
+#include "solid/utility/event.hpp"
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <iostream>
+#include <mutex>
+#include <thread>
+
+#include <unistd.h>
+
+using namespace std;
+using namespace solid;
+
+using AioSchedulerT = frame::Scheduler<frame::aio::Reactor>;
+using SchedulerT    = frame::Scheduler<frame::Reactor>;
+
+namespace {
+const LoggerT logger("test_file_async");
+
+mutex                     mtx;
+condition_variable        cnd;
+frame::file::FilePointerT file_ptr;
+bool                      file_opened = false;
+bool                      done        = false;
+
+inline char pattern_char(const size_t _pos)
+{
+    return static_cast<char>('a' + _pos % 26);
+}
+
+//-----------------------------------------------------------------------------
+// Writes the file, then reads it back: a part, the tail - shorter than asked -
+// and past the end. Every completion must run on the reactor thread.
+class Object final : public Dynamic<Object, frame::aio::Object> {
+public:
+    Object(frame::file::AsyncEngine& _rengine, const size_t _size)
+        : afile_(this->proxy(), _rengine)
+        , size_(_size)
+    {
+    }
+
+private:
+    void onEvent(frame::aio::ReactorContext& _rctx, Event&& _revent) override
+    {
+        if (generic_event_start == _revent) {
+            reactor_thread_id_ = this_thread::get_id();
+            afile_.reset(file_ptr);
+            doWrite(_rctx);
+        } else if (generic_event_kill == _revent) {
+            postStop(_rctx);
+        }
+    }
+
+    void checkCompletion(frame::aio::ReactorContext& _rctx, ErrorCodeT const& _rerr)
+    {
+        solid_check(this_thread::get_id() == reactor_thread_id_, "completion not on reactor thread");
+        solid_check(&_rctx.object() == this, "completion on wrong object");
+        solid_check(!_rerr, "file error: " << _rerr.message());
+        solid_check(!afile_.isPending(), "request still pending on completion");
+    }
+
+    void doWrite(frame::aio::ReactorContext& _rctx)
+    {
+        std::string buf(size_, '\0');
+        for (size_t i = 0; i < size_; ++i) {
+            buf[i] = pattern_char(i);
+        }
+        solid_check(!afile_.postWrite(_rctx, std::move(buf), 0, [this](frame::aio::ReactorContext& _rctx, std::string&& _ubuf, ErrorCodeT const& _rerr) {
+            checkCompletion(_rctx, _rerr);
+            solid_check(_ubuf.size() == size_, "write buffer not given back");
+            doReadHead(_rctx, std::move(_ubuf));
+        }),
+            "postWrite failed: " << _rctx.error().message());
+
+        checkAlreadyPending(_rctx);
+    }
+
+    //a second request while one is in flight fails right away, leaving its buffer
+    void checkAlreadyPending(frame::aio::ReactorContext& _rctx)
+    {
+        solid_check(afile_.isPending(), "request not pending");
+
+        std::string buf("untouched");
+        solid_check(afile_.postRead(_rctx, std::move(buf), 16, 0, [](frame::aio::ReactorContext&, std::string&&, ErrorCodeT const&) {
+            solid_throw("completion called for a rejected request");
+        }),
+            "second request must fail");
+        solid_check(_rctx.error() == frame::aio::error_already, "unexpected error: " << _rctx.error().message());
+        solid_check(buf == "untouched", "rejected request took the buffer");
+        _rctx.clearError();
+    }
+
+    void doReadHead(frame::aio::ReactorContext& _rctx, std::string&& _ubuf)
+    {
+        const size_t len = size_ / 2;
+        solid_check(!afile_.postRead(_rctx, std::move(_ubuf), len, 0, [this, len](frame::aio::ReactorContext& _rctx, std::string&& _ubuf, ErrorCodeT const& _rerr) {
+            checkCompletion(_rctx, _rerr);
+            solid_check(_ubuf.size() == len, "read " << _ubuf.size() << " of " << len);
+            checkData(_ubuf, 0);
+            doReadTail(_rctx, std::move(_ubuf));
+        }),
+            "postRead failed: " << _rctx.error().message());
+
+        checkAlreadyPending(_rctx);
+    }
+
+    void doReadTail(frame::aio::ReactorContext& _rctx, std::string&& _ubuf)
+    {
+        const size_t tail = size_ < 10 ? size_ : 10;
+        solid_check(!afile_.postRead(_rctx, std::move(_ubuf), 100, size_ - tail, [this, tail](frame::aio::ReactorContext& _rctx, std::string&& _ubuf, ErrorCodeT const& _rerr) {
+            checkCompletion(_rctx, _rerr);
+            solid_check(_ubuf.size() == tail, "short read of " << _ubuf.size() << " instead of " << tail);
+            checkData(_ubuf, size_ - tail);
+            doReadEnd(_rctx, std::move(_ubuf));
+        }),
+            "postRead failed: " << _rctx.error().message());
+    }
+
+    void doReadEnd(frame::aio::ReactorContext& _rctx, std::string&& _ubuf)
+    {
+        solid_check(!afile_.postRead(_rctx, std::move(_ubuf), 100, size_, [this](frame::aio::ReactorContext& _rctx, std::string&& _ubuf, ErrorCodeT const& _rerr) {
+            checkCompletion(_rctx, _rerr);
+            solid_check(_ubuf.empty(), "read " << _ubuf.size() << " bytes past the end of file");
+
+            afile_.clear();
+            postStop(_rctx);
+
+            lock_guard<mutex> lock(mtx);
+            done = true;
+            cnd.notify_one();
+        }),
+            "postRead failed: " << _rctx.error().message());
+    }
+
+    static void checkData(const std::string& _rbuf, const size_t _off)
+    {
+        for (size_t i = 0; i < _rbuf.size(); ++i) {
+            solid_check(_rbuf[i] == pattern_char(_off + i), "data mismatch at " << (_off + i));
+        }
+    }
+
+    frame::file::AsyncFile afile_;
+    const size_t           size_;
+    thread::id             reactor_thread_id_;
+};
+
+} //namespace
+
+// AsyncFile write, read, short read and end of file, completing on the reactor.
+// Usage: test_file_async [FILE_SIZE]
+int test_file_async(int argc, char* argv[])
+{
+    solid::log_start(std::cerr, {"solid::frame::file.*:EW", "test_file_async:VIEW"});
+
+    size_t file_size = 1000 * 1000;
+
+    if (argc > 1) {
+        file_size = atoi(argv[1]);
+    }
+
+    const std::string file_name = "/test_file_async_" + std::to_string(getpid()) + ".bin";
+    {
+        AioSchedulerT            aiosch;
+        SchedulerT               sch;
+        frame::Manager           m;
+        frame::ServiceT          svc{m};
+        frame::file::AsyncEngine engine;
+        ErrorConditionT          err;
+
+        solid_check(!sch.start(1), "Error starting scheduler");
+        solid_check(!aiosch.start(1), "Error starting aio scheduler");
+
+        frame::file::Utf8Configuration utf8cfg;
+        frame::file::TempConfiguration tempcfg;
+
+        utf8cfg.storagevec.push_back(frame::file::Utf8Configuration::Storage("/", "/tmp/"));
+
+        DynamicPointer<frame::file::Store<>> store_ptr(new frame::file::Store<>(m, utf8cfg, tempcfg));
+        {
+            SchedulerT::ObjectPointerT objptr(store_ptr);
+            solid_check(!sch.startObject(objptr, svc, make_event(GenericEvents::Start), err).isInvalid(), "Error starting file store: " << err.message());
+        }
+
+        store_ptr->requestCreateFile(
+            [](frame::file::Store<>&, frame::file::FilePointerT& _rptr, ErrorCodeT const& _rerr) {
+                solid_check(!_rerr && !_rptr.empty(), "Error creating file: " << _rerr.message());
+                lock_guard<mutex> lock(mtx);
+                file_ptr    = _rptr;
+                file_opened = true;
+                cnd.notify_one();
+            },
+            file_name, FileDevice::ReadWriteE);
+        {
+            unique_lock<mutex> lock(mtx);
+            solid_check(cnd.wait_for(lock, chrono::seconds(10), []() { return file_opened; }), "File not opened");
+        }
+
+        {
+            DynamicPointer<frame::aio::Object> objptr(new Object(engine, file_size));
+            solid_check(!aiosch.startObject(objptr, svc, make_event(GenericEvents::Start), err).isInvalid(), "Error starting object: " << err.message());
+        }
+
+        {
+            unique_lock<mutex> lock(mtx);
+            solid_check(cnd.wait_for(lock, chrono::seconds(100), []() { return done; }), "Process is taking too long.");
+        }
+        file_ptr.clear();
+        m.stop();
+        store_ptr.clear();
+    }
+    std::remove(("/tmp" + file_name).c_str());
+    return 0;
+}
@@ -0,0 +1,248 @@
+#include "solid/frame/manager.hpp"
+#include "solid/frame/reactor.hpp"
+#include "solid/frame/scheduler.hpp"
+#include "solid/frame/service.hpp"
+
+#include "solid/frame/file/filecache.hpp"
+#include "solid/frame/file/filestore.hpp"
+
+#include "solid/system/exception.hpp"
+#include "solid/system/log.hpp"
+
+#include "solid/utility/event.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <unistd.h>
+
+using namespace std;
+using namespace solid;
+
+using SchedulerT = frame::Scheduler<frame::Reactor>;
+
+namespace {
+const LoggerT logger("test_file_cache");
+
+constexpr size_t page_size       = 4096;
+constexpr size_t page_count      = 16;
+constexpr size_t race_page_count = 256; //more than the cache holds
+constexpr size_t race_read_count = 4; //pages per read
+
+inline char pattern_char(const size_t _pos)
+{
+    return static_cast<char>('a' + _pos % 26);
+}
+
+void create_file(const std::string& _path, const size_t _page_count = page_count)
+{
+    ofstream ofs(_path, ios::binary | ios::trunc);
+    for (size_t i = 0; i < page_size * _page_count; ++i) {
+        ofs.put(pattern_char(i));
+    }
+    solid_check(ofs.good(), "Error creating " << _path);
+}
+
+//a change not made through the store
+void external_write(const std::string& _path, const size_t _page, const char _c)
+{
+    fstream     fs(_path, ios::in | ios::out | ios::binary);
+    std::string data(page_size, _c);
+    fs.seekp(_page * page_size);
+    fs.write(data.data(), data.size());
+    solid_check(fs.good(), "Error writing " << _path);
+}
+
+frame::file::FilePointerT open_file(frame::file::Store<>& _rstore, const std::string& _name)
+{
+    mutex                     mtx;
+    condition_variable        cnd;
+    frame::file::FilePointerT file_ptr;
+    bool                      opened = false;
+
+    _rstore.requestOpenFile(
+        [&](frame::file::Store<>&, frame::file::FilePointerT& _rptr, ErrorCodeT const& _rerr) {
+            solid_check(!_rerr && !_rptr.empty(), "Error opening " << _name << ": " << _rerr.message());
+            lock_guard<mutex> lock(mtx);
+            file_ptr = _rptr;
+            opened   = true;
+            cnd.notify_one();
+        },
+        _name, FileDevice::ReadWriteE);
+
+    unique_lock<mutex> lock(mtx);
+    solid_check(cnd.wait_for(lock, chrono::seconds(10), [&opened]() { return opened; }), "File not opened: " << _name);
+    solid_check(file_ptr->cache() != nullptr, "File not attached to the cache: " << _name);
+    return file_ptr;
+}
+
+//reads a page through the cache and checks it is all _c or, for 0, the original pattern
+void check_page(frame::file::File& _rfile, const size_t _page, const char _c, const char* _what)
+{
+    char buf[page_size];
+
+    solid_check(_rfile.read(buf, page_size, _page * page_size) == static_cast<ssize_t>(page_size), _what << ": short read of page " << _page);
+
+    for (size_t i = 0; i < page_size; ++i) {
+        const char c = _c != 0 ? _c : pattern_char(_page * page_size + i);
+        solid_check(buf[i] == c, _what << ": page " << _page << " mismatch at " << i);
+    }
+}
+
+//the version of a race file page is written all over it
+uint64_t page_version(const char* _pdata)
+{
+    uint64_t v;
+    memcpy(&v, _pdata, sizeof(v));
+    return v;
+}
+
+//Scans the race file, missing the cache all the time, and reads every range
+//twice: the second read, mostly from the cache, must not see a version older
+//than the one written when the first read returned.
+void run_reader(frame::file::File& _rfile, const vector<atomic<uint64_t>>& _rversion_vec, const atomic<bool>& _rrunning)
+{
+    vector<char> buf(race_read_count * page_size);
+    uint64_t     min_version_arr[race_read_count];
+
+    while (_rrunning.load()) {
+        for (size_t first = 0; first < race_page_count; first += race_read_count) {
+            const int64_t off = first * page_size;
+
+            solid_check(_rfile.read(buf.data(), buf.size(), off) == static_cast<ssize_t>(buf.size()), "short concurrent read");
+
+            for (size_t i = 0; i < race_read_count; ++i) {
+                min_version_arr[i] = _rversion_vec[first + i].load();
+            }
+
+            solid_check(_rfile.read(buf.data(), buf.size(), off) == static_cast<ssize_t>(buf.size()), "short concurrent read");
+
+            for (size_t i = 0; i < race_read_count; ++i) {
+                const uint64_t v = page_version(buf.data() + i * page_size);
+                solid_check(v >= min_version_arr[i], "page " << (first + i) << " cached before its write: version " << v << " < " << min_version_arr[i]);
+            }
+        }
+    }
+}
+
+} //namespace
+
+// BlockCache hits and misses, the invalidation of the pages of all the
+// handles of a file on writes and the changes made by others, in the same
+// second and with the same size, seen on reopen - and writes racing with the
+// loads of another thread, which must not cache what they read before.
+// Usage: test_file_cache [WRITE_COUNT]
+int test_file_cache(int argc, char* argv[])
+{
+    solid::log_start(std::cerr, {"solid::frame::file.*:EW", "test_file_cache:VIEW"});
+
+    size_t write_count = 200000;
+
+    if (argc > 1) {
+        write_count = atoi(argv[1]);
+    }
+
+    const std::string name      = "/test_file_cache_" + std::to_string(getpid()) + ".bin";
+    const std::string link_name = "/test_file_cache_" + std::to_string(getpid()) + ".lnk";
+    const std::string path      = "/tmp" + name;
+    const std::string link_path = "/tmp" + link_name;
+    const std::string race_name = "/test_file_cache_" + std::to_string(getpid()) + ".race";
+    const std::string race_path = "/tmp" + race_name;
+
+    create_file(path);
+    create_file(race_path, race_page_count);
+    {
+        SchedulerT      sch;
+        frame::Manager  m;
+        frame::ServiceT svc{m};
+        ErrorConditionT err;
+
+        solid_check(!sch.start(1), "Error starting scheduler");
+
+        frame::file::Utf8Configuration utf8cfg;
+        frame::file::TempConfiguration tempcfg;
+
+        utf8cfg.storagevec.push_back(frame::file::Utf8Configuration::Storage("/", "/tmp/"));
+        utf8cfg.blockcacheptr = std::make_shared<frame::file::BlockCache>(frame::file::BlockCacheConfiguration(page_size, 64 * page_size, 4, 2));
+
+        DynamicPointer<frame::file::Store<>> store_ptr(new frame::file::Store<>(m, utf8cfg, tempcfg));
+        {
+            SchedulerT::ObjectPointerT objptr(store_ptr);
+            solid_check(!sch.startObject(objptr, svc, make_event(GenericEvents::Start), err).isInvalid(), "Error starting file store: " << err.message());
+        }
+
+        frame::file::FilePointerT a_ptr = open_file(*store_ptr, name);
+
+        check_page(*a_ptr, 0, 0, "first read");
+
+        //let the file system timestamps move on
+        this_thread::sleep_for(chrono::milliseconds(50));
+
+        external_write(path, 0, 'X');
+        external_write(path, 12, 'X');
+
+        check_page(*a_ptr, 0, 0, "cached page");
+        check_page(*a_ptr, 12, 'X', "not cached page");
+
+        //the store opens a path once - a hard link gives another handle
+        solid_check(::link(path.c_str(), link_path.c_str()) == 0, "Error linking " << link_path);
+
+        frame::file::FilePointerT b_ptr = open_file(*store_ptr, link_name);
+
+        check_page(*b_ptr, 0, 'X', "reopened file");
+
+        check_page(*a_ptr, 4, 0, "first handle");
+        check_page(*b_ptr, 4, 0, "second handle");
+
+        {
+            std::string data(page_size, 'Y');
+            solid_check(a_ptr->write(data.data(), data.size(), 4 * page_size) == static_cast<ssize_t>(page_size), "Error writing page 4");
+        }
+
+        check_page(*a_ptr, 4, 'Y', "writing handle");
+        check_page(*b_ptr, 4, 'Y', "other handle");
+
+        {
+            frame::file::FilePointerT race_ptr = open_file(*store_ptr, race_name);
+            vector<atomic<uint64_t>>  version_vec(race_page_count);
+            vector<char>              data(page_size);
+            atomic<bool>              running{true};
+
+            for (size_t i = 0; i < race_page_count; ++i) {
+                version_vec[i] = 0;
+            }
+
+            thread reader{[&race_ptr, &version_vec, &running]() { run_reader(*race_ptr, version_vec, running); }};
+
+            for (size_t i = 1; i <= write_count; ++i) {
+                const size_t page = (i * 7) % race_page_count;
+
+                for (size_t j = 0; j < page_size; j += sizeof(i)) {
+                    memcpy(data.data() + j, &i, sizeof(i));
+                }
+                solid_check(race_ptr->write(data.data(), data.size(), page * page_size) == static_cast<ssize_t>(page_size), "Error writing race page " << page);
+                version_vec[page] = i;
+            }
+            running = false;
+            reader.join();
+            race_ptr.clear();
+        }
+
+        a_ptr.clear();
+        b_ptr.clear();
+        m.stop();
+        store_ptr.clear();
+    }
+    std::remove(path.c_str());
+    std::remove(link_path.c_str());
+    std::remove(race_path.c_str());
+    return 0;
+}
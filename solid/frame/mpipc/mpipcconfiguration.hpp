@@ -21,7 +21,10 @@
 #include "solid/frame/scheduler.hpp"
 #include "solid/system/socketaddress.hpp"
 #include "solid/system/socketdevice.hpp"
+#include "solid/system/statistic.hpp"
 #include "solid/utility/function.hpp"
+#include <atomic>
+#include <memory>
 #include <vector>
 
 namespace solid {
@@ -36,7 +39,8 @@ struct ObjectProxy;
 namespace mpipc {
 
 enum struct ConnectionValues : size_t {
-    SocketEmplacementSize = 128
+    SocketEmplacementSize  = 128,
+    IdleRecvBufferCapacity = 32,
 };
 
 class Service;
@@ -100,6 +104,15 @@ using RecvBufferPointerT = std::shared_ptr<BufferBase>;
 
 RecvBufferPointerT make_recv_buffer(const size_t _cp);
 
+//! Returns the unix domain socket path of a "unix:" recipient name or listener address, nullptr otherwise
+/*!
+ * "unix:/run/app.sock" - file system socket
+ * "unix:@app" - abstract namespace socket (Linux only)
+ * With the default extract_recipient_name_fnc, the message url of a
+ * "unix:" recipient follows a "//" separator: "unix:/run/app.sock//msgurl".
+ */
+const char* unix_socket_path(const char* _name);
+
 struct RelayData {
     RecvBufferPointerT bufptr_;
     const char*        pdata_;
@@ -293,7 +306,7 @@ private:
     }
 };
 
-using AddressVectorT                            = std::vector<SocketAddressInet>;
+using AddressVectorT                            = std::vector<SocketAddress>;
 using ServerSetupSocketDeviceFunctionT          = solid_function_t(bool(SocketDevice&));
 using ClientSetupSocketDeviceFunctionT          = solid_function_t(bool(SocketDevice&));
 using ResolveCompleteFunctionT                  = solid_function_t(void(AddressVectorT&&));
@@ -330,6 +343,28 @@ struct ReaderConfiguration {
     UncompressFunctionT decompress_fnc;
 };
 
+//! Counters of the connections' writers
+/*!
+ * Only filled when given through WriterConfiguration::statistic_ptr.
+ * message_count_ / send_count_ is the average number of messages per send.
+ */
+struct WriterStatistic : solid::Statistic {
+    std::atomic<uint64_t> message_count_; //messages done serializing
+    std::atomic<uint64_t> send_count_; //buffers given to the socket
+    std::atomic<uint64_t> send_size_;
+    std::atomic<uint64_t> coalesce_count_; //sends delayed by the coalescing window
+    std::atomic<uint64_t> coalesce_timeout_count_; //delayed sends flushed by the window expiry
+    std::atomic<uint64_t> coalesce_size_count_; //delayed sends flushed by reaching coalesce_size
+    std::atomic<uint64_t> credit_wait_count_; //message bodies stopped waiting for credit from the peer
+    std::atomic<uint64_t> response_timeout_count_; //requests canceled by WriterConfiguration::response_timeout_milliseconds
+
+    WriterStatistic();
+
+    std::ostream& print(std::ostream& _ros) const override;
+};
+
+using WriterStatisticPointerT = std::shared_ptr<WriterStatistic>;
+
 struct WriterConfiguration {
     WriterConfiguration();
 
@@ -341,7 +376,34 @@ struct WriterConfiguration {
     size_t   container_size_limit;
     uint64_t stream_size_limit;
 
-    CompressFunctionT inplace_compress_fnc;
+    //! Small message coalescing - zero coalesce_window_microseconds disables it
+    /*!
+     * While less than coalesce_size bytes are ready to be sent, a connection
+     * holds them in its send buffer for at most coalesce_window_microseconds,
+     * and keeps writing the messages that arrive meanwhile after them. The
+     * held bytes are sent together when the window expires or when they reach
+     * coalesce_size - trading a bounded latency for fewer, fuller sends.
+     * coalesce_size is capped by half the connection send buffer capacity.
+     * NOTE: epoll waits in milliseconds, so the reactor polls through
+     * windows shorter than a millisecond.
+     */
+    size_t coalesce_window_microseconds;
+    size_t coalesce_size;
+
+    size_t stream_credit_window; //see Configuration::streamCreditWindow
+
+    //! Response deadline for requests - zero disables it
+    /*!
+     * A request whose response did not arrive within response_timeout_milliseconds
+     * from the moment it was fully written, completes with error_message_response_timeout.
+     * A connection keeps a single timer for the deadlines of all its requests.
+     * Like a canceled request, a timed out one keeps counting against
+     * max_message_count_response_wait until its late response arrives.
+     */
+    size_t response_timeout_milliseconds;
+
+    CompressFunctionT       inplace_compress_fnc;
+    WriterStatisticPointerT statistic_ptr;
 };
 
 struct Configuration {
@@ -412,6 +474,27 @@ public:
         return !isServer() && isClient();
     }
 
+    //! Credit based flow control for message bodies - zero (default) disables it
+    /*!
+     * Every message body the connection writes may have at most _sz bytes
+     * not yet consumed by the peer's reader. The peer grants credit back,
+     * with PacketHeader::CommandE::Update, as it consumes the body, so a
+     * large message is paced by its receiver without stopping the other
+     * messages multiplexed on the connection.
+     * The window goes with the header of every paced message, flagged by
+     * MessageFlagsE::CreditWindow, so only the sending peer needs it set.
+     * The headers of unpaced messages keep the format of the previous
+     * releases but a peer must be of this release to receive paced ones. It must hold at least two minimum packet data
+     * sizes of the protocol - Service::reconfigure fails otherwise.
+     * Bodies of relayed messages are paced by the relay buffer
+     * acknowledgements instead.
+     * See ConnectionContext::messageCredit.
+     */
+    void streamCreditWindow(const size_t _sz)
+    {
+        writer.stream_credit_window = _sz;
+    }
+
     void limitString(const size_t _sz)
     {
         reader.string_size_limit = _sz;
@@ -460,7 +543,8 @@ public:
         using ConnectionSecureHandshakeFunctionT = solid_function_t(void(ConnectionContext&));
 
         Server()
-            : listener_port(-1)
+            : listener_per_reactor(false)
+            , listener_port(-1)
         {
         }
 
@@ -478,6 +562,15 @@ public:
         std::string                        listener_address_str;
         std::string                        listener_service_str;
         Any<>                              secure_any;
+        //! One SO_REUSEPORT listener on every reactor of the scheduler
+        /*!
+         * The accepted connections run on the reactor of their listener.
+         * For a reactor bound to a CPU set (see Scheduler::start(CpuSetVectorT const&))
+         * the listener asks, through SO_INCOMING_CPU, for the connections
+         * received on the first CPU of the set, so that the NIC queue, the
+         * reactor and the connection buffers stay on the same NUMA node.
+         */
+        bool listener_per_reactor;
 
         int listenerPort() const
         {
@@ -508,6 +601,16 @@ public:
         ConnectionSecureHandshakeFunctionT connection_on_secure_handshake_fnc;
         ClientSetupSocketDeviceFunctionT   socket_device_setup_fnc;
         Any<>                              secure_any;
+        //! Delay before trying the next resolved address - zero disables it
+        /*!
+         * Happy eyeballs like connect: while a connection is still connecting
+         * after connection_hedge_delay_milliseconds, the rest of the resolved
+         * addresses are tried on another connection of the pool, without
+         * waiting for the first one to fail. The hedged connection counts
+         * against pool_max_pending_connection_count.
+         * With zero, the rest of the addresses are handed over right away.
+         */
+        uint32_t connection_hedge_delay_milliseconds;
 
     } client;
 
@@ -520,6 +623,8 @@ public:
     uint8_t                       connection_send_buffer_start_capacity_kb;
     uint8_t                       connection_send_buffer_max_capacity_kb;
     uint16_t                      connection_relay_buffer_count;
+    uint32_t                      connection_buffer_release_timeout_seconds; //release the buffers of a connection without message traffic for this many seconds (keepalives do not count); 0 disables
+    size_t                        connection_buffer_pool_max_count; //released buffers kept by the service for reuse
     ExtractRecipientNameFunctionT extract_recipient_name_fnc;
     ConnectionStopFunctionT       connection_stop_fnc;
     ConnectionOnEventFunctionT    connection_on_event_fnc;
@@ -555,6 +660,7 @@ private:
     }
 };
 
+//! Resolves "host:service" names and passes "unix:" names (see unix_socket_path) through as AF_UNIX addresses
 struct InternetResolverF {
     aio::Resolver&     rresolver;
     std::string        default_service;
@@ -178,6 +178,8 @@ struct MessageId {
     {
     }
 
+    MessageId& operator=(MessageId const& _rmsguid) = default;
+
     MessageId(RequestId const& _rrequid)
         : index(_rrequid.index)
         , unique(_rrequid.unique)
@@ -251,6 +253,8 @@ struct ConnectionContext {
         : rservice(_rccs.service(_rctx))
         , rconnection(_rccs.connection(_rctx))
         , message_flags(0)
+        , message_credit(InvalidSize())
+        , message_credit_window(0)
     {
     }
 
@@ -284,6 +288,17 @@ struct ConnectionContext {
         return message_id;
     }
 
+    //! Body bytes the message being serialized may still send before the peer grants more
+    /*!
+     * Only meaningful while serializing a message body on a connection
+     * with Configuration::streamCreditWindow - InvalidSize() otherwise.
+     * Lets the stream callbacks of large messages pace their sources.
+     */
+    size_t messageCredit() const
+    {
+        return message_credit;
+    }
+
     std::shared_ptr<Message> fetchRequest(Message const& _rmsg) const;
 
     //! Keep any connection data
@@ -318,6 +333,8 @@ private:
     RequestId      request_id;
     MessageId      message_id;
     std::string*   pmessage_url; //we cannot make it const - serializer constraint
+    size_t         message_credit;
+    uint32_t       message_credit_window;
 
     ConnectionContext(
         Service& _rsrv, Connection& _rcon)
@@ -326,6 +343,8 @@ private:
         , pmessage_header(nullptr)
         , message_flags(0)
         , pmessage_url(nullptr)
+        , message_credit(InvalidSize())
+        , message_credit_window(0)
     {
     }
 
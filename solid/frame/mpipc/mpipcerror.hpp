@@ -33,6 +33,7 @@ extern const ErrorConditionT error_connection_invalid_response_state;
 extern const ErrorConditionT error_message_canceled;
 extern const ErrorConditionT error_message_canceled_peer;
 extern const ErrorConditionT error_message_connection;
+extern const ErrorConditionT error_message_response_timeout;
 
 extern const ErrorConditionT error_reader_invalid_packet_header;
 extern const ErrorConditionT error_reader_invalid_message_switch;
@@ -62,6 +63,7 @@ extern const ErrorConditionT error_service_message_lost;
 extern const ErrorConditionT error_service_unknown_message;
 extern const ErrorConditionT error_service_invalid_url;
 extern const ErrorConditionT error_service_connection_not_needed;
+extern const ErrorConditionT error_service_invalid_credit_window;
 
 extern const ErrorConditionT error_compression_unavailable;
 extern const ErrorConditionT error_compression_engine;
@@ -37,8 +37,23 @@ struct MessageHeader {
         return _flags & state_flags;
     }
 
+    //the credit window goes on the wire only for paced bodies, flagged by
+    //MessageFlagsE::CreditWindow, so that unpaced headers keep the format
+    //of the peers not knowing about it
+    static MessageFlagsValueT wire_flags(ConnectionContext const& _rctx)
+    {
+        MessageFlagsT flags = _rctx.message_flags;
+        if (_rctx.message_credit_window != 0) {
+            flags.set(MessageFlagsE::CreditWindow);
+        } else {
+            flags.reset(MessageFlagsE::CreditWindow);
+        }
+        return flags.toUnderlyingType();
+    }
+
     MessageHeader()
         : flags_(0)
+        , credit_window_(0)
     {
     }
 
@@ -47,6 +62,7 @@ struct MessageHeader {
         : sender_request_id_(_rmsgh.sender_request_id_)
         , recipient_request_id_(_rmsgh.recipient_request_id_)
         , flags_(fetch_state_flags(_rmsgh.flags_).toUnderlyingType())
+        , credit_window_(0)
     {
     }
 
@@ -55,6 +71,7 @@ struct MessageHeader {
         sender_request_id_    = _umh.sender_request_id_;
         recipient_request_id_ = _umh.recipient_request_id_;
         flags_                = _umh.flags_;
+        credit_window_        = _umh.credit_window_;
         url_                  = std::move(_umh.url_);
         return *this;
     }
@@ -62,6 +79,7 @@ struct MessageHeader {
     RequestId   sender_request_id_;
     RequestId   recipient_request_id_;
     FlagsT      flags_;
+    uint32_t    credit_window_; //the sender's stream credit window - 0 when the body is not paced
     std::string url_;
 
     void clear()
@@ -69,7 +87,8 @@ struct MessageHeader {
         sender_request_id_.clear();
         recipient_request_id_.clear();
         url_.clear();
-        flags_ = 0;
+        flags_         = 0;
+        credit_window_ = 0;
     }
     template <class S>
     void solidSerializeV1(S& _rs, frame::mpipc::ConnectionContext& _rctx)
@@ -87,7 +106,10 @@ struct MessageHeader {
             _rs.pushCross(_rctx.request_id.unique, "sender_request_unique");
             solid_check(_rctx.pmessage_url, "message url must not be null");
             _rs.push(*_rctx.pmessage_url, "url");
-            uint64_t tmp = _rctx.message_flags.toUnderlyingType(); //not nice but safe - better solution in future versions
+            if (_rctx.message_credit_window != 0) {
+                _rs.pushCross(_rctx.message_credit_window, "credit_window");
+            }
+            uint64_t tmp = wire_flags(_rctx); //not nice but safe - better solution in future versions
             _rs.pushCross(tmp, "flags");
         } else {
 
@@ -98,6 +120,16 @@ struct MessageHeader {
             _rs.pushCross(sender_request_id_.unique, "sender_request_unique");
 
             _rs.push(url_, "url");
+            _rs.pushCall(
+                [this](S& _rs, frame::mpipc::ConnectionContext& /*_rctx*/, uint64_t /*_val*/, solid::ErrorConditionT& /*_rerr*/) {
+                    if (MessageFlagsT(flags_).has(MessageFlagsE::CreditWindow)) {
+                        _rs.pushCross(credit_window_, "credit_window");
+                    } else {
+                        credit_window_ = 0;
+                    }
+                },
+                0,
+                "credit_window");
             _rs.pushCross(flags_, "flags");
         }
     }
@@ -106,12 +138,15 @@ struct MessageHeader {
     void solidSerializeV2(S& _rs, frame::mpipc::ConnectionContext& _rctx, std::integral_constant<bool, true> _is_serializer, const char* _name)
     {
         solid_check(_rctx.pmessage_url, "message url must not be null");
-        const MessageFlagsValueT tmp = _rctx.message_flags.toUnderlyingType();
+        const MessageFlagsValueT tmp = wire_flags(_rctx);
         _rs.add(tmp, _rctx, "flags").add(*_rctx.pmessage_url, _rctx, "url");
         _rs.add(_rctx.request_id.index, _rctx, "sender_request_index");
         _rs.add(_rctx.request_id.unique, _rctx, "sender_request_unique");
         _rs.add(sender_request_id_.index, _rctx, "recipient_request_index");
         _rs.add(sender_request_id_.unique, _rctx, "recipient_request_unique");
+        if (_rctx.message_credit_window != 0) {
+            _rs.add(_rctx.message_credit_window, _rctx, "credit_window");
+        }
     }
 
     template <class S>
@@ -122,6 +157,14 @@ struct MessageHeader {
         _rs.add(sender_request_id_.unique, _rctx, "sender_request_unique");
         _rs.add(recipient_request_id_.index, _rctx, "recipient_request_index");
         _rs.add(recipient_request_id_.unique, _rctx, "recipient_request_unique");
+        _rs.add([this](S& _rs, frame::mpipc::ConnectionContext& _rctx, const char* /*_name*/) {
+            if (MessageFlagsT(flags_).has(MessageFlagsE::CreditWindow)) {
+                _rs.add(credit_window_, _rctx, "credit_window");
+            } else {
+                credit_window_ = 0;
+            }
+        },
+            _rctx, "credit_window");
     }
 
     template <class S>
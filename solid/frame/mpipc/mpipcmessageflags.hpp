@@ -30,6 +30,7 @@ enum struct MessageFlagsE : MessageFlagsValueT {
     OnPeer,
     BackOnSender,
     Relayed,
+    CreditWindow, //the header carries the sender's stream credit window
     LastFlag
 };
 
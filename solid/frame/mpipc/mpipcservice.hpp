@@ -41,6 +41,9 @@ struct Message;
 struct Configuration;
 class Connection;
 struct MessageBundle;
+struct MulticastBody;
+
+using MulticastBodyPointerT = std::shared_ptr<MulticastBody>;
 
 //! Inter Process Communication service
 /*!
@@ -143,6 +146,30 @@ public:
         MessageId&                _rmsg_id,
         const MessageFlagsT&      _flags = 0);
 
+    // send message to many recipients ----------------------------------------
+
+    //! Send the message to all the recipients, serializing its body only once
+    /*!
+     * The body is serialized lazily, one packet sized chunk at a time, by
+     * whichever connection gets first to a chunk - the others only copy it
+     * after their own message head - so the body serialization must not
+     * depend on the ConnectionContext.
+     * Only for one way messages - not for requests nor for responses.
+     * Returns the error of the first recipient that failed - the message
+     * still goes to all the others.
+     */
+    template <class T>
+    ErrorConditionT multicastMessage(
+        std::vector<RecipientId> const& _rrecipient_id_vec,
+        std::shared_ptr<T> const&       _rmsgptr,
+        const MessageFlagsT&            _flags = 0);
+
+    template <class T>
+    ErrorConditionT multicastMessage(
+        std::vector<std::string> const& _rrecipient_url_vec,
+        std::shared_ptr<T> const&       _rmsgptr,
+        const MessageFlagsT&            _flags = 0);
+
     // send request using recipient name --------------------------------------
 
     template <class T, class Fnc>
@@ -323,7 +350,7 @@ private:
 
     ErrorConditionT doStart();
 
-    void acceptIncomingConnection(SocketDevice& _rsd);
+    void acceptIncomingConnection(SocketDevice& _rsd, const size_t _reactor_index);
 
     ErrorConditionT activateConnection(ConnectionContext& _rconctx, ObjectIdT const& _robjui);
 
@@ -404,6 +431,12 @@ private:
 
     void rejectNewPoolMessage(Connection const& _rcon);
 
+    RecvBufferPointerT acquireRecvBuffer(const size_t _numa_node, uint8_t& _rbuffer_capacity_kb);
+    SendBufferPointerT acquireSendBuffer(const size_t _numa_node, uint8_t& _rbuffer_capacity_kb);
+
+    void releaseRecvBuffer(const size_t _numa_node, RecvBufferPointerT& _rbuf, const uint8_t _buffer_capacity_kb);
+    void releaseSendBuffer(const size_t _numa_node, SendBufferPointerT& _rbuf, const uint8_t _buffer_capacity_kb);
+
     bool fetchMessage(Connection& _rcon, ObjectIdT const& _robjuid, MessageId const& _rmsg_id);
 
     bool fetchCanceledMessage(Connection const& _rcon, MessageId const& _rmsg_id, MessageBundle& _rmsg_bundle);
@@ -428,32 +461,41 @@ private:
         MessageId const&        _rmsgid);
 
     ErrorConditionT doSendMessage(
-        const char*               _recipient_url,
-        const RecipientId&        _rrecipient_id_in,
-        MessagePointerT&          _rmsgptr,
-        MessageCompleteFunctionT& _rcomplete_fnc,
-        RecipientId*              _precipient_id_out,
-        MessageId*                _pmsg_id_out,
-        const MessageFlagsT&      _flags);
+        const char*                  _recipient_url,
+        const RecipientId&           _rrecipient_id_in,
+        MessagePointerT&             _rmsgptr,
+        MessageCompleteFunctionT&    _rcomplete_fnc,
+        RecipientId*                 _precipient_id_out,
+        MessageId*                   _pmsg_id_out,
+        const MessageFlagsT&         _flags,
+        const MulticastBodyPointerT& _rmulticast_body_ptr = MulticastBodyPointerT());
 
     ErrorConditionT doSendMessageToNewPool(
-        const char*               _recipient_url,
-        MessagePointerT&          _rmsgptr,
-        const size_t              _msg_type_idx,
-        MessageCompleteFunctionT& _rcomplete_fnc,
-        RecipientId*              _precipient_id_out,
-        MessageId*                _pmsguid_out,
-        const MessageFlagsT&      _flags,
-        std::string&              _msg_url);
+        const char*                  _recipient_url,
+        MessagePointerT&             _rmsgptr,
+        const size_t                 _msg_type_idx,
+        MessageCompleteFunctionT&    _rcomplete_fnc,
+        RecipientId*                 _precipient_id_out,
+        MessageId*                   _pmsguid_out,
+        const MessageFlagsT&         _flags,
+        std::string&                 _msg_url,
+        const MulticastBodyPointerT& _rmulticast_body_ptr);
 
     ErrorConditionT doSendMessageToConnection(
-        const RecipientId&        _rrecipient_id_in,
-        MessagePointerT&          _rmsgptr,
-        const size_t              _msg_type_idx,
-        MessageCompleteFunctionT& _rcomplete_fnc,
-        MessageId*                _pmsg_id_out,
-        const MessageFlagsT&      _flags,
-        std::string&              _msg_url);
+        const RecipientId&           _rrecipient_id_in,
+        MessagePointerT&             _rmsgptr,
+        const size_t                 _msg_type_idx,
+        MessageCompleteFunctionT&    _rcomplete_fnc,
+        MessageId*                   _pmsg_id_out,
+        const MessageFlagsT&         _flags,
+        std::string&                 _msg_url,
+        const MulticastBodyPointerT& _rmulticast_body_ptr);
+
+    ErrorConditionT doMulticastMessage(
+        std::vector<RecipientId> const* _precipient_id_vec,
+        std::vector<std::string> const* _precipient_url_vec,
+        MessagePointerT const&          _rmsgptr,
+        const MessageFlagsT&            _flags);
 
     bool doTryCreateNewConnectionForPool(const size_t _pool_index, ErrorConditionT& _rerror);
 
@@ -555,6 +597,26 @@ ErrorConditionT Service::sendMessage(
     return doSendMessage(nullptr, _rrecipient_id, msgptr, complete_handler, nullptr, &_rmsg_id, _flags);
 }
 //-------------------------------------------------------------------------
+template <class T>
+ErrorConditionT Service::multicastMessage(
+    std::vector<RecipientId> const& _rrecipient_id_vec,
+    std::shared_ptr<T> const&       _rmsgptr,
+    const MessageFlagsT&            _flags)
+{
+    MessagePointerT msgptr(std::static_pointer_cast<Message>(_rmsgptr));
+    return doMulticastMessage(&_rrecipient_id_vec, nullptr, msgptr, _flags);
+}
+//-------------------------------------------------------------------------
+template <class T>
+ErrorConditionT Service::multicastMessage(
+    std::vector<std::string> const& _rrecipient_url_vec,
+    std::shared_ptr<T> const&       _rmsgptr,
+    const MessageFlagsT&            _flags)
+{
+    MessagePointerT msgptr(std::static_pointer_cast<Message>(_rmsgptr));
+    return doMulticastMessage(nullptr, &_rrecipient_url_vec, msgptr, _flags);
+}
+//-------------------------------------------------------------------------
 // send request using recipient name --------------------------------------
 template <class T, class Fnc>
 ErrorConditionT Service::sendRequest(
@@ -63,7 +63,7 @@ public:
     virtual bool hasValidSocket() const = 0;
 
     virtual bool connect(
-        frame::aio::ReactorContext& _rctx, OnConnectF _pf, const SocketAddressInet& _raddr)
+        frame::aio::ReactorContext& _rctx, OnConnectF _pf, const SocketAddress& _raddr)
         = 0;
 
     virtual bool recvSome(
@@ -72,6 +72,10 @@ public:
 
     virtual bool hasPendingSend() const = 0;
 
+    //Replaces the buffer of the pending recv - used for releasing the
+    //connection buffers while idle. Stubs not supporting it return false.
+    virtual bool resetRecvBuffer(char* _pbuf, size_t _bufcp);
+
     virtual bool sendAll(
         frame::aio::ReactorContext& _rctx, OnSendF _pf, char* _buf, size_t _bufcp)
         = 0;
@@ -85,8 +89,13 @@ public:
     virtual bool secureConnect(
         frame::aio::ReactorContext& _rctx, ConnectionContext& _rconctx, OnSecureConnectF _pf, ErrorConditionT& _rerror);
 
+    //Called on the connection's reactor for the event sent with secureResumeEvent()
+    virtual void secureResume(frame::aio::ReactorContext& _rctx);
+
 protected:
     static ConnectionProxy connectionProxy();
+    //Event to notify the connection with when a handshake step ran off the reactor is done
+    static Event secureResumeEvent();
 };
 
 typedef void (*SocketStubDeleteF)(SocketStub*);
@@ -21,6 +21,7 @@
 
 #include "solid/utility/any.hpp"
 #include "solid/utility/event.hpp"
+#include "solid/utility/workpool.hpp"
 
 #include "solid/frame/aio/aiostream.hpp"
 
@@ -36,10 +37,11 @@ namespace openssl {
 using ContextT      = frame::aio::openssl::Context;
 using StreamSocketT = frame::aio::Stream<frame::aio::openssl::Socket>;
 
-using ConnectionPrepareServerFunctionT = solid_function_t(unsigned long(frame::aio::ReactorContext&, ConnectionContext&, StreamSocketT&, ErrorConditionT&));
-using ConnectionPrepareClientFunctionT = solid_function_t(unsigned long(frame::aio::ReactorContext&, ConnectionContext&, StreamSocketT&, ErrorConditionT&));
-using ConnectionServerVerifyFunctionT  = solid_function_t(bool(frame::aio::ReactorContext&, ConnectionContext&, StreamSocketT&, bool, frame::aio::openssl::VerifyContext&));
-using ConnectionClientVerifyFunctionT  = solid_function_t(bool(frame::aio::ReactorContext&, ConnectionContext&, StreamSocketT&, bool, frame::aio::openssl::VerifyContext&));
+using ConnectionPrepareServerFunctionT    = solid_function_t(unsigned long(frame::aio::ReactorContext&, ConnectionContext&, StreamSocketT&, ErrorConditionT&));
+using ConnectionPrepareClientFunctionT    = solid_function_t(unsigned long(frame::aio::ReactorContext&, ConnectionContext&, StreamSocketT&, ErrorConditionT&));
+using ConnectionServerVerifyFunctionT     = solid_function_t(bool(frame::aio::ReactorContext&, ConnectionContext&, StreamSocketT&, bool, frame::aio::openssl::VerifyContext&));
+using ConnectionClientVerifyFunctionT     = solid_function_t(bool(frame::aio::ReactorContext&, ConnectionContext&, StreamSocketT&, bool, frame::aio::openssl::VerifyContext&));
+using ConnectionHandshakeOffloadFunctionT = frame::aio::openssl::Socket::HandshakeOffloadFunctionT;
 
 struct ClientConfiguration {
     ClientConfiguration()
@@ -61,8 +63,11 @@ struct ServerConfiguration {
 
     ContextT context;
 
-    ConnectionPrepareServerFunctionT connection_prepare_secure_fnc;
-    ConnectionServerVerifyFunctionT  connection_verify_fnc;
+    ConnectionPrepareServerFunctionT    connection_prepare_secure_fnc;
+    ConnectionServerVerifyFunctionT     connection_verify_fnc;
+    //when set, the handshake step with the private key operation runs on the thread
+    //the function hands the job to, not on the connection's reactor
+    ConnectionHandshakeOffloadFunctionT connection_handshake_offload_fnc;
 };
 
 class SocketStub final : public mpipc::SocketStub {
@@ -155,7 +160,7 @@ private:
     }
 
     bool connect(
-        frame::aio::ReactorContext& _rctx, OnConnectF _pf, const SocketAddressInet& _raddr) override final
+        frame::aio::ReactorContext& _rctx, OnConnectF _pf, const SocketAddress& _raddr) override final
     {
         return sock.connect(_rctx, _raddr, _pf);
     }
@@ -171,6 +176,11 @@ private:
         return sock.hasPendingSend();
     }
 
+    bool resetRecvBuffer(char* _pbuf, size_t _bufcp) override final
+    {
+        return sock.resetRecvBuffer(_pbuf, _bufcp);
+    }
+
     bool sendAll(
         frame::aio::ReactorContext& _rctx, OnSendF _pf, char* _buf, size_t _bufcp) override final
     {
@@ -200,9 +210,25 @@ private:
 
         sock.secureSetVerifyCallback(_rctx, verify_mode, lambda);
 
+        if (!solid_function_empty(rconfig.connection_handshake_offload_fnc)) {
+            Manager&        rmanager = rservice.manager();
+            const ObjectIdT conid    = _rconctx.connectionId();
+
+            sock.socket().setHandshakeOffload(
+                rconfig.connection_handshake_offload_fnc,
+                [&rmanager, conid]() {
+                    rmanager.notify(conid, secureResumeEvent());
+                });
+        }
+
         return sock.secureAccept(_rctx, _pf);
     }
 
+    void secureResume(frame::aio::ReactorContext& _rctx) override final
+    {
+        sock.secureResume(_rctx);
+    }
+
     bool secureConnect(
         frame::aio::ReactorContext& _rctx, ConnectionContext& _rconctx, OnSecureConnectF _pf, ErrorConditionT& _rerror) override final
     {
@@ -221,6 +247,9 @@ private:
 
         sock.secureSetVerifyCallback(_rctx, verify_mode, lambda);
 
+        //resume the session of the pool, if the context caches sessions
+        sock.secureSetSessionKey(_rctx, _rconctx.recipientName());
+
         return sock.secureConnect(_rctx, _pf);
     }
 
@@ -261,6 +290,25 @@ namespace impl {
 
 } //namespace impl
 
+//! Rotate the key encrypting the TLS session tickets issued by the server side of a service.
+//! Call aio::openssl::Context::rotateSessionTicketKey from the context setup function first.
+inline ErrorCodeT rotate_session_ticket_key(mpipc::Configuration const& _rcfg)
+{
+    return _rcfg.server.secure_any.constCast<ServerConfiguration>()->context.rotateSessionTicketKey();
+}
+
+//! Run the costly server handshake steps of a service on a work pool, keeping its reactors
+//! responsive while many clients connect at once. Call it after setup_server.
+//! The work pool must outlive the service.
+inline void setup_server_handshake_offload(mpipc::Configuration& _rcfg, FunctionWorkPool& _rfwp)
+{
+    ServerConfiguration& rsecure_cfg = *_rcfg.server.secure_any.cast<ServerConfiguration>();
+
+    rsecure_cfg.connection_handshake_offload_fnc = [&_rfwp](frame::aio::openssl::Socket::HandshakeJobT&& _ujob) {
+        _rfwp.push(std::move(_ujob));
+    };
+}
+
 inline unsigned long basic_secure_start(
     frame::aio::ReactorContext& _rctx, ConnectionContext& _rconctx, StreamSocketT& _rsock, ErrorConditionT& _rerr)
 {
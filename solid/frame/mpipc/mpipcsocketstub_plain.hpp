@@ -111,7 +111,7 @@ private:
     }
 
     bool connect(
-        frame::aio::ReactorContext& _rctx, OnConnectF _pf, const SocketAddressInet& _raddr) override final
+        frame::aio::ReactorContext& _rctx, OnConnectF _pf, const SocketAddress& _raddr) override final
     {
         return sock.connect(_rctx, _raddr, _pf);
     }
@@ -127,6 +127,11 @@ private:
         return sock.hasPendingSend();
     }
 
+    bool resetRecvBuffer(char* _pbuf, size_t _bufcp) override final
+    {
+        return sock.resetRecvBuffer(_pbuf, _bufcp);
+    }
+
     bool sendAll(
         frame::aio::ReactorContext& _rctx, OnSendF _pf, char* _buf, size_t _bufcp) override final
     {
@@ -0,0 +1,197 @@
+// solid/frame/mpipc/mpipcsocketstub_shm.hpp
+//
+// Copyright (c) 2018 Valentin Palade (vipalade @ gmail . com)
+//
+// This file is part of SolidFrame framework.
+//
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt.
+//
+
+#pragma once
+
+#include "solid/system/socketdevice.hpp"
+
+#include "solid/utility/event.hpp"
+
+#include "solid/frame/aio/aioshmsocket.hpp"
+#include "solid/frame/aio/aiostream.hpp"
+#include "solid/frame/mpipc/mpipcconfiguration.hpp"
+#include "solid/frame/mpipc/mpipcsocketstub.hpp"
+
+namespace solid {
+namespace frame {
+namespace mpipc {
+namespace shm {
+
+using ContextT = frame::aio::shm::Context;
+
+//! Socket stub for peers on the same host, the bytes go through shared memory rings
+/*!
+    Both peers must use it - see setup_client and setup_server - usually
+    over "unix:" addresses. MessageWriter and MessageReader are the same,
+    only the byte transport differs. See frame::aio::shm::Socket.
+*/
+class SocketStub final : public mpipc::SocketStub {
+public:
+    SocketStub(frame::aio::ObjectProxy const& _rproxy, ContextT const& _rctx)
+        : sock(_rproxy, _rctx)
+    {
+    }
+    SocketStub(frame::aio::ObjectProxy const& _rproxy, SocketDevice&& _usd, ContextT const& _rctx)
+        : sock(_rproxy, std::move(_usd), _rctx)
+    {
+    }
+
+private:
+    ~SocketStub()
+    {
+    }
+
+    SocketDevice const& device() const override final
+    {
+        return sock.device();
+    }
+
+    SocketDevice& device() override final
+    {
+        return sock.device();
+    }
+
+    bool postSendAll(
+        frame::aio::ReactorContext& _rctx, OnSendAllRawF _pf, const char* _pbuf, size_t _bufcp, Event& _revent) override final
+    {
+        struct Closure {
+            OnSendAllRawF pf;
+            Event         event;
+
+            Closure(OnSendAllRawF _pf, Event const& _revent)
+                : pf(_pf)
+                , event(_revent)
+            {
+            }
+
+            void operator()(frame::aio::ReactorContext& _rctx)
+            {
+                (*pf)(_rctx, event);
+            }
+
+        } lambda(_pf, _revent);
+
+        return sock.postSendAll(_rctx, _pbuf, _bufcp, lambda);
+    }
+
+    bool postRecvSome(
+        frame::aio::ReactorContext& _rctx, OnRecvF _pf, char* _pbuf, size_t _bufcp) override final
+    {
+        return sock.postRecvSome(_rctx, _pbuf, _bufcp, _pf);
+    }
+
+    bool postRecvSome(
+        frame::aio::ReactorContext& _rctx, OnRecvSomeRawF _pf, char* _pbuf, size_t _bufcp, Event& _revent) override final
+    {
+        struct Closure {
+            OnRecvSomeRawF pf;
+            Event          event;
+
+            Closure(OnRecvSomeRawF _pf, Event const& _revent)
+                : pf(_pf)
+                , event(_revent)
+            {
+            }
+
+            void operator()(frame::aio::ReactorContext& _rctx, size_t _sz)
+            {
+                (*pf)(_rctx, _sz, event);
+            }
+
+        } lambda(_pf, _revent);
+
+        return sock.postRecvSome(_rctx, _pbuf, _bufcp, lambda);
+    }
+
+    bool hasValidSocket() const override final
+    {
+        return static_cast<bool>(sock.device());
+    }
+
+    bool connect(
+        frame::aio::ReactorContext& _rctx, OnConnectF _pf, const SocketAddress& _raddr) override final
+    {
+        return sock.connect(_rctx, _raddr, _pf);
+    }
+
+    bool recvSome(
+        frame::aio::ReactorContext& _rctx, OnRecvF _pf, char* _buf, size_t _bufcp, size_t& _sz) override final
+    {
+        return sock.recvSome(_rctx, _buf, _bufcp, _pf, _sz);
+    }
+
+    bool hasPendingSend() const override final
+    {
+        return sock.hasPendingSend();
+    }
+
+    bool resetRecvBuffer(char* _pbuf, size_t _bufcp) override final
+    {
+        return sock.resetRecvBuffer(_pbuf, _bufcp);
+    }
+
+    bool sendAll(
+        frame::aio::ReactorContext& _rctx, OnSendF _pf, char* _buf, size_t _bufcp) override final
+    {
+        return sock.sendAll(_rctx, _buf, _bufcp, _pf);
+    }
+
+    void prepareSocket(
+        frame::aio::ReactorContext& _rctx) override final
+    {
+    }
+
+private:
+    using StreamSocketT = frame::aio::Stream<frame::aio::shm::Socket>;
+
+    StreamSocketT sock;
+};
+
+struct CreateClientSocketF {
+    ContextT context;
+
+    SocketStubPtrT operator()(Configuration const& /*_rcfg*/, frame::aio::ObjectProxy const& _rproxy, char* _emplace_buf) const
+    {
+        if (sizeof(SocketStub) > static_cast<size_t>(ConnectionValues::SocketEmplacementSize)) {
+            return SocketStubPtrT(new SocketStub(_rproxy, context), SocketStub::delete_deleter);
+        } else {
+            return SocketStubPtrT(new (_emplace_buf) SocketStub(_rproxy, context), SocketStub::emplace_deleter);
+        }
+    }
+};
+
+struct CreateServerSocketF {
+    ContextT context;
+
+    SocketStubPtrT operator()(Configuration const& /*_rcfg*/, frame::aio::ObjectProxy const& _rproxy, SocketDevice&& _usd, char* _emplace_buf) const
+    {
+        if (sizeof(SocketStub) > static_cast<size_t>(ConnectionValues::SocketEmplacementSize)) {
+            return SocketStubPtrT(new SocketStub(_rproxy, std::move(_usd), context), SocketStub::delete_deleter);
+        } else {
+            return SocketStubPtrT(new (_emplace_buf) SocketStub(_rproxy, std::move(_usd), context), SocketStub::emplace_deleter);
+        }
+    }
+};
+
+//! The connecting side creates the rings, so the client context decides their capacity
+inline void setup_client(mpipc::Configuration& _rcfg, ContextT const& _rctx = ContextT())
+{
+    _rcfg.client.connection_create_socket_fnc = CreateClientSocketF{_rctx};
+}
+
+inline void setup_server(mpipc::Configuration& _rcfg, ContextT const& _rctx = ContextT())
+{
+    _rcfg.server.connection_create_socket_fnc = CreateServerSocketF{_rctx};
+}
+
+} //namespace shm
+} //namespace mpipc
+} //namespace frame
+} //namespace solid
@@ -16,6 +16,7 @@
 #include "solid/system/memory.hpp"
 
 #include <cstring>
+#include <limits>
 
 namespace solid {
 namespace frame {
@@ -50,6 +51,17 @@ RecvBufferPointerT make_recv_buffer(const size_t _cp)
     }
 }
 
+const char* unix_socket_path(const char* _name)
+{
+    static constexpr char   scheme[]  = "unix:";
+    static constexpr size_t scheme_sz = sizeof(scheme) - 1;
+
+    if (_name != nullptr && strncmp(_name, scheme, scheme_sz) == 0) {
+        return _name + scheme_sz;
+    }
+    return nullptr;
+}
+
 namespace {
 RecvBufferPointerT default_allocate_recv_buffer(const uint32_t _cp)
 {
@@ -98,6 +110,18 @@ const char* default_extract_recipient_name(const char* _purl, std::string& _msgu
         return nullptr;
     }
 
+    if (unix_socket_path(_purl) != nullptr) {
+        //the socket path contains '/'
+        const char* p = strstr(_purl, "//");
+
+        if (p == nullptr) {
+            return _purl;
+        }
+        _msgurl = (p + 2);
+        _tmpstr.assign(_purl, p - _purl);
+        return _tmpstr.c_str();
+    }
+
     const char* p = strchr(_purl, '/');
 
     if (p == nullptr) {
@@ -144,9 +168,41 @@ WriterConfiguration::WriterConfiguration()
     stream_size_limit    = InvalidSize();
     container_size_limit = InvalidSize();
 
+    coalesce_window_microseconds = 0;
+    coalesce_size                = 16 * 1024;
+
+    stream_credit_window = 0;
+
+    response_timeout_milliseconds = 0;
+
     inplace_compress_fnc = &default_compress;
 }
 //-----------------------------------------------------------------------------
+WriterStatistic::WriterStatistic()
+    : message_count_(0)
+    , send_count_(0)
+    , send_size_(0)
+    , coalesce_count_(0)
+    , coalesce_timeout_count_(0)
+    , coalesce_size_count_(0)
+    , credit_wait_count_(0)
+    , response_timeout_count_(0)
+{
+}
+//-----------------------------------------------------------------------------
+std::ostream& WriterStatistic::print(std::ostream& _ros) const
+{
+    _ros << " message_count_ = " << message_count_;
+    _ros << " send_count_ = " << send_count_;
+    _ros << " send_size_ = " << send_size_;
+    _ros << " coalesce_count_ = " << coalesce_count_;
+    _ros << " coalesce_timeout_count_ = " << coalesce_timeout_count_;
+    _ros << " coalesce_size_count_ = " << coalesce_size_count_;
+    _ros << " credit_wait_count_ = " << credit_wait_count_;
+    _ros << " response_timeout_count_ = " << response_timeout_count_;
+    return _ros;
+}
+//-----------------------------------------------------------------------------
 //-----------------------------------------------------------------------------
 /*static*/ RelayEngine& RelayEngine::instance()
 {
@@ -241,6 +297,9 @@ void Configuration::init()
 
     connection_relay_buffer_count = 8;
 
+    connection_buffer_release_timeout_seconds = 0;
+    connection_buffer_pool_max_count          = 1024;
+
     connection_inactivity_keepalive_count = 2;
 
     server.connection_start_state  = ConnectionState::Passive;
@@ -249,6 +308,8 @@ void Configuration::init()
     client.connection_start_state  = ConnectionState::Passive;
     client.connection_start_secure = true;
 
+    client.connection_hedge_delay_milliseconds = 0;
+
     connection_recv_buffer_allocate_fnc = &default_allocate_recv_buffer;
     connection_send_buffer_allocate_fnc = &default_allocate_send_buffer;
 
@@ -298,7 +359,14 @@ size_t Configuration::connectionReconnectTimeoutSeconds(
 //-----------------------------------------------------------------------------
 ErrorConditionT Configuration::check() const
 {
-    //TODO:
+    if (writer.stream_credit_window != 0) {
+        //the writer waits for credit below a minimum packet data size and
+        //the reader grants it back at half the window
+        if (writer.stream_credit_window < 2 * protocol().minimumFreePacketDataSize() || writer.stream_credit_window > std::numeric_limits<uint32_t>::max()) {
+            return error_service_invalid_credit_window;
+        }
+    }
+    //TODO: more checks
     return ErrorConditionT();
 }
 //-----------------------------------------------------------------------------
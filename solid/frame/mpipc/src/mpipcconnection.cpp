@@ -31,6 +31,7 @@ enum class ConnectionEvents {
     EnterActive,
     EnterPassive,
     StartSecure,
+    SecureResume,
     SendRaw,
     RecvRaw,
     Stopping,
@@ -63,6 +64,8 @@ const EventCategory<ConnectionEvents> connection_event_category{
             return "EnterPassive";
         case ConnectionEvents::StartSecure:
             return "StartSecure";
+        case ConnectionEvents::SecureResume:
+            return "SecureResume";
         case ConnectionEvents::SendRaw:
             return "SendRaw";
         case ConnectionEvents::RecvRaw:
@@ -260,6 +263,9 @@ Connection::Connection(
     : pool_id_(_rpool_id)
     , rpool_name_(_rpool_name)
     , timer_(this->proxy())
+    , idle_timer_(this->proxy())
+    , coalesce_timer_(this->proxy())
+    , response_timer_(this->proxy())
     , flags_(0)
     , recv_buf_off_(0)
     , cons_buf_off_(0)
@@ -267,6 +273,7 @@ Connection::Connection(
     , recv_buf_count_(0)
     , recv_buf_(nullptr)
     , send_buf_(nullptr)
+    , send_hold_size_(0)
     , send_relay_free_count_(static_cast<uint8_t>(_rconfiguration.connection_relay_buffer_count))
     , ackd_buf_count_(0)
     , recv_buf_cp_kb_(0)
@@ -285,6 +292,9 @@ Connection::Connection(
     : pool_id_(_rpool_id)
     , rpool_name_(_rpool_name)
     , timer_(this->proxy())
+    , idle_timer_(this->proxy())
+    , coalesce_timer_(this->proxy())
+    , response_timer_(this->proxy())
     , flags_(0)
     , recv_buf_off_(0)
     , cons_buf_off_(0)
@@ -292,6 +302,7 @@ Connection::Connection(
     , recv_buf_count_(0)
     , recv_buf_(nullptr)
     , send_buf_(nullptr)
+    , send_hold_size_(0)
     , send_relay_free_count_(static_cast<uint8_t>(_rconfiguration.connection_relay_buffer_count))
     , ackd_buf_count_(0)
     , recv_buf_cp_kb_(0)
@@ -489,6 +500,9 @@ void Connection::doStop(frame::aio::ReactorContext& _rctx, const ErrorConditionT
 
         flags_.set(FlagsE::Stopping);
 
+        //the connect failed before the hedge delay
+        doForwardHedgeAddresses(_rctx);
+
         ConnectionContext conctx(service(_rctx), *this);
         ErrorConditionT   tmp_error(error());
         ObjectIdT         objuid(uid(_rctx));
@@ -770,6 +784,10 @@ void Connection::onStopped(
                     [](Event& _revt, Connection& _rcon, frame::aio::ReactorContext& _rctx) {
                         _rcon.doHandleEventStartSecure(_rctx, _revt);
                     }},
+                {connection_event_category.event(ConnectionEvents::SecureResume),
+                    [](Event& _revt, Connection& _rcon, frame::aio::ReactorContext& _rctx) {
+                        _rcon.sock_ptr_->secureResume(_rctx);
+                    }},
                 {connection_event_category.event(ConnectionEvents::SendRaw),
                     [](Event& _revt, Connection& _rcon, frame::aio::ReactorContext& _rctx) {
                         _rcon.doHandleEventSendRaw(_rctx, _revt);
@@ -837,14 +855,23 @@ void Connection::doHandleEventResolve(
                 solid_dbg(logger, Info, this << ' ' << this->id() << " Connect to " << presolvemsg->currentAddress());
 
                 //initiate connect:
+                const bool connecting = !this->connect(_rctx, presolvemsg->currentAddress());
 
-                if (this->connect(_rctx, presolvemsg->currentAddress())) {
+                if (!connecting) {
                     onConnect(_rctx);
                 }
 
                 presolvemsg->popAddress();
 
-                service(_rctx).forwardResolveMessage(poolId(), _revent);
+                const uint32_t hedge_delay = service(_rctx).configuration().client.connection_hedge_delay_milliseconds;
+
+                if (connecting && hedge_delay != 0 && !presolvemsg->empty()) {
+                    //try the rest of the addresses only if this connect takes too long
+                    hedge_addr_vec_ = std::move(presolvemsg->addrvec);
+                    timer_.waitFor(_rctx, std::chrono::milliseconds(hedge_delay), onTimerHedge);
+                } else {
+                    service(_rctx).forwardResolveMessage(poolId(), _revent);
+                }
             } else {
                 solid_dbg(logger, Warning, this << ' ' << this->id() << " Empty resolve message");
                 doStop(_rctx, error_connection_resolve);
@@ -855,6 +882,31 @@ void Connection::doHandleEventResolve(
     }
 }
 //-----------------------------------------------------------------------------
+void Connection::doForwardHedgeAddresses(frame::aio::ReactorContext& _rctx)
+{
+    if (!hedge_addr_vec_.empty()) {
+        Event event = Connection::eventResolve();
+
+        event.any() = ResolveMessage(std::move(hedge_addr_vec_));
+        hedge_addr_vec_.clear();
+
+        service(_rctx).forwardResolveMessage(poolId(), event);
+    }
+}
+//-----------------------------------------------------------------------------
+/*static*/ void Connection::onTimerHedge(frame::aio::ReactorContext& _rctx)
+{
+    Connection& rthis = static_cast<Connection&>(_rctx.object());
+
+    if (rthis.isStopping()) {
+        return;
+    }
+
+    solid_dbg(logger, Info, &rthis << ' ' << rthis.id() << " still connecting - try the other " << rthis.hedge_addr_vec_.size() << " addresses");
+
+    rthis.doForwardHedgeAddresses(_rctx);
+}
+//-----------------------------------------------------------------------------
 bool Connection::willAcceptNewMessage(frame::aio::ReactorContext& /*_rctx*/) const
 {
     return !isStopping() /* && waiting_message_vec.empty() && msg_writer.willAcceptNewMessage(service(_rctx).configuration().writer)*/;
@@ -1194,6 +1246,9 @@ void Connection::doHandleEventSendRaw(frame::aio::ReactorContext& _rctx, Event&
 
         solid_dbg(logger, Info, this << " datasize = " << pdata->data.size());
 
+        doAcquireBuffers(_rctx);
+        doMarkMessageActivity();
+
         size_t tocopy = this->sendBufferCapacity();
 
         if (tocopy > pdata->data.size()) {
@@ -1228,6 +1283,9 @@ void Connection::doHandleEventRecvRaw(frame::aio::ReactorContext& _rctx, Event&
     solid_dbg(logger, Info, this);
 
     if (this->isRawState() && pdata != nullptr) {
+        doAcquireBuffers(_rctx);
+        doMarkMessageActivity();
+
         if (recv_buf_off_ == cons_buf_off_) {
             if (this->postRecvSome(_rctx, recv_buf_->data(), this->recvBufferCapacity(), _revent)) {
 
@@ -1311,6 +1369,8 @@ void Connection::doResetTimerStart(frame::aio::ReactorContext& _rctx)
             timer_.waitFor(_rctx, std::chrono::seconds(config.connection_keepalive_timeout_seconds), onTimerKeepalive);
         }
     }
+
+    doResetTimerIdle(_rctx);
 }
 //-----------------------------------------------------------------------------
 void Connection::doResetTimerSend(frame::aio::ReactorContext& _rctx)
@@ -1352,6 +1412,193 @@ void Connection::doResetTimerRecv(frame::aio::ReactorContext& _rctx)
     }
 }
 //-----------------------------------------------------------------------------
+// Returns true when the bytes in send_buf_ are held for the coalescing window.
+// Otherwise _rbuffer is set to all the bytes to be sent, the held ones included.
+bool Connection::doCoalesceSend(
+    frame::aio::ReactorContext& _rctx, WriterConfiguration const& _rconfig,
+    WriteBuffer& _rbuffer, const bool _can_hold)
+{
+    const size_t hold_size = send_hold_size_ + _rbuffer.size();
+
+    if (_rconfig.coalesce_window_microseconds == 0 || hold_size == 0) {
+        return false;
+    }
+
+    //keep at least half the buffer for the next writes
+    if (
+        _can_hold && !flags_.has(FlagsE::CoalesceFlush) && hold_size < _rconfig.coalesce_size && hold_size < (sendBufferCapacity() / 2)) {
+        if (send_hold_size_ == 0) {
+            solid_dbg(logger, Verbose, this << ' ' << this->id() << " hold " << hold_size << " bytes for " << _rconfig.coalesce_window_microseconds << "us");
+
+            coalesce_timer_.waitFor(_rctx, std::chrono::microseconds(_rconfig.coalesce_window_microseconds), onTimerCoalesce);
+
+            if (_rconfig.statistic_ptr) {
+                ++_rconfig.statistic_ptr->coalesce_count_;
+            }
+        }
+        send_hold_size_ = hold_size;
+        return true;
+    }
+
+    if (send_hold_size_ != 0) {
+        if (flags_.has(FlagsE::CoalesceFlush)) {
+            if (_rconfig.statistic_ptr) {
+                ++_rconfig.statistic_ptr->coalesce_timeout_count_;
+            }
+        } else {
+            coalesce_timer_.silentCancel(_rctx);
+            if (_rconfig.statistic_ptr) {
+                ++_rconfig.statistic_ptr->coalesce_size_count_;
+            }
+        }
+        _rbuffer.reset(send_buf_.get(), hold_size);
+        send_hold_size_ = 0;
+    }
+    flags_.reset(FlagsE::CoalesceFlush);
+    return false;
+}
+//-----------------------------------------------------------------------------
+/*static*/ void Connection::onTimerCoalesce(frame::aio::ReactorContext& _rctx)
+{
+    Connection& rthis = static_cast<Connection&>(_rctx.object());
+
+    solid_dbg(logger, Verbose, &rthis << " send " << rthis.send_hold_size_ << " held bytes");
+
+    if (rthis.isStopping()) {
+        return;
+    }
+
+    rthis.flags_.set(FlagsE::CoalesceFlush);
+    rthis.doSend(_rctx);
+}
+//-----------------------------------------------------------------------------
+// The requests wait for responses in the order they were written and all have
+// the same timeout, so a single timer on the oldest deadline covers them all.
+// The timer is not moved when the oldest request gets its response - it fires
+// early and is set again for the new oldest deadline.
+void Connection::doResetTimerResponse(frame::aio::ReactorContext& _rctx)
+{
+    std::chrono::steady_clock::time_point deadline;
+
+    if (!flags_.has(FlagsE::WaitResponseTimer) && msg_writer_.responseDeadline(deadline)) {
+        flags_.set(FlagsE::WaitResponseTimer);
+        response_timer_.waitUntil(_rctx, deadline, onTimerResponse);
+    }
+}
+//-----------------------------------------------------------------------------
+/*static*/ void Connection::onTimerResponse(frame::aio::ReactorContext& _rctx)
+{
+    Connection& rthis = static_cast<Connection&>(_rctx.object());
+
+    rthis.flags_.reset(FlagsE::WaitResponseTimer);
+
+    if (rthis.isStopping()) {
+        return;
+    }
+
+    ConnectionContext    conctx(rthis.service(_rctx), rthis);
+    Configuration const& rconfig = rthis.service(_rctx).configuration();
+    Sender               sender(rthis, _rctx, rconfig.writer, rconfig.protocol(), conctx, error_message_response_timeout);
+
+    const size_t count = rthis.msg_writer_.cancelExpired(_rctx.steadyTime(), sender);
+
+    solid_dbg(logger, Verbose, &rthis << " response timeout for " << count << " requests");
+
+    if (count != 0 && rconfig.writer.statistic_ptr) {
+        rconfig.writer.statistic_ptr->response_timeout_count_ += count;
+    }
+
+    rthis.doResetTimerResponse(_rctx);
+}
+//-----------------------------------------------------------------------------
+void Connection::doResetTimerIdle(frame::aio::ReactorContext& _rctx)
+{
+    Configuration const& config = service(_rctx).configuration();
+
+    if (config.connection_buffer_release_timeout_seconds != 0u) {
+        solid_dbg(logger, Verbose, this << ' ' << this->id() << " wait for " << config.connection_buffer_release_timeout_seconds << " seconds");
+
+        idle_timer_.waitFor(_rctx, std::chrono::seconds(config.connection_buffer_release_timeout_seconds), onTimerIdle);
+    }
+}
+//-----------------------------------------------------------------------------
+/*static*/ void Connection::onTimerIdle(frame::aio::ReactorContext& _rctx)
+{
+    Connection& rthis = static_cast<Connection&>(_rctx.object());
+
+    solid_dbg(logger, Verbose, &rthis << " " << rthis.flags_.toString());
+
+    if (rthis.isStopping()) {
+        return;
+    }
+
+    if (rthis.flags_.has(FlagsE::HasMessageActivity)) {
+        rthis.flags_.reset(FlagsE::HasMessageActivity);
+    } else {
+        rthis.flags_.set(FlagsE::Idle);
+        rthis.doTryReleaseBuffers(_rctx);
+    }
+
+    rthis.doResetTimerIdle(_rctx);
+}
+//-----------------------------------------------------------------------------
+void Connection::doMarkMessageActivity()
+{
+    flags_.set(FlagsE::HasMessageActivity);
+    flags_.reset(FlagsE::Idle);
+}
+//-----------------------------------------------------------------------------
+// Give recv_buf_ and send_buf_ back to the Service while the connection
+// has nothing in flight. The pending receive is moved onto idle_recv_buf_
+// so that it can only bring in the next few bytes.
+void Connection::doTryReleaseBuffers(frame::aio::ReactorContext& _rctx)
+{
+    if (
+        !flags_.has(FlagsE::Idle) || flags_.has(FlagsE::BuffersReleased) || isStopping() || isRawState() || recv_buf_off_ != cons_buf_off_ || recv_buf_.use_count() != 1 || !msg_writer_.empty() || hasPendingSend() || send_hold_size_ != 0 || ackd_buf_count_ != 0 || !cancel_remote_msg_vec_.empty()) {
+        return;
+    }
+
+    if (!sock_ptr_->resetRecvBuffer(idle_recv_buf_, sizeof(idle_recv_buf_))) {
+        //no pending receive to move
+        return;
+    }
+
+    solid_dbg(logger, Verbose, this << ' ' << this->id() << " release buffers");
+
+    Service& rsvc = service(_rctx);
+
+    recv_buf_off_ = 0;
+    cons_buf_off_ = 0;
+
+    rsvc.releaseRecvBuffer(_rctx.numaNode(), recv_buf_, recv_buf_cp_kb_);
+    rsvc.releaseSendBuffer(_rctx.numaNode(), send_buf_, send_buf_cp_kb_);
+
+    for (auto& rbuf : recv_buf_vec_) {
+        rsvc.releaseRecvBuffer(_rctx.numaNode(), rbuf, recv_buf_cp_kb_);
+    }
+    recv_buf_count_ -= static_cast<uint16_t>(recv_buf_vec_.size() + 1);
+    recv_buf_vec_.clear();
+
+    flags_.set(FlagsE::BuffersReleased);
+}
+//-----------------------------------------------------------------------------
+void Connection::doAcquireBuffers(frame::aio::ReactorContext& _rctx)
+{
+    if (flags_.has(FlagsE::BuffersReleased)) {
+        solid_dbg(logger, Verbose, this << ' ' << this->id() << " acquire buffers");
+
+        flags_.reset(FlagsE::BuffersReleased);
+
+        recv_buf_ = service(_rctx).acquireRecvBuffer(_rctx.numaNode(), recv_buf_cp_kb_);
+        send_buf_ = service(_rctx).acquireSendBuffer(_rctx.numaNode(), send_buf_cp_kb_);
+        ++recv_buf_count_;
+
+        //move the pending receive, if any, back onto recv_buf_.
+        //Otherwise we are called from onRecv which copies from idle_recv_buf_.
+        sock_ptr_->resetRecvBuffer(recv_buf_->data(), recvBufferCapacity());
+    }
+}
+//-----------------------------------------------------------------------------
 /*static*/ void Connection::onTimerInactivity(frame::aio::ReactorContext& _rctx)
 {
     Connection& rthis = static_cast<Connection&>(_rctx.object());
@@ -1505,6 +1752,7 @@ struct Connection::Receiver : MessageReader::Receiver {
 
     void receiveMessage(MessagePointerT& _rmsg_ptr, const size_t _msg_type_id) override
     {
+        rcon_.doMarkMessageActivity();
         rcon_.doCompleteMessage(rctx_, _rmsg_ptr, _msg_type_id);
         rcon_.flags_.set(FlagsE::PollPool); //reset flag
         rcon_.post(
@@ -1531,16 +1779,19 @@ struct Connection::Receiver : MessageReader::Receiver {
 
     bool receiveRelayStart(MessageHeader& _rmsghdr, const char* _pbeg, size_t _sz, MessageId& _rrelay_id, const bool _is_last, ErrorConditionT& _rerror) override
     {
+        rcon_.doMarkMessageActivity();
         return rcon_.doReceiveRelayStart(rctx_, _rmsghdr, _pbeg, _sz, _rrelay_id, _is_last, _rerror);
     }
 
     bool receiveRelayBody(const char* _pbeg, size_t _sz, const MessageId& _rrelay_id, const bool _is_last, ErrorConditionT& _rerror) override
     {
+        rcon_.doMarkMessageActivity();
         return rcon_.doReceiveRelayBody(rctx_, _pbeg, _sz, _rrelay_id, _is_last, _rerror);
     }
 
     bool receiveRelayResponse(MessageHeader& _rmsghdr, const char* _pbeg, size_t _sz, const MessageId& _rrelay_id, const bool _is_last, ErrorConditionT& _rerror) override
     {
+        rcon_.doMarkMessageActivity();
         return rcon_.doReceiveRelayResponse(rctx_, _rmsghdr, _pbeg, _sz, _rrelay_id, _is_last, _rerror);
     }
 
@@ -1563,6 +1814,30 @@ struct Connection::Receiver : MessageReader::Receiver {
         rcon_.doCancelRelayed(rctx_, nullptr, _rrelay_id);
     }
 
+    void pushCreditUpdate(const RequestId& _reqid, const uint32_t _size) override
+    {
+        if (rcon_.msg_writer_.grantCredit(_reqid, _size)) {
+            rcon_.post(
+                rctx_,
+                [](frame::aio::ReactorContext& _rctx, Event const& /*_revent*/) {
+                    Connection& rthis = static_cast<Connection&>(_rctx.object());
+                    rthis.doSend(_rctx);
+                });
+        }
+    }
+
+    void receiveCreditUpdate(const RequestId& _reqid, const uint32_t _size) override
+    {
+        if (rcon_.msg_writer_.updateCredit(_reqid, _size)) {
+            rcon_.post(
+                rctx_,
+                [](frame::aio::ReactorContext& _rctx, Event const& /*_revent*/) {
+                    Connection& rthis = static_cast<Connection&>(_rctx.object());
+                    rthis.doSend(_rctx);
+                });
+        }
+    }
+
     ResponseStateE checkResponseState(const MessageHeader& _rmsghdr, MessageId& _rrelay_id) const override
     {
         return rcon_.doCheckResponseState(rctx_, _rmsghdr, _rrelay_id);
@@ -1591,6 +1866,12 @@ struct Connection::Receiver : MessageReader::Receiver {
 
     rthis.doResetTimerRecv(_rctx);
 
+    if (rthis.flags_.has(FlagsE::BuffersReleased) && !_rctx.error()) {
+        //the bytes were received onto idle_recv_buf_
+        rthis.doAcquireBuffers(_rctx);
+        memcpy(rthis.recv_buf_->data(), rthis.idle_recv_buf_, _sz);
+    }
+
     do {
         solid_dbg(logger, Verbose, &rthis << " received size " << _sz);
 
@@ -1645,6 +1926,8 @@ struct Connection::Receiver : MessageReader::Receiver {
         solid_assert(!rv);
         (void)rv;
     }
+
+    rthis.doTryReleaseBuffers(_rctx);
 }
 //-----------------------------------------------------------------------------
 void Connection::doSend(frame::aio::ReactorContext& _rctx)
@@ -1679,6 +1962,8 @@ void Connection::doSend(frame::aio::ReactorContext& _rctx)
         }
 
         if (!this->hasPendingSend()) {
+            doAcquireBuffers(_rctx);
+
             unsigned                   repeatcnt      = 4;
             bool                       sent_something = false;
             Sender                     sender(*this, _rctx, rconfig.writer, rconfig.protocol(), conctx);
@@ -1711,7 +1996,13 @@ void Connection::doSend(frame::aio::ReactorContext& _rctx)
                     write_flags.set(MessageWriter::WriteFlagsE::ShouldSendKeepAlive);
                 }
 
-                WriteBuffer buffer{send_buf_.get(), sendBufferCapacity()};
+                if (!msg_writer_.empty()) {
+                    doMarkMessageActivity();
+                }
+
+                //write after the bytes held for the coalescing window, if any
+                WriteBuffer   buffer{send_buf_.get() + send_hold_size_, sendBufferCapacity() - send_hold_size_};
+                const uint8_t relay_free_count = send_relay_free_count_;
 
                 error = msg_writer_.write(
                     buffer, write_flags, ackd_buf_count_, cancel_remote_msg_vec_, send_relay_free_count_, sender);
@@ -1719,6 +2010,15 @@ void Connection::doSend(frame::aio::ReactorContext& _rctx)
                 flags_.reset(FlagsE::Keepalive);
 
                 if (!error) {
+                    //packets waiting for relay acceptance are not held
+                    if (doCoalesceSend(_rctx, rconfig.writer, buffer, relay_free_count == send_relay_free_count_)) {
+                        break;
+                    }
+
+                    if (!buffer.empty() && rconfig.writer.statistic_ptr) {
+                        ++rconfig.writer.statistic_ptr->send_count_;
+                        rconfig.writer.statistic_ptr->send_size_ += buffer.size();
+                    }
 
                     if (!buffer.empty() && this->sendAll(_rctx, buffer.data(), buffer.size())) {
                         if (_rctx.error()) {
@@ -1735,6 +2035,9 @@ void Connection::doSend(frame::aio::ReactorContext& _rctx)
                 } else {
                     solid_dbg(logger, Error, this << ' ' << id() << " size to send " << buffer.size() << " error " << error.message());
 
+                    buffer.reset(send_buf_.get(), send_hold_size_ + buffer.size());
+                    send_hold_size_ = 0;
+
                     if (!buffer.empty()) {
                         this->sendAll(_rctx, buffer.data(), buffer.size());
                     }
@@ -1751,12 +2054,17 @@ void Connection::doSend(frame::aio::ReactorContext& _rctx)
                 doResetTimerSend(_rctx);
             }
 
+            if (!this->isStopping()) {
+                doResetTimerResponse(_rctx);
+            }
+
             if (repeatcnt == 0) {
                 //solid_dbg(logger, Info, this<<" post send");
                 this->post(_rctx, [this](frame::aio::ReactorContext& _rctx, Event const& /*_revent*/) { this->doSend(_rctx); });
             }
             //solid_dbg(logger, Info, this<<" done-doSend "<<this->sendmsgvec[0].size()<<" "<<this->sendmsgvec[1].size());
 
+            doTryReleaseBuffers(_rctx);
         } //if(!this->hasPendingSend())
 
     } //if(!this->isStopping())
@@ -1786,6 +2094,8 @@ void Connection::doSend(frame::aio::ReactorContext& _rctx)
 
     if (!_rctx.error()) {
         solid_dbg(logger, Info, &rthis << ' ' << rthis.id() << " (" << local_address(rthis.sock_ptr_->device()) << ") -> (" << remote_address(rthis.sock_ptr_->device()) << ')');
+        //connected in time - the held back addresses are not needed
+        rthis.hedge_addr_vec_.clear();
         rthis.doStart(_rctx, false);
     } else {
         solid_dbg(logger, Error, &rthis << ' ' << rthis.id() << " connecting [" << _rctx.error().message() << "][" << _rctx.systemError().message() << ']');
@@ -2087,7 +2397,7 @@ ResponseStateE Connection::doCheckResponseState(frame::aio::ReactorContext& _rct
     return sock_ptr_->hasValidSocket();
 }
 //-----------------------------------------------------------------------------
-/*virtual*/ bool Connection::connect(frame::aio::ReactorContext& _rctx, const SocketAddressInet& _raddr)
+/*virtual*/ bool Connection::connect(frame::aio::ReactorContext& _rctx, const SocketAddress& _raddr)
 {
     return sock_ptr_->connect(_rctx, Connection::onConnect, _raddr);
 }
@@ -2215,11 +2525,25 @@ Configuration const& ConnectionContext::configuration() const
     return true;
 }
 //-----------------------------------------------------------------------------
+/*virtual*/ void SocketStub::secureResume(frame::aio::ReactorContext& /*_rctx*/)
+{
+}
+//-----------------------------------------------------------------------------
+/*virtual*/ bool SocketStub::resetRecvBuffer(char* /*_pbuf*/, size_t /*_bufcp*/)
+{
+    return false;
+}
+//-----------------------------------------------------------------------------
 ConnectionProxy SocketStub::connectionProxy()
 {
     return ConnectionProxy{};
 }
 //-----------------------------------------------------------------------------
+Event SocketStub::secureResumeEvent()
+{
+    return connection_event_category.event(ConnectionEvents::SecureResume);
+}
+//-----------------------------------------------------------------------------
 // ConnectionProxy
 //-----------------------------------------------------------------------------
 Service& ConnectionProxy::service(frame::aio::ReactorContext& _rctx) const
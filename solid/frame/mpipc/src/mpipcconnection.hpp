@@ -48,7 +48,7 @@ struct ResolveMessage {
         return addrvec.empty();
     }
 
-    SocketAddressInet const& currentAddress() const
+    SocketAddress const& currentAddress() const
     {
         return addrvec.back();
     }
@@ -188,6 +188,10 @@ protected:
     static void onConnect(frame::aio::ReactorContext& _rctx);
     static void onTimerInactivity(frame::aio::ReactorContext& _rctx);
     static void onTimerKeepalive(frame::aio::ReactorContext& _rctx);
+    static void onTimerIdle(frame::aio::ReactorContext& _rctx);
+    static void onTimerCoalesce(frame::aio::ReactorContext& _rctx);
+    static void onTimerResponse(frame::aio::ReactorContext& _rctx);
+    static void onTimerHedge(frame::aio::ReactorContext& _rctx);
     static void onSecureConnect(frame::aio::ReactorContext& _rctx);
     static void onSecureAccept(frame::aio::ReactorContext& _rctx);
 
@@ -246,6 +250,15 @@ private:
     void doResetTimerStart(frame::aio::ReactorContext& _rctx);
     void doResetTimerSend(frame::aio::ReactorContext& _rctx);
     void doResetTimerRecv(frame::aio::ReactorContext& _rctx);
+    void doResetTimerIdle(frame::aio::ReactorContext& _rctx);
+    void doResetTimerResponse(frame::aio::ReactorContext& _rctx);
+
+    bool doCoalesceSend(
+        frame::aio::ReactorContext& _rctx, WriterConfiguration const& _rconfig,
+        WriteBuffer& _rbuffer, const bool _can_hold);
+    void doMarkMessageActivity();
+    void doTryReleaseBuffers(frame::aio::ReactorContext& _rctx);
+    void doAcquireBuffers(frame::aio::ReactorContext& _rctx);
 
     ResponseStateE doCheckResponseState(frame::aio::ReactorContext& _rctx, const MessageHeader& _rmsghdr, MessageId& _rrelay_id);
 
@@ -301,6 +314,7 @@ private:
     void doHandleEventKill(frame::aio::ReactorContext& _rctx, Event& _revent);
     void doHandleEventStart(frame::aio::ReactorContext& _rctx, Event& _revent);
     void doHandleEventResolve(frame::aio::ReactorContext& _rctx, Event& _revent);
+    void doForwardHedgeAddresses(frame::aio::ReactorContext& _rctx);
     void doHandleEventNewPoolMessage(frame::aio::ReactorContext& _rctx, Event& _revent);
     void doHandleEventNewPoolQueueMessage(frame::aio::ReactorContext& _rctx, Event& _revent);
     void doHandleEventNewConnMessage(frame::aio::ReactorContext& _rctx, Event& _revent);
@@ -329,7 +343,7 @@ private:
     bool postRecvSome(frame::aio::ReactorContext& _rctx, char* _pbuf, size_t _bufcp);
     bool postRecvSome(frame::aio::ReactorContext& _rctx, char* _pbuf, size_t _bufcp, Event& _revent);
     bool hasValidSocket() const;
-    bool connect(frame::aio::ReactorContext& _rctx, const SocketAddressInet& _raddr);
+    bool connect(frame::aio::ReactorContext& _rctx, const SocketAddress& _raddr);
     bool recvSome(frame::aio::ReactorContext& _rctx, char* _buf, size_t _bufcp, size_t& _sz);
     bool hasPendingSend() const;
     bool sendAll(frame::aio::ReactorContext& _rctx, char* _buf, size_t _bufcp);
@@ -360,6 +374,11 @@ private:
         Raw,
         InPoolWaitQueue,
         Connected, //once set - the flag should not be reset. Is used by pool for restarting
+        HasMessageActivity, //keepalives do not count
+        Idle,
+        BuffersReleased, //recv_buf_ and send_buf_ are back in the Service's pool
+        CoalesceFlush, //the coalescing window expired - send the held bytes
+        WaitResponseTimer, //response_timer_ waits for the oldest request deadline
         LastFlag,
     };
 
@@ -379,6 +398,9 @@ private:
     ConnectionPoolId   pool_id_;
     const std::string& rpool_name_;
     TimerT             timer_;
+    TimerT             idle_timer_;
+    TimerT             coalesce_timer_;
+    TimerT             response_timer_;
     FlagsT             flags_;
     size_t             recv_buf_off_;
     size_t             cons_buf_off_;
@@ -387,6 +409,7 @@ private:
     RecvBufferPointerT recv_buf_;
     RecvBufferVectorT  recv_buf_vec_;
     SendBufferPointerT send_buf_;
+    size_t             send_hold_size_; //bytes held in send_buf_ for the coalescing window
     uint8_t            send_relay_free_count_;
     uint8_t            ackd_buf_count_;
     uint8_t            recv_buf_cp_kb_; //kilobytes
@@ -399,8 +422,10 @@ private:
     ErrorCodeT         sys_error_;
     Any<>              any_data_;
     char               socket_emplace_buf_[static_cast<size_t>(ConnectionValues::SocketEmplacementSize)];
+    char               idle_recv_buf_[static_cast<size_t>(ConnectionValues::IdleRecvBufferCapacity)];
     SocketStubPtrT     sock_ptr_;
     UniqueId           relay_id_;
+    AddressVectorT     hedge_addr_vec_; //resolved addresses held back while connecting - see Client::connection_hedge_delay_milliseconds
 };
 
 inline Any<>& Connection::any()
@@ -35,6 +35,7 @@ enum {
     ErrorMessageCanceledE,
     ErrorMessageCanceledPeerE,
     ErrorMessageConnectionE,
+    ErrorMessageResponseTimeoutE,
     ErrorCompressionUnavailableE,
     ErrorCompressionEngineE,
     ErrorReaderInvalidPacketHeaderE,
@@ -64,6 +65,7 @@ enum {
     ErrorServiceUnknownMessageE,
     ErrorServiceInvalidUrlE,
     ErrorServiceConnectionNotNeededE,
+    ErrorServiceInvalidCreditWindowE,
 };
 
 class ErrorCategory : public ErrorCategoryT {
@@ -121,6 +123,9 @@ std::string ErrorCategory::message(int _ev) const
     case ErrorMessageConnectionE:
         oss << "Message connection";
         break;
+    case ErrorMessageResponseTimeoutE:
+        oss << "Message response timeout";
+        break;
     case ErrorConnectionEnterActiveE:
         oss << "Connection cannot enter active state - too many active connections";
         break;
@@ -223,6 +228,9 @@ std::string ErrorCategory::message(int _ev) const
     case ErrorServiceConnectionNotNeededE:
         oss << "Service: connection not needed";
         break;
+    case ErrorServiceInvalidCreditWindowE:
+        oss << "Service: invalid stream credit window";
+        break;
     default:
         oss << "Unknown";
         break;
@@ -249,6 +257,7 @@ std::string ErrorCategory::message(int _ev) const
 /*extern*/ const ErrorConditionT error_message_canceled(ErrorMessageCanceledE, category);
 /*extern*/ const ErrorConditionT error_message_canceled_peer(ErrorMessageCanceledPeerE, category);
 /*extern*/ const ErrorConditionT error_message_connection(ErrorMessageConnectionE, category);
+/*extern*/ const ErrorConditionT error_message_response_timeout(ErrorMessageResponseTimeoutE, category);
 
 /*extern*/ const ErrorConditionT error_compression_unavailable(ErrorCompressionUnavailableE, category);
 /*extern*/ const ErrorConditionT error_compression_engine(ErrorCompressionEngineE, category);
@@ -282,6 +291,7 @@ std::string ErrorCategory::message(int _ev) const
 /*extern*/ const ErrorConditionT error_service_unknown_message(ErrorServiceUnknownMessageE, category);
 /*extern*/ const ErrorConditionT error_service_invalid_url(ErrorServiceInvalidUrlE, category);
 /*extern*/ const ErrorConditionT error_service_connection_not_needed(ErrorServiceConnectionNotNeededE, category);
+/*extern*/ const ErrorConditionT error_service_invalid_credit_window(ErrorServiceInvalidCreditWindowE, category);
 
 } //namespace mpipc
 } //namespace frame
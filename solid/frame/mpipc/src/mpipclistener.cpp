@@ -18,9 +18,10 @@ namespace frame {
 namespace mpipc {
 
 Listener::Listener(
-    SocketDevice& _rsd)
+    SocketDevice& _rsd, const size_t _reactor_index)
     : sock(this->proxy(), std::move(_rsd))
     , timer(this->proxy())
+    , reactor_index(_reactor_index)
 {
     solid_dbg(logger, Info, this);
 }
@@ -54,7 +55,7 @@ void Listener::onAccept(frame::aio::ReactorContext& _rctx, SocketDevice& _rsd)
 
     do {
         if (!_rctx.error()) {
-            service(_rctx).acceptIncomingConnection(_rsd);
+            service(_rctx).acceptIncomingConnection(_rsd, reactor_index);
         } else if (_rctx.error() == aio::error_listener_hangup) {
             solid_dbg(logger, Error, "listen hangup" << _rctx.error().message());
             //TODO: maybe you shoud restart the listener.
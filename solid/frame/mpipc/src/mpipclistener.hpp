@@ -37,7 +37,7 @@ public:
     }
 
     Listener(
-        SocketDevice& _rsd);
+        SocketDevice& _rsd, const size_t _reactor_index = InvalidIndex());
     ~Listener();
 
 private:
@@ -51,6 +51,7 @@ private:
 
     ListenerSocketT sock;
     TimerT          timer;
+    const size_t    reactor_index; //where to start the accepted connections
 };
 
 } //namespace mpipc
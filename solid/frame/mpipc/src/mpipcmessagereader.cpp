@@ -169,9 +169,19 @@ void MessageReader::doConsumePacket(
                 solid_assert(false);
             }
             break;
-        case PacketHeader::CommandE::Update:
-            solid_dbg(logger, Verbose, "Update");
-            break;
+        case PacketHeader::CommandE::Update: {
+            RequestId requid;
+            uint32_t  size = 0;
+            pbufpos        = _receiver.protocol().loadCrossValue(pbufpos, pbufend - pbufpos, requid.index);
+            if (pbufpos != nullptr && (pbufpos = _receiver.protocol().loadCrossValue(pbufpos, pbufend - pbufpos, requid.unique)) != nullptr && (pbufpos = _receiver.protocol().loadCrossValue(pbufpos, pbufend - pbufpos, size)) != nullptr) {
+                solid_dbg(logger, Verbose, "Update: " << requid << " credit " << size);
+                _receiver.receiveCreditUpdate(requid, size);
+            } else {
+                solid_dbg(logger, Verbose, "Update - error parsing");
+                _rerror = error_reader_protocol;
+                solid_assert(false);
+            }
+        } break;
         case PacketHeader::CommandE::CancelRequest: {
             RequestId requid;
             pbufpos = _receiver.protocol().loadCrossValue(pbufpos, pbufend - pbufpos, requid.index);
@@ -303,6 +313,8 @@ const char* MessageReader::doConsumeMessage(
                     rmsgstub.state_ = MessageStub::StateE::ReadBodyContinue;
                     _pbufpos += message_size;
 
+                    doGrantCredit(_msgidx, _cmd, message_size, _receiver);
+
                     if (rv >= 0) {
                         if (rv <= static_cast<int>(message_size)) {
 
@@ -361,6 +373,8 @@ const char* MessageReader::doConsumeMessage(
 
                 _pbufpos += message_size;
 
+                doGrantCredit(_msgidx, _cmd, message_size, _receiver);
+
                 if ((_cmd & static_cast<uint8_t>(PacketHeader::CommandE::EndMessageFlag)) != 0u) {
                     cache(rmsgstub.deserializer_ptr_);
                     rmsgstub.clear();
@@ -392,6 +406,8 @@ const char* MessageReader::doConsumeMessage(
             }
             _pbufpos += message_size;
 
+            doGrantCredit(_msgidx, _cmd, message_size, _receiver);
+
             if (_rerror) {
                 _pbufpos = _pbufend;
             }
@@ -417,6 +433,8 @@ const char* MessageReader::doConsumeMessage(
             }
             _pbufpos += message_size;
 
+            doGrantCredit(_msgidx, _cmd, message_size, _receiver);
+
             if (_rerror) {
                 _pbufpos = _pbufend;
             }
@@ -433,6 +451,7 @@ const char* MessageReader::doConsumeMessage(
             _pbufpos = _receiver.protocol().loadValue(_pbufpos, message_size);
             solid_dbg(logger, Verbose, "msgidx = " << _msgidx << " message_size = " << message_size);
             _pbufpos += message_size;
+            doGrantCredit(_msgidx, _cmd, message_size, _receiver);
             const bool is_message_end = (_cmd & static_cast<uint8_t>(PacketHeader::CommandE::EndMessageFlag)) != 0;
             if (is_message_end) {
                 rmsgstub.clear();
@@ -461,6 +480,8 @@ const char* MessageReader::doConsumeMessage(
             }
             _pbufpos += message_size;
 
+            doGrantCredit(_msgidx, _cmd, message_size, _receiver);
+
             if (_rerror) {
                 _pbufpos = _pbufend;
             }
@@ -480,6 +501,34 @@ const char* MessageReader::doConsumeMessage(
     return _pbufpos;
 }
 //-----------------------------------------------------------------------------
+// With stream credit, the peer's writer may send at most the window it
+// put in the message header body bytes ahead of us. Give credit back once
+// half that window was consumed, so the sender never waits when we keep up.
+void MessageReader::doGrantCredit(
+    const uint32_t _msgidx,
+    const uint8_t  _cmd,
+    const size_t   _size,
+    Receiver&      _receiver)
+{
+    if ((_cmd & static_cast<uint8_t>(PacketHeader::CommandE::EndMessageFlag)) != 0u) {
+        return;
+    }
+
+    MessageStub& rmsgstub = message_vec_[_msgidx];
+    const size_t window   = rmsgstub.message_header_.credit_window_;
+
+    if (window == 0 || rmsgstub.message_header_.sender_request_id_.isInvalid()) {
+        return;
+    }
+
+    rmsgstub.credit_used_ += _size;
+
+    if (rmsgstub.credit_used_ >= (window / 2)) {
+        _receiver.pushCreditUpdate(rmsgstub.message_header_.sender_request_id_, static_cast<uint32_t>(rmsgstub.credit_used_));
+        rmsgstub.credit_used_ = 0;
+    }
+}
+//-----------------------------------------------------------------------------
 void MessageReader::cache(Deserializer::PointerT& _des)
 {
     if (_des) {
@@ -525,6 +574,8 @@ Deserializer::PointerT MessageReader::createDeserializer(Receiver& _receiver)
 }
 /*virtual*/ void MessageReader::Receiver::pushCancelRequest(const RequestId&) {}
 /*virtual*/ void MessageReader::Receiver::cancelRelayed(const MessageId&) {}
+/*virtual*/ void MessageReader::Receiver::pushCreditUpdate(const RequestId&, const uint32_t) {}
+/*virtual*/ void MessageReader::Receiver::receiveCreditUpdate(const RequestId&, const uint32_t) {}
 //-----------------------------------------------------------------------------
 
 } //namespace mpipc
@@ -59,6 +59,8 @@ public:
         virtual bool           isRelayDisabled() const;
         virtual void           pushCancelRequest(const RequestId&);
         virtual void           cancelRelayed(const MessageId&);
+        virtual void           pushCreditUpdate(const RequestId&, const uint32_t _size);
+        virtual void           receiveCreditUpdate(const RequestId&, const uint32_t _size);
     };
 
     MessageReader();
@@ -89,6 +91,12 @@ private:
         Receiver&         _receiver,
         ErrorConditionT&  _rerror);
 
+    void doGrantCredit(
+        const uint32_t _msgidx,
+        const uint8_t  _cmd,
+        const size_t   _size,
+        Receiver&      _receiver);
+
     void                   cache(Deserializer::PointerT& _des);
     Deserializer::PointerT createDeserializer(Receiver& _receiver);
 
@@ -116,11 +124,13 @@ private:
         Deserializer::PointerT deserializer_ptr_;
         MessageHeader          message_header_;
         size_t                 packet_count_;
+        size_t                 credit_used_; //body bytes consumed since the last credit update
         MessageId              relay_id;
         StateE                 state_;
 
         MessageStub()
             : packet_count_(0)
+            , credit_used_(0)
             , state_(StateE::NotStarted)
         {
         }
@@ -130,6 +140,7 @@ private:
             message_ptr_.reset();
             deserializer_ptr_.reset();
             packet_count_ = 0;
+            credit_used_  = 0;
             state_        = StateE::NotStarted;
             relay_id.clear();
         }
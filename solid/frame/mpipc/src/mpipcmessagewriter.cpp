@@ -29,6 +29,7 @@ MessageWriter::MessageWriter()
     , order_inner_list_(message_vec_)
     , write_inner_list_(message_vec_)
     , cache_inner_list_(message_vec_)
+    , deadline_inner_list_(message_vec_)
 {
 }
 //-----------------------------------------------------------------------------
@@ -170,6 +171,10 @@ void MessageWriter::doUnprepareMessageStub(const size_t _msgidx)
 {
     MessageStub& rmsgstub(message_vec_[_msgidx]);
 
+    if (deadline_inner_list_.contains(_msgidx)) {
+        deadline_inner_list_.erase(_msgidx);
+    }
+
     rmsgstub.clear();
     cache_inner_list_.pushFront(_msgidx);
 }
@@ -184,6 +189,29 @@ void MessageWriter::cancel(
     }
 }
 //-----------------------------------------------------------------------------
+bool MessageWriter::grantCredit(RequestId const& _rrequid, const uint32_t _size)
+{
+    credit_grant_vec_.emplace_back(_rrequid, _size);
+    return credit_grant_vec_.size() == 1;
+}
+//-----------------------------------------------------------------------------
+bool MessageWriter::updateCredit(RequestId const& _rrequid, const uint32_t _size)
+{
+    const MessageId msgid(_rrequid);
+
+    if (msgid.isValid() && msgid.index < message_vec_.size() && msgid.unique == message_vec_[msgid.index].unique_) {
+        MessageStub& rmsgstub = message_vec_[msgid.index];
+
+        //credits for bodies not paced (relayed, or the peer grants while we do not wait) are ignored
+        if (rmsgstub.credit_ != InvalidSize() && (rmsgstub.state_ == MessageStub::StateE::WriteBodyStart || rmsgstub.state_ == MessageStub::StateE::WriteBodyContinue)) {
+            rmsgstub.credit_ += _size;
+            solid_dbg(logger, Verbose, this << " msgidx = " << msgid.index << " credit = " << rmsgstub.credit_);
+            return true;
+        }
+    }
+    return false;
+}
+//-----------------------------------------------------------------------------
 MessagePointerT MessageWriter::fetchRequest(MessageId const& _rmsguid) const
 {
     if (_rmsguid.isValid() && _rmsguid.index < message_vec_.size() && _rmsguid.unique == message_vec_[_rmsguid.index].unique_) {
@@ -231,6 +259,29 @@ void MessageWriter::cancelOldest(Sender& _rsender)
     }
 }
 //-----------------------------------------------------------------------------
+bool MessageWriter::responseDeadline(TimePointT& _rdeadline) const
+{
+    if (!deadline_inner_list_.empty()) {
+        _rdeadline = deadline_inner_list_.front().deadline_;
+        return true;
+    }
+    return false;
+}
+//-----------------------------------------------------------------------------
+size_t MessageWriter::cancelExpired(TimePointT const& _rnow, Sender& _rsender)
+{
+    size_t count = 0;
+    while (!deadline_inner_list_.empty() && deadline_inner_list_.front().deadline_ <= _rnow) {
+        const size_t msgidx = deadline_inner_list_.popFront();
+
+        solid_dbg(logger, Verbose, "response timeout for " << msgidx);
+
+        doCancel(msgidx, _rsender);
+        ++count;
+    }
+    return count;
+}
+//-----------------------------------------------------------------------------
 void MessageWriter::doCancel(
     const size_t _msgidx,
     Sender&      _rsender,
@@ -275,6 +326,9 @@ void MessageWriter::doCancel(
         } else if (!_force && rmsgstub.state_ == MessageStub::StateE::WriteWait) {
             //message is waiting response
             rmsgstub.state_ = MessageStub::StateE::WriteWaitCanceled;
+            if (deadline_inner_list_.contains(_msgidx)) {
+                deadline_inner_list_.erase(_msgidx);
+            }
         } else if (rmsgstub.state_ == MessageStub::StateE::WriteWait || rmsgstub.state_ == MessageStub::StateE::WriteWaitCanceled) {
             order_inner_list_.erase(_msgidx);
             doUnprepareMessageStub(_msgidx);
@@ -412,7 +466,7 @@ ErrorConditionT MessageWriter::write(
 // - be fast
 // - try to fill up the package
 // - be fair with all messages
-bool MessageWriter::doFindEligibleMessage(const bool _can_send_relay, const size_t /*_size*/)
+bool MessageWriter::doFindEligibleMessage(const bool _can_send_relay, const size_t /*_size*/, const size_t _min_credit)
 {
     size_t qsz = write_inner_list_.size();
     while ((qsz--) != 0u) {
@@ -433,6 +487,11 @@ bool MessageWriter::doFindEligibleMessage(const bool _can_send_relay, const size
         if (rmsgstub.isStartOrHeadState()) {
             return true;
         }
+        if (rmsgstub.isWaitCreditState(_min_credit)) {
+            //wait for the peer to grant credit - the other messages go on
+            write_inner_list_.pushBack(write_inner_list_.popFront());
+            continue;
+        }
         if (rmsgstub.isRelay()) {
             if (_can_send_relay) {
             } else {
@@ -483,8 +542,21 @@ size_t MessageWriter::doWritePacketData(
         _cancel_remote_msg_vec.pop_back();
     }
 
+    while (!credit_grant_vec_.empty() && static_cast<size_t>(_pbufend - pbufpos) >= _rsender.protocol().minimumFreePacketDataSize()) {
+        solid_dbg(logger, Verbose, this << " send Update " << credit_grant_vec_.back().first << " credit " << credit_grant_vec_.back().second);
+        uint8_t cmd = static_cast<uint8_t>(PacketHeader::CommandE::Update);
+        pbufpos     = _rsender.protocol().storeValue(pbufpos, cmd);
+        pbufpos     = _rsender.protocol().storeCrossValue(pbufpos, _pbufend - pbufpos, credit_grant_vec_.back().first.index);
+        solid_check(pbufpos != nullptr, "fail store cross value");
+        pbufpos = _rsender.protocol().storeCrossValue(pbufpos, _pbufend - pbufpos, credit_grant_vec_.back().first.unique);
+        solid_check(pbufpos != nullptr, "fail store cross value");
+        pbufpos = _rsender.protocol().storeCrossValue(pbufpos, _pbufend - pbufpos, credit_grant_vec_.back().second);
+        solid_check(pbufpos != nullptr, "fail store cross value");
+        credit_grant_vec_.pop_back();
+    }
+
     while (
-        !_rerror && static_cast<size_t>(_pbufend - pbufpos) >= _rsender.protocol().minimumFreePacketDataSize() && doFindEligibleMessage(_relay_free_count != 0, _pbufend - pbufpos)) {
+        !_rerror && static_cast<size_t>(_pbufend - pbufpos) >= _rsender.protocol().minimumFreePacketDataSize() && doFindEligibleMessage(_relay_free_count != 0, _pbufend - pbufpos, _rsender.protocol().minimumFreePacketDataSize())) {
         const size_t msgidx = write_inner_list_.frontIndex();
 
         PacketHeader::CommandE cmd = PacketHeader::CommandE::Message;
@@ -585,6 +657,9 @@ char* MessageWriter::doWriteMessageHead(
     _rsender.context().message_flags     = rmsgstub.msgbundle_.message_flags;
     _rsender.context().pmessage_url      = &rmsgstub.msgbundle_.message_url;
 
+    //the peer's reader grants credit on the window it finds in the header
+    _rsender.context().message_credit_window = rmsgstub.isRelay() ? 0 : static_cast<uint32_t>(_rsender.configuration().stream_credit_window);
+
     const long rv   = rmsgstub.state_ == MessageStub::StateE::WriteHeadStart ? rmsgstub.serializer_ptr_->run(_rsender.context(), _pbufpos, _pbufend - _pbufpos, rmsgstub.msgbundle_.message_ptr->header_) : rmsgstub.serializer_ptr_->run(_rsender.context(), _pbufpos, _pbufend - _pbufpos);
     rmsgstub.state_ = MessageStub::StateE::WriteHeadContinue;
 
@@ -595,6 +670,10 @@ char* MessageWriter::doWriteMessageHead(
         if (rmsgstub.serializer_ptr_->empty()) {
             //we've just finished serializing header
             rmsgstub.state_ = MessageStub::StateE::WriteBodyStart;
+
+            if (_rsender.context().message_credit_window != 0) {
+                rmsgstub.credit_ = _rsender.context().message_credit_window;
+            }
         }
         _pbufpos += rv;
     } else {
@@ -630,17 +709,39 @@ char* MessageWriter::doWriteMessageBody(
     _rsender.context().request_id.unique = rmsgstub.unique_;
     _rsender.context().message_flags     = rmsgstub.msgbundle_.message_flags;
     _rsender.context().pmessage_url      = &rmsgstub.msgbundle_.message_url;
+    _rsender.context().message_credit    = rmsgstub.credit_;
+
+    //never write more than the peer granted
+    const size_t bodysz = std::min(static_cast<size_t>(_pbufend - _pbufpos), rmsgstub.credit_);
+
+    long rv;
+    bool multicast_done = false;
 
-    const long rv   = rmsgstub.state_ == MessageStub::StateE::WriteBodyStart ? rmsgstub.serializer_ptr_->run(_rsender.context(), _pbufpos, _pbufend - _pbufpos, rmsgstub.msgbundle_.message_ptr, rmsgstub.msgbundle_.message_type_id) : rmsgstub.serializer_ptr_->run(_rsender.context(), _pbufpos, _pbufend - _pbufpos);
+    if (rmsgstub.isMulticast()) {
+        rv = doWriteMulticastBody(_pbufpos, bodysz, _msgidx, _rsender, multicast_done, _rerror);
+    } else if (rmsgstub.state_ == MessageStub::StateE::WriteBodyStart) {
+        rv = rmsgstub.serializer_ptr_->run(_rsender.context(), _pbufpos, bodysz, rmsgstub.msgbundle_.message_ptr, rmsgstub.msgbundle_.message_type_id);
+    } else {
+        rv = rmsgstub.serializer_ptr_->run(_rsender.context(), _pbufpos, bodysz);
+    }
     rmsgstub.state_ = MessageStub::StateE::WriteBodyContinue;
 
     if (rv >= 0) {
+        const bool done = rmsgstub.isMulticast() ? multicast_done : rmsgstub.serializer_ptr_->empty();
+
+        if (rmsgstub.credit_ != InvalidSize()) {
+            rmsgstub.credit_ -= rv;
+
+            if (rmsgstub.credit_ < _rsender.protocol().minimumFreePacketDataSize() && !done && _rsender.configuration().statistic_ptr) {
+                ++_rsender.configuration().statistic_ptr->credit_wait_count_;
+            }
+        }
 
         if (rmsgstub.isRelay()) {
             _rpacket_options.request_accept = true;
         }
 
-        if (rmsgstub.serializer_ptr_->empty()) {
+        if (done) {
             //we've just finished serializing body
             cmd |= static_cast<uint8_t>(PacketHeader::CommandE::EndMessageFlag);
 
@@ -669,13 +770,119 @@ char* MessageWriter::doWriteMessageBody(
         solid_dbg(logger, Verbose, "stored message body with index = " << _msgidx << " and size = " << rv << " cmd = " << (int)cmd);
 
         _pbufpos += rv;
-    } else {
+    } else if (!rmsgstub.isMulticast()) {
         _rerror = rmsgstub.serializer_ptr_->error();
     }
 
     return _pbufpos;
 }
 //-----------------------------------------------------------------------------
+// Copies the body from the chunk the message is on - producing it first,
+// if no other connection did, then moves on to the next chunk.
+long MessageWriter::doWriteMulticastBody(
+    char*            _pbufpos,
+    const size_t     _bufsz,
+    const size_t     _msgidx,
+    Sender&          _rsender,
+    bool&            _rdone,
+    ErrorConditionT& _rerror)
+{
+    MessageStub&   rmsgstub   = message_vec_[_msgidx];
+    MessageBundle& rmsgbundle = rmsgstub.msgbundle_;
+
+    if (!rmsgbundle.multicast_chunk_ptr->ready_.load(std::memory_order_acquire)) {
+        doProduceMulticastChunk(_msgidx, _rsender);
+    }
+
+    const MulticastChunk& rchunk = *rmsgbundle.multicast_chunk_ptr;
+
+    if (rchunk.error_) {
+        _rerror = rchunk.error_;
+        return -1;
+    }
+
+    const size_t sz = std::min(_bufsz, rchunk.data_.size() - rmsgstub.multicast_pos_);
+
+    memcpy(_pbufpos, rchunk.data_.data() + rmsgstub.multicast_pos_, sz);
+    rmsgstub.multicast_pos_ += sz;
+
+    if (rmsgstub.multicast_pos_ == rchunk.data_.size()) {
+        if (rchunk.next_) {
+            //releases the chunk if all the other recipients are past it
+            MulticastChunkPointerT next_ptr = rchunk.next_;
+
+            rmsgbundle.multicast_chunk_ptr = std::move(next_ptr);
+            rmsgstub.multicast_pos_        = 0;
+        } else {
+            _rdone = true;
+        }
+    }
+
+    return static_cast<long>(sz);
+}
+//-----------------------------------------------------------------------------
+// Serializes the next chunk of a multicast body, at most a packet long,
+// with the body's serializer - unless another connection just did it.
+void MessageWriter::doProduceMulticastChunk(
+    const size_t _msgidx,
+    Sender&      _rsender)
+{
+    MessageStub&    rmsgstub   = message_vec_[_msgidx];
+    MessageBundle&  rmsgbundle = rmsgstub.msgbundle_;
+    MulticastBody&  rbody      = *rmsgbundle.multicast_body_ptr;
+    MulticastChunk& rchunk     = *rmsgbundle.multicast_chunk_ptr;
+
+    std::lock_guard<std::mutex> lock(rbody.mutex_);
+
+    if (rchunk.ready_.load(std::memory_order_relaxed)) {
+        return;
+    }
+
+    const size_t          capacity = Protocol::MaxPacketDataSize;
+    Serializer::PointerT& rser_ptr = rbody.serializer_ptr_;
+    const bool            start    = !rser_ptr;
+    const size_t          credit   = _rsender.context().message_credit;
+    size_t                len      = 0;
+    long                  rv       = 0;
+
+    if (start) {
+        rser_ptr = createSerializer(_rsender);
+    }
+
+    //the chunks are shared by recipients with different credits
+    _rsender.context().message_credit = InvalidSize();
+
+    rchunk.data_.resize(capacity);
+
+    do {
+        if (start && len == 0) {
+            rv = rser_ptr->run(_rsender.context(), &rchunk.data_[len], capacity - len, rmsgbundle.message_ptr, rmsgbundle.message_type_id);
+        } else {
+            rv = rser_ptr->run(_rsender.context(), &rchunk.data_[len], capacity - len);
+        }
+        if (rv > 0) {
+            len += rv;
+        }
+    } while (rv > 0 && len < capacity && !rser_ptr->empty());
+
+    _rsender.context().message_credit = credit;
+
+    rchunk.data_.resize(len);
+
+    if (rv < 0) {
+        rchunk.error_ = rser_ptr->error();
+        cache(rser_ptr);
+    } else if (rser_ptr->empty()) {
+        cache(rser_ptr);
+    } else {
+        rchunk.next_ = std::make_shared<MulticastChunk>();
+    }
+
+    solid_dbg(logger, Verbose, "multicast body chunk serialized with size = " << len << " last = " << !rchunk.next_);
+
+    rchunk.ready_.store(true, std::memory_order_release);
+}
+//-----------------------------------------------------------------------------
 char* MessageWriter::doWriteRelayedHead(
     char*        _pbufpos,
     char*        _pbufend,
@@ -700,7 +907,8 @@ char* MessageWriter::doWriteRelayedHead(
     _rsender.context().request_id.unique = rmsgstub.unique_;
     _rsender.context().message_flags     = rmsgstub.prelay_data_->pmessage_header_->flags_;
     _rsender.context().message_flags.set(MessageFlagsE::Relayed);
-    _rsender.context().pmessage_url = &rmsgstub.prelay_data_->pmessage_header_->url_;
+    _rsender.context().pmessage_url          = &rmsgstub.prelay_data_->pmessage_header_->url_;
+    _rsender.context().message_credit_window = 0; //relayed bodies are paced by the relay buffer acknowledgements
 
     const long rv   = rmsgstub.state_ == MessageStub::StateE::RelayedHeadStart ? rmsgstub.serializer_ptr_->run(_rsender.context(), _pbufpos, _pbufend - _pbufpos, *rmsgstub.prelay_data_->pmessage_header_) : rmsgstub.serializer_ptr_->run(_rsender.context(), _pbufpos, _pbufend - _pbufpos);
     rmsgstub.state_ = MessageStub::StateE::RelayedHeadContinue;
@@ -897,6 +1105,10 @@ void MessageWriter::doTryCompleteMessageAfterSerialization(
     rmsgstub.msgbundle_.message_flags.reset(MessageFlagsE::StartedSend);
     rmsgstub.msgbundle_.message_flags.set(MessageFlagsE::DoneSend);
 
+    if (_rsender.configuration().statistic_ptr) {
+        ++_rsender.configuration().statistic_ptr->message_count_;
+    }
+
     rmsgstub.serializer_ptr_ = nullptr;
     rmsgstub.state_          = MessageStub::StateE::WriteStart;
 
@@ -915,6 +1127,11 @@ void MessageWriter::doTryCompleteMessageAfterSerialization(
         solid_dbg(logger, Verbose, MessageWriterPrintPairT(*this, PrintInnerListsE));
     } else {
         rmsgstub.state_ = MessageStub::StateE::WriteWait;
+
+        if (_rsender.configuration().response_timeout_milliseconds != 0) {
+            rmsgstub.deadline_ = std::chrono::steady_clock::now() + std::chrono::milliseconds(_rsender.configuration().response_timeout_milliseconds);
+            deadline_inner_list_.pushBack(_msgidx);
+        }
     }
 
     solid_dbg(logger, Verbose, MessageWriterPrintPairT(*this, PrintInnerListsE));
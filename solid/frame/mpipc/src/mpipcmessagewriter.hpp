@@ -10,6 +10,7 @@
 
 #pragma once
 
+#include <chrono>
 #include <vector>
 
 #include "solid/system/common.hpp"
@@ -127,6 +128,31 @@ public:
 
     void cancelOldest(Sender& _rsender);
 
+    //! The deadline of the oldest request waiting for its response
+    /*!
+     * Returns false when no request waits for a response with a deadline.
+     */
+    bool responseDeadline(std::chrono::steady_clock::time_point& _rdeadline) const;
+
+    //! Cancel the requests whose response did not arrive until _rnow
+    /*!
+     * The canceled requests keep their slots until their late responses
+     * arrive, just like the requests canceled by the user.
+     */
+    size_t cancelExpired(std::chrono::steady_clock::time_point const& _rnow, Sender& _rsender);
+
+    //! Queue credit to be written for the peer's message _rrequid
+    /*!
+     * Returns true when no other credit was waiting to be written.
+     */
+    bool grantCredit(RequestId const& _rrequid, const uint32_t _size);
+
+    //! Credit from the peer for our message _rrequid
+    /*!
+     * Returns true when the message body can be written further.
+     */
+    bool updateCredit(RequestId const& _rrequid, const uint32_t _size);
+
     ErrorConditionT write(
         WriteBuffer&       _rbuffer,
         const WriteFlagsT& _flags,
@@ -147,9 +173,12 @@ public:
     void print(std::ostream& _ros, const PrintWhat _what) const;
 
 private:
+    using TimePointT = std::chrono::steady_clock::time_point;
+
     enum {
         InnerLinkStatus = 0,
         InnerLinkOrder,
+        InnerLinkDeadline,
         InnerLinkCount
     };
 
@@ -184,8 +213,11 @@ private:
         MessageBundle        msgbundle_;
         uint32_t             unique_;
         size_t               packet_count_;
+        size_t               credit_; //body bytes we may still write - InvalidSize() if not paced
+        size_t               multicast_pos_; //body bytes already copied from the multicast body
         Serializer::PointerT serializer_ptr_;
         MessageId            pool_msg_id_;
+        TimePointT           deadline_; //the response deadline - see deadline_inner_list_
         StateE               state_;
         RelayData*           prelay_data_; //TODO: make somehow prelay_data_ act as a const pointer as its data must not be changed by Writer
         const char*          prelay_pos_;
@@ -195,6 +227,8 @@ private:
             MessageBundle& _rmsgbundle)
             : msgbundle_(std::move(_rmsgbundle))
             , packet_count_(0)
+            , credit_(InvalidSize())
+            , multicast_pos_(0)
             , state_(StateE::WriteStart)
             , prelay_data_(nullptr)
         {
@@ -203,6 +237,8 @@ private:
         MessageStub()
             : unique_(0)
             , packet_count_(0)
+            , credit_(InvalidSize())
+            , multicast_pos_(0)
             , state_(StateE::WriteStart)
             , prelay_data_(nullptr)
         {
@@ -214,8 +250,11 @@ private:
             , msgbundle_(std::move(_rmsgstub.msgbundle_))
             , unique_(_rmsgstub.unique_)
             , packet_count_(_rmsgstub.packet_count_)
+            , credit_(_rmsgstub.credit_)
+            , multicast_pos_(_rmsgstub.multicast_pos_)
             , serializer_ptr_(std::move(_rmsgstub.serializer_ptr_))
             , pool_msg_id_(_rmsgstub.pool_msg_id_)
+            , deadline_(_rmsgstub.deadline_)
             , state_(_rmsgstub.state_)
             , prelay_data_(nullptr)
         {
@@ -225,7 +264,9 @@ private:
         {
             msgbundle_.clear();
             ++unique_;
-            packet_count_ = 0;
+            packet_count_  = 0;
+            credit_        = InvalidSize();
+            multicast_pos_ = 0;
 
             solid_assert(prelay_data_ == nullptr);
             serializer_ptr_ = nullptr;
@@ -244,6 +285,11 @@ private:
             return state_ == StateE::WriteStart || state_ == StateE::WriteHeadStart || state_ == StateE::WriteHeadContinue || state_ == StateE::RelayedStart || state_ == StateE::RelayedHeadStart || state_ == StateE::RelayedHeadContinue;
         }
 
+        bool isWaitCreditState(const size_t _min_credit) const noexcept
+        {
+            return (state_ == StateE::WriteBodyStart || state_ == StateE::WriteBodyContinue) && credit_ < _min_credit;
+        }
+
         bool isWaitResponseState() const noexcept
         {
             return state_ == StateE::WriteWait || state_ == StateE::RelayedWait;
@@ -268,11 +314,18 @@ private:
         {
             return Message::is_synchronous(msgbundle_.message_flags);
         }
+
+        bool isMulticast() const noexcept
+        {
+            return msgbundle_.multicast_body_ptr != nullptr;
+        }
     };
 
-    using MessageVectorT          = std::vector<MessageStub>;
-    using MessageOrderInnerListT  = inner::List<MessageVectorT, InnerLinkOrder>;
-    using MessageStatusInnerListT = inner::List<MessageVectorT, InnerLinkStatus>;
+    using MessageVectorT            = std::vector<MessageStub>;
+    using CreditVectorT             = std::vector<std::pair<RequestId, uint32_t>>;
+    using MessageOrderInnerListT    = inner::List<MessageVectorT, InnerLinkOrder>;
+    using MessageStatusInnerListT   = inner::List<MessageVectorT, InnerLinkStatus>;
+    using MessageDeadlineInnerListT = inner::List<MessageVectorT, InnerLinkDeadline>;
 
     struct PacketOptions {
         bool force_no_compress;
@@ -301,7 +354,7 @@ private:
     bool isAsynchronousInPendingQueue() const;
     bool isDelayedCloseInPendingQueue() const;
 
-    bool doFindEligibleMessage(const bool _can_send_relay, const size_t _size);
+    bool doFindEligibleMessage(const bool _can_send_relay, const size_t _size, const size_t _min_credit);
 
     void doTryMoveMessageFromPendingToWriteQueue(mpipc::Configuration const& _rconfig);
 
@@ -360,6 +413,17 @@ private:
         PacketOptions&   _rpacket_options,
         Sender&          _rsender,
         ErrorConditionT& _rerror);
+    long doWriteMulticastBody(
+        char*            _pbufpos,
+        const size_t     _bufsz,
+        const size_t     _msgidx,
+        Sender&          _rsender,
+        bool&            _rdone,
+        ErrorConditionT& _rerror);
+    void doProduceMulticastChunk(
+        const size_t _msgidx,
+        Sender&      _rsender);
+
     void doTryCompleteMessageAfterSerialization(
         const size_t     _msgidx,
         Sender&          _rsender,
@@ -371,13 +435,18 @@ private:
     Serializer::PointerT createSerializer(Sender& _sender);
 
 private:
-    MessageVectorT          message_vec_;
-    uint32_t                current_message_type_id_;
-    size_t                  current_synchronous_message_idx_;
-    MessageOrderInnerListT  order_inner_list_;
-    MessageStatusInnerListT write_inner_list_;
-    MessageStatusInnerListT cache_inner_list_;
-    Serializer::PointerT    ser_top_;
+    MessageVectorT            message_vec_;
+    uint32_t                  current_message_type_id_;
+    size_t                    current_synchronous_message_idx_;
+    MessageOrderInnerListT    order_inner_list_;
+    MessageStatusInnerListT   write_inner_list_;
+    MessageStatusInnerListT   cache_inner_list_;
+    //requests waiting for responses, in the order they were written.
+    //The response timeout is the same for all of them, so the list is
+    //also sorted by deadline and only its front needs a timer.
+    MessageDeadlineInnerListT deadline_inner_list_;
+    Serializer::PointerT      ser_top_;
+    CreditVectorT             credit_grant_vec_;
 };
 
 typedef std::pair<MessageWriter const&, MessageWriter::PrintWhat> MessageWriterPrintPairT;
@@ -18,6 +18,12 @@
 #include <utility>
 #include <vector>
 
+#ifndef SOLID_ON_WINDOWS
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "solid/system/cpu.hpp"
 #include "solid/system/exception.hpp"
 #include "solid/system/log.hpp"
 #include "solid/system/socketdevice.hpp"
@@ -610,6 +616,50 @@ struct ConnectionPoolStub {
 
 typedef std::deque<ConnectionPoolStub> ConnectionPoolDequeT;
 typedef Stack<size_t>                  SizeStackT;
+typedef std::vector<RecvBufferPointerT> RecvBufferVectorT;
+typedef std::vector<SendBufferPointerT> SendBufferVectorT;
+typedef std::vector<RecvBufferVectorT>  RecvBufferVectorTVectorT;
+typedef std::vector<SendBufferVectorT>  SendBufferVectorTVectorT;
+
+//-----------------------------------------------------------------------------
+
+namespace {
+
+void incoming_cpu(SocketDevice& _rsd, CpuSetT const& _rcpu_set)
+{
+    if (!_rcpu_set.empty()) {
+        const ErrorCodeT err = _rsd.incomingCpu(_rcpu_set.front());
+        if (err) {
+            solid_log(logger, Warning, "SO_INCOMING_CPU " << _rcpu_set.front() << ": " << err.message());
+        }
+    }
+}
+
+void prepare_local_listener(SocketDevice& _rsd, const char* _path)
+{
+    const SocketAddress addr(_path);
+
+    if (addr.empty()) {
+        solid_log(logger, Error, "invalid unix socket path: " << _path);
+        return;
+    }
+#ifndef SOLID_ON_WINDOWS
+    struct stat st;
+    //remove the socket file left by a previous run - bind would fail with EADDRINUSE
+    if (!addr.isAbstract() && lstat(_path, &st) == 0 && S_ISSOCK(st.st_mode)) {
+        unlink(_path);
+    }
+#endif
+    _rsd.create(SocketInfo::Local);
+
+    const ErrorCodeT errc = _rsd.prepareAccept(addr, Listener::backlog_size());
+    if (errc) {
+        solid_log(logger, Error, "listening on unix socket " << addr << ": " << errc.message());
+        _rsd.close();
+    }
+}
+
+} //namespace
 
 //-----------------------------------------------------------------------------
 
@@ -619,6 +669,8 @@ struct Service::Data {
         : pmtxarr(nullptr)
         , mtxsarrcp(0)
         , config() /*, status(Status::Running)*/
+        , recv_buffer_pool_vec(numa_node_count())
+        , send_buffer_pool_vec(numa_node_count())
     {
     }
 
@@ -646,6 +698,29 @@ struct Service::Data {
         }
     }
 
+    void clearBufferPool()
+    {
+        lock_guard<std::mutex> lock(buffer_pool_mtx);
+        for (auto& rpool : recv_buffer_pool_vec) {
+            rpool.clear();
+        }
+        for (auto& rpool : send_buffer_pool_vec) {
+            rpool.clear();
+        }
+    }
+
+    //one pool per NUMA node, so that a connection does not reuse
+    //a buffer from the memory of another node
+    RecvBufferVectorT& recvBufferPool(const size_t _numa_node)
+    {
+        return recv_buffer_pool_vec[_numa_node % recv_buffer_pool_vec.size()];
+    }
+
+    SendBufferVectorT& sendBufferPool(const size_t _numa_node)
+    {
+        return send_buffer_pool_vec[_numa_node % send_buffer_pool_vec.size()];
+    }
+
     std::mutex           mtx;
     std::mutex*          pmtxarr;
     size_t               mtxsarrcp;
@@ -654,6 +729,9 @@ struct Service::Data {
     SizeStackT           conpoolcachestk;
     Configuration        config;
     std::string          tmp_str;
+    std::mutex           buffer_pool_mtx;
+    RecvBufferVectorTVectorT recv_buffer_pool_vec;
+    SendBufferVectorTVectorT send_buffer_pool_vec;
 };
 //=============================================================================
 
@@ -695,28 +773,42 @@ ErrorConditionT Service::doStart()
     }
 
     if (!configuration().server.listener_address_str.empty()) {
-        std::string tmp;
-        const char* hst_name;
-        const char* svc_name;
-
-        size_t off = impl_->config.server.listener_address_str.rfind(':');
-        if (off != std::string::npos) {
-            tmp      = impl_->config.server.listener_address_str.substr(0, off);
-            hst_name = tmp.c_str();
-            svc_name = impl_->config.server.listener_address_str.c_str() + off + 1;
-            if (svc_name[0] == 0) {
+        const char*    local_path = unix_socket_path(impl_->config.server.listener_address_str.c_str());
+        AioSchedulerT& rsch       = impl_->config.scheduler();
+        //SO_REUSEPORT does not spread unix domain connections
+        const bool   per_reactor = local_path == nullptr && impl_->config.server.listener_per_reactor && rsch.reactorCount() > 1;
+        SocketDevice sd;
+        ResolveData  rd;
+
+        if (local_path != nullptr) {
+            prepare_local_listener(sd, local_path);
+        } else {
+            std::string tmp;
+            const char* hst_name;
+            const char* svc_name;
+
+            size_t off = impl_->config.server.listener_address_str.rfind(':');
+            if (off != std::string::npos) {
+                tmp      = impl_->config.server.listener_address_str.substr(0, off);
+                hst_name = tmp.c_str();
+                svc_name = impl_->config.server.listener_address_str.c_str() + off + 1;
+                if (svc_name[0] == 0) {
+                    svc_name = impl_->config.server.listener_service_str.c_str();
+                }
+            } else {
+                hst_name = impl_->config.server.listener_address_str.c_str();
                 svc_name = impl_->config.server.listener_service_str.c_str();
             }
-        } else {
-            hst_name = impl_->config.server.listener_address_str.c_str();
-            svc_name = impl_->config.server.listener_service_str.c_str();
-        }
 
-        ResolveData  rd = synchronous_resolve(hst_name, svc_name, 0, -1, SocketInfo::Stream);
-        SocketDevice sd;
+            rd = synchronous_resolve(hst_name, svc_name, 0, -1, SocketInfo::Stream);
+        }
 
         if (!rd.empty()) {
             sd.create(rd.begin());
+            if (per_reactor) {
+                sd.enableReusePort();
+                incoming_cpu(sd, rsch.reactorCpuSet(0));
+            }
             const ErrorCodeT errc = sd.prepareAccept(rd.begin(), Listener::backlog_size());
             if (errc) {
                 sd.close();
@@ -729,12 +821,41 @@ ErrorConditionT Service::doStart()
 
             sd.localAddress(local_address);
 
-            impl_->config.server.listener_port = local_address.port();
+            if (local_path == nullptr) {
+                impl_->config.server.listener_port = local_address.port();
+            }
+
+            if (per_reactor) {
+                //the other listeners bind on the actual port of the first one
+                for (size_t i = 1; i < rsch.reactorCount(); ++i) {
+                    SocketDevice rp_sd;
+
+                    rp_sd.create(rd.begin());
+                    rp_sd.enableReusePort();
+                    incoming_cpu(rp_sd, rsch.reactorCpuSet(i));
+
+                    if (rp_sd.prepareAccept(local_address, Listener::backlog_size())) {
+                        error = error_service_start_listener;
+                        return error;
+                    }
+
+                    DynamicPointer<aio::Object> objptr(new Listener(rp_sd, i));
+
+                    rsch.startObject(i, objptr, *this, make_event(GenericEvents::Start), error);
+                    if (error) {
+                        return error;
+                    }
+                }
+
+                DynamicPointer<aio::Object> objptr(new Listener(sd, 0));
 
-            DynamicPointer<aio::Object> objptr(new Listener(sd));
+                rsch.startObject(0, objptr, *this, make_event(GenericEvents::Start), error);
+            } else {
+                DynamicPointer<aio::Object> objptr(new Listener(sd));
 
-            ObjectIdT conuid = impl_->config.scheduler().startObject(objptr, *this, make_event(GenericEvents::Start), error);
-            (void)conuid;
+                ObjectIdT conuid = rsch.startObject(objptr, *this, make_event(GenericEvents::Start), error);
+                (void)conuid;
+            }
             if (error) {
                 return error;
             }
@@ -772,10 +893,76 @@ ErrorConditionT Service::reconfigure(Configuration&& _ucfg)
         }
 
         impl_->config.reset(std::move(_ucfg));
+        impl_->clearBufferPool(); //buffer capacities might have changed
     }
     return doStart();
 }
 //-----------------------------------------------------------------------------
+// Only buffers with the start capacity are pooled - the others are freed.
+RecvBufferPointerT Service::acquireRecvBuffer(const size_t _numa_node, uint8_t& _rbuffer_capacity_kb)
+{
+    const Configuration& rconfig = configuration();
+
+    if (_rbuffer_capacity_kb == rconfig.connection_recv_buffer_start_capacity_kb) {
+        lock_guard<std::mutex> lock(impl_->buffer_pool_mtx);
+        RecvBufferVectorT&     rpool = impl_->recvBufferPool(_numa_node);
+        if (!rpool.empty()) {
+            RecvBufferPointerT buf = std::move(rpool.back());
+            rpool.pop_back();
+            return buf;
+        }
+    }
+    return rconfig.allocateRecvBuffer(_rbuffer_capacity_kb);
+}
+//-----------------------------------------------------------------------------
+SendBufferPointerT Service::acquireSendBuffer(const size_t _numa_node, uint8_t& _rbuffer_capacity_kb)
+{
+    const Configuration& rconfig = configuration();
+
+    if (_rbuffer_capacity_kb == rconfig.connection_send_buffer_start_capacity_kb) {
+        lock_guard<std::mutex> lock(impl_->buffer_pool_mtx);
+        SendBufferVectorT&     rpool = impl_->sendBufferPool(_numa_node);
+        if (!rpool.empty()) {
+            SendBufferPointerT buf = std::move(rpool.back());
+            rpool.pop_back();
+            return buf;
+        }
+    }
+    return rconfig.allocateSendBuffer(_rbuffer_capacity_kb);
+}
+//-----------------------------------------------------------------------------
+void Service::releaseRecvBuffer(const size_t _numa_node, RecvBufferPointerT& _rbuf, const uint8_t _buffer_capacity_kb)
+{
+    const Configuration& rconfig = configuration();
+
+    if (_rbuf && _rbuf.use_count() == 1 && _buffer_capacity_kb == rconfig.connection_recv_buffer_start_capacity_kb) {
+        lock_guard<std::mutex> lock(impl_->buffer_pool_mtx);
+        RecvBufferVectorT&     rpool = impl_->recvBufferPool(_numa_node);
+
+        if (rpool.size() < rconfig.connection_buffer_pool_max_count) {
+            rpool.emplace_back(std::move(_rbuf));
+            return;
+        }
+    }
+    _rbuf.reset();
+}
+//-----------------------------------------------------------------------------
+void Service::releaseSendBuffer(const size_t _numa_node, SendBufferPointerT& _rbuf, const uint8_t _buffer_capacity_kb)
+{
+    const Configuration& rconfig = configuration();
+
+    if (_rbuf && _buffer_capacity_kb == rconfig.connection_send_buffer_start_capacity_kb) {
+        lock_guard<std::mutex> lock(impl_->buffer_pool_mtx);
+        SendBufferVectorT&     rpool = impl_->sendBufferPool(_numa_node);
+
+        if (rpool.size() < rconfig.connection_buffer_pool_max_count) {
+            rpool.emplace_back(std::move(_rbuf));
+            return;
+        }
+    }
+    _rbuf.reset();
+}
+//-----------------------------------------------------------------------------
 size_t Service::doPushNewConnectionPool()
 {
 
@@ -875,13 +1062,14 @@ ErrorConditionT Service::doCreateConnectionPool(
 
 //-----------------------------------------------------------------------------
 ErrorConditionT Service::doSendMessage(
-    const char*               _recipient_url,
-    const RecipientId&        _rrecipient_id_in,
-    MessagePointerT&          _rmsgptr,
-    MessageCompleteFunctionT& _rcomplete_fnc,
-    RecipientId*              _precipient_id_out,
-    MessageId*                _pmsgid_out,
-    const MessageFlagsT&      _flags)
+    const char*                  _recipient_url,
+    const RecipientId&           _rrecipient_id_in,
+    MessagePointerT&             _rmsgptr,
+    MessageCompleteFunctionT&    _rcomplete_fnc,
+    RecipientId*                 _precipient_id_out,
+    MessageId*                   _pmsgid_out,
+    const MessageFlagsT&         _flags,
+    const MulticastBodyPointerT& _rmulticast_body_ptr)
 {
 
     solid_dbg(logger, Verbose, this);
@@ -947,7 +1135,8 @@ ErrorConditionT Service::doSendMessage(
             _rcomplete_fnc,
             _pmsgid_out,
             _flags,
-            message_url);
+            message_url,
+            _rmulticast_body_ptr);
     }
 
     if (recipient_name != nullptr) {
@@ -964,7 +1153,7 @@ ErrorConditionT Service::doSendMessage(
 
             return this->doSendMessageToNewPool(
                 recipient_name, _rmsgptr, msg_type_idx,
-                _rcomplete_fnc, _precipient_id_out, _pmsgid_out, _flags, message_url);
+                _rcomplete_fnc, _precipient_id_out, _pmsgid_out, _flags, message_url, _rmulticast_body_ptr);
         }
     } else if (
         static_cast<size_t>(_rrecipient_id_in.poolid.index) < impl_->pooldq.size()) {
@@ -1008,6 +1197,8 @@ ErrorConditionT Service::doSendMessage(
     //because from now on we can call complete on the message
     const MessageId msgid = rpool.pushBackMessage(_rmsgptr, msg_type_idx, _rcomplete_fnc, _flags, message_url);
 
+    rpool.msgvec[msgid.index].msgbundle.multicast(_rmulticast_body_ptr);
+
     if (_pmsgid_out != nullptr) {
 
         MessageStub& rmsgstub(rpool.msgvec[msgid.index]);
@@ -1065,14 +1256,55 @@ ErrorConditionT Service::doSendMessage(
 
 //-----------------------------------------------------------------------------
 
+ErrorConditionT Service::doMulticastMessage(
+    std::vector<RecipientId> const* _precipient_id_vec,
+    std::vector<std::string> const* _precipient_url_vec,
+    MessagePointerT const&          _rmsgptr,
+    const MessageFlagsT&            _flags)
+{
+    solid_dbg(logger, Verbose, this);
+
+    if (Message::is_request(_flags) || Message::is_response(_flags)) {
+        return error_service_message_flags;
+    }
+
+    //shared by all the messages - the connections write it chunk by chunk
+    const MulticastBodyPointerT multicast_body_ptr = std::make_shared<MulticastBody>();
+    const size_t                recipient_count    = _precipient_id_vec != nullptr ? _precipient_id_vec->size() : _precipient_url_vec->size();
+    ErrorConditionT             error;
+
+    for (size_t i = 0; i < recipient_count; ++i) {
+        MessagePointerT          msgptr(_rmsgptr);
+        MessageCompleteFunctionT complete_handler;
+        ErrorConditionT          err;
+
+        if (_precipient_id_vec != nullptr) {
+            err = doSendMessage(nullptr, (*_precipient_id_vec)[i], msgptr, complete_handler, nullptr, nullptr, _flags, multicast_body_ptr);
+        } else {
+            err = doSendMessage((*_precipient_url_vec)[i].c_str(), RecipientId(), msgptr, complete_handler, nullptr, nullptr, _flags, multicast_body_ptr);
+        }
+
+        if (err && !error) {
+            solid_dbg(logger, Error, this << " multicast to recipient " << i << " failed: " << err.message());
+            error = err;
+        }
+    }
+    //from now on only the messages hold the chunks
+    multicast_body_ptr->head_ptr_.reset();
+    return error;
+}
+
+//-----------------------------------------------------------------------------
+
 ErrorConditionT Service::doSendMessageToConnection(
-    const RecipientId&        _rrecipient_id_in,
-    MessagePointerT&          _rmsgptr,
-    const size_t              _msg_type_idx,
-    MessageCompleteFunctionT& _rcomplete_fnc,
-    MessageId*                _pmsgid_out,
-    const MessageFlagsT&      _flags,
-    std::string&              _msg_url)
+    const RecipientId&           _rrecipient_id_in,
+    MessagePointerT&             _rmsgptr,
+    const size_t                 _msg_type_idx,
+    MessageCompleteFunctionT&    _rcomplete_fnc,
+    MessageId*                   _pmsgid_out,
+    const MessageFlagsT&         _flags,
+    std::string&                 _msg_url,
+    const MulticastBodyPointerT& _rmulticast_body_ptr)
 {
     //d.mtx must be locked
 
@@ -1101,12 +1333,18 @@ ErrorConditionT Service::doSendMessageToConnection(
     if (is_server_side_pool) {
         //for a server pool we want to enque messages in the pool
         //
-        msgid   = rpool.pushBackMessage(_rmsgptr, _msg_type_idx, _rcomplete_fnc, _flags | MessageFlagsE::OneShotSend, _msg_url);
+        msgid = rpool.pushBackMessage(_rmsgptr, _msg_type_idx, _rcomplete_fnc, _flags | MessageFlagsE::OneShotSend, _msg_url);
+
+        rpool.msgvec[msgid.index].msgbundle.multicast(_rmulticast_body_ptr);
+
         success = manager().notify(
             _rrecipient_id_in.connectionId(),
             Connection::eventNewMessage());
     } else {
-        msgid   = rpool.insertMessage(_rmsgptr, _msg_type_idx, _rcomplete_fnc, _flags | MessageFlagsE::OneShotSend, _msg_url);
+        msgid = rpool.insertMessage(_rmsgptr, _msg_type_idx, _rcomplete_fnc, _flags | MessageFlagsE::OneShotSend, _msg_url);
+
+        rpool.msgvec[msgid.index].msgbundle.multicast(_rmulticast_body_ptr);
+
         success = manager().notify(
             _rrecipient_id_in.connectionId(),
             Connection::eventNewMessage(msgid));
@@ -1132,14 +1370,15 @@ ErrorConditionT Service::doSendMessageToConnection(
 //-----------------------------------------------------------------------------
 
 ErrorConditionT Service::doSendMessageToNewPool(
-    const char*               _recipient_name,
-    MessagePointerT&          _rmsgptr,
-    const size_t              _msg_type_idx,
-    MessageCompleteFunctionT& _rcomplete_fnc,
-    RecipientId*              _precipient_id_out,
-    MessageId*                _pmsgid_out,
-    const MessageFlagsT&      _flags,
-    std::string&              _msg_url)
+    const char*                  _recipient_name,
+    MessagePointerT&             _rmsgptr,
+    const size_t                 _msg_type_idx,
+    MessageCompleteFunctionT&    _rcomplete_fnc,
+    RecipientId*                 _precipient_id_out,
+    MessageId*                   _pmsgid_out,
+    const MessageFlagsT&         _flags,
+    std::string&                 _msg_url,
+    const MulticastBodyPointerT& _rmulticast_body_ptr)
 {
 
     solid_dbg(logger, Verbose, this);
@@ -1161,6 +1400,8 @@ ErrorConditionT Service::doSendMessageToNewPool(
 
     MessageId msgid = rpool.pushBackMessage(_rmsgptr, _msg_type_idx, _rcomplete_fnc, _flags, _msg_url);
 
+    rpool.msgvec[msgid.index].msgbundle.multicast(_rmulticast_body_ptr);
+
     if (!doTryCreateNewConnectionForPool(pool_index, error)) {
         solid_dbg(logger, Error, this << " Starting Session: " << error.message());
         rpool.popFrontMessage();
@@ -2193,17 +2434,24 @@ bool Service::doTryCreateNewConnectionForPool(const size_t _pool_index, ErrorCon
     solid_dbg(logger, Verbose, this);
 
     ConnectionPoolStub& rpool(impl_->pooldq[_pool_index]);
-    const bool          is_new_connection_needed = rpool.active_connection_count < rpool.persistent_connection_count || (rpool.hasAnyMessage() && rpool.conn_waitingq.size() < rpool.msgorder_inner_list.size());
+    bool                started = false;
 
-    if (
-        rpool.active_connection_count < configuration().pool_max_active_connection_count && rpool.pending_connection_count == 0 && is_new_connection_needed && isRunning()) {
+    while (true) {
+        const bool is_new_connection_needed = rpool.active_connection_count < rpool.persistent_connection_count || (rpool.hasAnyMessage() && rpool.conn_waitingq.size() < rpool.msgorder_inner_list.size());
+        //the standby connections of a persistent pool are warmed up concurrently
+        const bool is_warmup_needed = (static_cast<size_t>(rpool.active_connection_count) + rpool.pending_connection_count) < rpool.persistent_connection_count && rpool.pending_connection_count < configuration().pool_max_pending_connection_count;
 
-        solid_dbg(logger, Info, this << " try create new connection in pool " << rpool.active_connection_count << " pending connections " << rpool.pending_connection_count);
+        if (
+            rpool.active_connection_count < configuration().pool_max_active_connection_count && (rpool.pending_connection_count == 0 || is_warmup_needed) && is_new_connection_needed && isRunning()) {
 
-        DynamicPointer<aio::Object> objptr(new_connection(configuration(), ConnectionPoolId(_pool_index, rpool.unique), rpool.name));
-        ObjectIdT                   conuid = impl_->config.scheduler().startObject(objptr, *this, make_event(GenericEvents::Start), _rerror);
+            solid_dbg(logger, Info, this << " try create new connection in pool " << rpool.active_connection_count << " pending connections " << rpool.pending_connection_count);
 
-        if (!_rerror) {
+            DynamicPointer<aio::Object> objptr(new_connection(configuration(), ConnectionPoolId(_pool_index, rpool.unique), rpool.name));
+            ObjectIdT                   conuid = impl_->config.scheduler().startObject(objptr, *this, make_event(GenericEvents::Start), _rerror);
+
+            if (_rerror) {
+                break;
+            }
 
             solid_dbg(logger, Info, this << " Success starting Connection Pool object: " << conuid.index << ',' << conuid.unique);
 
@@ -2228,12 +2476,22 @@ bool Service::doTryCreateNewConnectionForPool(const size_t _pool_index, ErrorCon
                 manager().notify(conuid, std::move(event));
             }
 
-            return true;
+            started = true;
+
+            if (!is_warmup_needed) {
+                break;
+            }
+        } else {
+            if (!started) {
+                _rerror = error_service_connection_not_needed;
+            }
+            break;
         }
-    } else {
-        _rerror = error_service_connection_not_needed;
     }
-    return false;
+    if (started) {
+        _rerror.clear();
+    }
+    return started;
 }
 //-----------------------------------------------------------------------------
 void Service::forwardResolveMessage(ConnectionPoolId const& _rpoolid, Event& _revent)
@@ -2306,15 +2564,17 @@ void Service::doPushFrontMessageToPool(
 
         _rmsgbundle.message_flags.reset(MessageFlagsE::DoneSend).reset(MessageFlagsE::StartedSend);
 
+        MessageId msgid;
+
         if (_rmsgid.isInvalid()) {
-            rpool.pushFrontMessage(
+            msgid = rpool.pushFrontMessage(
                 _rmsgbundle.message_ptr,
                 _rmsgbundle.message_type_id,
                 _rmsgbundle.complete_fnc,
                 _rmsgbundle.message_flags,
                 _rmsgbundle.message_url);
         } else {
-            rpool.reinsertFrontMessage(
+            msgid = rpool.reinsertFrontMessage(
                 _rmsgid,
                 _rmsgbundle.message_ptr,
                 _rmsgbundle.message_type_id,
@@ -2322,6 +2582,8 @@ void Service::doPushFrontMessageToPool(
                 _rmsgbundle.message_flags,
                 _rmsgbundle.message_url);
         }
+        //a resent multicast message serializes its own body: the chunks
+        //already written might have been released
     }
 }
 //-----------------------------------------------------------------------------
@@ -2394,7 +2656,7 @@ ErrorConditionT Service::activateConnection(ConnectionContext& _rconctx, ObjectI
     return error;
 }
 //-----------------------------------------------------------------------------
-void Service::acceptIncomingConnection(SocketDevice& _rsd)
+void Service::acceptIncomingConnection(SocketDevice& _rsd, const size_t _reactor_index)
 {
 
     solid_dbg(logger, Verbose, this);
@@ -2421,8 +2683,15 @@ void Service::acceptIncomingConnection(SocketDevice& _rsd)
 
         solid::ErrorConditionT error;
 
-        ObjectIdT con_id = impl_->config.scheduler().startObject(
-            objptr, *this, make_event(GenericEvents::Start), error);
+        ObjectIdT con_id;
+
+        if (is_valid_index(_reactor_index)) {
+            con_id = impl_->config.scheduler().startObject(
+                _reactor_index, objptr, *this, make_event(GenericEvents::Start), error);
+        } else {
+            con_id = impl_->config.scheduler().startObject(
+                objptr, *this, make_event(GenericEvents::Start), error);
+        }
 
         solid_dbg(logger, Info, this << " receive connection [" << con_id << "] error = " << error.message());
 
@@ -2513,6 +2782,18 @@ struct ResolveF {
 
 void InternetResolverF::operator()(const std::string& _name, ResolveCompleteFunctionT& _cbk)
 {
+    const char* local_path = unix_socket_path(_name.c_str());
+
+    if (local_path != nullptr) {
+        AddressVectorT addrvec;
+        SocketAddress  addr(local_path);
+
+        if (!addr.empty()) {
+            addrvec.emplace_back(addr);
+        }
+        _cbk(std::move(addrvec));
+        return;
+    }
 
     std::string tmp;
     const char* hst_name;
@@ -16,6 +16,10 @@
 
 #include "solid/frame/mpipc/mpipcservice.hpp"
 
+#include <atomic>
+#include <mutex>
+#include <string>
+
 namespace solid {
 namespace frame {
 namespace mpipc {
@@ -155,12 +159,57 @@ private:
     uint16_t size_;
 };
 
+struct MulticastChunk;
+using MulticastChunkPointerT = std::shared_ptr<MulticastChunk>;
+
+//! A packet sized piece of a MulticastBody
+/*!
+ * Immutable once ready_ - next_ is the placeholder of the following chunk
+ * or empty for the last one.
+ */
+struct MulticastChunk {
+    std::atomic<bool>      ready_;
+    std::string            data_;
+    MulticastChunkPointerT next_;
+    ErrorConditionT        error_;
+
+    MulticastChunk()
+        : ready_(false)
+    {
+    }
+};
+
+//! Message body serialized once for all the recipients of a Service::multicastMessage
+/*!
+ * The body is serialized lazily, one packet sized chunk at a time, into a
+ * list of shared chunks. The connection getting first to a chunk not yet
+ * produced serializes it, under mutex_, with the serializer kept here - in
+ * its own ConnectionContext - while the others copy, with no lock held, the
+ * chunks already produced.
+ * Every recipient message only holds the chunk it copies from, so a chunk
+ * is released once all the recipients went past it: the memory used follows
+ * the distance between the fastest and the slowest connection, not the body
+ * size.
+ */
+struct MulticastBody {
+    std::mutex             mutex_;
+    Serializer::PointerT   serializer_ptr_; //of the chunks in production
+    MulticastChunkPointerT head_ptr_; //only held while the message is handed to the connections
+
+    MulticastBody()
+        : head_ptr_(std::make_shared<MulticastChunk>())
+    {
+    }
+};
+
 struct MessageBundle {
     size_t                   message_type_id;
     MessageFlagsT            message_flags;
     MessagePointerT          message_ptr;
     MessageCompleteFunctionT complete_fnc;
     std::string              message_url;
+    MulticastBodyPointerT    multicast_body_ptr;
+    MulticastChunkPointerT   multicast_chunk_ptr; //the chunk of the multicast body being written
 
     MessageBundle()
         : message_type_id(InvalidIndex())
@@ -188,16 +237,20 @@ struct MessageBundle {
         , message_flags(_rmsgbundle.message_flags)
         , message_ptr(std::move(_rmsgbundle.message_ptr))
         , message_url(std::move(_rmsgbundle.message_url))
+        , multicast_body_ptr(std::move(_rmsgbundle.multicast_body_ptr))
+        , multicast_chunk_ptr(std::move(_rmsgbundle.multicast_chunk_ptr))
     {
         std::swap(complete_fnc, _rmsgbundle.complete_fnc);
     }
 
     MessageBundle& operator=(MessageBundle&& _rmsgbundle)
     {
-        message_type_id = _rmsgbundle.message_type_id;
-        message_flags   = _rmsgbundle.message_flags;
-        message_ptr     = std::move(_rmsgbundle.message_ptr);
-        message_url     = std::move(_rmsgbundle.message_url);
+        message_type_id     = _rmsgbundle.message_type_id;
+        message_flags       = _rmsgbundle.message_flags;
+        message_ptr         = std::move(_rmsgbundle.message_ptr);
+        message_url         = std::move(_rmsgbundle.message_url);
+        multicast_body_ptr  = std::move(_rmsgbundle.multicast_body_ptr);
+        multicast_chunk_ptr = std::move(_rmsgbundle.multicast_chunk_ptr);
         solid_function_clear(complete_fnc);
         std::swap(complete_fnc, _rmsgbundle.complete_fnc);
         return *this;
@@ -209,8 +262,20 @@ struct MessageBundle {
         message_flags.reset();
         message_ptr.reset();
         message_url.clear();
+        multicast_body_ptr.reset();
+        multicast_chunk_ptr.reset();
         solid_function_clear(complete_fnc);
     }
+
+    void multicast(const MulticastBodyPointerT& _rbody_ptr)
+    {
+        multicast_body_ptr = _rbody_ptr;
+        if (_rbody_ptr) {
+            multicast_chunk_ptr = _rbody_ptr->head_ptr_;
+        } else {
+            multicast_chunk_ptr.reset();
+        }
+    }
 };
 
 } //namespace mpipc
@@ -0,0 +1,217 @@
+#include "solid/frame/mpipc/mpipcsocketstub_openssl.hpp"
+
+#include "solid/frame/manager.hpp"
+#include "solid/frame/scheduler.hpp"
+#include "solid/frame/service.hpp"
+
+#include "solid/frame/aio/aioobject.hpp"
+#include "solid/frame/aio/aioreactor.hpp"
+#include "solid/frame/aio/aioresolver.hpp"
+
+#include "solid/frame/mpipc/mpipcconfiguration.hpp"
+#include "solid/frame/mpipc/mpipcerror.hpp"
+#include "solid/frame/mpipc/mpipcprotocol_serialization_v2.hpp"
+#include "solid/frame/mpipc/mpipcservice.hpp"
+
+#include <algorithm>
+#include <condition_variable>
+#include <mutex>
+#include <set>
+#include <thread>
+
+#include "solid/system/cpu.hpp"
+#include "solid/system/exception.hpp"
+
+#include "solid/system/log.hpp"
+
+#include <iostream>
+
+#ifdef SOLID_ON_LINUX
+#include <sched.h>
+#endif
+
+using namespace std;
+using namespace solid;
+
+using AioSchedulerT = frame::Scheduler<frame::aio::Reactor>;
+using ProtocolT     = frame::mpipc::serialization_v2::Protocol<uint8_t>;
+
+namespace {
+const LoggerT logger("test_connection_affinity");
+
+mutex              mtx;
+condition_variable cnd;
+size_t             server_connection_count = 0;
+size_t             back_count              = 0;
+set<thread::id>    server_thread_set;
+CpuSetT            server_cpu_set; //all the CPUs of the server reactors
+
+struct Message : frame::mpipc::Message {
+    uint32_t idx;
+
+    Message(uint32_t _idx)
+        : idx(_idx)
+    {
+    }
+    Message() {}
+
+    SOLID_PROTOCOL_V2(_s, _rthis, _rctx, _name)
+    {
+        _s.add(_rthis.idx, _rctx, "idx");
+    }
+};
+
+//called on the reactor thread of the connection
+void server_connection_start(frame::mpipc::ConnectionContext& _rctx)
+{
+    solid_dbg(logger, Info, _rctx.recipientId());
+#ifdef SOLID_ON_LINUX
+    const int cpu = sched_getcpu();
+    solid_check(cpu >= 0 && find(server_cpu_set.begin(), server_cpu_set.end(), static_cast<size_t>(cpu)) != server_cpu_set.end(), "server reactor running on CPU " << cpu);
+#endif
+    lock_guard<mutex> lock(mtx);
+    server_thread_set.insert(this_thread::get_id());
+    ++server_connection_count;
+    cnd.notify_one();
+}
+
+void connection_stop(frame::mpipc::ConnectionContext& _rctx)
+{
+    solid_dbg(logger, Info, _rctx.recipientId() << " error: " << _rctx.error().message());
+}
+
+void client_complete_message(
+    frame::mpipc::ConnectionContext& _rctx,
+    std::shared_ptr<Message>& _rsent_msg_ptr, std::shared_ptr<Message>& _rrecv_msg_ptr,
+    ErrorConditionT const& _rerror)
+{
+    solid_check(!_rerror, "message failed: " << _rerror.message());
+
+    if (_rrecv_msg_ptr) {
+        lock_guard<mutex> lock(mtx);
+        ++back_count;
+        cnd.notify_one();
+    }
+}
+
+void server_complete_message(
+    frame::mpipc::ConnectionContext& _rctx,
+    std::shared_ptr<Message>& _rsent_msg_ptr, std::shared_ptr<Message>& _rrecv_msg_ptr,
+    ErrorConditionT const& _rerror)
+{
+    if (_rrecv_msg_ptr) {
+        _rctx.service().sendResponse(_rctx.recipientId(), _rrecv_msg_ptr);
+    }
+}
+
+} //namespace
+
+// Server with one SO_REUSEPORT listener per reactor, reactors bound to CPUs.
+// Usage: test_connection_affinity [REACTOR_COUNT] [CONNECTION_COUNT]
+int test_connection_affinity(int argc, char* argv[])
+{
+    solid::log_start(std::cerr, {".*:EW", "test_connection_affinity:VIEW"});
+
+    size_t reactor_count    = 2;
+    size_t connection_count = 32;
+
+    if (argc > 1) {
+        reactor_count = atoi(argv[1]);
+    }
+    if (argc > 2) {
+        connection_count = atoi(argv[2]);
+    }
+
+    //round-robin the reactors over the CPUs - more reactors than CPUs is fine
+    const CpuSetVectorT cpu_set_per_cpu_vec = cpu_set_per_cpu();
+    CpuSetVectorT       cpu_set_vec;
+
+    for (size_t i = 0; i < reactor_count; ++i) {
+        cpu_set_vec.push_back(cpu_set_per_cpu_vec[i % cpu_set_per_cpu_vec.size()]);
+        server_cpu_set.push_back(cpu_set_vec.back().front());
+    }
+
+    {
+        AioSchedulerT sch_client;
+        AioSchedulerT sch_server;
+
+        frame::Manager         m;
+        frame::mpipc::ServiceT mpipcserver(m);
+        frame::mpipc::ServiceT mpipcclient(m);
+        ErrorConditionT        err;
+        FunctionWorkPool       fwp{WorkPoolConfiguration()};
+        frame::aio::Resolver   resolver(fwp);
+
+        solid_check(!sch_client.start(1), "starting aio client scheduler");
+        solid_check(!sch_server.start(cpu_set_vec), "starting aio server scheduler");
+        solid_check(sch_server.reactorCount() == reactor_count, "wrong reactor count " << sch_server.reactorCount());
+
+        std::string server_port;
+
+        { //mpipc server initialization
+            auto                        proto = ProtocolT::create();
+            frame::mpipc::Configuration cfg(sch_server, proto);
+
+            proto->null(0);
+            proto->registerMessage<Message>(server_complete_message, 1);
+
+            cfg.connection_stop_fnc         = &connection_stop;
+            cfg.server.connection_start_fnc = &server_connection_start;
+
+            cfg.server.listener_address_str   = "0.0.0.0:0";
+            cfg.server.connection_start_state = frame::mpipc::ConnectionState::Active;
+            cfg.server.listener_per_reactor   = true;
+
+            err = mpipcserver.reconfigure(std::move(cfg));
+            solid_check(!err, "starting server mpipcservice: " << err.message());
+
+            std::ostringstream oss;
+            oss << mpipcserver.configuration().server.listenerPort();
+            server_port = oss.str();
+        }
+
+        { //mpipc client initialization
+            auto                        proto = ProtocolT::create();
+            frame::mpipc::Configuration cfg(sch_client, proto);
+
+            proto->null(0);
+            proto->registerMessage<Message>(client_complete_message, 1);
+
+            cfg.client.connection_start_state = frame::mpipc::ConnectionState::Active;
+            cfg.connection_stop_fnc           = &connection_stop;
+
+            cfg.pool_max_active_connection_count = connection_count;
+            cfg.pool_max_message_queue_size      = connection_count;
+
+            cfg.client.name_resolve_fnc = frame::mpipc::InternetResolverF(resolver, server_port.c_str());
+
+            err = mpipcclient.reconfigure(std::move(cfg));
+            solid_check(!err, "starting client mpipcservice: " << err.message());
+        }
+
+        err = mpipcclient.createConnectionPool("localhost", connection_count);
+        solid_check(!err, "creating connection pool: " << err.message());
+
+        {
+            unique_lock<mutex> lock(mtx);
+            solid_check(cnd.wait_for(lock, std::chrono::seconds(120), [connection_count]() { return server_connection_count == connection_count; }), "Connecting is taking too long.");
+        }
+
+        for (size_t i = 0; i < connection_count; ++i) {
+            frame::mpipc::MessagePointerT msgptr(new Message(static_cast<uint32_t>(i)));
+            err = mpipcclient.sendMessage("localhost", msgptr, {frame::mpipc::MessageFlagsE::WaitResponse});
+            solid_check(!err, "sending message: " << err.message());
+        }
+
+        {
+            unique_lock<mutex> lock(mtx);
+            solid_check(cnd.wait_for(lock, std::chrono::seconds(120), [connection_count]() { return back_count == connection_count; }), "Process is taking too long: " << back_count << " of " << connection_count);
+        }
+
+        solid_log(logger, Verbose, "server connections ran on " << server_thread_set.size() << " of " << reactor_count << " reactors");
+        //the kernel spreads the connections over the listeners
+        solid_check(connection_count < 16 || server_thread_set.size() == reactor_count, "connections on " << server_thread_set.size() << " of " << reactor_count << " reactors");
+    }
+
+    return 0;
+}
@@ -0,0 +1,203 @@
+#include "solid/frame/mpipc/mpipcsocketstub_openssl.hpp"
+
+#include "solid/frame/manager.hpp"
+#include "solid/frame/scheduler.hpp"
+#include "solid/frame/service.hpp"
+
+#include "solid/frame/aio/aioobject.hpp"
+#include "solid/frame/aio/aioreactor.hpp"
+#include "solid/frame/aio/aioresolver.hpp"
+
+#include "solid/frame/mpipc/mpipcconfiguration.hpp"
+#include "solid/frame/mpipc/mpipcerror.hpp"
+#include "solid/frame/mpipc/mpipcprotocol_serialization_v2.hpp"
+#include "solid/frame/mpipc/mpipcservice.hpp"
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#include "solid/system/exception.hpp"
+
+#include "solid/system/log.hpp"
+
+#include <iostream>
+
+using namespace std;
+using namespace solid;
+
+using AioSchedulerT = frame::Scheduler<frame::aio::Reactor>;
+using ProtocolT     = frame::mpipc::serialization_v2::Protocol<uint8_t>;
+
+namespace {
+const LoggerT logger("test_connection_coalesce");
+
+mutex              mtx;
+condition_variable cnd;
+size_t             recv_count = 0;
+
+struct Message : frame::mpipc::Message {
+    uint32_t    idx;
+    std::string str;
+
+    Message(uint32_t _idx, size_t _size)
+        : idx(_idx)
+        , str(_size, 'a' + _idx % 26)
+    {
+    }
+    Message() {}
+
+    SOLID_PROTOCOL_V2(_s, _rthis, _rctx, _name)
+    {
+        _s.add(_rthis.idx, _rctx, "idx");
+        _s.add(_rthis.str, _rctx, "str");
+    }
+};
+
+void connection_stop(frame::mpipc::ConnectionContext& _rctx)
+{
+    solid_dbg(logger, Info, _rctx.recipientId() << " error: " << _rctx.error().message());
+}
+
+void client_complete_message(
+    frame::mpipc::ConnectionContext& _rctx,
+    std::shared_ptr<Message>& _rsent_msg_ptr, std::shared_ptr<Message>& _rrecv_msg_ptr,
+    ErrorConditionT const& _rerror)
+{
+    solid_check(!_rerror, "message failed: " << _rerror.message());
+}
+
+void server_complete_message(
+    frame::mpipc::ConnectionContext& _rctx,
+    std::shared_ptr<Message>& _rsent_msg_ptr, std::shared_ptr<Message>& _rrecv_msg_ptr,
+    ErrorConditionT const& _rerror)
+{
+    if (_rrecv_msg_ptr) {
+        lock_guard<mutex> lock(mtx);
+        ++recv_count;
+        cnd.notify_one();
+    }
+}
+
+void wait_recv(const size_t _count)
+{
+    unique_lock<mutex> lock(mtx);
+    solid_check(cnd.wait_for(lock, std::chrono::seconds(120), [_count]() { return recv_count == _count; }), "Process is taking too long: " << recv_count << " of " << _count);
+}
+
+//one way small messages sent one by one from the application thread
+frame::mpipc::WriterStatisticPointerT run(const size_t _coalesce_window_microseconds, const size_t _message_count, const size_t _message_size)
+{
+    AioSchedulerT sch_client;
+    AioSchedulerT sch_server;
+
+    frame::Manager         m;
+    frame::mpipc::ServiceT mpipcserver(m);
+    frame::mpipc::ServiceT mpipcclient(m);
+    ErrorConditionT        err;
+    FunctionWorkPool       fwp{WorkPoolConfiguration()};
+    frame::aio::Resolver   resolver(fwp);
+    auto                   statistic_ptr = std::make_shared<frame::mpipc::WriterStatistic>();
+
+    recv_count = 0;
+
+    solid_check(!sch_client.start(1), "starting aio client scheduler");
+    solid_check(!sch_server.start(1), "starting aio server scheduler");
+
+    std::string server_port;
+
+    { //mpipc server initialization
+        auto                        proto = ProtocolT::create();
+        frame::mpipc::Configuration cfg(sch_server, proto);
+
+        proto->null(0);
+        proto->registerMessage<Message>(server_complete_message, 1);
+
+        cfg.connection_stop_fnc = &connection_stop;
+
+        cfg.server.listener_address_str   = "127.0.0.1:0";
+        cfg.server.connection_start_state = frame::mpipc::ConnectionState::Active;
+
+        err = mpipcserver.reconfigure(std::move(cfg));
+        solid_check(!err, "starting server mpipcservice: " << err.message());
+
+        std::ostringstream oss;
+        oss << mpipcserver.configuration().server.listenerPort();
+        server_port = oss.str();
+    }
+
+    { //mpipc client initialization
+        auto                        proto = ProtocolT::create();
+        frame::mpipc::Configuration cfg(sch_client, proto);
+
+        proto->null(0);
+        proto->registerMessage<Message>(client_complete_message, 1);
+
+        cfg.client.connection_start_state = frame::mpipc::ConnectionState::Active;
+        cfg.connection_stop_fnc           = &connection_stop;
+        cfg.pool_max_message_queue_size   = _message_count;
+
+        cfg.client.name_resolve_fnc = frame::mpipc::InternetResolverF(resolver, server_port.c_str());
+
+        cfg.writer.coalesce_window_microseconds = _coalesce_window_microseconds;
+        cfg.writer.statistic_ptr                = statistic_ptr;
+
+        err = mpipcclient.reconfigure(std::move(cfg));
+        solid_check(!err, "starting client mpipcservice: " << err.message());
+    }
+
+    //the first message also establishes the connection
+    err = mpipcclient.sendMessage("localhost", frame::mpipc::MessagePointerT(new Message(0, _message_size)), {});
+    solid_check(!err, "sending message: " << err.message());
+    wait_recv(1);
+
+    const auto start = chrono::steady_clock::now();
+
+    for (size_t i = 0; i < _message_count; ++i) {
+        err = mpipcclient.sendMessage("localhost", frame::mpipc::MessagePointerT(new Message(static_cast<uint32_t>(i), _message_size)), {});
+        solid_check(!err, "sending message: " << err.message());
+        this_thread::yield();
+    }
+    wait_recv(_message_count + 1);
+
+    const auto   duration = chrono::steady_clock::now() - start;
+    const double seconds  = chrono::duration<double>(duration).count();
+
+    cout << "coalesce window " << _coalesce_window_microseconds << "us: " << static_cast<size_t>(_message_count / seconds) << " msg/s "
+         << static_cast<double>(statistic_ptr->message_count_) / statistic_ptr->send_count_ << " messages per send" << endl;
+    cout << "Writer statistic:" << *statistic_ptr << endl;
+    return statistic_ptr;
+}
+
+} //namespace
+
+// Small one way messages with and without the writer coalescing window.
+// Usage: test_connection_coalesce [MESSAGE_COUNT] [MESSAGE_SIZE]
+int test_connection_coalesce(int argc, char* argv[])
+{
+    solid::log_start(std::cerr, {".*:EW", "test_connection_coalesce:VIEW"});
+
+    size_t message_count = 10000;
+    size_t message_size  = 32;
+
+    if (argc > 1) {
+        message_count = atoi(argv[1]);
+    }
+    if (argc > 2) {
+        message_size = atoi(argv[2]);
+    }
+
+    auto statistic_ptr = run(0, message_count, message_size);
+
+    solid_check(statistic_ptr->coalesce_count_ == 0, "coalescing while disabled");
+
+    statistic_ptr = run(2000, message_count, message_size);
+
+    solid_check(statistic_ptr->message_count_ == message_count + 1, "messages written: " << statistic_ptr->message_count_);
+    solid_check(statistic_ptr->coalesce_count_ != 0, "no send was coalesced");
+    solid_check(statistic_ptr->coalesce_count_ == statistic_ptr->coalesce_timeout_count_ + statistic_ptr->coalesce_size_count_, "held sends not flushed");
+    solid_check(statistic_ptr->message_count_ > statistic_ptr->send_count_, "no more than one message per send");
+
+    return 0;
+}
@@ -0,0 +1,264 @@
+#include "solid/frame/mpipc/mpipcsocketstub_openssl.hpp"
+
+#include "solid/frame/manager.hpp"
+#include "solid/frame/scheduler.hpp"
+#include "solid/frame/service.hpp"
+
+#include "solid/frame/aio/aioobject.hpp"
+#include "solid/frame/aio/aioreactor.hpp"
+#include "solid/frame/aio/aioresolver.hpp"
+
+#include "solid/frame/mpipc/mpipcconfiguration.hpp"
+#include "solid/frame/mpipc/mpipcerror.hpp"
+#include "solid/frame/mpipc/mpipcprotocol_serialization_v2.hpp"
+#include "solid/frame/mpipc/mpipcservice.hpp"
+
+#include <chrono>
+#include <condition_variable>
+#include <limits>
+#include <mutex>
+#include <sstream>
+#include <thread>
+
+#include "solid/system/exception.hpp"
+
+#include "solid/system/log.hpp"
+
+#include <iostream>
+
+using namespace std;
+using namespace solid;
+
+using AioSchedulerT = frame::Scheduler<frame::aio::Reactor>;
+using ProtocolT     = frame::mpipc::serialization_v2::Protocol<uint8_t>;
+
+namespace {
+const LoggerT logger("test_connection_credit");
+
+mutex              mtx;
+condition_variable cnd;
+size_t             recv_count     = 0;
+size_t             max_credit     = 0; //the largest credit seen by the stream callbacks
+bool               credit_invalid = false;
+
+//The data goes as a stream, so that its callback sees the message credit
+struct Message : frame::mpipc::Message {
+    uint32_t           idx;
+    std::string        data;
+    std::ostringstream oss;
+
+    Message(uint32_t _idx, size_t _size)
+        : idx(_idx)
+        , data(_size, 'a' + _idx % 26)
+    {
+    }
+    Message() {}
+
+    template <class S>
+    void solidSerializeV2(S& _s, frame::mpipc::ConnectionContext& _rctx, const char* _name) const
+    {
+        _s.add(idx, _rctx, "idx");
+        _s.push([piss = std::unique_ptr<std::istringstream>(new std::istringstream(data))](S& _s, frame::mpipc::ConnectionContext& _rctx, const char* _name) mutable {
+            _s.add(*piss, [](std::istream& _ris, uint64_t _len, const bool _done, frame::mpipc::ConnectionContext& _rctx, const char* _name) {
+                lock_guard<mutex> lock(mtx);
+                if (_rctx.messageCredit() == InvalidSize()) {
+                    credit_invalid = true;
+                } else if (_rctx.messageCredit() > max_credit) {
+                    max_credit = _rctx.messageCredit();
+                }
+            },
+                _rctx, _name);
+            return true;
+        },
+            _rctx, _name);
+    }
+
+    template <class S>
+    void solidSerializeV2(S& _s, frame::mpipc::ConnectionContext& _rctx, const char* _name)
+    {
+        _s.add(idx, _rctx, "idx");
+        _s.add(oss, [](std::ostream& _ros, uint64_t _len, const bool _done, frame::mpipc::ConnectionContext& _rctx, const char* _name) {}, _rctx, "data");
+    }
+};
+
+void connection_stop(frame::mpipc::ConnectionContext& _rctx)
+{
+    solid_dbg(logger, Info, _rctx.recipientId() << " error: " << _rctx.error().message());
+}
+
+void client_complete_message(
+    frame::mpipc::ConnectionContext& _rctx,
+    std::shared_ptr<Message>& _rsent_msg_ptr, std::shared_ptr<Message>& _rrecv_msg_ptr,
+    ErrorConditionT const& _rerror)
+{
+    solid_check(!_rerror, "message failed: " << _rerror.message());
+}
+
+void server_complete_message(
+    frame::mpipc::ConnectionContext& _rctx,
+    std::shared_ptr<Message>& _rsent_msg_ptr, std::shared_ptr<Message>& _rrecv_msg_ptr,
+    ErrorConditionT const& _rerror)
+{
+    if (_rrecv_msg_ptr) {
+        const std::string data = _rrecv_msg_ptr->oss.str();
+        solid_check(data.empty() || (data.front() == 'a' + _rrecv_msg_ptr->idx % 26 && data.back() == data.front()), "message data mismatch");
+        lock_guard<mutex> lock(mtx);
+        ++recv_count;
+        cnd.notify_one();
+    }
+}
+
+void wait_recv(const size_t _count)
+{
+    unique_lock<mutex> lock(mtx);
+    solid_check(cnd.wait_for(lock, std::chrono::seconds(120), [_count]() { return recv_count == _count; }), "Process is taking too long: " << recv_count << " of " << _count);
+}
+
+//large messages multiplexed with small ones over a single connection
+frame::mpipc::WriterStatisticPointerT run(const size_t _server_credit_window, const size_t _client_credit_window, const size_t _message_count, const size_t _message_size)
+{
+    AioSchedulerT sch_client;
+    AioSchedulerT sch_server;
+
+    frame::Manager         m;
+    frame::mpipc::ServiceT mpipcserver(m);
+    frame::mpipc::ServiceT mpipcclient(m);
+    ErrorConditionT        err;
+    FunctionWorkPool       fwp{WorkPoolConfiguration()};
+    frame::aio::Resolver   resolver(fwp);
+    auto                   statistic_ptr = std::make_shared<frame::mpipc::WriterStatistic>();
+
+    recv_count     = 0;
+    max_credit     = 0;
+    credit_invalid = false;
+
+    solid_check(!sch_client.start(1), "starting aio client scheduler");
+    solid_check(!sch_server.start(1), "starting aio server scheduler");
+
+    std::string server_port;
+
+    { //mpipc server initialization
+        auto                        proto = ProtocolT::create();
+        frame::mpipc::Configuration cfg(sch_server, proto);
+
+        proto->null(0);
+        proto->registerMessage<Message>(server_complete_message, 1);
+
+        cfg.connection_stop_fnc = &connection_stop;
+
+        cfg.server.listener_address_str   = "127.0.0.1:0";
+        cfg.server.connection_start_state = frame::mpipc::ConnectionState::Active;
+
+        cfg.streamCreditWindow(_server_credit_window);
+
+        err = mpipcserver.reconfigure(std::move(cfg));
+        solid_check(!err, "starting server mpipcservice: " << err.message());
+
+        std::ostringstream oss;
+        oss << mpipcserver.configuration().server.listenerPort();
+        server_port = oss.str();
+    }
+
+    { //mpipc client initialization
+        auto                        proto = ProtocolT::create();
+        frame::mpipc::Configuration cfg(sch_client, proto);
+
+        proto->null(0);
+        proto->registerMessage<Message>(client_complete_message, 1);
+
+        cfg.client.connection_start_state = frame::mpipc::ConnectionState::Active;
+        cfg.connection_stop_fnc           = &connection_stop;
+        cfg.pool_max_message_queue_size   = 2 * _message_count;
+
+        cfg.client.name_resolve_fnc = frame::mpipc::InternetResolverF(resolver, server_port.c_str());
+
+        cfg.streamCreditWindow(_client_credit_window);
+        cfg.writer.statistic_ptr = statistic_ptr;
+
+        err = mpipcclient.reconfigure(std::move(cfg));
+        solid_check(!err, "starting client mpipcservice: " << err.message());
+    }
+
+    const auto start = chrono::steady_clock::now();
+
+    for (size_t i = 0; i < _message_count; ++i) {
+        err = mpipcclient.sendMessage("localhost", frame::mpipc::MessagePointerT(new Message(static_cast<uint32_t>(i), _message_size)), {});
+        solid_check(!err, "sending message: " << err.message());
+        err = mpipcclient.sendMessage("localhost", frame::mpipc::MessagePointerT(new Message(static_cast<uint32_t>(i), 16)), {});
+        solid_check(!err, "sending message: " << err.message());
+    }
+    wait_recv(2 * _message_count);
+
+    const auto   duration = chrono::steady_clock::now() - start;
+    const double seconds  = chrono::duration<double>(duration).count();
+
+    cout << "credit window " << _server_credit_window << '/' << _client_credit_window << ": " << (_message_count * _message_size) / (seconds * 1024 * 1024) << " MB/s"
+         << " max credit " << max_credit << endl;
+    cout << "Writer statistic:" << *statistic_ptr << endl;
+    return statistic_ptr;
+}
+
+//a window the writer could never send a packet of
+void check_invalid_credit_window()
+{
+    AioSchedulerT sch;
+
+    frame::Manager         m;
+    frame::mpipc::ServiceT mpipcservice(m);
+
+    solid_check(!sch.start(1), "starting aio scheduler");
+
+    for (const size_t credit_window : {size_t(1), size_t(16), static_cast<size_t>(std::numeric_limits<uint32_t>::max()) + 1}) {
+        auto                        proto = ProtocolT::create();
+        frame::mpipc::Configuration cfg(sch, proto);
+
+        proto->null(0);
+        proto->registerMessage<Message>(client_complete_message, 1);
+
+        cfg.streamCreditWindow(credit_window);
+
+        const ErrorConditionT err = mpipcservice.reconfigure(std::move(cfg));
+        solid_check(err == frame::mpipc::error_service_invalid_credit_window, "credit window " << credit_window << " not rejected: " << err.message());
+    }
+}
+
+} //namespace
+
+// Large messages paced by the receiver's credit, multiplexed with small messages.
+// Usage: test_connection_credit [MESSAGE_COUNT] [MESSAGE_SIZE]
+int test_connection_credit(int argc, char* argv[])
+{
+    solid::log_start(std::cerr, {".*:EW", "test_connection_credit:VIEW"});
+
+    size_t message_count = 8;
+    size_t message_size  = 8 * 1024 * 1024;
+
+    if (argc > 1) {
+        message_count = atoi(argv[1]);
+    }
+    if (argc > 2) {
+        message_size = atoi(argv[2]);
+    }
+
+    check_invalid_credit_window();
+
+    auto statistic_ptr = run(0, 0, message_count, message_size);
+
+    solid_check(statistic_ptr->credit_wait_count_ == 0, "credit waits without flow control");
+    solid_check(max_credit == 0 && credit_invalid, "credit without flow control");
+
+    const size_t credit_window = 64 * 1024;
+
+    statistic_ptr = run(credit_window, credit_window, message_count, message_size);
+
+    solid_check(statistic_ptr->credit_wait_count_ != 0, "no message waited for credit");
+    solid_check(!credit_invalid && max_credit <= credit_window, "credit beyond the window: " << max_credit);
+
+    //only the sender knows the window - the receiver grants on the one in the message header
+    statistic_ptr = run(0, credit_window, message_count, message_size);
+
+    solid_check(statistic_ptr->credit_wait_count_ != 0, "no message waited for credit");
+    solid_check(!credit_invalid && max_credit <= credit_window, "credit beyond the window: " << max_credit);
+
+    return 0;
+}
@@ -0,0 +1,253 @@
+#include "solid/frame/mpipc/mpipcsocketstub_openssl.hpp"
+
+#include "solid/frame/manager.hpp"
+#include "solid/frame/scheduler.hpp"
+#include "solid/frame/service.hpp"
+
+#include "solid/frame/aio/aioobject.hpp"
+#include "solid/frame/aio/aioreactor.hpp"
+#include "solid/frame/aio/aioresolver.hpp"
+
+#include "solid/frame/mpipc/mpipcconfiguration.hpp"
+#include "solid/frame/mpipc/mpipcerror.hpp"
+#include "solid/frame/mpipc/mpipcprotocol_serialization_v2.hpp"
+#include "solid/frame/mpipc/mpipcservice.hpp"
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <set>
+#include <thread>
+
+#include "solid/system/exception.hpp"
+
+#include "solid/system/log.hpp"
+
+#include <iostream>
+
+using namespace std;
+using namespace solid;
+
+using AioSchedulerT = frame::Scheduler<frame::aio::Reactor>;
+using ProtocolT     = frame::mpipc::serialization_v2::Protocol<uint8_t>;
+using ThreadIdSetT  = std::set<std::thread::id>;
+
+namespace {
+const LoggerT logger("test_connection_handshake_offload");
+
+mutex              mtx;
+condition_variable cnd;
+size_t             response_count         = 0;
+size_t             server_handshake_count = 0;
+size_t             server_verify_count    = 0;
+size_t             offload_count          = 0;
+ThreadIdSetT       reactor_thread_set;
+ThreadIdSetT       offload_thread_set;
+
+struct Message : frame::mpipc::Message {
+    uint32_t idx;
+
+    Message(uint32_t _idx)
+        : idx(_idx)
+    {
+    }
+    Message() {}
+
+    SOLID_PROTOCOL_V2(_s, _rthis, _rctx, _name)
+    {
+        _s.add(_rthis.idx, _rctx, "idx");
+    }
+};
+
+void connection_stop(frame::mpipc::ConnectionContext& _rctx)
+{
+    solid_dbg(logger, Info, _rctx.recipientId() << " error: " << _rctx.error().message());
+}
+
+void server_secure_handshake(frame::mpipc::ConnectionContext& _rctx)
+{
+    lock_guard<mutex> lock(mtx);
+    ++server_handshake_count;
+    cnd.notify_one();
+}
+
+//the client certificate is verified on the reactor, after the offloaded step
+bool server_secure_verify(
+    frame::aio::ReactorContext& _rctx, frame::mpipc::ConnectionContext& _rconctx, frame::mpipc::openssl::StreamSocketT& _rsock, bool _preverified, frame::aio::openssl::VerifyContext& _rverify_ctx)
+{
+    if (X509_STORE_CTX_get_error_depth(_rverify_ctx.nativeHandle()) == 0) {
+        lock_guard<mutex> lock(mtx);
+        ++server_verify_count;
+        reactor_thread_set.insert(this_thread::get_id());
+    }
+    return _preverified;
+}
+
+void client_complete_message(
+    frame::mpipc::ConnectionContext& _rctx,
+    std::shared_ptr<Message>& _rsent_msg_ptr, std::shared_ptr<Message>& _rrecv_msg_ptr,
+    ErrorConditionT const& _rerror)
+{
+    solid_check(!_rerror, "message failed: " << _rerror.message());
+    if (_rrecv_msg_ptr) {
+        solid_check(_rsent_msg_ptr && _rsent_msg_ptr->idx == _rrecv_msg_ptr->idx, "response mismatch");
+        lock_guard<mutex> lock(mtx);
+        ++response_count;
+        cnd.notify_one();
+    }
+}
+
+void server_complete_message(
+    frame::mpipc::ConnectionContext& _rctx,
+    std::shared_ptr<Message>& _rsent_msg_ptr, std::shared_ptr<Message>& _rrecv_msg_ptr,
+    ErrorConditionT const& _rerror)
+{
+    solid_check(!_rerror, "message failed: " << _rerror.message());
+    if (_rrecv_msg_ptr) {
+        ErrorConditionT err = _rctx.service().sendResponse(_rctx.recipientId(), _rrecv_msg_ptr);
+        solid_check(!err, "sending response: " << err.message());
+    }
+}
+
+template <class Pred>
+void wait(Pred _pred)
+{
+    unique_lock<mutex> lock(mtx);
+    solid_check(cnd.wait_for(lock, std::chrono::seconds(60), _pred), "Process is taking too long");
+}
+
+} //namespace
+
+// Many secure clients connect at once to a server which runs the ClientHello
+// processing - with its private key operation - on a work pool.
+// Usage: test_connection_handshake_offload [CONNECTION_COUNT]
+int test_connection_handshake_offload(int argc, char* argv[])
+{
+    solid::log_start(std::cerr, {".*:EW", "test_connection_handshake_offload:VIEW"});
+
+    size_t connection_count = 32;
+
+    if (argc > 1) {
+        connection_count = atoi(argv[1]);
+    }
+
+    AioSchedulerT sch_client;
+    AioSchedulerT sch_server;
+
+    frame::Manager         m;
+    frame::mpipc::ServiceT mpipcserver(m);
+    frame::mpipc::ServiceT mpipcclient(m);
+    ErrorConditionT        err;
+    FunctionWorkPool       fwp{WorkPoolConfiguration()};
+    FunctionWorkPool       handshake_fwp{WorkPoolConfiguration()};
+    frame::aio::Resolver   resolver(fwp);
+
+    solid_check(!sch_client.start(1), "starting aio client scheduler");
+    solid_check(!sch_server.start(1), "starting aio server scheduler");
+
+    std::string server_port;
+
+    { //mpipc server initialization
+        auto                        proto = ProtocolT::create();
+        frame::mpipc::Configuration cfg(sch_server, proto);
+
+        proto->null(0);
+        proto->registerMessage<Message>(server_complete_message, 1);
+
+        cfg.connection_stop_fnc = &connection_stop;
+
+        cfg.server.listener_address_str               = "127.0.0.1:0";
+        cfg.server.connection_start_state             = frame::mpipc::ConnectionState::Active;
+        cfg.server.connection_on_secure_handshake_fnc = &server_secure_handshake;
+
+        frame::mpipc::openssl::setup_server(
+            cfg,
+            [](frame::aio::openssl::Context& _rctx) -> ErrorCodeT {
+                _rctx.loadVerifyFile("echo-ca-cert.pem");
+                _rctx.loadCertificateFile("echo-server-cert.pem");
+                _rctx.loadPrivateKeyFile("echo-server-key.pem");
+                return ErrorCodeT();
+            },
+            frame::mpipc::openssl::NameCheckSecureStart{"echo-client"},
+            server_secure_verify);
+
+        //like setup_server_handshake_offload, but also records where the jobs run
+        cfg.server.secure_any.cast<frame::mpipc::openssl::ServerConfiguration>()->connection_handshake_offload_fnc =
+            [&handshake_fwp](frame::aio::openssl::Socket::HandshakeJobT&& _ujob) {
+                handshake_fwp.push(
+                    [job = std::move(_ujob)]() {
+                        {
+                            lock_guard<mutex> lock(mtx);
+                            ++offload_count;
+                            offload_thread_set.insert(this_thread::get_id());
+                        }
+                        job();
+                    });
+            };
+
+        err = mpipcserver.reconfigure(std::move(cfg));
+        solid_check(!err, "starting server mpipcservice: " << err.message());
+
+        std::ostringstream oss;
+        oss << mpipcserver.configuration().server.listenerPort();
+        server_port = oss.str();
+    }
+
+    { //mpipc client initialization
+        auto                        proto = ProtocolT::create();
+        frame::mpipc::Configuration cfg(sch_client, proto);
+
+        proto->null(0);
+        proto->registerMessage<Message>(client_complete_message, 1);
+
+        cfg.client.connection_start_state     = frame::mpipc::ConnectionState::Active;
+        cfg.connection_stop_fnc               = &connection_stop;
+        cfg.pool_max_active_connection_count  = connection_count;
+        cfg.pool_max_pending_connection_count = connection_count;
+        cfg.pool_max_message_queue_size       = connection_count;
+
+        cfg.client.name_resolve_fnc = frame::mpipc::InternetResolverF(resolver, server_port.c_str());
+
+        frame::mpipc::openssl::setup_client(
+            cfg,
+            [](frame::aio::openssl::Context& _rctx) -> ErrorCodeT {
+                _rctx.loadVerifyFile("echo-ca-cert.pem");
+                _rctx.loadCertificateFile("echo-client-cert.pem");
+                _rctx.loadPrivateKeyFile("echo-client-key.pem");
+                return ErrorCodeT();
+            },
+            frame::mpipc::openssl::NameCheckSecureStart{"echo-server"});
+
+        err = mpipcclient.reconfigure(std::move(cfg));
+        solid_check(!err, "starting client mpipcservice: " << err.message());
+    }
+
+    const auto start = chrono::steady_clock::now();
+
+    err = mpipcclient.createConnectionPool("localhost", connection_count);
+    solid_check(!err, "creating connection pool: " << err.message());
+
+    wait([connection_count]() { return server_handshake_count == connection_count; });
+
+    const auto handshake_duration = chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - start).count();
+
+    for (size_t i = 0; i < connection_count; ++i) {
+        err = mpipcclient.sendRequest("localhost", std::make_shared<Message>(static_cast<uint32_t>(i)), client_complete_message);
+        solid_check(!err, "sending request: " << err.message());
+    }
+
+    wait([connection_count]() { return response_count == connection_count; });
+
+    cout << connection_count << " secure connections in " << handshake_duration << "ms with " << offload_count << " offloaded handshake steps" << endl;
+
+    lock_guard<mutex> lock(mtx);
+
+    solid_check(offload_count == connection_count, "unexpected offloaded step count: " << offload_count);
+    solid_check(server_verify_count == connection_count, "unexpected client certificate verify count: " << server_verify_count);
+
+    for (const auto& thread_id : offload_thread_set) {
+        solid_check(reactor_thread_set.find(thread_id) == reactor_thread_set.end(), "handshake step run on the reactor thread");
+    }
+
+    return 0;
+}
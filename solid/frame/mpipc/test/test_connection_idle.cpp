@@ -0,0 +1,270 @@
+#include "solid/frame/mpipc/mpipcsocketstub_openssl.hpp"
+
+#include "solid/frame/manager.hpp"
+#include "solid/frame/scheduler.hpp"
+#include "solid/frame/service.hpp"
+
+#include "solid/frame/aio/aiolistener.hpp"
+#include "solid/frame/aio/aioobject.hpp"
+#include "solid/frame/aio/aioreactor.hpp"
+#include "solid/frame/aio/aioresolver.hpp"
+#include "solid/frame/aio/aiotimer.hpp"
+
+#include "solid/frame/mpipc/mpipcconfiguration.hpp"
+#include "solid/frame/mpipc/mpipcerror.hpp"
+#include "solid/frame/mpipc/mpipcprotocol_serialization_v2.hpp"
+#include "solid/frame/mpipc/mpipcservice.hpp"
+
+#include <condition_variable>
+#include <fstream>
+#include <mutex>
+#include <thread>
+#include <unistd.h>
+
+#include "solid/system/exception.hpp"
+
+#include "solid/system/log.hpp"
+
+#include <iostream>
+
+using namespace std;
+using namespace solid;
+
+using AioSchedulerT = frame::Scheduler<frame::aio::Reactor>;
+using ProtocolT     = frame::mpipc::serialization_v2::Protocol<uint8_t>;
+
+namespace {
+const LoggerT logger("test_connection_idle");
+
+const size_t message_size = 1000; //larger than the idle receive buffer
+
+mutex               mtx;
+condition_variable  cnd;
+size_t              server_connection_count = 0;
+size_t              back_count              = 0;
+std::atomic<size_t> live_recv_buffer_count(0);
+
+//counts the receive buffers alive in both services
+struct CountedBuffer : frame::mpipc::Buffer<0> {
+    CountedBuffer(const size_t _cp)
+        : frame::mpipc::Buffer<0>(_cp)
+    {
+        ++live_recv_buffer_count;
+    }
+    ~CountedBuffer()
+    {
+        --live_recv_buffer_count;
+    }
+};
+
+frame::mpipc::RecvBufferPointerT allocate_recv_buffer(const uint32_t _cp)
+{
+    return std::make_shared<CountedBuffer>(_cp);
+}
+
+size_t resident_size_kb()
+{
+    ifstream ifs("/proc/self/statm");
+    size_t   total    = 0;
+    size_t   resident = 0;
+    ifs >> total >> resident;
+    return (resident * sysconf(_SC_PAGESIZE)) / 1024;
+}
+
+struct Message : frame::mpipc::Message {
+    uint32_t    idx;
+    std::string str;
+
+    Message(uint32_t _idx)
+        : idx(_idx)
+        , str(message_size, static_cast<char>('a' + _idx % 26))
+    {
+    }
+    Message() {}
+
+    SOLID_PROTOCOL_V2(_s, _rthis, _rctx, _name)
+    {
+        _s.add(_rthis.idx, _rctx, "idx").add(_rthis.str, _rctx, "str");
+    }
+
+    bool check() const
+    {
+        return str == std::string(message_size, static_cast<char>('a' + idx % 26));
+    }
+};
+
+void server_connection_start(frame::mpipc::ConnectionContext& _rctx)
+{
+    solid_dbg(logger, Info, _rctx.recipientId());
+    lock_guard<mutex> lock(mtx);
+    ++server_connection_count;
+    cnd.notify_one();
+}
+
+void connection_stop(frame::mpipc::ConnectionContext& _rctx)
+{
+    solid_dbg(logger, Info, _rctx.recipientId() << " error: " << _rctx.error().message());
+}
+
+void client_complete_message(
+    frame::mpipc::ConnectionContext& _rctx,
+    std::shared_ptr<Message>& _rsent_msg_ptr, std::shared_ptr<Message>& _rrecv_msg_ptr,
+    ErrorConditionT const& _rerror)
+{
+    solid_check(!_rerror, "message failed: " << _rerror.message());
+
+    if (_rrecv_msg_ptr) {
+        solid_check(_rrecv_msg_ptr->check(), "Message check failed.");
+        lock_guard<mutex> lock(mtx);
+        ++back_count;
+        cnd.notify_one();
+    }
+}
+
+void server_complete_message(
+    frame::mpipc::ConnectionContext& _rctx,
+    std::shared_ptr<Message>& _rsent_msg_ptr, std::shared_ptr<Message>& _rrecv_msg_ptr,
+    ErrorConditionT const& _rerror)
+{
+    if (_rrecv_msg_ptr) {
+        solid_check(_rrecv_msg_ptr->check(), "Message check failed.");
+        _rctx.service().sendResponse(_rctx.recipientId(), _rrecv_msg_ptr);
+    }
+}
+
+void send_round(frame::mpipc::Service& _rsvc, const size_t _count, const size_t _offset)
+{
+    for (size_t i = 0; i < _count; ++i) {
+        frame::mpipc::MessagePointerT msgptr(new Message(static_cast<uint32_t>(_offset + i)));
+        const ErrorConditionT         err = _rsvc.sendMessage("localhost", msgptr, {frame::mpipc::MessageFlagsE::WaitResponse});
+        solid_check(!err, "sending message: " << err.message());
+    }
+}
+
+void wait_back(const size_t _count)
+{
+    unique_lock<mutex> lock(mtx);
+    solid_check(cnd.wait_for(lock, std::chrono::seconds(120), [_count]() { return back_count == _count; }), "Process is taking too long: " << back_count << " of " << _count);
+}
+
+} //namespace
+
+int test_connection_idle(int argc, char* argv[])
+{
+    solid::log_start(std::cerr, {".*:EW", "test_connection_idle:VIEW"});
+
+    size_t connection_count = 100000;
+    size_t pool_max_count   = 4;
+
+    if (argc > 1) {
+        connection_count = atoi(argv[1]);
+    }
+    if (argc > 2) {
+        pool_max_count = atoi(argv[2]);
+    }
+
+    {
+        AioSchedulerT sch_client;
+        AioSchedulerT sch_server;
+
+        frame::Manager         m;
+        frame::mpipc::ServiceT mpipcserver(m);
+        frame::mpipc::ServiceT mpipcclient(m);
+        ErrorConditionT        err;
+        FunctionWorkPool       fwp{WorkPoolConfiguration()};
+        frame::aio::Resolver   resolver(fwp);
+
+        solid_check(!sch_client.start(1), "starting aio client scheduler");
+        solid_check(!sch_server.start(1), "starting aio server scheduler");
+
+        std::string server_port;
+
+        { //mpipc server initialization
+            auto                        proto = ProtocolT::create();
+            frame::mpipc::Configuration cfg(sch_server, proto);
+
+            proto->null(0);
+            proto->registerMessage<Message>(server_complete_message, 1);
+
+            cfg.connection_stop_fnc         = &connection_stop;
+            cfg.server.connection_start_fnc = &server_connection_start;
+
+            cfg.server.listener_address_str   = "0.0.0.0:0";
+            cfg.server.connection_start_state = frame::mpipc::ConnectionState::Active;
+
+            cfg.connection_inactivity_timeout_seconds = 10;
+            cfg.connection_inactivity_keepalive_count = 20;
+
+            cfg.connection_buffer_release_timeout_seconds = 1;
+            cfg.connection_buffer_pool_max_count          = pool_max_count;
+            cfg.connection_recv_buffer_allocate_fnc       = &allocate_recv_buffer;
+
+            err = mpipcserver.reconfigure(std::move(cfg));
+            solid_check(!err, "starting server mpipcservice: " << err.message());
+
+            std::ostringstream oss;
+            oss << mpipcserver.configuration().server.listenerPort();
+            server_port = oss.str();
+        }
+
+        { //mpipc client initialization
+            auto                        proto = ProtocolT::create();
+            frame::mpipc::Configuration cfg(sch_client, proto);
+
+            proto->null(0);
+            proto->registerMessage<Message>(client_complete_message, 1);
+
+            //keepalives must not keep the buffers of an idle connection
+            cfg.connection_keepalive_timeout_seconds = 1;
+
+            cfg.client.connection_start_state = frame::mpipc::ConnectionState::Active;
+            cfg.connection_stop_fnc           = &connection_stop;
+
+            cfg.pool_max_active_connection_count = connection_count;
+            cfg.pool_max_message_queue_size      = connection_count;
+
+            cfg.connection_buffer_release_timeout_seconds = 1;
+            cfg.connection_buffer_pool_max_count          = pool_max_count;
+            cfg.connection_recv_buffer_allocate_fnc       = &allocate_recv_buffer;
+
+            cfg.client.name_resolve_fnc = frame::mpipc::InternetResolverF(resolver, server_port.c_str());
+
+            err = mpipcclient.reconfigure(std::move(cfg));
+            solid_check(!err, "starting client mpipcservice: " << err.message());
+        }
+
+        const size_t start_rss_kb = resident_size_kb();
+
+        err = mpipcclient.createConnectionPool("localhost", connection_count);
+        solid_check(!err, "creating connection pool: " << err.message());
+
+        {
+            unique_lock<mutex> lock(mtx);
+            solid_check(cnd.wait_for(lock, std::chrono::seconds(120), [connection_count]() { return server_connection_count == connection_count; }), "Connecting is taking too long.");
+        }
+
+        send_round(mpipcclient, connection_count, 0);
+        wait_back(connection_count);
+
+        const size_t active_rss_kb      = resident_size_kb();
+        const size_t active_recv_buffer = live_recv_buffer_count;
+
+        //two release periods plus slack - with keepalives going on
+        this_thread::sleep_for(chrono::seconds(4));
+
+        const size_t idle_rss_kb      = resident_size_kb();
+        const size_t idle_recv_buffer = live_recv_buffer_count;
+
+        solid_log(logger, Verbose, "connections = " << connection_count << " rss: start = " << start_rss_kb << "KB active = " << active_rss_kb << "KB idle = " << idle_rss_kb << "KB");
+        solid_log(logger, Verbose, "recv buffers: active = " << active_recv_buffer << " idle = " << idle_recv_buffer);
+
+        //only the service pools may hold buffers, plus one connection per reactor still busy
+        solid_check(idle_recv_buffer <= 2 * pool_max_count + 2, "idle connections still hold " << idle_recv_buffer << " buffers");
+
+        //idle connections must reacquire their buffers
+        send_round(mpipcclient, connection_count, connection_count);
+        wait_back(2 * connection_count);
+    }
+
+    return 0;
+}
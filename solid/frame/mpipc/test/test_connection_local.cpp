@@ -0,0 +1,227 @@
+#include "solid/frame/mpipc/mpipcsocketstub_openssl.hpp"
+#include "solid/frame/mpipc/mpipcsocketstub_shm.hpp"
+
+#include "solid/frame/manager.hpp"
+#include "solid/frame/scheduler.hpp"
+#include "solid/frame/service.hpp"
+
+#include "solid/frame/aio/aioobject.hpp"
+#include "solid/frame/aio/aioreactor.hpp"
+#include "solid/frame/aio/aioresolver.hpp"
+
+#include "solid/frame/mpipc/mpipcconfiguration.hpp"
+#include "solid/frame/mpipc/mpipcerror.hpp"
+#include "solid/frame/mpipc/mpipcprotocol_serialization_v2.hpp"
+#include "solid/frame/mpipc/mpipcservice.hpp"
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#include "solid/system/exception.hpp"
+
+#include "solid/system/log.hpp"
+
+#include <iostream>
+
+#include <unistd.h>
+
+using namespace std;
+using namespace solid;
+
+using AioSchedulerT = frame::Scheduler<frame::aio::Reactor>;
+using ProtocolT     = frame::mpipc::serialization_v2::Protocol<uint8_t>;
+
+namespace {
+const LoggerT logger("test_connection_local");
+
+mutex              mtx;
+condition_variable cnd;
+size_t             back_count = 0;
+
+struct Message : frame::mpipc::Message {
+    uint32_t    idx;
+    std::string str;
+
+    Message(uint32_t _idx, size_t _size)
+        : idx(_idx)
+        , str(_size, 'a' + _idx % 26)
+    {
+    }
+    Message() {}
+
+    SOLID_PROTOCOL_V2(_s, _rthis, _rctx, _name)
+    {
+        _s.add(_rthis.idx, _rctx, "idx");
+        _s.add(_rthis.str, _rctx, "str");
+    }
+};
+
+void connection_stop(frame::mpipc::ConnectionContext& _rctx)
+{
+    solid_dbg(logger, Info, _rctx.recipientId() << " error: " << _rctx.error().message());
+}
+
+void client_complete_message(
+    frame::mpipc::ConnectionContext& _rctx,
+    std::shared_ptr<Message>& _rsent_msg_ptr, std::shared_ptr<Message>& _rrecv_msg_ptr,
+    ErrorConditionT const& _rerror)
+{
+    solid_check(!_rerror, "message failed: " << _rerror.message());
+
+    if (_rrecv_msg_ptr) {
+        solid_check(_rrecv_msg_ptr->str == _rsent_msg_ptr->str, "message data mismatch");
+        lock_guard<mutex> lock(mtx);
+        ++back_count;
+        cnd.notify_one();
+    }
+}
+
+void server_complete_message(
+    frame::mpipc::ConnectionContext& _rctx,
+    std::shared_ptr<Message>& _rsent_msg_ptr, std::shared_ptr<Message>& _rrecv_msg_ptr,
+    ErrorConditionT const& _rerror)
+{
+    if (_rrecv_msg_ptr) {
+        _rctx.service().sendResponse(_rctx.recipientId(), _rrecv_msg_ptr);
+    }
+}
+
+void wait_back(const size_t _count)
+{
+    unique_lock<mutex> lock(mtx);
+    solid_check(cnd.wait_for(lock, std::chrono::seconds(120), [_count]() { return back_count == _count; }), "Process is taking too long: " << back_count << " of " << _count);
+}
+
+//ping-pong round trips, then a burst of messages over a single connection
+void run(const char* _name, const std::string& _listener_address, const size_t _message_count, const size_t _message_size, const bool _shm = false)
+{
+    AioSchedulerT sch_client;
+    AioSchedulerT sch_server;
+
+    frame::Manager         m;
+    frame::mpipc::ServiceT mpipcserver(m);
+    frame::mpipc::ServiceT mpipcclient(m);
+    ErrorConditionT        err;
+    FunctionWorkPool       fwp{WorkPoolConfiguration()};
+    frame::aio::Resolver   resolver(fwp);
+
+    back_count = 0;
+
+    solid_check(!sch_client.start(1), "starting aio client scheduler");
+    solid_check(!sch_server.start(1), "starting aio server scheduler");
+
+    std::string recipient_name;
+
+    { //mpipc server initialization
+        auto                        proto = ProtocolT::create();
+        frame::mpipc::Configuration cfg(sch_server, proto);
+
+        proto->null(0);
+        proto->registerMessage<Message>(server_complete_message, 1);
+
+        cfg.connection_stop_fnc = &connection_stop;
+
+        cfg.server.listener_address_str   = _listener_address;
+        cfg.server.connection_start_state = frame::mpipc::ConnectionState::Active;
+
+        if (_shm) {
+            frame::mpipc::shm::setup_server(cfg);
+        }
+
+        err = mpipcserver.reconfigure(std::move(cfg));
+        solid_check(!err, "starting server mpipcservice: " << err.message());
+
+        if (frame::mpipc::unix_socket_path(_listener_address.c_str()) != nullptr) {
+            recipient_name = _listener_address;
+        } else {
+            std::ostringstream oss;
+            oss << "localhost:" << mpipcserver.configuration().server.listenerPort();
+            recipient_name = oss.str();
+        }
+    }
+
+    { //mpipc client initialization
+        auto                        proto = ProtocolT::create();
+        frame::mpipc::Configuration cfg(sch_client, proto);
+
+        proto->null(0);
+        proto->registerMessage<Message>(client_complete_message, 1);
+
+        cfg.client.connection_start_state = frame::mpipc::ConnectionState::Active;
+        cfg.connection_stop_fnc           = &connection_stop;
+        cfg.pool_max_message_queue_size   = _message_count;
+
+        cfg.client.name_resolve_fnc = frame::mpipc::InternetResolverF(resolver, "0");
+
+        if (_shm) {
+            frame::mpipc::shm::setup_client(cfg);
+        }
+
+        err = mpipcclient.reconfigure(std::move(cfg));
+        solid_check(!err, "starting client mpipcservice: " << err.message());
+    }
+
+    //the first message also establishes the connection
+    err = mpipcclient.sendMessage(recipient_name.c_str(), frame::mpipc::MessagePointerT(new Message(0, _message_size)), {frame::mpipc::MessageFlagsE::WaitResponse});
+    solid_check(!err, "sending message: " << err.message());
+    wait_back(1);
+
+    auto start = chrono::steady_clock::now();
+
+    for (size_t i = 0; i < _message_count; ++i) {
+        err = mpipcclient.sendMessage(recipient_name.c_str(), frame::mpipc::MessagePointerT(new Message(static_cast<uint32_t>(i), _message_size)), {frame::mpipc::MessageFlagsE::WaitResponse});
+        solid_check(!err, "sending message: " << err.message());
+        wait_back(i + 2);
+    }
+
+    const auto latency = chrono::steady_clock::now() - start;
+
+    start = chrono::steady_clock::now();
+
+    for (size_t i = 0; i < _message_count; ++i) {
+        err = mpipcclient.sendMessage(recipient_name.c_str(), frame::mpipc::MessagePointerT(new Message(static_cast<uint32_t>(i), _message_size)), {frame::mpipc::MessageFlagsE::WaitResponse});
+        solid_check(!err, "sending message: " << err.message());
+    }
+    wait_back(2 * _message_count + 1);
+
+    const auto   duration = chrono::steady_clock::now() - start;
+    const double seconds  = chrono::duration<double>(duration).count();
+
+    cout << _name << ": round trip " << chrono::duration_cast<chrono::microseconds>(latency).count() / static_cast<double>(_message_count) << "us"
+         << " burst " << static_cast<size_t>(_message_count / seconds) << " msg/s "
+         << (2.0 * _message_count * _message_size) / (seconds * 1024 * 1024) << " MB/s" << endl;
+}
+
+} //namespace
+
+// Same host mpipc over TCP loopback vs unix domain sockets (file system and abstract namespace)
+// vs shared memory rings.
+// Usage: test_connection_local [MESSAGE_COUNT] [MESSAGE_SIZE]
+int test_connection_local(int argc, char* argv[])
+{
+    solid::log_start(std::cerr, {".*:EW", "test_connection_local:VIEW"});
+
+    size_t message_count = 1000;
+    size_t message_size  = 1024;
+
+    if (argc > 1) {
+        message_count = atoi(argv[1]);
+    }
+    if (argc > 2) {
+        message_size = atoi(argv[2]);
+    }
+
+    const std::string path = "/tmp/test_connection_local_" + std::to_string(getpid()) + ".sock";
+
+    run("tcp loopback", "127.0.0.1:0", message_count, message_size);
+    run("unix socket", "unix:" + path, message_count, message_size);
+#ifdef SOLID_ON_LINUX
+    run("unix abstract socket", "unix:@test_connection_local_" + std::to_string(getpid()), message_count, message_size);
+#endif
+    run("shared memory rings", "unix:" + path, message_count, message_size, true);
+    unlink(path.c_str());
+
+    return 0;
+}
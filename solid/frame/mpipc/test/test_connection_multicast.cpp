@@ -0,0 +1,233 @@
+#include "solid/frame/mpipc/mpipcsocketstub_openssl.hpp"
+
+#include "solid/frame/manager.hpp"
+#include "solid/frame/scheduler.hpp"
+#include "solid/frame/service.hpp"
+
+#include "solid/frame/aio/aioobject.hpp"
+#include "solid/frame/aio/aioreactor.hpp"
+#include "solid/frame/aio/aioresolver.hpp"
+
+#include "solid/frame/mpipc/mpipcconfiguration.hpp"
+#include "solid/frame/mpipc/mpipcerror.hpp"
+#include "solid/frame/mpipc/mpipcprotocol_serialization_v2.hpp"
+#include "solid/frame/mpipc/mpipcservice.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#include "solid/system/exception.hpp"
+
+#include "solid/system/log.hpp"
+
+#include <iostream>
+
+using namespace std;
+using namespace solid;
+
+using AioSchedulerT = frame::Scheduler<frame::aio::Reactor>;
+using ProtocolT     = frame::mpipc::serialization_v2::Protocol<uint8_t>;
+
+namespace {
+const LoggerT logger("test_connection_multicast");
+
+mutex                             mtx;
+condition_variable                cnd;
+size_t                            recv_count = 0;
+vector<frame::mpipc::RecipientId> recipient_vec;
+std::atomic<size_t>               serialize_count(0);
+
+struct Message : frame::mpipc::Message {
+    uint32_t    idx;
+    std::string str;
+
+    Message(uint32_t _idx, size_t _size)
+        : idx(_idx)
+        , str(_size, 'a' + _idx % 26)
+    {
+    }
+    Message() {}
+
+    template <class S>
+    void solidSerializeV2(S& _s, frame::mpipc::ConnectionContext& _rctx, const char* _name) const
+    {
+        ++serialize_count;
+        _s.add(idx, _rctx, "idx");
+        _s.add(str, _rctx, "str");
+    }
+
+    template <class S>
+    void solidSerializeV2(S& _s, frame::mpipc::ConnectionContext& _rctx, const char* _name)
+    {
+        _s.add(idx, _rctx, "idx");
+        _s.add(str, _rctx, "str");
+    }
+};
+
+void connection_stop(frame::mpipc::ConnectionContext& _rctx)
+{
+    solid_dbg(logger, Info, _rctx.recipientId() << " error: " << _rctx.error().message());
+}
+
+void server_connection_start(frame::mpipc::ConnectionContext& _rctx)
+{
+    lock_guard<mutex> lock(mtx);
+    recipient_vec.emplace_back(_rctx.recipientId());
+    cnd.notify_one();
+}
+
+void client_complete_message(
+    frame::mpipc::ConnectionContext& _rctx,
+    std::shared_ptr<Message>& _rsent_msg_ptr, std::shared_ptr<Message>& _rrecv_msg_ptr,
+    ErrorConditionT const& _rerror)
+{
+    if (_rrecv_msg_ptr) {
+        solid_check(_rrecv_msg_ptr->str.size() > 0 && _rrecv_msg_ptr->str.find_first_not_of(static_cast<char>('a' + _rrecv_msg_ptr->idx % 26)) == std::string::npos, "message data mismatch");
+        lock_guard<mutex> lock(mtx);
+        ++recv_count;
+        cnd.notify_one();
+    }
+}
+
+void server_complete_message(
+    frame::mpipc::ConnectionContext& _rctx,
+    std::shared_ptr<Message>& _rsent_msg_ptr, std::shared_ptr<Message>& _rrecv_msg_ptr,
+    ErrorConditionT const& _rerror)
+{
+    solid_check(!_rerror, "message failed: " << _rerror.message());
+}
+
+void wait_recv(const size_t _count)
+{
+    unique_lock<mutex> lock(mtx);
+    solid_check(cnd.wait_for(lock, std::chrono::seconds(120), [_count]() { return recv_count == _count; }), "Process is taking too long: " << recv_count << " of " << _count);
+}
+
+} //namespace
+
+// The server pushes the same notification to all its client connections:
+// one sendMessage per recipient vs one multicastMessage. Whatever the server
+// reactor count, the multicast body is serialized once, chunk by chunk, by
+// the connections getting first to each chunk.
+// Usage: test_connection_multicast [RECIPIENT_COUNT] [MESSAGE_COUNT] [MESSAGE_SIZE] [SERVER_REACTOR_COUNT]
+int test_connection_multicast(int argc, char* argv[])
+{
+    solid::log_start(std::cerr, {".*:EW", "test_connection_multicast:VIEW"});
+
+    size_t recipient_count = 100;
+    size_t message_count   = 10;
+    size_t message_size    = 64 * 1024;
+    size_t reactor_count   = 1;
+
+    if (argc > 1) {
+        recipient_count = atoi(argv[1]);
+    }
+    if (argc > 2) {
+        message_count = atoi(argv[2]);
+    }
+    if (argc > 3) {
+        message_size = atoi(argv[3]);
+    }
+    if (argc > 4) {
+        reactor_count = atoi(argv[4]);
+    }
+
+    AioSchedulerT sch_client;
+    AioSchedulerT sch_server;
+
+    frame::Manager         m;
+    frame::mpipc::ServiceT mpipcserver(m);
+    frame::mpipc::ServiceT mpipcclient(m);
+    ErrorConditionT        err;
+    FunctionWorkPool       fwp{WorkPoolConfiguration()};
+    frame::aio::Resolver   resolver(fwp);
+
+    solid_check(!sch_client.start(1), "starting aio client scheduler");
+    solid_check(!sch_server.start(reactor_count), "starting aio server scheduler");
+
+    std::string server_port;
+
+    { //mpipc server initialization
+        auto                        proto = ProtocolT::create();
+        frame::mpipc::Configuration cfg(sch_server, proto);
+
+        proto->null(0);
+        proto->registerMessage<Message>(server_complete_message, 1);
+
+        cfg.connection_stop_fnc = &connection_stop;
+
+        cfg.server.listener_address_str   = "127.0.0.1:0";
+        cfg.server.connection_start_state = frame::mpipc::ConnectionState::Active;
+        cfg.server.connection_start_fnc   = &server_connection_start;
+
+        err = mpipcserver.reconfigure(std::move(cfg));
+        solid_check(!err, "starting server mpipcservice: " << err.message());
+
+        std::ostringstream oss;
+        oss << mpipcserver.configuration().server.listenerPort();
+        server_port = oss.str();
+    }
+
+    { //mpipc client initialization
+        auto                        proto = ProtocolT::create();
+        frame::mpipc::Configuration cfg(sch_client, proto);
+
+        proto->null(0);
+        proto->registerMessage<Message>(client_complete_message, 1);
+
+        cfg.client.connection_start_state     = frame::mpipc::ConnectionState::Active;
+        cfg.connection_stop_fnc               = &connection_stop;
+        cfg.pool_max_active_connection_count  = recipient_count;
+        cfg.pool_max_pending_connection_count = recipient_count;
+
+        cfg.client.name_resolve_fnc = frame::mpipc::InternetResolverF(resolver, server_port.c_str());
+
+        err = mpipcclient.reconfigure(std::move(cfg));
+        solid_check(!err, "starting client mpipcservice: " << err.message());
+    }
+
+    err = mpipcclient.createConnectionPool("localhost", recipient_count);
+    solid_check(!err, "creating connection pool: " << err.message());
+
+    {
+        unique_lock<mutex> lock(mtx);
+        solid_check(cnd.wait_for(lock, std::chrono::seconds(120), [recipient_count]() { return recipient_vec.size() == recipient_count; }), "Connecting is taking too long: " << recipient_vec.size() << " of " << recipient_count);
+    }
+
+    auto start = chrono::steady_clock::now();
+
+    for (size_t i = 0; i < message_count; ++i) {
+        auto msgptr = std::make_shared<Message>(static_cast<uint32_t>(i), message_size);
+        for (const auto& recipient_id : recipient_vec) {
+            err = mpipcserver.sendMessage(recipient_id, msgptr);
+            solid_check(!err, "sending message: " << err.message());
+        }
+    }
+    wait_recv(recipient_count * message_count);
+
+    const auto   unicast_duration        = chrono::steady_clock::now() - start;
+    const size_t unicast_serialize_count = serialize_count.exchange(0);
+
+    start = chrono::steady_clock::now();
+
+    for (size_t i = 0; i < message_count; ++i) {
+        err = mpipcserver.multicastMessage(recipient_vec, std::make_shared<Message>(static_cast<uint32_t>(i), message_size));
+        solid_check(!err, "multicasting message: " << err.message());
+    }
+    wait_recv(2 * recipient_count * message_count);
+
+    const auto   multicast_duration        = chrono::steady_clock::now() - start;
+    const size_t multicast_serialize_count = serialize_count.exchange(0);
+
+    cout << "1 -> " << recipient_count << " fan-out of " << message_count << " messages of " << message_size << " bytes:" << endl;
+    cout << "sendMessage:      " << chrono::duration_cast<chrono::milliseconds>(unicast_duration).count() << "ms " << unicast_serialize_count << " serializations" << endl;
+    cout << "multicastMessage: " << chrono::duration_cast<chrono::milliseconds>(multicast_duration).count() << "ms " << multicast_serialize_count << " serializations" << endl;
+
+    solid_check(unicast_serialize_count == recipient_count * message_count, "unexpected serialization count: " << unicast_serialize_count);
+    solid_check(multicast_serialize_count == message_count, "multicast body serialized " << multicast_serialize_count << " times");
+
+    return 0;
+}
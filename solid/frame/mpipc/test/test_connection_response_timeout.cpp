@@ -0,0 +1,242 @@
+#include "solid/frame/mpipc/mpipcsocketstub_openssl.hpp"
+
+#include "solid/frame/manager.hpp"
+#include "solid/frame/scheduler.hpp"
+#include "solid/frame/service.hpp"
+
+#include "solid/frame/aio/aioobject.hpp"
+#include "solid/frame/aio/aioreactor.hpp"
+#include "solid/frame/aio/aioresolver.hpp"
+
+#include "solid/frame/mpipc/mpipcconfiguration.hpp"
+#include "solid/frame/mpipc/mpipcerror.hpp"
+#include "solid/frame/mpipc/mpipcprotocol_serialization_v2.hpp"
+#include "solid/frame/mpipc/mpipcservice.hpp"
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#include "solid/system/exception.hpp"
+
+#include "solid/system/log.hpp"
+
+#include <iostream>
+
+using namespace std;
+using namespace solid;
+
+using AioSchedulerT = frame::Scheduler<frame::aio::Reactor>;
+using ProtocolT     = frame::mpipc::serialization_v2::Protocol<uint8_t>;
+
+namespace {
+const LoggerT logger("test_connection_response_timeout");
+
+struct Message;
+
+using MessagePointerT  = std::shared_ptr<Message>;
+using LateResponseVecT = std::vector<std::pair<frame::mpipc::RecipientId, MessagePointerT>>;
+
+mutex              mtx;
+condition_variable cnd;
+size_t             response_count     = 0;
+size_t             timeout_count      = 0;
+size_t             late_sent_count    = 0;
+bool               unexpected_message = false;
+LateResponseVecT   late_response_vec;
+
+//the server answers idx % 3 == 0 at once, never answers idx % 3 == 1
+//and answers idx % 3 == 2 only after the client gave up on them
+struct Message : frame::mpipc::Message {
+    uint32_t    idx;
+    std::string str;
+
+    Message(uint32_t _idx)
+        : idx(_idx)
+        , str(16, 'a' + _idx % 26)
+    {
+    }
+    Message() {}
+
+    SOLID_PROTOCOL_V2(_s, _rthis, _rctx, _name)
+    {
+        _s.add(_rthis.idx, _rctx, "idx");
+        _s.add(_rthis.str, _rctx, "str");
+    }
+};
+
+void connection_stop(frame::mpipc::ConnectionContext& _rctx)
+{
+    solid_dbg(logger, Info, _rctx.recipientId() << " error: " << _rctx.error().message());
+}
+
+void client_complete_message(
+    frame::mpipc::ConnectionContext& _rctx,
+    MessagePointerT& _rsent_msg_ptr, MessagePointerT& _rrecv_msg_ptr,
+    ErrorConditionT const& _rerror)
+{
+    //late responses must be dropped, not delivered as new messages
+    lock_guard<mutex> lock(mtx);
+    unexpected_message = true;
+    cnd.notify_one();
+}
+
+void client_complete_request(
+    frame::mpipc::ConnectionContext& _rctx,
+    MessagePointerT& _rsent_msg_ptr, MessagePointerT& _rrecv_msg_ptr,
+    ErrorConditionT const& _rerror)
+{
+    solid_check(_rsent_msg_ptr, "no request");
+
+    lock_guard<mutex> lock(mtx);
+    if (_rerror == frame::mpipc::error_message_response_timeout) {
+        solid_check(!_rrecv_msg_ptr && _rsent_msg_ptr->idx % 3 != 0, "unexpected timeout for " << _rsent_msg_ptr->idx);
+        ++timeout_count;
+    } else {
+        solid_check(!_rerror, "request failed: " << _rerror.message());
+        solid_check(_rrecv_msg_ptr && _rrecv_msg_ptr->idx == _rsent_msg_ptr->idx && _rsent_msg_ptr->idx % 3 == 0, "unexpected response for " << _rsent_msg_ptr->idx);
+        ++response_count;
+    }
+    cnd.notify_one();
+}
+
+void server_complete_message(
+    frame::mpipc::ConnectionContext& _rctx,
+    MessagePointerT& _rsent_msg_ptr, MessagePointerT& _rrecv_msg_ptr,
+    ErrorConditionT const& _rerror)
+{
+    solid_check(!_rerror, "message failed: " << _rerror.message());
+
+    if (_rrecv_msg_ptr) {
+        const uint32_t idx = _rrecv_msg_ptr->idx;
+        if (idx % 3 == 0) {
+            ErrorConditionT err = _rctx.service().sendResponse(_rctx.recipientId(), _rrecv_msg_ptr);
+            solid_check(!err, "sending response: " << err.message());
+        } else if (idx % 3 == 2) {
+            lock_guard<mutex> lock(mtx);
+            late_response_vec.emplace_back(_rctx.recipientId(), std::move(_rrecv_msg_ptr));
+            cnd.notify_one();
+        }
+    } else if (_rsent_msg_ptr && _rsent_msg_ptr->idx % 3 == 2) {
+        lock_guard<mutex> lock(mtx);
+        ++late_sent_count;
+        cnd.notify_one();
+    }
+}
+
+template <class Pred>
+void wait(Pred _pred)
+{
+    unique_lock<mutex> lock(mtx);
+    solid_check(cnd.wait_for(lock, std::chrono::seconds(120), _pred), "Process is taking too long");
+}
+
+} //namespace
+
+// Requests whose responses come too late or never, complete with error_message_response_timeout.
+// Usage: test_connection_response_timeout [REQUEST_COUNT] [RESPONSE_TIMEOUT_MILLISECONDS]
+int test_connection_response_timeout(int argc, char* argv[])
+{
+    solid::log_start(std::cerr, {".*:EW", "test_connection_response_timeout:VIEW"});
+
+    size_t request_count    = 30;
+    size_t response_timeout = 500;
+
+    if (argc > 1) {
+        request_count = atoi(argv[1]);
+    }
+    if (argc > 2) {
+        response_timeout = atoi(argv[2]);
+    }
+
+    AioSchedulerT sch_client;
+    AioSchedulerT sch_server;
+
+    frame::Manager         m;
+    frame::mpipc::ServiceT mpipcserver(m);
+    frame::mpipc::ServiceT mpipcclient(m);
+    ErrorConditionT        err;
+    FunctionWorkPool       fwp{WorkPoolConfiguration()};
+    frame::aio::Resolver   resolver(fwp);
+    auto                   statistic_ptr = std::make_shared<frame::mpipc::WriterStatistic>();
+
+    solid_check(!sch_client.start(1), "starting aio client scheduler");
+    solid_check(!sch_server.start(1), "starting aio server scheduler");
+
+    std::string server_port;
+
+    { //mpipc server initialization
+        auto                        proto = ProtocolT::create();
+        frame::mpipc::Configuration cfg(sch_server, proto);
+
+        proto->null(0);
+        proto->registerMessage<Message>(server_complete_message, 1);
+
+        cfg.connection_stop_fnc = &connection_stop;
+
+        cfg.server.listener_address_str   = "127.0.0.1:0";
+        cfg.server.connection_start_state = frame::mpipc::ConnectionState::Active;
+
+        err = mpipcserver.reconfigure(std::move(cfg));
+        solid_check(!err, "starting server mpipcservice: " << err.message());
+
+        std::ostringstream oss;
+        oss << mpipcserver.configuration().server.listenerPort();
+        server_port = oss.str();
+    }
+
+    { //mpipc client initialization
+        auto                        proto = ProtocolT::create();
+        frame::mpipc::Configuration cfg(sch_client, proto);
+
+        proto->null(0);
+        proto->registerMessage<Message>(client_complete_message, 1);
+
+        cfg.client.connection_start_state = frame::mpipc::ConnectionState::Active;
+        cfg.connection_stop_fnc           = &connection_stop;
+        cfg.pool_max_message_queue_size   = request_count + 1;
+
+        cfg.client.name_resolve_fnc = frame::mpipc::InternetResolverF(resolver, server_port.c_str());
+
+        cfg.writer.response_timeout_milliseconds = response_timeout;
+        cfg.writer.statistic_ptr                 = statistic_ptr;
+
+        err = mpipcclient.reconfigure(std::move(cfg));
+        solid_check(!err, "starting client mpipcservice: " << err.message());
+    }
+
+    const size_t expect_timeout_count = request_count - (request_count + 2) / 3;
+    const size_t expect_late_count    = request_count / 3;
+
+    for (size_t i = 0; i < request_count; ++i) {
+        err = mpipcclient.sendRequest("localhost", std::make_shared<Message>(static_cast<uint32_t>(i)), client_complete_request);
+        solid_check(!err, "sending request: " << err.message());
+    }
+
+    wait([request_count]() { return response_count + timeout_count == request_count; });
+
+    solid_check(timeout_count == expect_timeout_count, "timeout count " << timeout_count << " expected " << expect_timeout_count);
+
+    wait([expect_late_count]() { return late_response_vec.size() == expect_late_count; });
+
+    for (auto& late_response : late_response_vec) {
+        err = mpipcserver.sendResponse(late_response.first, late_response.second);
+        solid_check(!err, "sending late response: " << err.message());
+    }
+
+    wait([expect_late_count]() { return late_sent_count == expect_late_count; });
+
+    //the connection must still serve requests after the late responses
+    err = mpipcclient.sendRequest("localhost", std::make_shared<Message>(static_cast<uint32_t>(3 * request_count)), client_complete_request);
+    solid_check(!err, "sending request: " << err.message());
+
+    wait([request_count]() { return response_count + timeout_count == request_count + 1; });
+
+    cout << "Writer statistic:" << *statistic_ptr << endl;
+
+    solid_check(!unexpected_message, "late response delivered as a new message");
+    solid_check(statistic_ptr->response_timeout_count_ == expect_timeout_count, "statistic timeout count " << statistic_ptr->response_timeout_count_);
+
+    return 0;
+}
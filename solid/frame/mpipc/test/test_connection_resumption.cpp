@@ -0,0 +1,257 @@
+#include "solid/frame/mpipc/mpipcsocketstub_openssl.hpp"
+
+#include "solid/frame/manager.hpp"
+#include "solid/frame/scheduler.hpp"
+#include "solid/frame/service.hpp"
+
+#include "solid/frame/aio/aioobject.hpp"
+#include "solid/frame/aio/aioreactor.hpp"
+#include "solid/frame/aio/aioresolver.hpp"
+
+#include "solid/frame/mpipc/mpipcconfiguration.hpp"
+#include "solid/frame/mpipc/mpipcerror.hpp"
+#include "solid/frame/mpipc/mpipcprotocol_serialization_v2.hpp"
+#include "solid/frame/mpipc/mpipcservice.hpp"
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#include "solid/system/exception.hpp"
+
+#include "solid/system/log.hpp"
+
+#include <iostream>
+
+using namespace std;
+using namespace solid;
+
+using AioSchedulerT = frame::Scheduler<frame::aio::Reactor>;
+using ProtocolT     = frame::mpipc::serialization_v2::Protocol<uint8_t>;
+
+namespace {
+const LoggerT logger("test_connection_resumption");
+
+mutex              mtx;
+condition_variable cnd;
+size_t             response_count       = 0;
+size_t             close_count          = 0;
+size_t             full_handshake_count = 0;
+
+struct Message : frame::mpipc::Message {
+    uint32_t idx;
+
+    Message(uint32_t _idx)
+        : idx(_idx)
+    {
+    }
+    Message() {}
+
+    SOLID_PROTOCOL_V2(_s, _rthis, _rctx, _name)
+    {
+        _s.add(_rthis.idx, _rctx, "idx");
+    }
+};
+
+void connection_stop(frame::mpipc::ConnectionContext& _rctx)
+{
+    solid_dbg(logger, Info, _rctx.recipientId() << " error: " << _rctx.error().message());
+}
+
+//the server certificate is only verified on full handshakes
+bool client_secure_verify(
+    frame::aio::ReactorContext& _rctx, frame::mpipc::ConnectionContext& _rconctx, frame::mpipc::openssl::StreamSocketT& _rsock, bool _preverified, frame::aio::openssl::VerifyContext& _rverify_ctx)
+{
+    if (X509_STORE_CTX_get_error_depth(_rverify_ctx.nativeHandle()) == 0) {
+        lock_guard<mutex> lock(mtx);
+        ++full_handshake_count;
+    }
+    return _preverified;
+}
+
+void client_complete_message(
+    frame::mpipc::ConnectionContext& _rctx,
+    std::shared_ptr<Message>& _rsent_msg_ptr, std::shared_ptr<Message>& _rrecv_msg_ptr,
+    ErrorConditionT const& _rerror)
+{
+    solid_check(!_rerror, "message failed: " << _rerror.message());
+    if (_rrecv_msg_ptr) {
+        solid_check(_rsent_msg_ptr && _rsent_msg_ptr->idx == _rrecv_msg_ptr->idx, "response mismatch");
+        lock_guard<mutex> lock(mtx);
+        ++response_count;
+        cnd.notify_one();
+    }
+}
+
+void server_complete_message(
+    frame::mpipc::ConnectionContext& _rctx,
+    std::shared_ptr<Message>& _rsent_msg_ptr, std::shared_ptr<Message>& _rrecv_msg_ptr,
+    ErrorConditionT const& _rerror)
+{
+    solid_check(!_rerror, "message failed: " << _rerror.message());
+    if (_rrecv_msg_ptr) {
+        ErrorConditionT err = _rctx.service().sendResponse(_rctx.recipientId(), _rrecv_msg_ptr);
+        solid_check(!err, "sending response: " << err.message());
+    }
+}
+
+template <class Pred>
+void wait(Pred _pred)
+{
+    unique_lock<mutex> lock(mtx);
+    solid_check(cnd.wait_for(lock, std::chrono::seconds(60), _pred), "Process is taking too long");
+}
+
+//every iteration opens a new connection to the same pool, does one request and closes the pool
+size_t connect_loop(frame::mpipc::ServiceT& _rmpipcclient, const size_t _count, const frame::mpipc::Configuration* _protate_cfg = nullptr)
+{
+    {
+        lock_guard<mutex> lock(mtx);
+        response_count = close_count = full_handshake_count = 0;
+    }
+
+    for (size_t i = 0; i < _count; ++i) {
+        if (_protate_cfg != nullptr && (i == _count / 3 || i == (2 * _count) / 3)) {
+            //first rotation: the ticket is still accepted, second: two rotations later it is not
+            const size_t rotate_count = i == _count / 3 ? 1 : 2;
+            for (size_t j = 0; j < rotate_count; ++j) {
+                const ErrorCodeT err = frame::mpipc::openssl::rotate_session_ticket_key(*_protate_cfg);
+                solid_check(!err, "rotating session ticket key: " << err.message());
+            }
+        }
+
+        frame::mpipc::RecipientId recipient_id;
+        ErrorConditionT           err = _rmpipcclient.sendRequest("localhost", std::make_shared<Message>(static_cast<uint32_t>(i)), client_complete_message, recipient_id);
+        solid_check(!err, "sending request: " << err.message());
+
+        wait([i]() { return response_count == i + 1; });
+
+        err = _rmpipcclient.forceCloseConnectionPool(
+            recipient_id,
+            [](frame::mpipc::ConnectionContext& _rctx) {
+                lock_guard<mutex> lock(mtx);
+                ++close_count;
+                cnd.notify_one();
+            });
+        solid_check(!err, "closing connection pool: " << err.message());
+
+        wait([i]() { return close_count == i + 1; });
+    }
+
+    lock_guard<mutex> lock(mtx);
+    return full_handshake_count;
+}
+
+} //namespace
+
+// Handshakes per second of secure reconnects to the same pool, with and without TLS session resumption.
+// Halfway the server rotates its session ticket key: once (tickets still accepted), then twice (one full handshake).
+// Usage: test_connection_resumption [CONNECTION_COUNT]
+int test_connection_resumption(int argc, char* argv[])
+{
+    solid::log_start(std::cerr, {".*:EW", "test_connection_resumption:VIEW"});
+
+    size_t connection_count = 60;
+
+    if (argc > 1) {
+        connection_count = atoi(argv[1]);
+    }
+
+    AioSchedulerT sch_client;
+    AioSchedulerT sch_server;
+
+    frame::Manager         m;
+    frame::mpipc::ServiceT mpipcserver(m);
+    frame::mpipc::ServiceT mpipcclient_full(m);
+    frame::mpipc::ServiceT mpipcclient_resume(m);
+    ErrorConditionT        err;
+    FunctionWorkPool       fwp{WorkPoolConfiguration()};
+    frame::aio::Resolver   resolver(fwp);
+
+    solid_check(!sch_client.start(1), "starting aio client scheduler");
+    solid_check(!sch_server.start(1), "starting aio server scheduler");
+
+    std::string server_port;
+
+    { //mpipc server initialization
+        auto                        proto = ProtocolT::create();
+        frame::mpipc::Configuration cfg(sch_server, proto);
+
+        proto->null(0);
+        proto->registerMessage<Message>(server_complete_message, 1);
+
+        cfg.connection_stop_fnc = &connection_stop;
+
+        cfg.server.listener_address_str   = "127.0.0.1:0";
+        cfg.server.connection_start_state = frame::mpipc::ConnectionState::Active;
+
+        frame::mpipc::openssl::setup_server(
+            cfg,
+            [](frame::aio::openssl::Context& _rctx) -> ErrorCodeT {
+                _rctx.loadVerifyFile("echo-ca-cert.pem");
+                _rctx.loadCertificateFile("echo-server-cert.pem");
+                _rctx.loadPrivateKeyFile("echo-server-key.pem");
+                _rctx.setSessionIdContext("test_connection_resumption");
+                return _rctx.rotateSessionTicketKey();
+            },
+            frame::mpipc::openssl::NameCheckSecureStart{"echo-client"});
+
+        err = mpipcserver.reconfigure(std::move(cfg));
+        solid_check(!err, "starting server mpipcservice: " << err.message());
+
+        std::ostringstream oss;
+        oss << mpipcserver.configuration().server.listenerPort();
+        server_port = oss.str();
+    }
+
+    for (auto* pmpipcclient : {&mpipcclient_full, &mpipcclient_resume}) { //mpipc clients initialization
+        auto                        proto = ProtocolT::create();
+        frame::mpipc::Configuration cfg(sch_client, proto);
+        const bool                  resume = pmpipcclient == &mpipcclient_resume;
+
+        proto->null(0);
+        proto->registerMessage<Message>(client_complete_message, 1);
+
+        cfg.client.connection_start_state = frame::mpipc::ConnectionState::Active;
+        cfg.connection_stop_fnc           = &connection_stop;
+
+        cfg.client.name_resolve_fnc = frame::mpipc::InternetResolverF(resolver, server_port.c_str());
+
+        frame::mpipc::openssl::setup_client(
+            cfg,
+            [resume](frame::aio::openssl::Context& _rctx) -> ErrorCodeT {
+                _rctx.loadVerifyFile("echo-ca-cert.pem");
+                _rctx.loadCertificateFile("echo-client-cert.pem");
+                _rctx.loadPrivateKeyFile("echo-client-key.pem");
+                if (resume) {
+                    return _rctx.enableSessionCache();
+                }
+                return ErrorCodeT();
+            },
+            frame::mpipc::openssl::NameCheckSecureStart{"echo-server"},
+            client_secure_verify);
+
+        err = pmpipcclient->reconfigure(std::move(cfg));
+        solid_check(!err, "starting client mpipcservice: " << err.message());
+    }
+
+    auto         start         = chrono::steady_clock::now();
+    const size_t full_count    = connect_loop(mpipcclient_full, connection_count);
+    const auto   full_duration = chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - start).count();
+
+    start = chrono::steady_clock::now();
+
+    const size_t resume_full_count   = connect_loop(mpipcclient_resume, connection_count, &mpipcserver.configuration());
+    const auto   resume_duration     = chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - start).count();
+    const size_t expect_resume_count = connection_count - 2; //all but the first connection and the one after the second rotation
+
+    cout << connection_count << " secure reconnects:" << endl;
+    cout << "full handshakes:    " << full_duration << "ms " << (connection_count * 1000 / (full_duration + 1)) << " handshakes/sec " << full_count << " full" << endl;
+    cout << "session resumption: " << resume_duration << "ms " << (connection_count * 1000 / (resume_duration + 1)) << " handshakes/sec " << resume_full_count << " full" << endl;
+
+    solid_check(full_count == connection_count, "unexpected full handshake count without session cache: " << full_count);
+    solid_check(connection_count - resume_full_count == expect_resume_count, "unexpected resumed session count: " << (connection_count - resume_full_count));
+
+    return 0;
+}
@@ -0,0 +1,282 @@
+#include "solid/frame/mpipc/mpipcsocketstub_openssl.hpp"
+
+#include "solid/frame/manager.hpp"
+#include "solid/frame/scheduler.hpp"
+#include "solid/frame/service.hpp"
+
+#include "solid/frame/aio/aioobject.hpp"
+#include "solid/frame/aio/aioreactor.hpp"
+#include "solid/frame/aio/aioresolver.hpp"
+
+#include "solid/frame/mpipc/mpipcconfiguration.hpp"
+#include "solid/frame/mpipc/mpipcerror.hpp"
+#include "solid/frame/mpipc/mpipcprotocol_serialization_v2.hpp"
+#include "solid/frame/mpipc/mpipcservice.hpp"
+
+#include "solid/utility/chunkstream.hpp"
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#include "solid/system/exception.hpp"
+
+#include "solid/system/log.hpp"
+
+#include <iostream>
+
+using namespace std;
+using namespace solid;
+
+using AioSchedulerT = frame::Scheduler<frame::aio::Reactor>;
+using ProtocolT     = frame::mpipc::serialization_v2::Protocol<uint8_t>;
+
+namespace {
+const LoggerT logger("test_connection_stream_sink");
+
+mutex              mtx;
+condition_variable cnd;
+size_t             recv_count = 0;
+size_t             sent_count = 0;
+
+inline char pattern_char(const uint64_t _pos, const uint32_t _idx)
+{
+    return static_cast<char>('a' + (_pos + _idx) % 26);
+}
+
+//generates the data of a message, so that the sender does not hold it either
+class PatternIStreamBuf : public std::streambuf {
+    char     buf[4096];
+    uint64_t pos;
+    uint64_t size;
+    uint32_t idx;
+
+public:
+    PatternIStreamBuf(const uint64_t _size, const uint32_t _idx)
+        : pos(0)
+        , size(_size)
+        , idx(_idx)
+    {
+        setg(buf, buf, buf);
+    }
+
+protected:
+    int_type underflow() override
+    {
+        if (pos == size) {
+            return traits_type::eof();
+        }
+        size_t len = sizeof(buf);
+        if (len > size - pos) {
+            len = static_cast<size_t>(size - pos);
+        }
+        for (size_t i = 0; i < len; ++i) {
+            buf[i] = pattern_char(pos + i, idx);
+        }
+        pos += len;
+        setg(buf, buf, buf + len);
+        return traits_type::to_int_type(buf[0]);
+    }
+};
+
+struct PatternIStream : std::istream {
+    PatternIStreamBuf buf;
+
+    PatternIStream(const uint64_t _size, const uint32_t _idx)
+        : std::istream(nullptr)
+        , buf(_size, _idx)
+    {
+        rdbuf(&buf);
+    }
+};
+
+//On the receiving side the data goes, as it is deserialized, to a chunk sink
+//checking it - the message never holds it
+struct Message : frame::mpipc::Message {
+    uint32_t     idx;
+    uint64_t     size;
+    ChunkOStream chunk_os;
+    uint64_t     check_pos      = 0;
+    size_t       chunk_count    = 0;
+    size_t       max_chunk_size = 0;
+    bool         check_failed   = false;
+    bool         done           = false;
+
+    Message(uint32_t _idx, uint64_t _size)
+        : idx(_idx)
+        , size(_size)
+    {
+    }
+    Message() {}
+
+    void consume(const char* _pbuf, size_t _sz)
+    {
+        for (size_t i = 0; i < _sz; ++i) {
+            if (_pbuf[i] != pattern_char(check_pos + i, idx)) {
+                check_failed = true;
+            }
+        }
+        check_pos += _sz;
+        ++chunk_count;
+        if (_sz > max_chunk_size) {
+            max_chunk_size = _sz;
+        }
+    }
+
+    template <class S>
+    void solidSerializeV2(S& _s, frame::mpipc::ConnectionContext& _rctx, const char* _name) const
+    {
+        _s.add(idx, _rctx, "idx");
+        _s.add(size, _rctx, "size");
+        _s.push([pis = std::unique_ptr<PatternIStream>(new PatternIStream(size, idx))](S& _s, frame::mpipc::ConnectionContext& _rctx, const char* _name) mutable {
+            _s.add(*pis, [](std::istream& _ris, uint64_t _len, const bool _done, frame::mpipc::ConnectionContext& _rctx, const char* _name) {}, _rctx, _name);
+            return true;
+        },
+            _rctx, "data");
+    }
+
+    template <class S>
+    void solidSerializeV2(S& _s, frame::mpipc::ConnectionContext& _rctx, const char* _name)
+    {
+        _s.add(idx, _rctx, "idx");
+        _s.add(size, _rctx, "size");
+
+        chunk_os.sink([this](const char* _pbuf, size_t _sz) { consume(_pbuf, _sz); });
+
+        _s.add(chunk_os, [this](std::ostream& _ros, uint64_t _len, const bool _done, frame::mpipc::ConnectionContext& _rctx, const char* _name) {
+            done = _done;
+        },
+            _rctx, "data");
+    }
+};
+
+void connection_stop(frame::mpipc::ConnectionContext& _rctx)
+{
+    solid_dbg(logger, Info, _rctx.recipientId() << " error: " << _rctx.error().message());
+}
+
+void client_complete_message(
+    frame::mpipc::ConnectionContext& _rctx,
+    std::shared_ptr<Message>& _rsent_msg_ptr, std::shared_ptr<Message>& _rrecv_msg_ptr,
+    ErrorConditionT const& _rerror)
+{
+    solid_check(!_rerror, "message failed: " << _rerror.message());
+    if (_rsent_msg_ptr) {
+        lock_guard<mutex> lock(mtx);
+        ++sent_count;
+        cnd.notify_one();
+    }
+}
+
+void server_complete_message(
+    frame::mpipc::ConnectionContext& _rctx,
+    std::shared_ptr<Message>& _rsent_msg_ptr, std::shared_ptr<Message>& _rrecv_msg_ptr,
+    ErrorConditionT const& _rerror)
+{
+    solid_check(!_rerror, "message failed: " << _rerror.message());
+    if (_rrecv_msg_ptr) {
+        Message& rmsg = *_rrecv_msg_ptr;
+
+        solid_check(rmsg.done && !rmsg.check_failed, "message " << rmsg.idx << " data mismatch");
+        solid_check(rmsg.check_pos == rmsg.size && rmsg.chunk_os.size() == rmsg.size, "message " << rmsg.idx << " received " << rmsg.check_pos << " of " << rmsg.size);
+        //the data came in many chunks, none larger than a packet
+        solid_check(rmsg.size < 1024 * 1024 || rmsg.chunk_count > 16, "message " << rmsg.idx << " received in " << rmsg.chunk_count << " chunks");
+        solid_check(rmsg.max_chunk_size <= 64 * 1024, "message " << rmsg.idx << " chunk of " << rmsg.max_chunk_size);
+
+        solid_dbg(logger, Info, "message " << rmsg.idx << " received in " << rmsg.chunk_count << " chunks of at most " << rmsg.max_chunk_size);
+
+        lock_guard<mutex> lock(mtx);
+        ++recv_count;
+        cnd.notify_one();
+    }
+}
+
+} //namespace
+
+// Big messages are received through a chunk sink, as the packets come, without ever being held in memory.
+// Usage: test_connection_stream_sink [MESSAGE_COUNT] [MESSAGE_SIZE]
+int test_connection_stream_sink(int argc, char* argv[])
+{
+    solid::log_start(std::cerr, {".*:EW", "test_connection_stream_sink:VIEW"});
+
+    size_t   message_count = 4;
+    uint64_t message_size  = 64 * 1024 * 1024;
+
+    if (argc > 1) {
+        message_count = atoi(argv[1]);
+    }
+    if (argc > 2) {
+        message_size = atoll(argv[2]);
+    }
+
+    AioSchedulerT sch_client;
+    AioSchedulerT sch_server;
+
+    frame::Manager         m;
+    frame::mpipc::ServiceT mpipcserver(m);
+    frame::mpipc::ServiceT mpipcclient(m);
+    ErrorConditionT        err;
+    FunctionWorkPool       fwp{WorkPoolConfiguration()};
+    frame::aio::Resolver   resolver(fwp);
+
+    solid_check(!sch_client.start(1), "starting aio client scheduler");
+    solid_check(!sch_server.start(1), "starting aio server scheduler");
+
+    std::string server_port;
+
+    { //mpipc server initialization
+        auto                        proto = ProtocolT::create();
+        frame::mpipc::Configuration cfg(sch_server, proto);
+
+        proto->null(0);
+        proto->registerMessage<Message>(server_complete_message, 1);
+
+        cfg.connection_stop_fnc = &connection_stop;
+
+        cfg.server.listener_address_str   = "127.0.0.1:0";
+        cfg.server.connection_start_state = frame::mpipc::ConnectionState::Active;
+
+        err = mpipcserver.reconfigure(std::move(cfg));
+        solid_check(!err, "starting server mpipcservice: " << err.message());
+
+        std::ostringstream oss;
+        oss << mpipcserver.configuration().server.listenerPort();
+        server_port = oss.str();
+    }
+
+    { //mpipc client initialization
+        auto                        proto = ProtocolT::create();
+        frame::mpipc::Configuration cfg(sch_client, proto);
+
+        proto->null(0);
+        proto->registerMessage<Message>(client_complete_message, 1);
+
+        cfg.client.connection_start_state = frame::mpipc::ConnectionState::Active;
+        cfg.connection_stop_fnc           = &connection_stop;
+        cfg.pool_max_message_queue_size   = message_count;
+
+        cfg.client.name_resolve_fnc = frame::mpipc::InternetResolverF(resolver, server_port.c_str());
+
+        err = mpipcclient.reconfigure(std::move(cfg));
+        solid_check(!err, "starting client mpipcservice: " << err.message());
+    }
+
+    const auto start = chrono::steady_clock::now();
+
+    for (size_t i = 0; i < message_count; ++i) {
+        err = mpipcclient.sendMessage("localhost", std::make_shared<Message>(static_cast<uint32_t>(i), message_size), {});
+        solid_check(!err, "sending message: " << err.message());
+    }
+
+    {
+        unique_lock<mutex> lock(mtx);
+        solid_check(cnd.wait_for(lock, std::chrono::seconds(120), [message_count]() { return recv_count == message_count && sent_count == message_count; }), "Process is taking too long: " << recv_count << " of " << message_count);
+    }
+
+    const auto duration = chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - start).count();
+
+    cout << message_count << " messages of " << message_size << " bytes streamed in " << duration << "ms" << endl;
+
+    return 0;
+}
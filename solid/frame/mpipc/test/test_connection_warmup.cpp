@@ -0,0 +1,248 @@
+#include "solid/frame/mpipc/mpipcsocketstub_openssl.hpp"
+
+#include "solid/frame/manager.hpp"
+#include "solid/frame/scheduler.hpp"
+#include "solid/frame/service.hpp"
+
+#include "solid/frame/aio/aioobject.hpp"
+#include "solid/frame/aio/aioreactor.hpp"
+#include "solid/frame/aio/aioresolver.hpp"
+
+#include "solid/frame/mpipc/mpipcconfiguration.hpp"
+#include "solid/frame/mpipc/mpipcerror.hpp"
+#include "solid/frame/mpipc/mpipcprotocol_serialization_v2.hpp"
+#include "solid/frame/mpipc/mpipcservice.hpp"
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "solid/system/exception.hpp"
+
+#include "solid/system/log.hpp"
+
+#include <iostream>
+
+using namespace std;
+using namespace solid;
+
+using AioSchedulerT = frame::Scheduler<frame::aio::Reactor>;
+using ProtocolT     = frame::mpipc::serialization_v2::Protocol<uint8_t>;
+
+namespace {
+const LoggerT logger("test_connection_warmup");
+
+mutex              mtx;
+condition_variable cnd;
+size_t             server_connection_count = 0;
+size_t             response_count          = 0;
+
+struct Message : frame::mpipc::Message {
+    uint32_t idx;
+
+    Message(uint32_t _idx)
+        : idx(_idx)
+    {
+    }
+    Message() {}
+
+    SOLID_PROTOCOL_V2(_s, _rthis, _rctx, _name)
+    {
+        _s.add(_rthis.idx, _rctx, "idx");
+    }
+};
+
+//A listener whose accept queue is full: connects to it neither succeed nor fail
+struct BlackHole {
+    int         listen_fd = -1;
+    vector<int> fill_fd_vec;
+    int         port = 0;
+
+    BlackHole()
+    {
+        sockaddr_in addr{};
+        socklen_t   addr_len = sizeof(addr);
+
+        addr.sin_family      = AF_INET;
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+        listen_fd = socket(AF_INET, SOCK_STREAM, 0);
+        solid_check(listen_fd >= 0, "blackhole socket");
+        solid_check(bind(listen_fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) == 0, "blackhole bind");
+        solid_check(listen(listen_fd, 0) == 0, "blackhole listen");
+        solid_check(getsockname(listen_fd, reinterpret_cast<sockaddr*>(&addr), &addr_len) == 0, "blackhole getsockname");
+
+        port = ntohs(addr.sin_port);
+
+        for (int i = 0; i < 4; ++i) {
+            const int fd = socket(AF_INET, SOCK_STREAM, 0);
+            fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+            connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
+            fill_fd_vec.push_back(fd);
+        }
+        this_thread::sleep_for(chrono::milliseconds(100));
+    }
+
+    ~BlackHole()
+    {
+        for (const auto fd : fill_fd_vec) {
+            close(fd);
+        }
+        close(listen_fd);
+    }
+};
+
+void connection_stop(frame::mpipc::ConnectionContext& _rctx)
+{
+    solid_dbg(logger, Info, _rctx.recipientId() << " error: " << _rctx.error().message());
+}
+
+void server_connection_start(frame::mpipc::ConnectionContext& _rctx)
+{
+    lock_guard<mutex> lock(mtx);
+    ++server_connection_count;
+    cnd.notify_one();
+}
+
+void client_complete_message(
+    frame::mpipc::ConnectionContext& _rctx,
+    std::shared_ptr<Message>& _rsent_msg_ptr, std::shared_ptr<Message>& _rrecv_msg_ptr,
+    ErrorConditionT const& _rerror)
+{
+    solid_check(!_rerror, "message failed: " << _rerror.message());
+    if (_rrecv_msg_ptr) {
+        solid_check(_rsent_msg_ptr && _rsent_msg_ptr->idx == _rrecv_msg_ptr->idx, "response mismatch");
+        lock_guard<mutex> lock(mtx);
+        ++response_count;
+        cnd.notify_one();
+    }
+}
+
+void server_complete_message(
+    frame::mpipc::ConnectionContext& _rctx,
+    std::shared_ptr<Message>& _rsent_msg_ptr, std::shared_ptr<Message>& _rrecv_msg_ptr,
+    ErrorConditionT const& _rerror)
+{
+    solid_check(!_rerror, "message failed: " << _rerror.message());
+    if (_rrecv_msg_ptr) {
+        ErrorConditionT err = _rctx.service().sendResponse(_rctx.recipientId(), _rrecv_msg_ptr);
+        solid_check(!err, "sending response: " << err.message());
+    }
+}
+
+} //namespace
+
+// A persistent pool warms up all its standby connections at once, and every
+// connection first tries an address that never answers, then - after the
+// hedge delay - the address of the server.
+// Usage: test_connection_warmup [CONNECTION_COUNT] [HEDGE_DELAY_MILLISECONDS]
+int test_connection_warmup(int argc, char* argv[])
+{
+    solid::log_start(std::cerr, {".*:EW", "test_connection_warmup:VIEW"});
+
+    size_t   connection_count = 4;
+    uint32_t hedge_delay      = 200;
+
+    if (argc > 1) {
+        connection_count = atoi(argv[1]);
+    }
+    if (argc > 2) {
+        hedge_delay = atoi(argv[2]);
+    }
+
+    BlackHole     black_hole;
+    AioSchedulerT sch_client;
+    AioSchedulerT sch_server;
+
+    frame::Manager         m;
+    frame::mpipc::ServiceT mpipcserver(m);
+    frame::mpipc::ServiceT mpipcclient(m);
+    ErrorConditionT        err;
+
+    solid_check(!sch_client.start(1), "starting aio client scheduler");
+    solid_check(!sch_server.start(1), "starting aio server scheduler");
+
+    int server_port = 0;
+
+    { //mpipc server initialization
+        auto                        proto = ProtocolT::create();
+        frame::mpipc::Configuration cfg(sch_server, proto);
+
+        proto->null(0);
+        proto->registerMessage<Message>(server_complete_message, 1);
+
+        cfg.connection_stop_fnc = &connection_stop;
+
+        cfg.server.listener_address_str   = "127.0.0.1:0";
+        cfg.server.connection_start_state = frame::mpipc::ConnectionState::Active;
+        cfg.server.connection_start_fnc   = &server_connection_start;
+
+        err = mpipcserver.reconfigure(std::move(cfg));
+        solid_check(!err, "starting server mpipcservice: " << err.message());
+
+        server_port = mpipcserver.configuration().server.listenerPort();
+    }
+
+    { //mpipc client initialization
+        auto                        proto = ProtocolT::create();
+        frame::mpipc::Configuration cfg(sch_client, proto);
+
+        proto->null(0);
+        proto->registerMessage<Message>(client_complete_message, 1);
+
+        cfg.client.connection_start_state     = frame::mpipc::ConnectionState::Active;
+        cfg.connection_stop_fnc               = &connection_stop;
+        cfg.pool_max_active_connection_count  = connection_count;
+        cfg.pool_max_pending_connection_count = 2 * connection_count; //room for the hedged connections
+
+        //the last address is tried first
+        cfg.client.name_resolve_fnc = [server_port, &black_hole](const std::string&, frame::mpipc::ResolveCompleteFunctionT& _rcbk) {
+            frame::mpipc::AddressVectorT addrvec;
+            addrvec.emplace_back("127.0.0.1", server_port);
+            addrvec.emplace_back("127.0.0.1", black_hole.port);
+            _rcbk(std::move(addrvec));
+        };
+        cfg.client.connection_hedge_delay_milliseconds = hedge_delay;
+
+        err = mpipcclient.reconfigure(std::move(cfg));
+        solid_check(!err, "starting client mpipcservice: " << err.message());
+    }
+
+    const auto start = chrono::steady_clock::now();
+
+    err = mpipcclient.createConnectionPool("localhost", connection_count);
+    solid_check(!err, "creating connection pool: " << err.message());
+
+    {
+        unique_lock<mutex> lock(mtx);
+        solid_check(cnd.wait_for(lock, std::chrono::seconds(60), [connection_count]() { return server_connection_count == connection_count; }), "Warm up is taking too long: " << server_connection_count << " of " << connection_count);
+    }
+
+    const auto warmup_duration = chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - start).count();
+
+    cout << connection_count << " connections warmed up in " << warmup_duration << "ms with " << hedge_delay << "ms hedge delay" << endl;
+
+    //one after the other, each connection would have waited for its own hedge delay
+    solid_check(static_cast<size_t>(warmup_duration) < connection_count * hedge_delay, "connections not warmed up concurrently");
+
+    for (size_t i = 0; i < connection_count; ++i) {
+        err = mpipcclient.sendRequest("localhost", std::make_shared<Message>(static_cast<uint32_t>(i)), client_complete_message);
+        solid_check(!err, "sending request: " << err.message());
+    }
+
+    {
+        unique_lock<mutex> lock(mtx);
+        solid_check(cnd.wait_for(lock, std::chrono::seconds(60), [connection_count]() { return response_count == connection_count; }), "Process is taking too long: " << response_count << " of " << connection_count);
+    }
+
+    solid_check(server_connection_count == connection_count, "unexpected server connections: " << server_connection_count);
+
+    return 0;
+}
@@ -29,6 +29,10 @@ struct TimerCallback;
 
 typedef DynamicPointer<Object> ObjectPointerT;
 
+//! The basic reactor has nothing to configure
+struct ReactorConfiguration {
+};
+
 //!
 /*!
 
@@ -60,10 +64,11 @@ class Reactor : public frame::ReactorBase {
     };
 
 public:
-    typedef ObjectPointerT TaskT;
-    typedef Object         ObjectT;
+    typedef ObjectPointerT       TaskT;
+    typedef Object               ObjectT;
+    typedef ReactorConfiguration ConfigurationT;
 
-    Reactor(SchedulerBase& _rsched, const size_t _schedidx);
+    Reactor(SchedulerBase& _rsched, const size_t _schedidx, ConfigurationT const& _rcfg = ConfigurationT());
     ~Reactor();
 
     template <typename Function>
@@ -34,6 +34,8 @@ public:
     bool   prepareThread(const bool _success);
     void   unprepareThread();
     size_t load() const;
+    //! The NUMA node of the CPU set the reactor is bound to - 0 if not bound
+    size_t numaNode() const;
 
 protected:
     typedef std::atomic<size_t> AtomicSizeT;
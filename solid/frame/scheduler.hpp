@@ -22,8 +22,9 @@ class Service;
 template <class R>
 class Scheduler : private SchedulerBase {
 public:
-    typedef typename R::ObjectT     ObjectT;
-    typedef DynamicPointer<ObjectT> ObjectPointerT;
+    typedef typename R::ObjectT         ObjectT;
+    typedef DynamicPointer<ObjectT>     ObjectPointerT;
+    typedef typename R::ConfigurationT ReactorConfigurationT;
 
 private:
     typedef R ReactorT;
@@ -31,9 +32,12 @@ private:
     struct Worker {
         static void run(SchedulerBase* _psched, const size_t _idx)
         {
-            ReactorT reactor(*_psched, _idx);
+            //bind the thread before creating the reactor, so that the reactor
+            //data is allocated on the NUMA node of its CPU set
+            const bool bound = static_cast<Scheduler*>(_psched)->doBindThread(_idx);
+            ReactorT   reactor(*_psched, _idx, static_cast<Scheduler*>(_psched)->reactor_config_);
 
-            if (!reactor.prepareThread(reactor.start())) {
+            if (!reactor.prepareThread(bound && reactor.start())) {
                 return;
             }
             reactor.run();
@@ -71,7 +75,11 @@ private:
     };
 
 public:
-    Scheduler() {}
+    //! The configuration is used by all the reactors of the Scheduler
+    explicit Scheduler(ReactorConfigurationT const& _rreactor_config = ReactorConfigurationT())
+        : reactor_config_(_rreactor_config)
+    {
+    }
 
     ErrorConditionT start(const size_t _reactorcnt = 1)
     {
@@ -88,6 +96,28 @@ public:
         return SchedulerBase::doStart(Worker::create, enf, exf, _reactorcnt);
     }
 
+    //! Start one reactor for every CPU set, with its thread bound to the CPU set
+    /*!
+     * Everything a reactor allocates, including the objects' buffers
+     * allocated on the reactor thread (e.g. mpipc connection buffers), is
+     * placed by the first touch memory policy on the local NUMA node.
+     * See cpu_set_per_cpu and cpu_set_per_numa_node.
+     */
+    ErrorConditionT start(CpuSetVectorT const& _rcpu_set_vec)
+    {
+        ThreadEnterFunctionT enf;
+        ThreadExitFunctionT  exf;
+        return SchedulerBase::doStart(Worker::create, enf, exf, _rcpu_set_vec.size(), _rcpu_set_vec);
+    }
+
+    template <class EnterFct, class ExitFct>
+    ErrorConditionT start(EnterFct _enf, ExitFct _exf, CpuSetVectorT const& _rcpu_set_vec)
+    {
+        ThreadEnterFunctionT enf(std::move(_enf));
+        ThreadExitFunctionT  exf(std::move(_exf));
+        return SchedulerBase::doStart(Worker::create, enf, exf, _rcpu_set_vec.size(), _rcpu_set_vec);
+    }
+
     void stop(const bool _wait = true)
     {
         SchedulerBase::doStop(_wait);
@@ -102,6 +132,32 @@ public:
 
         return doStartObject(*_robjptr, _rsvc, fct, _rerr);
     }
+
+    //! Start the object on the given reactor instead of the least loaded one
+    ObjectIdT startObject(
+        const size_t _reactor_index,
+        ObjectPointerT& _robjptr, Service& _rsvc,
+        Event&& _revt, ErrorConditionT& _rerr)
+    {
+        ScheduleCommand   cmd(_robjptr, _rsvc, std::move(_revt));
+        ScheduleFunctionT fct([&cmd](ReactorBase& _rreactor) { return cmd(_rreactor); });
+
+        return doStartObject(_reactor_index, *_robjptr, _rsvc, fct, _rerr);
+    }
+
+    size_t reactorCount() const
+    {
+        return SchedulerBase::doReactorCount();
+    }
+
+    //! The CPU set the reactor is bound to - empty if not bound
+    CpuSetT const& reactorCpuSet(const size_t _reactor_index) const
+    {
+        return SchedulerBase::doReactorCpuSet(_reactor_index);
+    }
+
+private:
+    const ReactorConfigurationT reactor_config_;
 };
 
 } //namespace frame
@@ -11,6 +11,7 @@
 #pragma once
 
 #include "solid/frame/common.hpp"
+#include "solid/system/cpu.hpp"
 #include "solid/system/error.hpp"
 #include "solid/system/pimpl.hpp"
 #include "solid/utility/function.hpp"
@@ -40,11 +41,19 @@ protected:
         CreateWorkerF         _pf,
         ThreadEnterFunctionT& _renf,
         ThreadExitFunctionT&  _rexf,
-        size_t                _reactorcnt);
+        size_t                _reactorcnt,
+        CpuSetVectorT const&  _rcpu_set_vec = CpuSetVectorT());
 
     void doStop(const bool _wait = true);
 
     ObjectIdT doStartObject(ObjectBase& _robj, Service& _rsvc, ScheduleFunctionT& _rfct, ErrorConditionT& _rerr);
+    ObjectIdT doStartObject(const size_t _reactor_index, ObjectBase& _robj, Service& _rsvc, ScheduleFunctionT& _rfct, ErrorConditionT& _rerr);
+
+    size_t         doReactorCount() const;
+    CpuSetT const& doReactorCpuSet(const size_t _reactor_index) const;
+
+    //! Called on the reactor thread before the reactor is created
+    bool doBindThread(const size_t _reactor_index);
 
 protected:
     SchedulerBase();
@@ -55,6 +64,7 @@ private:
 
     bool   prepareThread(const size_t _idx, ReactorBase& _rsel, const bool _success);
     void   unprepareThread(const size_t _idx, ReactorBase& _rsel);
+    size_t reactorNumaNode(const size_t _idx) const;
     size_t doComputeScheduleReactorIndex();
 
 private:
@@ -108,6 +108,16 @@ protected:
     void   doCacheObjectIndex(const size_t _idx);
     size_t atomicMaxCount() const;
 
+    //Optimistic shared acquisition, without the index mutex: every index has
+    //an atomic word holding the unique id, an "open" flag and the use count.
+    //The path is opened under the index mutex for items in shared state
+    //without waiters, moving the item's use count into the word, and closed -
+    //the count moved back - before anything else touches the item's state.
+    void*  doTryAcquireShared(UniqueId const& _ruid);
+    bool   doOpenShared(const size_t _idx, const UniqueT _uid, void* _pobj, const size_t _usecnt);
+    size_t doCloseShared(const size_t _idx);
+    bool   doIsSharedUsed(const size_t _idx) const;
+
     UidVectorT& consumeEraseVector() const;
     UidVectorT& fillEraseVector() const;
 
@@ -120,6 +130,7 @@ protected:
 private:
     friend struct PointerBase;
     void         erasePointer(UniqueId const& _ruid, const bool _isalive);
+    bool         doTryReleaseShared(UniqueId const& _ruid);
     virtual bool doDecrementObjectUseCount(UniqueId const& _uid, const bool _isalive) = 0;
     virtual bool doExecute()                                                          = 0;
     virtual void doResizeObjectVector(const size_t _newsz)                            = 0;
@@ -386,6 +397,10 @@ public:
         PointerT     ptr;
         const size_t idx = _ruid.index;
         if (idx < this->atomicMaxCount()) {
+            T* pt = static_cast<T*>(this->doTryAcquireShared(_ruid));
+            if (pt != nullptr) {
+                return PointerT(pt, this, _ruid);
+            }
             std::lock_guard<std::mutex> lock2(this->mutex(idx));
             Stub&                       rs = stubvec[idx];
             if (rs.uid == _ruid.unique) {
@@ -460,7 +475,10 @@ public:
         PointerT     ptr;
         ErrorCodeT   err;
         const size_t idx = _ruid.index;
-        if (idx < this->atomicMaxCount()) {
+        T*           pt  = nullptr;
+        if (idx < this->atomicMaxCount() && (pt = static_cast<T*>(this->doTryAcquireShared(_ruid))) != nullptr) {
+            ptr = PointerT(pt, this, _ruid);
+        } else if (idx < this->atomicMaxCount()) {
             std::lock_guard<std::mutex> lock2(this->mutex(idx));
             Stub&                       rs = stubvec[idx];
             if (rs.uid == _ruid.unique) {
@@ -592,9 +610,16 @@ private:
         stubvec.resize(_newsz);
     }
 
+    //Under the index mutex, before using the use count or changing the state
+    void doCloseShared(const size_t _idx)
+    {
+        stubvec[_idx].usecnt += StoreBase::doCloseShared(_idx);
+    }
+
     PointerT doTryGetAlive(const size_t _idx)
     {
         Stub& rs = stubvec[_idx];
+        doCloseShared(_idx);
         ++rs.alivecnt;
         rs.state = StoreBase::UniqueLockStateE;
         return PointerT(nullptr, this, UniqueId(_idx, rs.uid));
@@ -604,8 +629,14 @@ private:
     {
         Stub& rs = stubvec[_idx];
         if (rs.state == StoreBase::SharedLockStateE && rs.pwaitfirst == nullptr) {
-            ++rs.usecnt;
-            return PointerT(&rs.obj, this, UniqueId(_idx, rs.uid));
+            const UniqueId uid(_idx, rs.uid);
+            if (this->doTryAcquireShared(uid) == nullptr) {
+                ++rs.usecnt;
+                if (this->doOpenShared(_idx, rs.uid, &rs.obj, rs.usecnt)) {
+                    rs.usecnt = 0;
+                }
+            }
+            return PointerT(&rs.obj, this, uid);
         }
         return PointerT();
     }
@@ -613,6 +644,7 @@ private:
     PointerT doTryGetUnique(const size_t _idx)
     {
         Stub& rs = stubvec[_idx];
+        doCloseShared(_idx);
         if (rs.usecnt == 0) {
             solid_assert(rs.pwaitfirst == nullptr);
             ++rs.usecnt;
@@ -624,6 +656,7 @@ private:
     PointerT doTryGetReinit(const size_t _idx)
     {
         Stub& rs = stubvec[_idx];
+        doCloseShared(_idx);
         if (rs.usecnt == 0 && rs.alivecnt == 0 && rs.pwaitfirst == nullptr) {
             ++rs.usecnt;
             rs.state = StoreBase::UniqueLockStateE;
@@ -647,6 +680,8 @@ private:
     {
         Stub&     rs    = stubvec[_idx];
         WaitStub* pwait = reinterpret_cast<WaitStub*>(this->doTryAllocateWait());
+        //the waiters go before new shared acquisitions
+        doCloseShared(_idx);
         if (pwait == nullptr) {
             waitdq.push_back(WaitStub());
             pwait = &waitdq.back();
@@ -712,7 +747,7 @@ private:
                     //its an uid added by executeBeforeErase
                     --rs.usecnt;
                 }
-                if (rs.canClear()) {
+                if (rs.canClear() && !this->doIsSharedUsed(it->index)) {
                     rcacheidxvec.push_back(it->index);
                 } else {
                     doExecuteErase(it->index);
@@ -741,6 +776,7 @@ private:
                         pmtx->lock();
                     }
                     Stub& rs = stubvec[*it];
+                    doCloseShared(*it);
                     if (rs.canClear()) {
                         rs.clear();
                         must_reschedule = controller().clear(acc, rs.obj, *it) || must_reschedule;
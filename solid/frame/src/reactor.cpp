@@ -286,7 +286,8 @@ struct Reactor::Data {
 
 Reactor::Reactor(
     SchedulerBase& _rsched,
-    const size_t   _idx)
+    const size_t   _idx,
+    ConfigurationT const& /*_rcfg*/)
     : ReactorBase(_rsched, _idx)
     , impl_(make_pimpl<Data>())
 {
@@ -801,6 +802,10 @@ bool ReactorBase::prepareThread(const bool _success)
 {
     return scheduler().prepareThread(idInScheduler(), *this, _success);
 }
+size_t ReactorBase::numaNode() const
+{
+    return rsch.reactorNumaNode(schidx);
+}
 void ReactorBase::unprepareThread()
 {
     scheduler().unprepareThread(idInScheduler(), *this);
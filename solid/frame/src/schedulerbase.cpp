@@ -149,6 +149,8 @@ struct SchedulerBase::Data {
     ThreadEnterFunctionT threnfnc;
     ThreadExitFunctionT  threxfnc;
     ReactorVectorT       reactorvec;
+    CpuSetVectorT        cpusetvec;
+    std::vector<size_t>  numanodevec;
     mutex                mtx;
     condition_variable   cnd;
 };
@@ -174,9 +176,11 @@ void dummy_thread_exit()
 ErrorConditionT SchedulerBase::doStart(
     CreateWorkerF         _pf,
     ThreadEnterFunctionT& _renf, ThreadExitFunctionT& _rexf,
-    size_t _reactorcnt)
+    size_t _reactorcnt, CpuSetVectorT const& _rcpu_set_vec)
 {
-    if (_reactorcnt == 0) {
+    if (!_rcpu_set_vec.empty()) {
+        _reactorcnt = _rcpu_set_vec.size();
+    } else if (_reactorcnt == 0) {
         _reactorcnt = thread::hardware_concurrency();
     }
     bool start_err = false;
@@ -195,6 +199,11 @@ ErrorConditionT SchedulerBase::doStart(
         }
 
         impl_->reactorvec.resize(_reactorcnt);
+        impl_->cpusetvec = _rcpu_set_vec;
+        impl_->numanodevec.clear();
+        for (const auto& rcpu_set : impl_->cpusetvec) {
+            impl_->numanodevec.push_back(rcpu_set.empty() ? 0 : cpu_numa_node(rcpu_set.front()));
+        }
 
         if (!solid_function_empty(_renf)) {
             solid_function_clear(impl_->threnfnc);
@@ -325,6 +334,57 @@ ObjectIdT SchedulerBase::doStartObject(ObjectBase& _robj, Service& _rsvc, Schedu
     return rv;
 }
 
+ObjectIdT SchedulerBase::doStartObject(const size_t _reactor_index, ObjectBase& _robj, Service& _rsvc, ScheduleFunctionT& _rfct, ErrorConditionT& _rerr)
+{
+    ++impl_->usecnt;
+    ObjectIdT rv;
+    if (impl_->status == StatusRunningE) {
+        ReactorStub& rrs = impl_->reactorvec[_reactor_index % impl_->reactorvec.size()];
+
+        rv = _rsvc.registerObject(_robj, *rrs.preactor, _rfct, _rerr);
+    } else {
+        _rerr = error_running();
+    }
+    --impl_->usecnt;
+    return rv;
+}
+
+size_t SchedulerBase::doReactorCount() const
+{
+    return impl_->reactorvec.size();
+}
+
+CpuSetT const& SchedulerBase::doReactorCpuSet(const size_t _reactor_index) const
+{
+    static const CpuSetT empty_cpu_set;
+    if (_reactor_index < impl_->cpusetvec.size()) {
+        return impl_->cpusetvec[_reactor_index];
+    }
+    return empty_cpu_set;
+}
+
+size_t SchedulerBase::reactorNumaNode(const size_t _idx) const
+{
+    return _idx < impl_->numanodevec.size() ? impl_->numanodevec[_idx] : 0;
+}
+
+bool SchedulerBase::doBindThread(const size_t _reactor_index)
+{
+    CpuSetT const& rcpu_set = doReactorCpuSet(_reactor_index);
+
+    if (rcpu_set.empty()) {
+        return true;
+    }
+
+    const ErrorCodeT err = thread_cpu_affinity(rcpu_set);
+
+    if (err) {
+        solid_log(logger, Error, "reactor " << _reactor_index << " failed binding to CPU set: " << err.message());
+        return false;
+    }
+    return true;
+}
+
 bool less_cmp(ReactorStub const& _rrs1, ReactorStub const& _rrs2)
 {
     return _rrs1.preactor->load() < _rrs2.preactor->load();
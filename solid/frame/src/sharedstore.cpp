@@ -18,6 +18,7 @@
 #include "solid/utility/queue.hpp"
 #include "solid/utility/stack.hpp"
 #include <atomic>
+#include <memory>
 #include <mutex>
 
 using namespace std;
@@ -46,6 +47,35 @@ void PointerBase::doClear(const bool _isalive)
 //---------------------------------------------------------------
 //      StoreBase
 //---------------------------------------------------------------
+namespace {
+//the lock-free shared path word: unique(32) | open(1) | count(31)
+constexpr uint64_t shared_open_flag   = static_cast<uint64_t>(1) << 31;
+constexpr uint64_t shared_count_mask  = shared_open_flag - 1;
+constexpr size_t   shared_block_size  = 1024; //the index allocation step
+constexpr size_t   shared_block_count = 4 * 1024;
+
+inline uint64_t shared_word(const UniqueT _uid)
+{
+    return static_cast<uint64_t>(_uid) << 32;
+}
+
+inline UniqueT shared_word_unique(const uint64_t _w)
+{
+    return static_cast<UniqueT>(_w >> 32);
+}
+
+struct SharedSlot {
+    std::atomic<uint64_t> word;
+    std::atomic<void*>    pobj;
+
+    SharedSlot()
+        : word(0)
+        , pobj(nullptr)
+    {
+    }
+};
+} //namespace
+
 typedef std::atomic<size_t> AtomicSizeT;
 typedef MutualStore<mutex>  MutexMutualStoreT;
 typedef Queue<UniqueId>     UidQueueT;
@@ -57,10 +87,34 @@ struct StoreBase::Data {
         Manager& _rm)
         : rm(_rm)
         , objmaxcnt{0}
+        , sharedblocks(new std::atomic<SharedSlot*>[shared_block_count])
     {
         pfillerasevec = &erasevec[0];
         pconserasevec = &erasevec[1];
+        for (size_t i = 0; i < shared_block_count; ++i) {
+            sharedblocks[i].store(nullptr);
+        }
     }
+    ~Data()
+    {
+        for (size_t i = 0; i < shared_block_count; ++i) {
+            delete[] sharedblocks[i].load();
+        }
+    }
+
+    //nullptr for indexes beyond the lock-free path capacity
+    SharedSlot* sharedSlot(const size_t _idx) const
+    {
+        const size_t blkidx = _idx / shared_block_size;
+        if (blkidx < shared_block_count) {
+            SharedSlot* pblk = sharedblocks[blkidx].load(std::memory_order_acquire);
+            if (pblk != nullptr) {
+                return pblk + (_idx % shared_block_size);
+            }
+        }
+        return nullptr;
+    }
+
     Manager&            rm;
     shared::AtomicSizeT objmaxcnt;
     MutexMutualStoreT   mtxstore;
@@ -72,6 +126,8 @@ struct StoreBase::Data {
     ExecWaitVectorT     exewaitvec;
     VoidPtrStackT       cachewaitstk;
     std::mutex          mtx;
+
+    std::unique_ptr<std::atomic<SharedSlot*>[]> sharedblocks;
 };
 
 void StoreBase::Accessor::notify()
@@ -162,6 +218,9 @@ size_t StoreBase::doAllocateIndex()
         const size_t objcnt = impl_->objmaxcnt.load();
         lock_all(impl_->mtxstore, objcnt);
         doResizeObjectVector(objcnt + 1024);
+        if (objcnt / shared_block_size < shared_block_count) {
+            impl_->sharedblocks[objcnt / shared_block_size].store(new SharedSlot[shared_block_size], std::memory_order_release);
+        }
         for (size_t i = objcnt + 1023; i > objcnt; --i) {
             impl_->cacheobjidxstk.push(i);
         }
@@ -172,8 +231,83 @@ size_t StoreBase::doAllocateIndex()
     }
     return rv;
 }
+void* StoreBase::doTryAcquireShared(UniqueId const& _ruid)
+{
+    SharedSlot* pslot = impl_->sharedSlot(static_cast<size_t>(_ruid.index));
+
+    if (pslot != nullptr) {
+        uint64_t w = pslot->word.load(std::memory_order_acquire);
+
+        while (shared_word_unique(w) == _ruid.unique && (w & shared_open_flag) && (w & shared_count_mask) != shared_count_mask) {
+            if (pslot->word.compare_exchange_weak(w, w + 1, std::memory_order_acq_rel)) {
+                return pslot->pobj.load(std::memory_order_relaxed);
+            }
+        }
+    }
+    return nullptr;
+}
+
+bool StoreBase::doOpenShared(const size_t _idx, const UniqueT _uid, void* _pobj, const size_t _usecnt)
+{
+    //the index mutex is locked and the path is closed
+    SharedSlot* pslot = impl_->sharedSlot(_idx);
+
+    if (pslot != nullptr && _usecnt < shared_count_mask) {
+        solid_assert(!(pslot->word.load(std::memory_order_relaxed) & shared_open_flag));
+        pslot->pobj.store(_pobj, std::memory_order_relaxed);
+        pslot->word.store(shared_word(_uid) | shared_open_flag | _usecnt, std::memory_order_release);
+        return true;
+    }
+    return false;
+}
+
+size_t StoreBase::doCloseShared(const size_t _idx)
+{
+    //the index mutex is locked
+    SharedSlot* pslot = impl_->sharedSlot(_idx);
+
+    if (pslot != nullptr) {
+        uint64_t w = pslot->word.load(std::memory_order_relaxed);
+        if (w & shared_open_flag) {
+            w = pslot->word.exchange(shared_word(shared_word_unique(w)), std::memory_order_acq_rel);
+            return static_cast<size_t>(w & shared_count_mask);
+        }
+    }
+    return 0;
+}
+
+bool StoreBase::doIsSharedUsed(const size_t _idx) const
+{
+    const SharedSlot* pslot = impl_->sharedSlot(_idx);
+    return pslot != nullptr && (pslot->word.load(std::memory_order_acquire) & shared_count_mask) != 0;
+}
+
+bool StoreBase::doTryReleaseShared(UniqueId const& _ruid)
+{
+    SharedSlot* pslot = impl_->sharedSlot(static_cast<size_t>(_ruid.index));
+
+    if (pslot != nullptr) {
+        uint64_t w = pslot->word.load(std::memory_order_relaxed);
+
+        //after close the count is zero and the release takes the mutex path
+        while (shared_word_unique(w) == _ruid.unique && (w & shared_count_mask) != 0) {
+            if (pslot->word.compare_exchange_weak(w, w - 1, std::memory_order_acq_rel)) {
+                if ((w & shared_count_mask) == 1) {
+                    //the last user - let the store release the item
+                    notifyObject(_ruid);
+                }
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
 void StoreBase::erasePointer(UniqueId const& _ruid, const bool _isalive)
 {
+    if (!_isalive && doTryReleaseShared(_ruid)) {
+        return;
+    }
     if (_ruid.index < impl_->objmaxcnt.load()) {
         bool do_notify = true;
         {
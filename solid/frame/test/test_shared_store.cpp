@@ -0,0 +1,221 @@
+#include "solid/frame/manager.hpp"
+#include "solid/frame/reactor.hpp"
+#include "solid/frame/scheduler.hpp"
+#include "solid/frame/service.hpp"
+#include "solid/frame/sharedstore.hpp"
+
+#include "solid/system/exception.hpp"
+#include "solid/system/log.hpp"
+
+#include "solid/utility/event.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace std;
+using namespace solid;
+
+using SchedulerT = frame::Scheduler<frame::Reactor>;
+
+namespace {
+const LoggerT logger("test_shared_store");
+
+mutex              mtx;
+condition_variable cnd;
+size_t             clear_count = 0;
+
+struct Item {
+    atomic<uint32_t> tag{0}; //the unique id the item was inserted with
+    atomic<size_t>   holder{0}; //non zero while held unique
+};
+
+class TestStore : public frame::shared::Store<Item, TestStore> {
+    using BaseT = frame::shared::Store<Item, TestStore>;
+
+public:
+    TestStore(frame::Manager& _rm)
+        : BaseT(_rm)
+    {
+    }
+
+    bool clear(frame::shared::StoreBase::Accessor& /*_rsbacc*/, Item& _ritem, const size_t /*_idx*/)
+    {
+        _ritem.tag = 0;
+        lock_guard<std::mutex> lock(mtx);
+        ++clear_count;
+        cnd.notify_one();
+        return false;
+    }
+
+    bool executeBeforeErase(frame::shared::StoreBase::Accessor& /*_rsbacc*/)
+    {
+        return false;
+    }
+
+    void executeOnSignal(frame::shared::StoreBase::Accessor& /*_rsbacc*/, ulong /*_sm*/)
+    {
+    }
+};
+
+inline uint64_t pack(const frame::UniqueId& _ruid)
+{
+    return (static_cast<uint64_t>(_ruid.index) << 32) | _ruid.unique;
+}
+
+inline frame::UniqueId unpack(const uint64_t _w)
+{
+    return frame::UniqueId(static_cast<size_t>(_w >> 32), static_cast<frame::UniqueT>(_w & 0xffffffff));
+}
+
+atomic<uint64_t> crt_uid{0};
+atomic<bool>     running{true};
+atomic<size_t>   hit_count{0};
+atomic<size_t>   miss_count{0};
+
+//Acquires shared pointers for the last published item, which the writer
+//keeps switching to unique, releasing and replacing on the same index -
+//and, every other time, for the one before, already replaced.
+void reader_run(TestStore& _rstore)
+{
+    uint64_t prev_w = 0;
+    uint64_t last_w = 0;
+    size_t   count  = 0;
+
+    while (running.load(memory_order_relaxed)) {
+        const uint64_t w = crt_uid.load(memory_order_acquire);
+        if (w != last_w) {
+            prev_w = last_w;
+            last_w = w;
+        }
+        const frame::UniqueId uid = unpack((++count % 2) ? w : prev_w);
+        ErrorCodeT            err;
+        auto                  ptr = _rstore.shared(uid, err);
+
+        if (!ptr.empty()) {
+            solid_check(ptr->tag.load() == uid.unique, "shared pointer for " << uid.unique << " to item " << ptr->tag.load());
+            solid_check(ptr->holder.load() == 0, "shared pointer to an item held unique");
+            ++hit_count;
+        } else {
+            ++miss_count;
+        }
+        this_thread::yield();
+    }
+}
+
+} //namespace
+
+// Concurrent shared acquisitions and releases against unique acquisitions
+// and the reuse of the item index with a new unique id.
+// Usage: test_shared_store [READER_COUNT] [GENERATION_COUNT]
+int test_shared_store(int argc, char* argv[])
+{
+    solid::log_start(std::cerr, {"solid::frame.*:EW", "test_shared_store:VIEW"});
+
+    size_t reader_count     = 4;
+    size_t generation_count = 2000;
+
+    if (argc > 1) {
+        reader_count = atoi(argv[1]);
+    }
+    if (argc > 2) {
+        generation_count = atoi(argv[2]);
+    }
+
+    size_t         reuse_count = 0;
+    atomic<size_t> unique_count{0};
+    {
+        SchedulerT      sch;
+        frame::Manager  m;
+        frame::ServiceT svc{m};
+        ErrorConditionT err;
+
+        solid_check(!sch.start(1), "Error starting scheduler");
+
+        DynamicPointer<TestStore> store_ptr(new TestStore(m));
+        {
+            SchedulerT::ObjectPointerT objptr(store_ptr);
+            solid_check(!sch.startObject(objptr, svc, make_event(GenericEvents::Start), err).isInvalid(), "Error starting store: " << err.message());
+        }
+        TestStore& rstore = *store_ptr;
+
+        {
+            auto ptr = rstore.insertUnique();
+            crt_uid.store(pack(ptr.id()));
+            ptr->tag = ptr.id().unique;
+        }
+        {
+            unique_lock<mutex> lock(mtx);
+            solid_check(cnd.wait_for(lock, chrono::seconds(10), []() { return clear_count == 1; }), "item not cleared");
+        }
+
+        vector<thread> reader_vec;
+        for (size_t i = 0; i < reader_count; ++i) {
+            reader_vec.emplace_back([&rstore]() { reader_run(rstore); });
+        }
+
+        for (size_t g = 0; g < generation_count; ++g) {
+            const frame::UniqueId prev_uid = unpack(crt_uid.load());
+            auto                  ptr      = rstore.insertUnique();
+            const frame::UniqueId uid      = ptr.id();
+
+            if (uid.index == prev_uid.index) {
+                ++reuse_count;
+                solid_check(uid.unique != prev_uid.unique, "index reused with the same unique id");
+            }
+
+            ptr->tag = uid.unique;
+            solid_check(rstore.uniqueToShared(ptr), "unique to shared failed");
+            crt_uid.store(pack(uid), memory_order_release);
+
+            for (size_t i = 0; i < 16; ++i) {
+                this_thread::yield();
+            }
+
+            //a unique request while the item is shared - the readers keep acquiring
+            //it - is queued and delivered, on the store thread, after the last release
+            const bool delivered = rstore.requestUnique(
+                [uid, &unique_count](TestStore&, TestStore::PointerT& _rptr, ErrorCodeT const& _rerr) {
+                    solid_check(!_rerr && !_rptr.empty(), "unique request failed");
+                    solid_check(_rptr->tag.load() == uid.unique, "unique pointer to a reused item");
+                    _rptr->holder = 1;
+                    for (size_t i = 0; i < 16; ++i) {
+                        this_thread::yield();
+                    }
+                    _rptr->holder = 0;
+                    ++unique_count;
+                },
+                uid);
+            solid_check(!delivered, "unique request delivered while the item is shared");
+            ptr.clear();
+
+            //wait for the store to clear it
+            {
+                unique_lock<mutex> lock(mtx);
+                solid_check(cnd.wait_for(lock, chrono::seconds(60), [g]() { return clear_count == g + 2; }), "item " << g << " not cleared: " << clear_count);
+            }
+
+            ErrorCodeT err;
+            solid_check(rstore.shared(uid, err).empty(), "shared pointer to a cleared item");
+            solid_check(rstore.unique(uid, err).empty(), "unique pointer to a cleared item");
+        }
+
+        running = false;
+        for (auto& t : reader_vec) {
+            t.join();
+        }
+
+        m.stop();
+    }
+
+    solid_log(logger, Verbose, "hit_count = " << hit_count << " miss_count = " << miss_count << " reuse_count = " << reuse_count << " unique_count = " << unique_count);
+
+    solid_check(reuse_count > generation_count / 2, "the item index was rarely reused: " << reuse_count);
+    solid_check(unique_count == generation_count, "unique requests delivered: " << unique_count);
+    solid_check(hit_count != 0, "no shared acquisition");
+    return 0;
+}
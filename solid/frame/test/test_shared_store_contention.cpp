@@ -0,0 +1,150 @@
+#include "solid/frame/manager.hpp"
+#include "solid/frame/reactor.hpp"
+#include "solid/frame/scheduler.hpp"
+#include "solid/frame/service.hpp"
+#include "solid/frame/sharedstore.hpp"
+
+#include "solid/system/exception.hpp"
+#include "solid/system/log.hpp"
+
+#include "solid/utility/event.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+using namespace std;
+using namespace solid;
+
+using SchedulerT = frame::Scheduler<frame::Reactor>;
+
+namespace {
+const LoggerT logger("test_shared_store_contention");
+
+struct Item {
+    size_t value = 0;
+};
+
+class TestStore : public frame::shared::Store<Item, TestStore> {
+    using BaseT = frame::shared::Store<Item, TestStore>;
+
+public:
+    TestStore(frame::Manager& _rm)
+        : BaseT(_rm)
+    {
+    }
+
+    bool clear(frame::shared::StoreBase::Accessor& /*_rsbacc*/, Item& _ritem, const size_t /*_idx*/)
+    {
+        _ritem.value = 0;
+        return false;
+    }
+
+    bool executeBeforeErase(frame::shared::StoreBase::Accessor& /*_rsbacc*/)
+    {
+        return false;
+    }
+
+    void executeOnSignal(frame::shared::StoreBase::Accessor& /*_rsbacc*/, ulong /*_sm*/)
+    {
+    }
+};
+
+//nanoseconds per acquire/release round trip, with _thread_count threads on the same item
+template <class F>
+double measure(const size_t _thread_count, const size_t _repeat_count, F _f)
+{
+    atomic<size_t> ready_count{0};
+    vector<thread> thread_vec;
+
+    const auto start = chrono::steady_clock::now();
+
+    for (size_t i = 0; i < _thread_count; ++i) {
+        thread_vec.emplace_back(
+            [&ready_count, _thread_count, _repeat_count, &_f]() {
+                ++ready_count;
+                while (ready_count.load() != _thread_count) {
+                    this_thread::yield();
+                }
+                for (size_t j = 0; j < _repeat_count; ++j) {
+                    _f();
+                }
+            });
+    }
+    for (auto& t : thread_vec) {
+        t.join();
+    }
+
+    const auto duration = chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - start).count();
+
+    return static_cast<double>(duration) / (_thread_count * _repeat_count);
+}
+
+} //namespace
+
+// Shared acquisitions of a single item, from many threads: the lock-free path
+// against the index mutex path - which alive pointers take.
+// Usage: test_shared_store_contention [MAX_THREAD_COUNT] [REPEAT_COUNT]
+int test_shared_store_contention(int argc, char* argv[])
+{
+    solid::log_start(std::cerr, {"solid::frame.*:EW", "test_shared_store_contention:VIEW"});
+
+    size_t max_thread_count = 4;
+    size_t repeat_count     = 100000;
+
+    if (argc > 1) {
+        max_thread_count = atoi(argv[1]);
+    }
+    if (argc > 2) {
+        repeat_count = atoi(argv[2]);
+    }
+
+    SchedulerT      sch;
+    frame::Manager  m;
+    frame::ServiceT svc{m};
+    ErrorConditionT err;
+
+    solid_check(!sch.start(1), "Error starting scheduler");
+
+    DynamicPointer<TestStore> store_ptr(new TestStore(m));
+    {
+        SchedulerT::ObjectPointerT objptr(store_ptr);
+        solid_check(!sch.startObject(objptr, svc, make_event(GenericEvents::Start), err).isInvalid(), "Error starting store: " << err.message());
+    }
+    TestStore& rstore = *store_ptr;
+
+    //keep the items from being cleared - acquiring alive pointers leaves
+    //an item in unique state, so they go on a different one
+    auto hold_ptr = rstore.insertUnique();
+    solid_check(rstore.uniqueToShared(hold_ptr), "unique to shared failed");
+    auto alive_hold_ptr = rstore.insertUnique();
+
+    const frame::UniqueId uid       = hold_ptr.id();
+    const frame::UniqueId alive_uid = alive_hold_ptr.id();
+
+    for (size_t thread_count = 1; thread_count <= max_thread_count; thread_count *= 2) {
+        const double shared_ns = measure(
+            thread_count, repeat_count,
+            [&rstore, uid]() {
+                ErrorCodeT err;
+                auto       ptr = rstore.shared(uid, err);
+                solid_check(!ptr.empty(), "shared acquisition failed");
+            });
+        const double alive_ns = measure(
+            thread_count, repeat_count,
+            [&rstore, alive_uid]() {
+                ErrorCodeT err;
+                auto       ptr = rstore.alive(alive_uid, err);
+                solid_check(!ptr.empty(), "alive acquisition failed");
+            });
+
+        cout << thread_count << " threads: lock-free shared " << shared_ns << "ns mutex path " << alive_ns << "ns per round trip" << endl;
+    }
+
+    hold_ptr.clear();
+    alive_hold_ptr.clear();
+    m.stop();
+    return 0;
+}
@@ -509,7 +509,7 @@ public: //should be protected
         Runnable r{&_ris, &store_stream, _sz, 0, lambda, _name};
 
         if (isRunEmpty()) {
-            if (store_stream(*this, r, nullptr) == ReturnE::Done) {
+            if (store_stream(*this, r, &_rctx) == ReturnE::Done) {
                 return;
             }
         }
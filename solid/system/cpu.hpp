@@ -0,0 +1,54 @@
+// solid/system/cpu.hpp
+//
+// Copyright (c) 2018 Valentin Palade (vipalade @ gmail . com)
+//
+// This file is part of SolidFrame framework.
+//
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt.
+//
+
+#pragma once
+
+#include "solid/system/common.hpp"
+#include "solid/system/error.hpp"
+#include <vector>
+
+namespace solid {
+
+//! A set of CPU indexes, as used by the operating system
+using CpuSetT       = std::vector<size_t>;
+using CpuSetVectorT = std::vector<CpuSetT>;
+
+//! The number of configured CPUs
+size_t cpu_count();
+
+//! The number of NUMA nodes - 1 where the platform does not expose them
+size_t numa_node_count();
+
+//! The CPUs of the given NUMA node
+CpuSetT numa_node_cpu_set(const size_t _node);
+
+//! The NUMA node of the given CPU - 0 where unknown
+size_t cpu_numa_node(const size_t _cpu);
+
+//! One single CPU set for every CPU, grouped by NUMA node
+/*!
+ * Consecutive CPU sets are on the same NUMA node, so that the first
+ * reactors of a Scheduler started with them share a node.
+ */
+CpuSetVectorT cpu_set_per_cpu();
+
+//! One CPU set for every NUMA node, containing all the CPUs of the node
+CpuSetVectorT cpu_set_per_numa_node();
+
+//! Bind the calling thread to the given CPU set
+/*!
+ * With the default, first touch, memory policy, the memory the thread
+ * allocates and initializes afterwards is placed on the NUMA node(s) of
+ * the CPU set.
+ * Only on linux and FreeBSD - error_not_implemented otherwise.
+ */
+ErrorCodeT thread_cpu_affinity(CpuSetT const& _rcpu_set);
+
+} //namespace solid
@@ -18,6 +18,8 @@
 #endif
 
 #include <array>
+#include <cstddef>
+#include <cstring>
 #include <ostream>
 
 #include "solid/system/socketinfo.hpp"
@@ -246,8 +248,10 @@ public:
     size_t          hash() const;
     size_t          addressHash() const;
 
+    //! Unix domain socket path - on Linux "@name" is an abstract namespace address
     void        path(const char* _pth);
     const char* path() const;
+    bool        isAbstract() const;
 
 private:
     friend class SocketDevice;
@@ -445,6 +449,24 @@ size_t in_addr_hash(const in_addr& _inaddr);
 
 size_t in_addr_hash(const in6_addr& _inaddr);
 
+#ifndef SOLID_ON_WINDOWS
+//! Fills a unix domain address, returns its size or 0 if _path does not fit
+/*!
+    On Linux a path starting with '@' names a socket in the abstract
+    namespace - no file system entry, gone with its last reference.
+*/
+socklen_t local_address_assign(sockaddr_un& _raddr, const char* _path);
+
+//! Returns the path of a unix domain address, without the leading '@'/'\0' for abstract addresses
+const char* local_address_path(const sockaddr_un& _raddr, const socklen_t _sz);
+
+bool local_address_is_abstract(const sockaddr_un& _raddr, const socklen_t _sz);
+
+int local_address_compare(const sockaddr_un& _raddr1, const socklen_t _sz1, const sockaddr_un& _raddr2, const socklen_t _sz2);
+
+size_t local_address_hash(const sockaddr_un& _raddr, const socklen_t _sz);
+#endif
+
 std::ostream& operator<<(std::ostream& _ros, const SocketAddressInet4& _rsa);
 
 std::ostream& operator<<(std::ostream& _ros, const SocketAddressInet& _rsa);
@@ -486,6 +508,7 @@ public:
 
     void        path(const char* _pth);
     const char* path() const;
+    bool        isAbstract() const;
 
 private:
     friend class SocketDevice;
@@ -494,6 +517,8 @@ private:
     AddrUnion d;
     socklen_t sz;
 };
+
+std::ostream& operator<<(std::ostream& _ros, const SocketAddressLocal& _rsa);
 #endif
 //==================================================================
 #ifndef SOLID_HAS_NO_INLINES
@@ -370,7 +370,11 @@ inline bool SocketAddress::operator<(const SocketAddress& _raddr) const
     } else if (sockAddr()->sa_family > _raddr.sockAddr()->sa_family) {
         return false;
     }
-
+#ifndef SOLID_ON_WINDOWS
+    if (isLocal()) {
+        return local_address_compare(d.localaddr, sz, _raddr.d.localaddr, _raddr.sz) < 0;
+    }
+#endif
     if (isInet6()) {
         const int rv = memcmp(
             (const void*)&this->d.inaddr6.sin6_addr.s6_addr,
@@ -394,6 +398,11 @@ inline bool SocketAddress::operator<(const SocketAddress& _raddr) const
 inline bool SocketAddress::operator==(const SocketAddress& _raddr) const
 {
     if (sockAddr()->sa_family == _raddr.sockAddr()->sa_family) {
+#ifndef SOLID_ON_WINDOWS
+        if (isLocal()) {
+            return local_address_compare(d.localaddr, sz, _raddr.d.localaddr, _raddr.sz) == 0;
+        }
+#endif
         if (isInet6()) {
             return (memcmp(
                         (const void*)&this->d.inaddr6.sin6_addr.s6_addr,
@@ -457,13 +466,16 @@ inline bool SocketAddress::port(int _port)
 }
 inline void SocketAddress::clear()
 {
-    d.addr.sa_family          = 0;
-    d.inaddr4.sin_addr.s_addr = 0;
-    sz                        = 0;
-    port(0);
+    memset(&d, 0, sizeof(d));
+    sz = 0;
 }
 inline size_t SocketAddress::hash() const
 {
+#ifndef SOLID_ON_WINDOWS
+    if (isLocal()) {
+        return local_address_hash(d.localaddr, sz);
+    }
+#endif
     if (isInet6()) {
         return in_addr_hash(address6()) ^ d.inaddr6.sin6_port;
     }
@@ -471,21 +483,45 @@ inline size_t SocketAddress::hash() const
 }
 inline size_t SocketAddress::addressHash() const
 {
+#ifndef SOLID_ON_WINDOWS
+    if (isLocal()) {
+        return local_address_hash(d.localaddr, sz);
+    }
+#endif
     if (isInet6()) {
         return in_addr_hash(address6());
     }
     return in_addr_hash(address4());
 }
 
+#ifndef SOLID_ON_WINDOWS
+inline void SocketAddress::path(const char* _pth)
+{
+    clear();
+    sz = local_address_assign(d.localaddr, _pth);
+}
+inline const char* SocketAddress::path() const
+{
+    return isLocal() ? local_address_path(d.localaddr, sz) : nullptr;
+}
+inline bool SocketAddress::isAbstract() const
+{
+    return isLocal() && local_address_is_abstract(d.localaddr, sz);
+}
+#else
 inline void SocketAddress::path(const char* /*_pth*/)
 {
-    //TODO
+    clear();
 }
 inline const char* SocketAddress::path() const
 {
-    //TODO
-    return NULL;
+    return nullptr;
 }
+inline bool SocketAddress::isAbstract() const
+{
+    return false;
+}
+#endif
 inline SocketAddress::operator sockaddr*()
 {
     return sockAddr();
@@ -1149,16 +1185,74 @@ inline size_t in_addr_hash(const in6_addr& _inaddr)
 //          SocketAddressLocal
 //-----------------------------------------------------------------------
 #ifndef SOLID_ON_WINDOWS
+inline socklen_t local_address_assign(sockaddr_un& _raddr, const char* _path)
+{
+    const size_t len = strlen(_path);
+
+    memset(&_raddr, 0, sizeof(_raddr));
+
+    if (len == 0 || len >= sizeof(_raddr.sun_path)) {
+        return 0;
+    }
+
+    _raddr.sun_family = AF_UNIX;
+    memcpy(_raddr.sun_path, _path, len);
+#ifdef SOLID_ON_LINUX
+    if (_path[0] == '@') {
+        //abstract namespace: leading '\0', the name is not '\0' terminated
+        _raddr.sun_path[0] = '\0';
+        return static_cast<socklen_t>(offsetof(sockaddr_un, sun_path) + len);
+    }
+#endif
+    return static_cast<socklen_t>(offsetof(sockaddr_un, sun_path) + len + 1);
+}
+inline bool local_address_is_abstract(const sockaddr_un& _raddr, const socklen_t _sz)
+{
+    return _sz > offsetof(sockaddr_un, sun_path) && _raddr.sun_path[0] == '\0';
+}
+inline const char* local_address_path(const sockaddr_un& _raddr, const socklen_t _sz)
+{
+    if (_sz <= offsetof(sockaddr_un, sun_path)) {
+        return "";
+    }
+    //the bytes past the address size are zero (see local_address_assign and clear())
+    return local_address_is_abstract(_raddr, _sz) ? _raddr.sun_path + 1 : _raddr.sun_path;
+}
+inline int local_address_compare(const sockaddr_un& _raddr1, const socklen_t _sz1, const sockaddr_un& _raddr2, const socklen_t _sz2)
+{
+    if (_sz1 != _sz2) {
+        return _sz1 < _sz2 ? -1 : 1;
+    }
+    if (_sz1 <= offsetof(sockaddr_un, sun_path)) {
+        return 0;
+    }
+    return memcmp(_raddr1.sun_path, _raddr2.sun_path, _sz1 - offsetof(sockaddr_un, sun_path));
+}
+inline size_t local_address_hash(const sockaddr_un& _raddr, const socklen_t _sz)
+{
+    size_t h = 0;
+    for (size_t i = offsetof(sockaddr_un, sun_path); i < _sz; ++i) {
+        h = h * 31 + static_cast<unsigned char>(_raddr.sun_path[i - offsetof(sockaddr_un, sun_path)]);
+    }
+    return h;
+}
+
 inline SocketAddressLocal::SocketAddressLocal()
 {
+    clear();
 }
-inline SocketAddressLocal::SocketAddressLocal(const char* /*_path*/)
+inline SocketAddressLocal::SocketAddressLocal(const char* _path)
 {
-    //TODO:
+    path(_path);
 }
 
-inline SocketAddressLocal& SocketAddressLocal::operator=(const SocketAddressStub&)
+inline SocketAddressLocal& SocketAddressLocal::operator=(const SocketAddressStub& _rsas)
 {
+    clear();
+    if (_rsas.sockAddr() != nullptr && _rsas.isLocal() && static_cast<size_t>(_rsas.size()) <= sizeof(d)) {
+        memcpy(&d.addr, _rsas.sockAddr(), _rsas.size());
+        sz = _rsas.size();
+    }
     return *this;
 }
 
@@ -1186,40 +1280,40 @@ inline SocketAddressLocal::operator const sockaddr*() const
     return sockAddr();
 }
 
-inline bool SocketAddressLocal::operator<(const SocketAddressLocal& /*_raddr*/) const
+inline bool SocketAddressLocal::operator<(const SocketAddressLocal& _raddr) const
 {
-    //TODO
-    return false;
+    return local_address_compare(d.localaddr, sz, _raddr.d.localaddr, _raddr.sz) < 0;
 }
-inline bool SocketAddressLocal::operator==(const SocketAddressLocal& /*_raddr*/) const
+inline bool SocketAddressLocal::operator==(const SocketAddressLocal& _raddr) const
 {
-    //TODO
-    return false;
+    return local_address_compare(d.localaddr, sz, _raddr.d.localaddr, _raddr.sz) == 0;
 }
 
 inline void SocketAddressLocal::clear()
 {
-    //TODO
+    memset(&d, 0, sizeof(d));
+    sz = 0;
 }
 inline size_t SocketAddressLocal::hash() const
 {
-    //TODO
-    return 0;
+    return local_address_hash(d.localaddr, sz);
 }
 inline size_t SocketAddressLocal::addressHash() const
 {
-    //TODO
-    return 0;
+    return local_address_hash(d.localaddr, sz);
 }
 
-inline void SocketAddressLocal::path(const char* /*_pth*/)
+inline void SocketAddressLocal::path(const char* _pth)
 {
-    //TODO
+    sz = local_address_assign(d.localaddr, _pth);
 }
 inline const char* SocketAddressLocal::path() const
 {
-    //TODO
-    return NULL;
+    return local_address_path(d.localaddr, sz);
+}
+inline bool SocketAddressLocal::isAbstract() const
+{
+    return local_address_is_abstract(d.localaddr, sz);
 }
 inline SocketAddressLocal::operator sockaddr*()
 {
@@ -16,6 +16,36 @@
 
 namespace solid {
 
+//! The maximum number of datagrams sent or received by one batch call
+constexpr size_t datagram_batch_capacity = 64;
+
+//! A datagram slot for the SocketDevice batch send and recv
+/*!
+ * recv: fills up to capacity_ bytes of buffer_, setting size_ and the
+ * sender address_.
+ * send: sends size_ bytes from buffer_ to address_ - an empty address_
+ * for connected sockets.
+ * segment_size_: UDP generic segmentation - on send, with a non zero
+ * value, the kernel splits buffer_ into segment_size_ datagrams (GSO);
+ * on recv, the segment size of the coalesced datagrams received with
+ * enableGenericReceiveOffload (GRO) or zero.
+ */
+struct DatagramStub {
+    char*         buffer_;
+    size_t        capacity_;
+    size_t        size_;
+    SocketAddress address_;
+    size_t        segment_size_;
+
+    DatagramStub(char* _buffer = nullptr, const size_t _capacity = 0)
+        : buffer_(_buffer)
+        , capacity_(_capacity)
+        , size_(0)
+        , segment_size_(0)
+    {
+    }
+};
+
 //! A wrapper for berkeley sockets
 class SocketDevice : public Device {
 public:
@@ -83,6 +113,13 @@ public:
 
     ErrorCodeT enableLoopbackFastPath();
 
+    ErrorCodeT enableGenericReceiveOffload(); //UDP_GRO - only on linux
+
+    ErrorCodeT enableBusyPoll(const size_t _microseconds); //SO_BUSY_POLL - only on linux
+
+    ErrorCodeT enableReusePort(); //SO_REUSEPORT - call before prepareAccept/bind
+    ErrorCodeT incomingCpu(const size_t _cpu); //SO_INCOMING_CPU - only on linux
+
     //ErrorCodeT sendBufferSize(size_t _sz);
     //ErrorCodeT recvBufferSize(size_t _sz);
     ErrorCodeT sendBufferSize(int& _rrv);
@@ -94,10 +131,22 @@ public:
     ssize_t send(const char* _pb, size_t _ul, bool& _rcan_retry, ErrorCodeT& _rerr, unsigned _flags = 0);
     //! Reads data from a socket
     ssize_t recv(char* _pb, size_t _ul, bool& _rcan_retry, ErrorCodeT& _rerr, unsigned _flags = 0);
+    //! Write data from a file at the given offset - zero copy where the platform supports it
+    ssize_t sendFile(const Device& _rfile, int64_t _off, size_t _ul, bool& _rcan_retry, ErrorCodeT& _rerr);
     //! Send a datagram to a socket
     ssize_t send(const char* _pb, size_t _ul, const SocketAddressStub& _sap, bool& _rcan_retry, ErrorCodeT& _rerr);
     //! Recv data from a socket
     ssize_t recv(char* _pb, size_t _ul, SocketAddress& _rsa, bool& _rcan_retry, ErrorCodeT& _rerr);
+    //! Receive up to _count (at most datagram_batch_capacity) datagrams with a single call - returns the number of datagrams received
+    /*!
+     * Uses recvmmsg on Linux. Elsewhere it receives a single datagram.
+     */
+    ssize_t recv(DatagramStub* _pdgs, size_t _count, bool& _rcan_retry, ErrorCodeT& _rerr);
+    //! Send up to _count (at most datagram_batch_capacity) datagrams with a single call - returns the number of datagrams sent
+    /*!
+     * Uses sendmmsg on Linux. Elsewhere it sends the datagrams one by one.
+     */
+    ssize_t send(const DatagramStub* _pdgs, size_t _count, bool& _rcan_retry, ErrorCodeT& _rerr);
     //! Gets the remote address for a connected socket
     ErrorCodeT remoteAddress(SocketAddress& _rsa) const;
     //! Gets the local address for a socket
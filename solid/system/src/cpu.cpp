@@ -0,0 +1,171 @@
+// solid/system/src/cpu.cpp
+//
+// Copyright (c) 2018 Valentin Palade (vipalade @ gmail . com)
+//
+// This file is part of SolidFrame framework.
+//
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt.
+//
+#include "solid/system/cpu.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <fstream>
+#include <string>
+#include <thread>
+
+#if defined(SOLID_ON_LINUX)
+#include <pthread.h>
+#include <sched.h>
+#elif defined(SOLID_ON_FREEBSD)
+#include <pthread.h>
+#include <pthread_np.h>
+#include <sys/cpuset.h>
+#endif
+
+namespace solid {
+
+namespace {
+
+#if defined(SOLID_ON_LINUX)
+//parse a linux cpu list, e.g. "0-3,8,10-11"
+bool read_cpu_list(const std::string& _path, CpuSetT& _rcpu_set)
+{
+    std::ifstream ifs(_path);
+    std::string   line;
+
+    if (!ifs || !std::getline(ifs, line)) {
+        return false;
+    }
+
+    size_t off = 0;
+    while (off < line.size()) {
+        size_t end = line.find(',', off);
+        if (end == std::string::npos) {
+            end = line.size();
+        }
+        const std::string range = line.substr(off, end - off);
+        const size_t      dash  = range.find('-');
+
+        if (!range.empty()) {
+            const size_t first = std::stoul(range.substr(0, dash));
+            const size_t last  = dash == std::string::npos ? first : std::stoul(range.substr(dash + 1));
+
+            for (size_t i = first; i <= last; ++i) {
+                _rcpu_set.push_back(i);
+            }
+        }
+        off = end + 1;
+    }
+    return true;
+}
+
+std::string numa_node_cpu_list_path(const size_t _node)
+{
+    return "/sys/devices/system/node/node" + std::to_string(_node) + "/cpulist";
+}
+#endif
+
+} //namespace
+
+size_t cpu_count()
+{
+    const size_t cnt = std::thread::hardware_concurrency();
+    return cnt != 0 ? cnt : 1;
+}
+
+size_t numa_node_count()
+{
+#if defined(SOLID_ON_LINUX)
+    size_t cnt = 0;
+    while (std::ifstream(numa_node_cpu_list_path(cnt))) {
+        ++cnt;
+    }
+    return cnt != 0 ? cnt : 1;
+#else
+    return 1;
+#endif
+}
+
+CpuSetT numa_node_cpu_set(const size_t _node)
+{
+    CpuSetT cpu_set;
+#if defined(SOLID_ON_LINUX)
+    if (read_cpu_list(numa_node_cpu_list_path(_node), cpu_set)) {
+        return cpu_set;
+    }
+#endif
+    if (_node == 0) {
+        for (size_t i = 0; i < cpu_count(); ++i) {
+            cpu_set.push_back(i);
+        }
+    }
+    return cpu_set;
+}
+
+size_t cpu_numa_node(const size_t _cpu)
+{
+    const size_t node_cnt = numa_node_count();
+    for (size_t node = 0; node < node_cnt; ++node) {
+        const CpuSetT cpu_set = numa_node_cpu_set(node);
+        if (std::find(cpu_set.begin(), cpu_set.end(), _cpu) != cpu_set.end()) {
+            return node;
+        }
+    }
+    return 0;
+}
+
+CpuSetVectorT cpu_set_per_cpu()
+{
+    CpuSetVectorT cpu_set_vec;
+    const size_t  node_cnt = numa_node_count();
+
+    for (size_t node = 0; node < node_cnt; ++node) {
+        for (const auto cpu : numa_node_cpu_set(node)) {
+            cpu_set_vec.emplace_back(1, cpu);
+        }
+    }
+    return cpu_set_vec;
+}
+
+CpuSetVectorT cpu_set_per_numa_node()
+{
+    CpuSetVectorT cpu_set_vec;
+    const size_t  node_cnt = numa_node_count();
+
+    for (size_t node = 0; node < node_cnt; ++node) {
+        CpuSetT cpu_set = numa_node_cpu_set(node);
+        if (!cpu_set.empty()) {
+            cpu_set_vec.emplace_back(std::move(cpu_set));
+        }
+    }
+    return cpu_set_vec;
+}
+
+ErrorCodeT thread_cpu_affinity(CpuSetT const& _rcpu_set)
+{
+#if defined(SOLID_ON_LINUX) || defined(SOLID_ON_FREEBSD)
+#if defined(SOLID_ON_LINUX)
+    cpu_set_t cpuset;
+#else
+    cpuset_t cpuset;
+#endif
+    CPU_ZERO(&cpuset);
+    for (const auto cpu : _rcpu_set) {
+        if (cpu >= CPU_SETSIZE) {
+            return ErrorCodeT(EINVAL, std::system_category());
+        }
+        CPU_SET(cpu, &cpuset);
+    }
+    const int rv = pthread_setaffinity_np(pthread_self(), sizeof(cpuset), &cpuset);
+    if (rv == 0) {
+        return ErrorCodeT();
+    }
+    return ErrorCodeT(rv, std::system_category());
+#else
+    (void)_rcpu_set;
+    return solid::error_not_implemented;
+#endif
+}
+
+} //namespace solid
@@ -25,6 +25,14 @@
 #include <sys/stat.h>
 #include <sys/types.h>
 #include <unistd.h>
+#if defined(SOLID_ON_LINUX)
+#include <netinet/udp.h>
+#include <sys/sendfile.h>
+#include <sys/socket.h>
+#elif defined(SOLID_ON_DARWIN) || defined(SOLID_ON_FREEBSD)
+#include <sys/socket.h>
+#include <sys/uio.h>
+#endif
 #endif
 
 #include <cassert>
@@ -749,6 +757,64 @@ ssize_t SocketDevice::send(const char* _pb, size_t _ul, bool& _rcan_retry, Error
     return rv;
 #endif
 }
+#if !defined(SOLID_ON_LINUX) && !defined(SOLID_ON_DARWIN) && !defined(SOLID_ON_FREEBSD)
+namespace {
+//Reads from _off without moving the file position
+ssize_t read_at(const Device& _rfile, char* _pb, size_t _bl, int64_t _off)
+{
+#ifdef SOLID_ON_WINDOWS
+    OVERLAPPED ov = {};
+    DWORD      cnt = 0;
+    ov.Offset      = static_cast<DWORD>(_off & 0xffffffff);
+    ov.OffsetHigh  = static_cast<DWORD>(_off >> 32);
+    if (ReadFile(_rfile.descriptor(), _pb, static_cast<DWORD>(_bl), &cnt, &ov)) {
+        return cnt;
+    }
+    return GetLastError() == ERROR_HANDLE_EOF ? 0 : -1;
+#else
+    return ::pread(_rfile.descriptor(), _pb, _bl, _off);
+#endif
+}
+} //namespace
+#endif
+
+ssize_t SocketDevice::sendFile(const Device& _rfile, int64_t _off, size_t _ul, bool& _rcan_retry, ErrorCodeT& _rerr)
+{
+#if defined(SOLID_ON_LINUX)
+    off_t   off = _off;
+    ssize_t rv  = ::sendfile(descriptor(), _rfile.descriptor(), &off, _ul);
+    _rcan_retry = (errno == EAGAIN || errno == EWOULDBLOCK);
+    _rerr       = last_socket_error();
+    return rv;
+#elif defined(SOLID_ON_DARWIN) || defined(SOLID_ON_FREEBSD)
+#if defined(SOLID_ON_DARWIN)
+    off_t     len = _ul;
+    const int rv  = ::sendfile(_rfile.descriptor(), descriptor(), _off, &len, nullptr, 0);
+#else
+    off_t     len = 0;
+    const int rv  = ::sendfile(_rfile.descriptor(), descriptor(), _off, _ul, nullptr, &len, 0);
+#endif
+    _rcan_retry = (errno == EAGAIN || errno == EWOULDBLOCK);
+    _rerr       = last_socket_error();
+    if (rv == 0 || len > 0) {
+        //partial writes on a non-blocking socket fail with EAGAIN
+        _rcan_retry = false;
+        return len;
+    }
+    return -1;
+#else
+    //no zero copy - e.g. TransmitFile needs overlapped IO - read and send
+    char          buf[16 * 1024];
+    const ssize_t readsz = read_at(_rfile, buf, _ul < sizeof(buf) ? _ul : sizeof(buf), _off);
+    if (readsz <= 0) {
+        _rcan_retry = false;
+        _rerr       = last_system_error();
+        return readsz;
+    }
+    //only what gets sent is consumed from the file
+    return send(buf, readsz, _rcan_retry, _rerr);
+#endif
+}
 ssize_t SocketDevice::recv(char* _pb, size_t _ul, bool& _rcan_retry, ErrorCodeT& _rerr, unsigned)
 {
 #ifdef SOLID_ON_WINDOWS
@@ -810,6 +876,151 @@ ssize_t SocketDevice::recv(char* _pb, size_t _ul, SocketAddress& _rsa, bool& _rc
 #endif
 }
 
+#if defined(SOLID_ON_LINUX)
+namespace {
+union DatagramControl {
+    cmsghdr hdr;
+    char    buf[CMSG_SPACE(sizeof(int))];
+};
+} //namespace
+#endif
+
+ssize_t SocketDevice::recv(DatagramStub* _pdgs, size_t _count, bool& _rcan_retry, ErrorCodeT& _rerr)
+{
+#if defined(SOLID_ON_LINUX)
+    mmsghdr         msgs[datagram_batch_capacity];
+    iovec           iovs[datagram_batch_capacity];
+    DatagramControl ctls[datagram_batch_capacity];
+
+    if (_count > datagram_batch_capacity) {
+        _count = datagram_batch_capacity;
+    }
+
+    for (size_t i = 0; i < _count; ++i) {
+        DatagramStub& rdg  = _pdgs[i];
+        msghdr&       rmsg = msgs[i].msg_hdr;
+
+        rdg.address_.clear();
+        iovs[i].iov_base = rdg.buffer_;
+        iovs[i].iov_len  = rdg.capacity_;
+
+        rmsg.msg_name       = rdg.address_.sockAddr();
+        rmsg.msg_namelen    = SocketAddress::Capacity;
+        rmsg.msg_iov        = &iovs[i];
+        rmsg.msg_iovlen     = 1;
+        rmsg.msg_control    = ctls[i].buf;
+        rmsg.msg_controllen = sizeof(ctls[i].buf);
+        rmsg.msg_flags      = 0;
+        msgs[i].msg_len     = 0;
+    }
+
+    //MSG_WAITFORONE: only wait for the first datagram on blocking sockets
+    const int rv = ::recvmmsg(descriptor(), msgs, static_cast<unsigned>(_count), MSG_WAITFORONE, nullptr);
+    _rcan_retry  = (errno == EAGAIN || errno == EWOULDBLOCK);
+    _rerr        = last_socket_error();
+
+    for (int i = 0; i < rv; ++i) {
+        DatagramStub& rdg  = _pdgs[i];
+        msghdr&       rmsg = msgs[i].msg_hdr;
+
+        rdg.size_         = msgs[i].msg_len;
+        rdg.address_.sz   = rmsg.msg_namelen;
+        rdg.segment_size_ = 0;
+#ifdef UDP_GRO
+        for (cmsghdr* pcmsg = CMSG_FIRSTHDR(&rmsg); pcmsg != nullptr; pcmsg = CMSG_NXTHDR(&rmsg, pcmsg)) {
+            if (pcmsg->cmsg_level == SOL_UDP && pcmsg->cmsg_type == UDP_GRO) {
+                int segment_size;
+                memcpy(&segment_size, CMSG_DATA(pcmsg), sizeof(segment_size));
+                rdg.segment_size_ = segment_size;
+            }
+        }
+#endif
+    }
+    return rv;
+#else
+    if (_count == 0) {
+        return 0;
+    }
+    //a second recv would block on blocking sockets
+    const ssize_t rv = recv(_pdgs->buffer_, _pdgs->capacity_, _pdgs->address_, _rcan_retry, _rerr);
+    if (rv < 0) {
+        return rv;
+    }
+    _pdgs->size_         = rv;
+    _pdgs->segment_size_ = 0;
+    return 1;
+#endif
+}
+
+ssize_t SocketDevice::send(const DatagramStub* _pdgs, size_t _count, bool& _rcan_retry, ErrorCodeT& _rerr)
+{
+#if defined(SOLID_ON_LINUX)
+    mmsghdr         msgs[datagram_batch_capacity];
+    iovec           iovs[datagram_batch_capacity];
+    DatagramControl ctls[datagram_batch_capacity];
+
+    if (_count > datagram_batch_capacity) {
+        _count = datagram_batch_capacity;
+    }
+
+    for (size_t i = 0; i < _count; ++i) {
+        const DatagramStub& rdg  = _pdgs[i];
+        msghdr&             rmsg = msgs[i].msg_hdr;
+
+        iovs[i].iov_base = rdg.buffer_;
+        iovs[i].iov_len  = rdg.size_;
+
+        rmsg.msg_name       = rdg.address_.empty() ? nullptr : const_cast<sockaddr*>(rdg.address_.sockAddr());
+        rmsg.msg_namelen    = rdg.address_.size();
+        rmsg.msg_iov        = &iovs[i];
+        rmsg.msg_iovlen     = 1;
+        rmsg.msg_control    = nullptr;
+        rmsg.msg_controllen = 0;
+        rmsg.msg_flags      = 0;
+        msgs[i].msg_len     = 0;
+
+        if (rdg.segment_size_ != 0) {
+#ifdef UDP_SEGMENT
+            rmsg.msg_control    = ctls[i].buf;
+            rmsg.msg_controllen = CMSG_SPACE(sizeof(uint16_t));
+
+            cmsghdr*       pcmsg        = CMSG_FIRSTHDR(&rmsg);
+            const uint16_t segment_size = static_cast<uint16_t>(rdg.segment_size_);
+
+            pcmsg->cmsg_level = SOL_UDP;
+            pcmsg->cmsg_type  = UDP_SEGMENT;
+            pcmsg->cmsg_len   = CMSG_LEN(sizeof(segment_size));
+            memcpy(CMSG_DATA(pcmsg), &segment_size, sizeof(segment_size));
+#else
+            _rcan_retry = false;
+            _rerr       = solid::error_not_implemented;
+            return -1;
+#endif
+        }
+    }
+
+    const int rv = ::sendmmsg(descriptor(), msgs, static_cast<unsigned>(_count), 0);
+    _rcan_retry  = (errno == EAGAIN || errno == EWOULDBLOCK);
+    _rerr        = last_socket_error();
+    return rv;
+#else
+    size_t i = 0;
+    for (; i < _count; ++i) {
+        const DatagramStub& rdg = _pdgs[i];
+        if (rdg.segment_size_ != 0) {
+            _rcan_retry = false;
+            _rerr       = solid::error_not_implemented;
+            break;
+        }
+        const ssize_t rv = rdg.address_.empty() ? send(rdg.buffer_, rdg.size_, _rcan_retry, _rerr) : send(rdg.buffer_, rdg.size_, rdg.address_, _rcan_retry, _rerr);
+        if (rv < 0) {
+            break;
+        }
+    }
+    return i != 0 || _count == 0 ? static_cast<ssize_t>(i) : -1;
+#endif
+}
+
 ErrorCodeT SocketDevice::remoteAddress(SocketAddress& _rsa) const
 {
 #ifdef SOLID_ON_WINDOWS
@@ -984,6 +1195,63 @@ ErrorCodeT SocketDevice::hasNoDelay(bool& _rrv) const
     return last_socket_error();
 }
 
+ErrorCodeT SocketDevice::enableGenericReceiveOffload()
+{
+#if defined(SOLID_ON_LINUX) && defined(UDP_GRO)
+    int flag = 1;
+    int rv = setsockopt(descriptor(), SOL_UDP, UDP_GRO, reinterpret_cast<char*>(&flag), sizeof(flag));
+    if (rv == 0) {
+        return ErrorCodeT();
+    }
+    return last_socket_error();
+#else
+    return solid::error_not_implemented;
+#endif
+}
+
+ErrorCodeT SocketDevice::enableBusyPoll(const size_t _microseconds)
+{
+#if defined(SOLID_ON_LINUX) && defined(SO_BUSY_POLL)
+    int value = static_cast<int>(_microseconds);
+    int rv = setsockopt(descriptor(), SOL_SOCKET, SO_BUSY_POLL, reinterpret_cast<char*>(&value), sizeof(value));
+    if (rv == 0) {
+        return ErrorCodeT();
+    }
+    return last_socket_error();
+#else
+    return solid::error_not_implemented;
+#endif
+}
+
+ErrorCodeT SocketDevice::enableReusePort()
+{
+#if defined(SO_REUSEPORT)
+    int yes = 1;
+    int rv = setsockopt(descriptor(), SOL_SOCKET, SO_REUSEPORT, reinterpret_cast<char*>(&yes), sizeof(yes));
+    if (rv == 0) {
+        return ErrorCodeT();
+    }
+    return last_socket_error();
+#else
+    return solid::error_not_implemented;
+#endif
+}
+
+ErrorCodeT SocketDevice::incomingCpu(const size_t _cpu)
+{
+#if defined(SOLID_ON_LINUX) && defined(SO_INCOMING_CPU)
+    int value = static_cast<int>(_cpu);
+    int rv = setsockopt(descriptor(), SOL_SOCKET, SO_INCOMING_CPU, reinterpret_cast<char*>(&value), sizeof(value));
+    if (rv == 0) {
+        return ErrorCodeT();
+    }
+    return last_socket_error();
+#else
+    (void)_cpu;
+    return solid::error_not_implemented;
+#endif
+}
+
 ErrorCodeT SocketDevice::enableCork()
 {
 #ifdef SOLID_ON_WINDOWS
@@ -136,6 +136,10 @@ std::ostream& operator<<(std::ostream& _ros, const SocketAddressInet& _rsa)
 
 std::ostream& operator<<(std::ostream& _ros, const SocketAddress& _rsa)
 {
+    if (_rsa.isLocal()) {
+        _ros << (_rsa.isAbstract() ? "@" : "") << _rsa.path();
+        return _ros;
+    }
     std::string hoststr;
     std::string servstr;
     synchronous_resolve(
@@ -146,4 +150,12 @@ std::ostream& operator<<(std::ostream& _ros, const SocketAddress& _rsa)
     return _ros;
 }
 
+#ifndef SOLID_ON_WINDOWS
+std::ostream& operator<<(std::ostream& _ros, const SocketAddressLocal& _rsa)
+{
+    _ros << (_rsa.isAbstract() ? "@" : "") << _rsa.path();
+    return _ros;
+}
+#endif
+
 } //namespace solid
@@ -11,6 +11,7 @@
 #pragma once
 
 #include "solid/system/exception.hpp"
+#include "solid/utility/recycler.hpp"
 #include <cstddef>
 #include <type_traits>
 #include <typeindex>
@@ -23,7 +24,7 @@ namespace impl {
 //-----------------------------------------------------------------------------
 //      AnyValueBase
 //-----------------------------------------------------------------------------
-struct AnyValueBase {
+struct AnyValueBase : Recyclable {
     virtual ~AnyValueBase();
     virtual const void*   get() const                                                = 0;
     virtual void*         get()                                                      = 0;
@@ -41,6 +42,7 @@ struct AnyValue;
 
 template <class T>
 struct AnyValue<T, true> : AnyValueBase {
+    static_assert(is_recyclable<T>::value, "over-aligned values are not supported by Any");
 
     template <class... Args>
     explicit AnyValue(Args&&... _args)
@@ -83,6 +85,8 @@ struct AnyValue<T, true> : AnyValueBase {
 
 template <class T>
 struct AnyValue<T, false> : AnyValueBase {
+    static_assert(is_recyclable<T>::value, "over-aligned values are not supported by Any");
+
     template <class... Args>
     explicit AnyValue(Args&&... _args)
         : value_(std::forward<Args>(_args)...)
@@ -0,0 +1,114 @@
+// solid/utility/chunkstream.hpp
+//
+// Copyright (c) 2018 Valentin Palade (vipalade @ gmail . com)
+//
+// This file is part of SolidFrame framework.
+//
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt.
+//
+
+#pragma once
+
+#include "solid/utility/function.hpp"
+#include <cstdint>
+#include <ostream>
+#include <streambuf>
+
+namespace solid {
+
+//! A std::streambuf handing every written chunk to a function
+/*!
+    Nothing is buffered: a write of N bytes is a single call
+    of the chunk function with the caller's buffer.
+*/
+class ChunkOStreamBuf : public std::streambuf {
+public:
+    using ChunkFunctionT = solid_function_t(void(const char*, size_t));
+
+    ChunkOStreamBuf() {}
+
+    explicit ChunkOStreamBuf(ChunkFunctionT _chunk_fnc)
+        : chunk_fnc(std::move(_chunk_fnc))
+    {
+    }
+
+    void sink(ChunkFunctionT _chunk_fnc)
+    {
+        chunk_fnc = std::move(_chunk_fnc);
+    }
+
+    uint64_t size() const
+    {
+        return sz;
+    }
+
+protected:
+    std::streamsize xsputn(const char_type* _s, std::streamsize _n) override
+    {
+        if (solid_function_empty(chunk_fnc)) {
+            return 0;
+        }
+        if (_n > 0) {
+            chunk_fnc(_s, static_cast<size_t>(_n));
+            sz += _n;
+        }
+        return _n;
+    }
+
+    int_type overflow(int_type _c = traits_type::eof()) override
+    {
+        if (traits_type::eq_int_type(_c, traits_type::eof())) {
+            return traits_type::not_eof(_c);
+        }
+        const char_type c = traits_type::to_char_type(_c);
+        return xsputn(&c, 1) == 1 ? _c : traits_type::eof();
+    }
+
+private:
+    ChunkFunctionT chunk_fnc;
+    uint64_t       sz = 0;
+};
+
+//! A std::ostream handing every written chunk to a function
+/*!
+    Use it as the receiving side sink of a serialized stream to
+    process big data chunk by chunk, as it is deserialized:
+    <code>
+    _s.add(_rthis.chunk_os, [](std::ostream& _ros, uint64_t _len, const bool _done, Ctx& _rctx, const char* _name){}, _rctx, "data");
+    </code>
+    A write with no chunk function set fails the stream.
+*/
+class ChunkOStream : public std::ostream {
+public:
+    using ChunkFunctionT = ChunkOStreamBuf::ChunkFunctionT;
+
+    ChunkOStream()
+        : std::ostream(nullptr)
+    {
+        rdbuf(&buf);
+    }
+
+    explicit ChunkOStream(ChunkFunctionT _chunk_fnc)
+        : std::ostream(nullptr)
+        , buf(std::move(_chunk_fnc))
+    {
+        rdbuf(&buf);
+    }
+
+    void sink(ChunkFunctionT _chunk_fnc)
+    {
+        buf.sink(std::move(_chunk_fnc));
+    }
+
+    //! The number of bytes given to the chunk function
+    uint64_t size() const
+    {
+        return buf.size();
+    }
+
+private:
+    ChunkOStreamBuf buf;
+};
+
+} //namespace solid
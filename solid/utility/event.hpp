@@ -35,8 +35,18 @@ class EventHandlerBase;
 //      Event
 //-----------------------------------------------------------------------------
 
+//! The inline storage for the Event payload, besides any_min_data_size
+/*!
+ * Payloads not fitting in, are allocated from the per-thread Recyclable
+ * storage (see solid/utility/recycler.hpp).
+ * Can be overridden at build time, like SOLID_FUNCTION_STORAGE.
+ */
+#ifndef SOLID_EVENT_STORAGE
+#define SOLID_EVENT_STORAGE max_size(sizeof(void*) + sizeof(uint64_t), sizeof(std::shared_ptr<uint64_t>))
+#endif
+
 struct Event {
-    static constexpr size_t any_size = any_min_data_size + max_size(sizeof(void*) + sizeof(uint64_t), sizeof(std::shared_ptr<uint64_t>));
+    static constexpr size_t any_size = any_min_data_size + (SOLID_EVENT_STORAGE);
 
     using AnyT = Any<any_size>;
 
@@ -11,6 +11,7 @@
 #pragma once
 
 #include "solid/system/exception.hpp"
+#include "solid/utility/recycler.hpp"
 #include <cstddef>
 #include <functional>
 #include <type_traits>
@@ -24,7 +25,7 @@ namespace impl {
 //-----------------------------------------------------------------------------
 //      FunctionValueBase
 //-----------------------------------------------------------------------------
-struct FunctionValueBase {
+struct FunctionValueBase : Recyclable {
     virtual ~FunctionValueBase();
     virtual const void*        get() const                                                = 0;
     virtual void*              get()                                                      = 0;
@@ -51,6 +52,7 @@ struct FunctionValue;
 
 template <class T, class R, class... ArgTypes>
 struct FunctionValue<T, true, R, ArgTypes...> : FunctionValueInter<R, ArgTypes...> {
+    static_assert(is_recyclable<T>::value, "over-aligned closures are not supported by Function");
 
     FunctionValue(T&& _rt)
         : value_(std::forward<T>(_rt))
@@ -105,6 +107,7 @@ struct FunctionValue<T, true, R, ArgTypes...> : FunctionValueInter<R, ArgTypes..
 
 template <class T, class R, class... ArgTypes>
 struct FunctionValue<T, false, R, ArgTypes...> : FunctionValueInter<R, ArgTypes...> {
+    static_assert(is_recyclable<T>::value, "over-aligned closures are not supported by Function");
 
     explicit FunctionValue(T&& _rt)
         : value_(std::forward<T>(_rt))
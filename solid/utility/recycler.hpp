@@ -0,0 +1,78 @@
+// solid/utility/recycler.hpp
+//
+// Copyright (c) 2018 Valentin Palade (vipalade @ gmail . com)
+//
+// This file is part of SolidFrame framework.
+//
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt.
+//
+
+#pragma once
+
+#include <cstddef>
+#include <type_traits>
+
+namespace solid {
+
+namespace impl {
+
+void* recycler_allocate(const size_t _sz);
+void  recycler_deallocate(void* _pv, const size_t _sz);
+
+//The number of blocks the recycler took from the heap - for tests and statistics
+size_t recycler_heap_allocation_count();
+
+} //namespace impl
+
+constexpr size_t recycler_max_size       = 1024;
+constexpr size_t recycler_class_capacity = 64 * 1024;
+
+//! Per-thread recycled storage for small heap objects
+/*!
+ * Classes deriving from Recyclable are allocated from per-thread free
+ * lists of power of two size classes, from 32 to recycler_max_size bytes.
+ * A freed block goes to the free list of the freeing thread. Above
+ * recycler_class_capacity bytes per size class, half of the list moves to
+ * a process wide depot, from where threads with empty lists take their
+ * blocks before going to the heap. So objects allocated on one thread and
+ * freed on another - e.g. Events notified to a reactor - come back to the
+ * allocating thread in batches.
+ * Larger objects use the global operator new.
+ *
+ * Used by Any and Function for values not fitting their inline storage so
+ * that, in steady state, oversized Event payloads and posted closures do
+ * not hit the heap.
+ *
+ * NOTE: a class hierarchy deriving from Recyclable must have a virtual
+ * destructor, if objects are deleted through a base pointer.
+ * NOTE: the blocks have the default operator new alignment - over-aligned
+ * classes are not supported, see is_recyclable.
+ */
+struct Recyclable {
+    static void* operator new(const size_t _sz)
+    {
+        return impl::recycler_allocate(_sz);
+    }
+
+    static void* operator new(const size_t, void* _pv) noexcept
+    {
+        return _pv;
+    }
+
+    static void operator delete(void* _pv, const size_t _sz)
+    {
+        impl::recycler_deallocate(_pv, _sz);
+    }
+
+    static void operator delete(void*, void*) noexcept
+    {
+    }
+};
+
+//! The classes Recyclable can allocate - the ones not over-aligned
+template <class T>
+struct is_recyclable : std::integral_constant<bool, alignof(T) <= alignof(std::max_align_t)> {
+};
+
+} //namespace solid
@@ -0,0 +1,223 @@
+// solid/utility/src/recycler.cpp
+//
+// Copyright (c) 2018 Valentin Palade (vipalade @ gmail . com)
+//
+// This file is part of SolidFrame framework.
+//
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt.
+//
+
+#include "solid/utility/recycler.hpp"
+#include <atomic>
+#include <mutex>
+#include <new>
+
+namespace solid {
+namespace impl {
+
+namespace {
+
+constexpr size_t min_class_size    = 32;
+constexpr size_t class_count       = 6; //32, 64, 128, 256, 512, 1024
+constexpr size_t depot_batch_count = 16; //per size class
+
+static_assert((min_class_size << (class_count - 1)) == recycler_max_size, "size classes do not cover recycler_max_size");
+
+struct Node {
+    Node* pnext_;
+    Node* pnextbatch_; //on the first node of a batch in the depot
+};
+
+static_assert(sizeof(Node) <= min_class_size, "min_class_size too small for a Node");
+
+inline size_t class_capacity(const size_t _idx)
+{
+    return (recycler_class_capacity >> _idx) / min_class_size;
+}
+
+//half of the class capacity
+inline size_t batch_size(const size_t _idx)
+{
+    return class_capacity(_idx) / 2;
+}
+
+std::atomic<size_t> heap_allocation_count{0};
+
+//Blocks freed on a thread other than the one allocating them pile up on
+//the freeing thread: above the class capacity, a batch goes to the depot,
+//where the allocating thread finds it, once its own list is empty.
+struct Depot {
+    std::mutex mutex_;
+    Node*      batches_[class_count] = {nullptr};
+    size_t     count_[class_count]   = {0};
+
+    bool push(const size_t _idx, Node* _pbatch)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (count_[_idx] < depot_batch_count) {
+            _pbatch->pnextbatch_ = batches_[_idx];
+            batches_[_idx]       = _pbatch;
+            ++count_[_idx];
+            return true;
+        }
+        return false;
+    }
+
+    Node* pop(const size_t _idx)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        Node*                       pbatch = batches_[_idx];
+        if (pbatch != nullptr) {
+            batches_[_idx] = pbatch->pnextbatch_;
+            --count_[_idx];
+        }
+        return pbatch;
+    }
+};
+
+//never destroyed - usable by threads ending after the static destructors
+Depot& depot()
+{
+    static Depot* pdepot = new Depot;
+    return *pdepot;
+}
+
+//trivially destructible so it is still usable while other thread_local
+//or static objects are destroyed
+struct ThreadCache {
+    Node*  free_[class_count];
+    size_t count_[class_count];
+    bool   guarded_;
+    bool   destroyed_;
+
+    void flush()
+    {
+        for (size_t i = 0; i < class_count; ++i) {
+            while (free_[i] != nullptr) {
+                Node* pn = free_[i];
+                free_[i] = pn->pnext_;
+                ::operator delete(pn);
+            }
+            count_[i] = 0;
+        }
+    }
+
+    //moves the first batch_size blocks of the list to the depot
+    void release(const size_t _idx)
+    {
+        Node* pbatch = free_[_idx];
+        Node* plast  = pbatch;
+        for (size_t i = 1; i < batch_size(_idx); ++i) {
+            plast = plast->pnext_;
+        }
+        free_[_idx]   = plast->pnext_;
+        plast->pnext_ = nullptr;
+
+        count_[_idx] -= batch_size(_idx);
+
+        if (!depot().push(_idx, pbatch)) {
+            while (pbatch != nullptr) {
+                Node* pn = pbatch;
+                pbatch   = pn->pnext_;
+                ::operator delete(pn);
+            }
+        }
+    }
+};
+
+thread_local ThreadCache tls_cache = {{nullptr}, {0}, false, false};
+
+//returns the blocks to the heap when the thread ends
+struct ThreadCacheGuard {
+    ThreadCacheGuard()
+    {
+        tls_cache.guarded_ = true;
+    }
+    ~ThreadCacheGuard()
+    {
+        tls_cache.flush();
+        tls_cache.destroyed_ = true;
+    }
+};
+
+thread_local ThreadCacheGuard tls_guard;
+
+inline void touch(ThreadCacheGuard&) {}
+
+inline size_t class_index(const size_t _sz)
+{
+    size_t idx = 0;
+    size_t csz = min_class_size;
+    while (csz < _sz) {
+        csz <<= 1;
+        ++idx;
+    }
+    return idx;
+}
+
+void* heap_allocate(const size_t _sz)
+{
+    heap_allocation_count.fetch_add(1, std::memory_order_relaxed);
+    return ::operator new(_sz);
+}
+
+} //namespace
+
+void* recycler_allocate(const size_t _sz)
+{
+    if (_sz <= recycler_max_size) {
+        const size_t idx = class_index(_sz);
+        ThreadCache& rc  = tls_cache;
+        if (rc.free_[idx] == nullptr && !rc.destroyed_) {
+            rc.free_[idx] = depot().pop(idx);
+            if (rc.free_[idx] != nullptr) {
+                if (!rc.guarded_) {
+                    touch(tls_guard);
+                }
+                rc.count_[idx] = batch_size(idx);
+            }
+        }
+        if (rc.free_[idx] != nullptr) {
+            Node* pn      = rc.free_[idx];
+            rc.free_[idx] = pn->pnext_;
+            --rc.count_[idx];
+            return pn;
+        }
+        return heap_allocate(min_class_size << idx);
+    }
+    return heap_allocate(_sz);
+}
+
+void recycler_deallocate(void* _pv, const size_t _sz)
+{
+    if (_pv == nullptr) {
+        return;
+    }
+    if (_sz <= recycler_max_size) {
+        const size_t idx = class_index(_sz);
+        ThreadCache& rc  = tls_cache;
+        if (!rc.destroyed_) {
+            if (!rc.guarded_) {
+                touch(tls_guard);
+            }
+            Node* pn      = static_cast<Node*>(_pv);
+            pn->pnext_    = rc.free_[idx];
+            rc.free_[idx] = pn;
+            ++rc.count_[idx];
+            if (rc.count_[idx] > class_capacity(idx)) {
+                rc.release(idx);
+            }
+            return;
+        }
+    }
+    ::operator delete(_pv);
+}
+
+size_t recycler_heap_allocation_count()
+{
+    return heap_allocation_count.load(std::memory_order_relaxed);
+}
+
+} //namespace impl
+} //namespace solid
@@ -0,0 +1,146 @@
+#include "solid/system/exception.hpp"
+#include "solid/utility/recycler.hpp"
+#include <condition_variable>
+#include <cstdlib>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace std;
+using namespace solid;
+
+namespace {
+
+template <size_t Size>
+struct Value : Recyclable {
+    char data_[Size];
+};
+
+using SmallValueT = Value<40>;
+using LargeValueT = Value<1000>;
+
+struct alignas(64) OverAlignedValue {
+    char data_[64];
+};
+
+static_assert(is_recyclable<LargeValueT>::value, "recyclable value");
+static_assert(!is_recyclable<OverAlignedValue>::value, "over-aligned value is not recyclable");
+
+struct Exchange {
+    mutex                mtx_;
+    condition_variable   cnd_;
+    vector<SmallValueT*> small_vec_;
+    vector<LargeValueT*> large_vec_;
+    bool                 full_    = false;
+    bool                 running_ = true;
+};
+
+//frees, on its own thread, the values the producer allocates
+void consumer_run(Exchange& _rex)
+{
+    unique_lock<mutex> lock(_rex.mtx_);
+    while (true) {
+        _rex.cnd_.wait(lock, [&_rex]() { return _rex.full_ || !_rex.running_; });
+        if (!_rex.full_) {
+            break;
+        }
+        for (auto* pv : _rex.small_vec_) {
+            delete pv;
+        }
+        for (auto* pv : _rex.large_vec_) {
+            delete pv;
+        }
+        _rex.small_vec_.clear();
+        _rex.large_vec_.clear();
+        _rex.full_ = false;
+        _rex.cnd_.notify_one();
+    }
+}
+
+void produce(Exchange& _rex, const size_t _count)
+{
+    unique_lock<mutex> lock(_rex.mtx_);
+    _rex.cnd_.wait(lock, [&_rex]() { return !_rex.full_; });
+    for (size_t i = 0; i < _count; ++i) {
+        _rex.small_vec_.push_back(new SmallValueT);
+        _rex.large_vec_.push_back(new LargeValueT);
+    }
+    _rex.full_ = true;
+    _rex.cnd_.notify_one();
+}
+
+} //namespace
+
+// Values allocated on a thread and freed on another come back to the
+// allocating thread, through the recycler depot, without the heap - as long
+// as the values in flight fit in the bounded depot: for the 1KB class, 16
+// batches of 32 blocks.
+// Usage: test_recycler [ROUND_COUNT] [BATCH_COUNT]
+int test_recycler(int argc, char* argv[])
+{
+    size_t round_count = 1000;
+    size_t batch_count = 300;
+
+    if (argc > 1) {
+        round_count = atoi(argv[1]);
+    }
+    if (argc > 2) {
+        batch_count = atoi(argv[2]);
+    }
+
+    { //same thread
+        vector<SmallValueT*> vec;
+        for (size_t i = 0; i < batch_count; ++i) {
+            vec.push_back(new SmallValueT);
+        }
+        for (auto* pv : vec) {
+            delete pv;
+        }
+        vec.clear();
+
+        const size_t start_count = impl::recycler_heap_allocation_count();
+
+        for (size_t i = 0; i < batch_count; ++i) {
+            vec.push_back(new SmallValueT);
+        }
+        for (auto* pv : vec) {
+            delete pv;
+        }
+        const size_t count = impl::recycler_heap_allocation_count() - start_count;
+        solid_check(count == 0, "same thread allocations: " << count);
+    }
+
+    Exchange ex;
+    ex.small_vec_.reserve(batch_count);
+    ex.large_vec_.reserve(batch_count);
+
+    thread consumer{[&ex]() { consumer_run(ex); }};
+
+    //warm up the recycled storage of both threads - till the blocks the
+    //consumer keeps and the ones in the depot reach their steady state
+    for (size_t i = 0; i < 256; ++i) {
+        produce(ex, batch_count);
+    }
+
+    const size_t start_count = impl::recycler_heap_allocation_count();
+
+    for (size_t i = 0; i < round_count; ++i) {
+        produce(ex, batch_count);
+    }
+
+    const size_t count = impl::recycler_heap_allocation_count() - start_count;
+
+    {
+        unique_lock<mutex> lock(ex.mtx_);
+        ex.cnd_.wait(lock, [&ex]() { return !ex.full_; });
+        ex.running_ = false;
+        ex.cnd_.notify_one();
+    }
+    consumer.join();
+
+    cout << "heap allocations for " << 2 * round_count * batch_count << " values freed on another thread: " << count << endl;
+
+    solid_check(count == 0, "cross thread allocations: " << count);
+    return 0;
+}
@@ -0,0 +1,173 @@
+#include "solid/system/exception.hpp"
+#include "solid/utility/workpool.hpp"
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <iostream>
+#include <iterator>
+#include <thread>
+#include <vector>
+
+using namespace solid;
+using namespace std;
+
+namespace {
+const LoggerT logger("test_batch");
+}
+
+int test_workpool_batch(int argc, char* argv[])
+{
+    solid::log_start(std::cerr, {".*:EWS", "test_batch:VIEWS"});
+
+    cout << "usage: " << argv[0] << " JOB_COUNT BATCH_SIZE WAIT_SECONDS QUEUE_SIZE PRODUCER_COUNT CONSUMER_COUNT" << endl;
+
+    size_t        job_count      = 1000000;
+    size_t        batch_size     = 64;
+    int           wait_seconds   = 100;
+    int           queue_size     = -1;
+    int           producer_count = 2;
+    int           consumer_count = thread::hardware_concurrency();
+    promise<void> prom;
+
+    if (argc > 1) {
+        job_count = atoi(argv[1]);
+    }
+
+    if (argc > 2) {
+        batch_size = atoi(argv[2]);
+    }
+
+    if (argc > 3) {
+        wait_seconds = atoi(argv[3]);
+    }
+
+    if (argc > 4) {
+        queue_size = atoi(argv[4]);
+    }
+
+    if (argc > 5) {
+        producer_count = atoi(argv[5]);
+    }
+
+    if (argc > 6) {
+        consumer_count = atoi(argv[6]);
+    }
+
+    const size_t max_queue_size = queue_size <= 0 ? std::numeric_limits<size_t>::max() : queue_size;
+    const size_t v              = (((job_count - 1) * job_count) / 2) * producer_count;
+
+    thread wait_thread(
+        [](promise<void>& _rprom, const int _wait_time_seconds) {
+            solid_check(_rprom.get_future().wait_for(chrono::seconds(_wait_time_seconds)) == future_status::ready, " Test is taking too long - waited " << _wait_time_seconds << " secs");
+        },
+        std::ref(prom), wait_seconds);
+
+#ifndef SOLID_USE_WORKPOOL_MUTEX
+    //thread_safe::Queue pushBatch/popBatch
+    {
+        using QueueT = thread_safe::Queue<size_t, 5>;
+
+        QueueT              q;
+        std::atomic<bool>   running{true};
+        std::atomic<size_t> val{0};
+        std::atomic<size_t> pop_count{0};
+        vector<thread>      cons_vec;
+        vector<thread>      prod_vec;
+
+        for (int i = 0; i < consumer_count; ++i) {
+            cons_vec.emplace_back(
+                [&q, &running, &val, &pop_count, batch_size, max_queue_size]() {
+                    vector<size_t> out(batch_size);
+                    size_t         cnt;
+                    while ((cnt = q.popBatch(out.begin(), out.size(), running, max_queue_size)) != 0) {
+                        solid_check(cnt <= out.size());
+                        for (size_t i = 0; i < cnt; ++i) {
+                            val += out[i];
+                        }
+                        pop_count += cnt;
+                    }
+                });
+        }
+
+        for (int i = 0; i < producer_count; ++i) {
+            prod_vec.emplace_back(
+                [&q, job_count, batch_size, max_queue_size]() {
+                    vector<size_t> in;
+                    in.reserve(batch_size);
+                    for (size_t i = 0; i < job_count; ++i) {
+                        in.emplace_back(i);
+                        if (in.size() == batch_size || i == (job_count - 1)) {
+                            q.pushBatch(in.begin(), in.end(), max_queue_size);
+                            in.clear();
+                        }
+                    }
+                });
+        }
+
+        for (auto& t : prod_vec) {
+            t.join();
+        }
+
+        while (pop_count != job_count * producer_count) {
+            this_thread::sleep_for(chrono::milliseconds(10));
+        }
+
+        running = false;
+        q.wake();
+
+        for (auto& t : cons_vec) {
+            t.join();
+        }
+        solid_log(logger, Warning, "queue val = " << val << " expected val = " << v);
+        solid_check(v == val, v << " != " << val);
+    }
+#endif
+    //WorkPool pushBatch and tryPush
+    {
+        std::atomic<size_t> val{0};
+        std::atomic<size_t> try_fail_count{0};
+        {
+            WorkPool<size_t> wp{
+                1,
+                WorkPoolConfiguration(consumer_count, max_queue_size),
+                [&val](const size_t _v) {
+                    val += _v;
+                }};
+
+            vector<thread> prod_vec;
+
+            for (int i = 0; i < producer_count; ++i) {
+                prod_vec.emplace_back(
+                    [&wp, &try_fail_count, job_count, batch_size, i]() {
+                        vector<size_t> in;
+                        in.reserve(batch_size);
+                        for (size_t j = 0; j < job_count; ++j) {
+                            if (i % 2) {
+                                //odd producers use tryPush with backoff
+                                while (!wp.tryPush(j)) {
+                                    ++try_fail_count;
+                                    this_thread::yield();
+                                }
+                                continue;
+                            }
+                            in.emplace_back(j);
+                            if (in.size() == batch_size || j == (job_count - 1)) {
+                                wp.pushBatch(std::make_move_iterator(in.begin()), std::make_move_iterator(in.end()));
+                                in.clear();
+                            }
+                        }
+                    });
+            }
+
+            for (auto& t : prod_vec) {
+                t.join();
+            }
+        }
+        solid_log(logger, Warning, "workpool val = " << val << " expected val = " << v << " try_fail_count = " << try_fail_count);
+        solid_check(v == val, v << " != " << val);
+    }
+
+    prom.set_value();
+    wait_thread.join();
+    return 0;
+}
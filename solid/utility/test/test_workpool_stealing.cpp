@@ -0,0 +1,168 @@
+#include "solid/system/exception.hpp"
+#include "solid/utility/workpool_stealing.hpp"
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <future>
+#include <iostream>
+#include <thread>
+
+using namespace solid;
+using namespace std;
+
+namespace {
+const LoggerT logger("test_stealing");
+
+std::atomic<size_t> val{0};
+std::atomic<size_t> tree_val{0};
+
+struct Context {
+    size_t count_;
+
+    Context(const size_t _count)
+        : count_(_count)
+    {
+    }
+
+    ~Context()
+    {
+        solid_log(logger, Verbose, "worker handled " << count_ << " jobs");
+    }
+};
+} //namespace
+
+int test_workpool_stealing(int argc, char* argv[])
+{
+    solid::log_start(std::cerr, {".*:EWS", "test_stealing:VIEWS"});
+
+    cout << "usage: " << argv[0] << " JOB_COUNT WAIT_SECONDS QUEUE_SIZE PRODUCER_COUNT CONSUMER_COUNT PUSH_SLEEP_MSECS JOB_SLEEP_MSECS TREE_DEPTH" << endl;
+
+    using StealingWorkPoolT = StealingWorkPool<size_t>;
+    using AtomicPWPT        = std::atomic<StealingWorkPoolT*>;
+
+    size_t        job_count        = 5000000;
+    int           wait_seconds     = 100;
+    int           queue_size       = -1;
+    int           producer_count   = 0;
+    int           consumer_count   = thread::hardware_concurrency();
+    int           push_sleep_msecs = 0;
+    int           job_sleep_msecs  = 0;
+    size_t        tree_depth       = 16;
+    promise<void> prom;
+    AtomicPWPT    pwp{nullptr};
+
+    if (argc > 1) {
+        job_count = atoi(argv[1]);
+    }
+
+    if (argc > 2) {
+        wait_seconds = atoi(argv[2]);
+    }
+
+    if (argc > 3) {
+        queue_size = atoi(argv[3]);
+    }
+
+    if (argc > 4) {
+        producer_count = atoi(argv[4]);
+    }
+
+    if (argc > 5) {
+        consumer_count = atoi(argv[5]);
+    }
+
+    if (argc > 6) {
+        push_sleep_msecs = atoi(argv[6]);
+    }
+
+    if (argc > 7) {
+        job_sleep_msecs = atoi(argv[7]);
+    }
+
+    if (argc > 8) {
+        tree_depth = atoi(argv[8]);
+    }
+
+    thread wait_thread(
+        [](promise<void>& _rprom, AtomicPWPT& _rpwp, const int _wait_time_seconds) {
+            if (_rprom.get_future().wait_for(chrono::seconds(_wait_time_seconds)) != future_status::ready) {
+                if (_rpwp != nullptr) {
+                    _rpwp.load()->dumpStatistics();
+                }
+                solid_throw(" Test is taking too long - waited " << _wait_time_seconds << " secs");
+            }
+        },
+        std::ref(prom), std::ref(pwp), wait_seconds);
+
+    //external producers - jobs go through the injection queue
+    {
+        StealingWorkPoolT wp{
+            1,
+            WorkPoolConfiguration(consumer_count, queue_size <= 0 ? std::numeric_limits<size_t>::max() : queue_size),
+            [job_sleep_msecs](size_t _v, Context& _rctx) {
+                val += _v;
+                ++_rctx.count_;
+                if (job_sleep_msecs != 0) {
+                    this_thread::sleep_for(chrono::milliseconds(job_sleep_msecs));
+                }
+            },
+            static_cast<size_t>(0)};
+
+        pwp = &wp;
+
+        auto producer_lambda = [job_count, push_sleep_msecs, &wp]() {
+            for (size_t i = 0; i < job_count; ++i) {
+                if (push_sleep_msecs != 0) {
+                    this_thread::sleep_for(chrono::milliseconds(push_sleep_msecs));
+                }
+                wp.push(i);
+            };
+        };
+
+        if (producer_count != 0) {
+            vector<thread> thr_vec;
+            thr_vec.reserve(producer_count);
+            for (int i = 0; i < producer_count; ++i) {
+                thr_vec.emplace_back(producer_lambda);
+            }
+            for (auto& t : thr_vec) {
+                t.join();
+            }
+        } else {
+            producer_lambda();
+        }
+        pwp = nullptr;
+    }
+
+    //jobs pushing jobs - exercises local deques and stealing
+    {
+        StealingWorkPoolT wp{
+            1,
+            WorkPoolConfiguration(consumer_count, queue_size <= 0 ? std::numeric_limits<size_t>::max() : queue_size),
+            [&pwp](size_t _depth) {
+                ++tree_val;
+                if (_depth != 0) {
+                    pwp.load()->push(_depth - 1);
+                    pwp.load()->push(_depth - 1);
+                }
+            }};
+        pwp = &wp;
+        wp.push(tree_depth);
+        //pwp is reset after the pool is destroyed because jobs still use it
+    }
+    pwp = nullptr;
+
+    prom.set_value();
+    wait_thread.join();
+
+    const size_t v = (((job_count - 1) * job_count) / 2) * (producer_count == 0 ? 1 : producer_count);
+
+    solid_log(logger, Warning, "val = " << val << " expected val = " << v);
+    solid_check(v == val, v << " != " << val);
+
+    const size_t tree_v = (static_cast<size_t>(1) << (tree_depth + 1)) - 1;
+
+    solid_log(logger, Warning, "tree_val = " << tree_val << " expected tree_val = " << tree_v);
+    solid_check(tree_v == tree_val, tree_v << " != " << tree_val);
+    return 0;
+}
@@ -0,0 +1,161 @@
+#include "solid/system/exception.hpp"
+#include "solid/utility/workpool_strand.hpp"
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <iostream>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace solid;
+using namespace std;
+
+namespace {
+const LoggerT logger("test_strand");
+
+struct KeyStub {
+    std::atomic<bool>   busy_;
+    std::atomic<size_t> next_;
+
+    KeyStub()
+        : busy_(false)
+        , next_(0)
+    {
+    }
+};
+
+//move-only and not default constructible - like a lambda capturing state
+struct Job {
+    size_t key_;
+    size_t seq_;
+
+    Job(const size_t _key, const size_t _seq)
+        : key_(_key)
+        , seq_(_seq)
+    {
+    }
+
+    Job(Job&&)      = default;
+    Job(const Job&) = delete;
+    Job& operator=(const Job&) = delete;
+    Job& operator=(Job&&) = delete;
+};
+
+struct Context {
+    size_t count_;
+
+    Context(const size_t _count)
+        : count_(_count)
+    {
+    }
+
+    ~Context()
+    {
+        solid_log(logger, Verbose, "worker handled " << count_ << " jobs");
+    }
+};
+} //namespace
+
+int test_workpool_strand(int argc, char* argv[])
+{
+    solid::log_start(std::cerr, {".*:EWS", "test_strand:VIEWS"});
+
+    cout << "usage: " << argv[0] << " JOB_COUNT KEY_COUNT WAIT_SECONDS QUEUE_SIZE PRODUCER_COUNT CONSUMER_COUNT" << endl;
+
+    using StrandWorkPoolT = StrandWorkPool<size_t, Job>;
+    using KeyVectorT      = std::vector<std::unique_ptr<KeyStub>>;
+
+    size_t              job_count      = 100000;
+    size_t              key_count      = 16;
+    int                 wait_seconds   = 100;
+    int                 queue_size     = -1;
+    int                 producer_count = 0;
+    int                 consumer_count = thread::hardware_concurrency();
+    promise<void>       prom;
+    std::atomic<size_t> handled_count{0};
+
+    if (argc > 1) {
+        job_count = atoi(argv[1]);
+    }
+
+    if (argc > 2) {
+        key_count = atoi(argv[2]);
+    }
+
+    if (argc > 3) {
+        wait_seconds = atoi(argv[3]);
+    }
+
+    if (argc > 4) {
+        queue_size = atoi(argv[4]);
+    }
+
+    if (argc > 5) {
+        producer_count = atoi(argv[5]);
+    }
+
+    if (argc > 6) {
+        consumer_count = atoi(argv[6]);
+    }
+
+    thread wait_thread(
+        [](promise<void>& _rprom, const int _wait_time_seconds) {
+            solid_check(_rprom.get_future().wait_for(chrono::seconds(_wait_time_seconds)) == future_status::ready, " Test is taking too long - waited " << _wait_time_seconds << " secs");
+        },
+        std::ref(prom), wait_seconds);
+
+    //every producer uses its own set of keys so that the per key sequence is known
+    const size_t total_key_count = key_count * (producer_count == 0 ? 1 : producer_count);
+    KeyVectorT   key_vec;
+
+    for (size_t i = 0; i < total_key_count; ++i) {
+        key_vec.emplace_back(new KeyStub);
+    }
+
+    {
+        StrandWorkPoolT wp{
+            1,
+            WorkPoolConfiguration(consumer_count, queue_size <= 0 ? std::numeric_limits<size_t>::max() : queue_size),
+            [&key_vec, &handled_count](Job& _rjob, Context& _rctx) {
+                KeyStub& rkey = *key_vec[_rjob.key_];
+
+                solid_check(!rkey.busy_.exchange(true), "concurrent jobs on key " << _rjob.key_);
+                solid_check(rkey.next_ == _rjob.seq_, "out of order job on key " << _rjob.key_ << ": " << _rjob.seq_ << " != " << rkey.next_);
+                ++rkey.next_;
+                ++_rctx.count_;
+                ++handled_count;
+                rkey.busy_ = false;
+            },
+            static_cast<size_t>(0)};
+
+        auto producer_lambda = [job_count, key_count, &wp](const size_t _key_offset) {
+            for (size_t i = 0; i < job_count; ++i) {
+                const size_t key = _key_offset + (i % key_count);
+                wp.push(key, Job(key, i / key_count));
+            };
+        };
+
+        if (producer_count != 0) {
+            vector<thread> thr_vec;
+            thr_vec.reserve(producer_count);
+            for (int i = 0; i < producer_count; ++i) {
+                thr_vec.emplace_back(producer_lambda, i * key_count);
+            }
+            for (auto& t : thr_vec) {
+                t.join();
+            }
+        } else {
+            producer_lambda(0);
+        }
+    }
+
+    prom.set_value();
+    wait_thread.join();
+
+    const size_t expect_count = job_count * (producer_count == 0 ? 1 : producer_count);
+
+    solid_log(logger, Warning, "handled_count = " << handled_count << " expected = " << expect_count);
+    solid_check(expect_count == handled_count, expect_count << " != " << handled_count);
+    return 0;
+}
@@ -10,8 +10,10 @@
 
 #pragma once
 #define NOMINMAX
+#include <algorithm>
 #include <condition_variable>
 #include <functional>
+#include <iterator>
 #include <memory>
 #include <mutex>
 #include <queue>
@@ -144,6 +146,9 @@ class Queue {
         std::atomic<size_t> push_notif_;
         std::atomic<size_t> wait_pop_on_pos_;
         std::atomic<size_t> wait_pop_on_next_;
+        std::atomic<size_t> push_batch_count_;
+        std::atomic<size_t> pop_batch_count_;
+        std::atomic<size_t> try_push_fail_count_;
         Statistic()
             : push_count_(0)
             , push_node_count_(0)
@@ -155,6 +160,9 @@ class Queue {
             , push_notif_(0)
             , wait_pop_on_pos_(0)
             , wait_pop_on_next_(0)
+            , push_batch_count_(0)
+            , pop_batch_count_(0)
+            , try_push_fail_count_(0)
         {
         }
 
@@ -170,6 +178,9 @@ class Queue {
             _ros << " push_notif_ = " << push_notif_;
             _ros << " wait_pop_on_pos_ = " << wait_pop_on_pos_;
             _ros << " wait_pop_on_next_ = " << wait_pop_on_next_;
+            _ros << " push_batch_count_ = " << push_batch_count_;
+            _ros << " pop_batch_count_ = " << pop_batch_count_;
+            _ros << " try_push_fail_count_ = " << try_push_fail_count_;
             return _ros;
         }
     } statistic_;
@@ -203,8 +214,42 @@ public:
         return doPush(*pt, std::move(_rt), _max_queue_size, std::integral_constant<bool, false>());
     }
 
+    //! Non-blocking push
+    /*!
+     * Returns 0 and leaves _rt untouched if the queue holds at least
+     * _max_queue_size items (backpressure), otherwise the queue size.
+     */
+    size_t tryPush(const T& _rt, const size_t _max_queue_size)
+    {
+        T* pt = nullptr;
+        return doTryPush(_rt, std::move(*pt), _max_queue_size, std::integral_constant<bool, true>());
+    }
+
+    size_t tryPush(T&& _rt, const size_t _max_queue_size)
+    {
+        T* pt = nullptr;
+        return doTryPush(*pt, std::move(_rt), _max_queue_size, std::integral_constant<bool, false>());
+    }
+
+    //! Push a range of items, reserving node positions with one atomic per node
+    /*!
+     * Use std::make_move_iterator to move the items.
+     * Returns the queue size after the last item was pushed.
+     */
+    template <class It>
+    size_t pushBatch(It _first, It _last, const size_t _max_queue_size);
+
     bool pop(T& _rt, std::atomic<bool>& _running, const size_t _max_queue_size);
 
+    //! Pop at least one and at most _max_count items
+    /*!
+     * Waits like pop for the first item, then takes, without waiting, the
+     * already committed items of the current node with one atomic.
+     * Returns the number of items written to _out, 0 if stopped.
+     */
+    template <class OutIt>
+    size_t popBatch(OutIt _out, const size_t _max_count, std::atomic<bool>& _running, const size_t _max_queue_size);
+
     void wake()
     {
         pop_end_.condition_.notify_all();
@@ -276,6 +321,17 @@ private:
 
     template <bool IsCopy>
     size_t doPush(const T& _rt, T&& _ut, const size_t _max_queue_size, std::integral_constant<bool, IsCopy>);
+
+    template <bool IsCopy>
+    size_t doTryPush(const T& _rt, T&& _ut, const size_t _max_queue_size, std::integral_constant<bool, IsCopy>);
+
+    void doCommit(Node& _rn, const size_t _pos, const size_t _count);
+
+    bool doPushOverflow(Node* _pn, const size_t _max_queue_size, const bool _wait);
+
+    void doNotifyPopEnd();
+
+    void doNotifyPushEnd(const size_t _sz, const size_t _max_queue_size);
 };
 
 //-----------------------------------------------------------------------------
@@ -339,74 +395,177 @@ size_t Queue<T, NBits>::doPush(const T& _rt, T&& _ut, const size_t _max_queue_si
 
             const size_t sz = size_.fetch_add(1) + 1;
 
-            std::atomic_thread_fence(std::memory_order_release);
-
-            {
-                size_t crtpos = pos;
-                while (!pn->push_commit_pos_.compare_exchange_weak(crtpos, pos + 1, std::memory_order_relaxed, std::memory_order_relaxed)) {
-                    crtpos = pos;
-                    std::this_thread::yield();
-                }
-            }
+            doCommit(*pn, pos, 1);
             nodeRelease(pn, __LINE__);
 #ifdef SOLID_WP_PRINT
             if (pos == 0) {
                 printt(_rt, __LINE__, pn, 0);
             }
 #endif
-
-            const size_t pop_wait_cnt = pop_end_.wait_count_.load();
-
-            if (pop_wait_cnt != 0) {
-                {
-                    std::unique_lock<std::mutex> lock(pop_end_.mutex_);
-                }
-                solid_dbg(workpool_logger, Verbose, this << " pop_wait_cnt = " << pop_wait_cnt);
-                pop_end_.condition_.notify_all(); //see NOTE(*) below
-            }
+            doNotifyPopEnd();
 
             solid_statistic_inc(statistic_.push_count_);
             solid_dbg(workpool_logger, Verbose, this << " done push " << sz);
             return sz;
         } else {
-            //overflow
-            bool do_notify_pop_end = false;
-            {
-                std::unique_lock<std::mutex> lock(push_end_.mutex_);
+            doPushOverflow(pn, _max_queue_size, true);
+        }
+    } while (true);
+}
+//-----------------------------------------------------------------------------
+template <class T, unsigned NBits>
+template <bool IsCopy>
+size_t Queue<T, NBits>::doTryPush(const T& _rt, T&& _ut, const size_t _max_queue_size, std::integral_constant<bool, IsCopy> _is_copy)
+{
+    if (size_.load() >= _max_queue_size) {
+        solid_statistic_inc(statistic_.try_push_fail_count_);
+        return 0;
+    }
+    do {
+        Node*        pn  = pushNodeAcquire();
+        const size_t pos = pn->push_pos_.fetch_add(1);
 
-                if (size_.load() >= _max_queue_size) {
-                    push_end_.wait_count_.fetch_add(1);
-                    push_end_.condition_.wait(lock, [this, _max_queue_size]() { return size_.load() < _max_queue_size; });
-                    push_end_.wait_count_.fetch_sub(1);
-                }
+        if (pos < node_size) {
+            doCopyOrMove(*pn, pos, _rt, std::move(_ut), _is_copy);
+
+            const size_t sz = size_.fetch_add(1) + 1;
+
+            doCommit(*pn, pos, 1);
+            nodeRelease(pn, __LINE__);
+            doNotifyPopEnd();
 
-                //pn is locked!
-                //the following check is safe because push_end_.pnode_ is
-                //modified only under push_end_.mutex_ lock
-                if (push_end_.pnode_ == pn) {
-                    solid_dbg(workpool_logger, Verbose, this << " newNode");
-                    //ABA cannot happen because pn is locked and cannot be in the empty stack
-                    Node* pnewn = newNode();
-                    pnewn->use_cnt_.fetch_add(1); //one for ptmpn->next_
-                    Node* ptmpn = push_end_.nodeExchange(pnewn);
+            solid_statistic_inc(statistic_.push_count_);
+            return sz;
+        } else if (!doPushOverflow(pn, _max_queue_size, false)) {
+            //positions reserved past node_size are never used, nothing to undo
+            solid_statistic_inc(statistic_.try_push_fail_count_);
+            return 0;
+        }
+    } while (true);
+}
+//-----------------------------------------------------------------------------
+template <class T, unsigned NBits>
+template <class It>
+size_t Queue<T, NBits>::pushBatch(It _first, It _last, const size_t _max_queue_size)
+{
+    size_t sz = size_.load();
 
-                    ptmpn->next_.store(pnewn);
+    while (_first != _last) {
+        Node*        pn    = pushNodeAcquire();
+        const size_t count = std::distance(_first, _last);
+        const size_t pos   = pn->push_pos_.fetch_add(count);
 
-                    nodeRelease(ptmpn, __LINE__);
+        if (pos < node_size) {
+            //the positions past node_size are lost, the remaining items go to the next node
+            const size_t cnt = std::min(count, node_size - pos);
 
-                    do_notify_pop_end = pop_end_.wait_count_.load() != 0;
-                }
-                nodeRelease(pn, __LINE__);
+            for (size_t i = 0; i < cnt; ++i, ++_first) {
+                new (pn->data_ + ((pos + i) * sizeof(T))) T{*_first};
             }
-            if (do_notify_pop_end) {
-                {
-                    std::unique_lock<std::mutex> lock(pop_end_.mutex_);
-                }
-                pop_end_.condition_.notify_all(); //see NOTE(*) below
-                solid_statistic_inc(statistic_.pop_notif_);
+
+            sz = size_.fetch_add(cnt) + cnt;
+
+            doCommit(*pn, pos, cnt);
+            nodeRelease(pn, __LINE__);
+            doNotifyPopEnd();
+
+            solid_statistic_add(statistic_.push_count_, cnt);
+            solid_statistic_inc(statistic_.push_batch_count_);
+            solid_dbg(workpool_logger, Verbose, this << " done push batch " << cnt << ' ' << sz);
+        } else {
+            doPushOverflow(pn, _max_queue_size, true);
+        }
+    }
+    return sz;
+}
+//-----------------------------------------------------------------------------
+//NOTE(**) - a push commits only after all the positions before it are commited
+template <class T, unsigned NBits>
+void Queue<T, NBits>::doCommit(Node& _rn, const size_t _pos, const size_t _count)
+{
+    std::atomic_thread_fence(std::memory_order_release);
+
+    size_t crtpos = _pos;
+    while (!_rn.push_commit_pos_.compare_exchange_weak(crtpos, _pos + _count, std::memory_order_relaxed, std::memory_order_relaxed)) {
+        crtpos = _pos;
+        std::this_thread::yield();
+    }
+}
+//-----------------------------------------------------------------------------
+template <class T, unsigned NBits>
+void Queue<T, NBits>::doNotifyPopEnd()
+{
+    const size_t pop_wait_cnt = pop_end_.wait_count_.load();
+
+    if (pop_wait_cnt != 0) {
+        {
+            std::unique_lock<std::mutex> lock(pop_end_.mutex_);
+        }
+        solid_dbg(workpool_logger, Verbose, this << " pop_wait_cnt = " << pop_wait_cnt);
+        pop_end_.condition_.notify_all(); //see NOTE(*) below
+    }
+}
+//-----------------------------------------------------------------------------
+template <class T, unsigned NBits>
+void Queue<T, NBits>::doNotifyPushEnd(const size_t _sz, const size_t _max_queue_size)
+{
+    if (_sz < _max_queue_size && push_end_.wait_count_.load()) {
+        solid_dbg(workpool_logger, Verbose, this << " notify push - size = " << _sz << " wait_count = " << push_end_.wait_count_.load());
+        //we need the lock here in order to be certain that push threads
+        // are either waiting on push_end_.condition_ or have not yet read size_ value
+        {
+            std::lock_guard<std::mutex> lock(push_end_.mutex_);
+        }
+        push_end_.condition_.notify_one();
+        solid_statistic_inc(statistic_.push_notif_);
+    }
+}
+//-----------------------------------------------------------------------------
+//Called with _pn acquired when the node is full - releases _pn.
+//Returns false, without moving to a new node, if the queue is full and _wait is false.
+template <class T, unsigned NBits>
+bool Queue<T, NBits>::doPushOverflow(Node* _pn, const size_t _max_queue_size, const bool _wait)
+{
+    bool do_notify_pop_end = false;
+    {
+        std::unique_lock<std::mutex> lock(push_end_.mutex_);
+
+        if (size_.load() >= _max_queue_size) {
+            if (!_wait) {
+                nodeRelease(_pn, __LINE__);
+                return false;
             }
+            push_end_.wait_count_.fetch_add(1);
+            push_end_.condition_.wait(lock, [this, _max_queue_size]() { return size_.load() < _max_queue_size; });
+            push_end_.wait_count_.fetch_sub(1);
         }
-    } while (true);
+
+        //pn is locked!
+        //the following check is safe because push_end_.pnode_ is
+        //modified only under push_end_.mutex_ lock
+        if (push_end_.pnode_ == _pn) {
+            solid_dbg(workpool_logger, Verbose, this << " newNode");
+            //ABA cannot happen because pn is locked and cannot be in the empty stack
+            Node* pnewn = newNode();
+            pnewn->use_cnt_.fetch_add(1); //one for ptmpn->next_
+            Node* ptmpn = push_end_.nodeExchange(pnewn);
+
+            ptmpn->next_.store(pnewn);
+
+            nodeRelease(ptmpn, __LINE__);
+
+            do_notify_pop_end = pop_end_.wait_count_.load() != 0;
+        }
+        nodeRelease(_pn, __LINE__);
+    }
+    if (do_notify_pop_end) {
+        {
+            std::unique_lock<std::mutex> lock(pop_end_.mutex_);
+        }
+        pop_end_.condition_.notify_all(); //see NOTE(*) below
+        solid_statistic_inc(statistic_.pop_notif_);
+    }
+    return true;
 }
 //-----------------------------------------------------------------------------
 template <class T, unsigned NBits>
@@ -459,16 +618,7 @@ bool Queue<T, NBits>::pop(T& _rt, std::atomic<bool>& _running, const size_t _max
 #endif
             solid_check(sz < 10000000ULL);
             nodeRelease(pn, __LINE__);
-            if (sz < _max_queue_size && push_end_.wait_count_.load()) {
-                solid_dbg(workpool_logger, Verbose, this << " notify push - size = " << sz << " wait_count = " << push_end_.wait_count_.load());
-                //we need the lock here in order to be certain that push threads
-                // are either waiting on push_end_.condition_ or have not yet read size_ value
-                {
-                    std::lock_guard<std::mutex> lock(push_end_.mutex_);
-                }
-                push_end_.condition_.notify_one();
-                solid_statistic_inc(statistic_.push_notif_);
-            }
+            doNotifyPushEnd(sz, _max_queue_size);
             solid_statistic_inc(statistic_.pop_count_);
             solid_dbg(workpool_logger, Verbose, this << " done pop - pos = " << pos);
             return true;
@@ -505,6 +655,56 @@ bool Queue<T, NBits>::pop(T& _rt, std::atomic<bool>& _running, const size_t _max
 
     } while (true);
 }
+//-----------------------------------------------------------------------------
+template <class T, unsigned NBits>
+template <class OutIt>
+size_t Queue<T, NBits>::popBatch(OutIt _out, const size_t _max_count, std::atomic<bool>& _running, const size_t _max_queue_size)
+{
+    size_t count = 0;
+    {
+        T t;
+        if (_max_count == 0 || !pop(t, _running, _max_queue_size)) {
+            return 0;
+        }
+        *_out = std::move(t);
+        ++_out;
+        ++count;
+    }
+
+    while (count < _max_count) {
+        Node*  pn              = popNodeAquire();
+        size_t pos             = pn->pop_pos_.load();
+        size_t push_commit_pos = pn->push_commit_pos_.load(std::memory_order_relaxed);
+
+        if (pos >= push_commit_pos) {
+            //nothing committed past the reserved positions (or the node is exhausted)
+            nodeRelease(pn, __LINE__);
+            break;
+        }
+
+        const size_t cnt = std::min(push_commit_pos - pos, _max_count - count);
+
+        if (!pn->pop_pos_.compare_exchange_strong(pos, pos + cnt)) {
+            nodeRelease(pn, __LINE__);
+            continue;
+        }
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+
+        for (size_t i = 0; i < cnt; ++i, ++_out) {
+            *_out = std::move(pn->item(pos + i));
+        }
+        count += cnt;
+
+        const size_t sz = size_.fetch_sub(cnt) - cnt;
+
+        nodeRelease(pn, __LINE__);
+        doNotifyPushEnd(sz, _max_queue_size);
+        solid_statistic_add(statistic_.pop_count_, cnt);
+    }
+    solid_statistic_inc(statistic_.pop_batch_count_);
+    return count;
+}
 
 } //namespace thread_safe
 
@@ -635,11 +835,25 @@ public:
     template <class JT>
     void push(JT&& _jb);
 
+    //! Non-blocking push - returns false, leaving _jb untouched, if the job queue is full
+    bool tryPush(const Job& _jb);
+
+    bool tryPush(Job&& _jb);
+
+    //! Push a range of jobs with one queue reservation per queue node
+    /*!
+     * Use std::make_move_iterator to move the jobs.
+     */
+    template <class It>
+    void pushBatch(It _first, It _last);
+
     void dumpStatistics() const;
 
 private:
     bool pop(Job& _rjob);
 
+    void doGrow(const size_t _qsz);
+
     void doStart(size_t _start_wkr_cnt, WorkerFactoryT&& _uworker_factory_fnc);
 
     void doStop();
@@ -663,36 +877,62 @@ template <typename Job, size_t QNBits>
 template <class JT>
 void WorkPool<Job, QNBits>::push(const JT& _jb)
 {
-    const size_t qsz     = job_q_.push(_jb, config_.max_job_queue_size_);
-    const size_t thr_cnt = thr_cnt_.load();
-
-    if (thr_cnt < config_.max_worker_count_ && qsz > thr_cnt) {
-        std::lock_guard<std::mutex> lock(thr_mtx_);
-        if (qsz > thr_vec_.size() && thr_vec_.size() < config_.max_worker_count_) {
-            thr_vec_.emplace_back(worker_factory_fnc_());
-            ++thr_cnt_;
-            solid_statistic_max(statistic_.max_worker_count_, thr_vec_.size());
-        }
-    }
-    solid_statistic_max(statistic_.max_jobs_in_queue_, qsz);
+    doGrow(job_q_.push(_jb, config_.max_job_queue_size_));
 }
 //-----------------------------------------------------------------------------
 template <typename Job, size_t QNBits>
 template <class JT>
 void WorkPool<Job, QNBits>::push(JT&& _jb)
 {
-    const size_t qsz     = job_q_.push(std::move(_jb), config_.max_job_queue_size_);
+    doGrow(job_q_.push(std::move(_jb), config_.max_job_queue_size_));
+}
+//-----------------------------------------------------------------------------
+template <typename Job, size_t QNBits>
+bool WorkPool<Job, QNBits>::tryPush(const Job& _jb)
+{
+    const size_t qsz = job_q_.tryPush(_jb, config_.max_job_queue_size_);
+    if (qsz != 0) {
+        doGrow(qsz);
+        return true;
+    }
+    return false;
+}
+//-----------------------------------------------------------------------------
+template <typename Job, size_t QNBits>
+bool WorkPool<Job, QNBits>::tryPush(Job&& _jb)
+{
+    const size_t qsz = job_q_.tryPush(std::move(_jb), config_.max_job_queue_size_);
+    if (qsz != 0) {
+        doGrow(qsz);
+        return true;
+    }
+    return false;
+}
+//-----------------------------------------------------------------------------
+template <typename Job, size_t QNBits>
+template <class It>
+void WorkPool<Job, QNBits>::pushBatch(It _first, It _last)
+{
+    if (_first != _last) {
+        doGrow(job_q_.pushBatch(_first, _last, config_.max_job_queue_size_));
+    }
+}
+//-----------------------------------------------------------------------------
+template <typename Job, size_t QNBits>
+void WorkPool<Job, QNBits>::doGrow(const size_t _qsz)
+{
     const size_t thr_cnt = thr_cnt_.load();
 
-    if (thr_cnt < config_.max_worker_count_ && qsz > thr_cnt) {
+    if (thr_cnt < config_.max_worker_count_ && _qsz > thr_cnt) {
         std::lock_guard<std::mutex> lock(thr_mtx_);
-        if (qsz > thr_vec_.size() && thr_vec_.size() < config_.max_worker_count_) {
+        //a batch may need more than one new worker
+        while (_qsz > thr_vec_.size() && thr_vec_.size() < config_.max_worker_count_) {
             thr_vec_.emplace_back(worker_factory_fnc_());
             ++thr_cnt_;
             solid_statistic_max(statistic_.max_worker_count_, thr_vec_.size());
         }
     }
-    solid_statistic_max(statistic_.max_jobs_in_queue_, qsz);
+    solid_statistic_max(statistic_.max_jobs_in_queue_, _qsz);
 }
 //-----------------------------------------------------------------------------
 template <typename Job, size_t QNBits>
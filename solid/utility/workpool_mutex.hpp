@@ -154,9 +154,23 @@ public:
     template <class JT>
     void push(JT&& _jb);
 
+    //! Non-blocking push - returns false, leaving _jb untouched, if the job queue is full
+    bool tryPush(const Job& _jb);
+
+    bool tryPush(Job&& _jb);
+
+    //! Push a range of jobs under a single lock acquisition (while not full)
+    /*!
+     * Use std::make_move_iterator to move the jobs.
+     */
+    template <class It>
+    void pushBatch(It _first, It _last);
+
 private:
     bool doWaitJob(std::unique_lock<std::mutex>& _lock);
 
+    void doGrow(const size_t _qsz);
+
     bool pop(Job& _rjob);
 
     void doStart(size_t _start_wkr_cnt, WorkerFactoryT&& _uworker_factory_fnc);
@@ -251,6 +265,84 @@ void WorkPool<Job, QNBits>::push(JT&& _jb)
 }
 //-----------------------------------------------------------------------------
 template <typename Job, size_t QNBits>
+bool WorkPool<Job, QNBits>::tryPush(const Job& _jb)
+{
+    size_t qsz;
+    {
+        std::unique_lock<std::mutex> lock(mtx_);
+
+        if (job_q_.size() >= config_.max_job_queue_size_) {
+            return false;
+        }
+        job_q_.push(_jb);
+        qsz = job_q_.size();
+    }
+    sig_cnd_.notify_one();
+    doGrow(qsz);
+    return true;
+}
+//-----------------------------------------------------------------------------
+template <typename Job, size_t QNBits>
+bool WorkPool<Job, QNBits>::tryPush(Job&& _jb)
+{
+    size_t qsz;
+    {
+        std::unique_lock<std::mutex> lock(mtx_);
+
+        if (job_q_.size() >= config_.max_job_queue_size_) {
+            return false;
+        }
+        job_q_.push(std::move(_jb));
+        qsz = job_q_.size();
+    }
+    sig_cnd_.notify_one();
+    doGrow(qsz);
+    return true;
+}
+//-----------------------------------------------------------------------------
+template <typename Job, size_t QNBits>
+template <class It>
+void WorkPool<Job, QNBits>::pushBatch(It _first, It _last)
+{
+    while (_first != _last) {
+        size_t qsz;
+        {
+            std::unique_lock<std::mutex> lock(mtx_);
+
+            while (job_q_.size() >= config_.max_job_queue_size_) {
+                sig_cnd_.wait(lock);
+            }
+
+            do {
+                job_q_.push(*_first);
+                ++_first;
+            } while (_first != _last && job_q_.size() < config_.max_job_queue_size_);
+
+            qsz = job_q_.size();
+        }
+
+        sig_cnd_.notify_all();
+        doGrow(qsz);
+    }
+}
+//-----------------------------------------------------------------------------
+template <typename Job, size_t QNBits>
+void WorkPool<Job, QNBits>::doGrow(const size_t _qsz)
+{
+    const size_t thr_cnt = thr_cnt_.load();
+
+    if (thr_cnt < config_.max_worker_count_ && _qsz > thr_cnt) {
+        std::lock_guard<std::mutex> lock(thr_mtx_);
+        while (_qsz > thr_vec_.size() && thr_vec_.size() < config_.max_worker_count_) {
+            thr_vec_.emplace_back(worker_factory_fnc_());
+            ++thr_cnt_;
+            solid_statistic_max(statistic_.max_worker_count_, thr_vec_.size());
+        }
+    }
+    solid_statistic_max(statistic_.max_jobs_in_queue_, _qsz);
+}
+//-----------------------------------------------------------------------------
+template <typename Job, size_t QNBits>
 bool WorkPool<Job, QNBits>::doWaitJob(std::unique_lock<std::mutex>& _lock)
 {
     while (job_q_.empty() && running_.load(std::memory_order_relaxed)) {
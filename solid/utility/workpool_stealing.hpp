@@ -0,0 +1,625 @@
+// solid/utility/workpool_stealing.hpp
+//
+// Copyright (c) 2018 Valentin Palade (vipalade @ gmail . com)
+//
+// This file is part of SolidFrame framework.
+//
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt.
+//
+
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "solid/system/exception.hpp"
+#include "solid/system/log.hpp"
+#include "solid/system/statistic.hpp"
+#include "solid/utility/common.hpp"
+#include "solid/utility/functiontraits.hpp"
+#include "solid/utility/queue.hpp"
+#include "solid/utility/workpool.hpp"
+
+namespace solid {
+
+//-----------------------------------------------------------------------------
+//-----------------------------------------------------------------------------
+namespace thread_safe {
+
+//! Chase-Lev work-stealing deque of pointers with fixed capacity
+/*!
+ * One owner thread pushes and pops at the bottom (LIFO),
+ * any number of thief threads steal from the top (FIFO).
+ * The items are pointers so that a thief never reads a slot
+ * that the owner may be overwriting.
+ */
+template <class T, unsigned NBits = 10>
+class StealingDeque {
+    static constexpr const size_t node_mask = bits_to_mask(NBits);
+    static constexpr const size_t node_size = bits_to_count(NBits);
+    static constexpr const size_t line_size = 64;
+    using SlotT                             = std::atomic<T*>;
+
+    //An index alone on its cache line, wherever the deque is placed.
+    //Padding rather than alignas(64): the deques are heap allocated and
+    //operator new, before C++17, only honours alignof(std::max_align_t).
+    struct Index {
+        char                 head_pad_[line_size - sizeof(std::atomic<int64_t>)];
+        std::atomic<int64_t> value_;
+        char                 tail_pad_[line_size - sizeof(std::atomic<int64_t>)];
+    };
+
+    Index top_;
+    Index bottom_;
+    SlotT slots_[node_size];
+
+public:
+    static constexpr size_t capacity()
+    {
+        return node_size;
+    }
+
+    StealingDeque()
+    {
+        top_.value_.store(0, std::memory_order_relaxed);
+        bottom_.value_.store(0, std::memory_order_relaxed);
+        for (auto& slot : slots_) {
+            slot.store(nullptr, std::memory_order_relaxed);
+        }
+    }
+
+    StealingDeque(const StealingDeque&) = delete;
+    StealingDeque& operator=(const StealingDeque&) = delete;
+
+    //! Owner only - returns false if the deque is full
+    bool push(T* _pt)
+    {
+        const int64_t b = bottom_.value_.load(std::memory_order_relaxed);
+        const int64_t t = top_.value_.load(std::memory_order_acquire);
+
+        if (static_cast<size_t>(b - t) >= node_size) {
+            return false;
+        }
+        slots_[static_cast<size_t>(b) & node_mask].store(_pt, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        bottom_.value_.store(b + 1, std::memory_order_relaxed);
+        return true;
+    }
+
+    //! Owner only - returns nullptr if the deque is empty
+    T* pop()
+    {
+        const int64_t b = bottom_.value_.load(std::memory_order_relaxed) - 1;
+        bottom_.value_.store(b, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t t = top_.value_.load(std::memory_order_relaxed);
+
+        if (t <= b) {
+            T* pt = slots_[static_cast<size_t>(b) & node_mask].load(std::memory_order_relaxed);
+            if (t == b) {
+                //last item - race against thieves
+                if (!top_.value_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+                    pt = nullptr;
+                }
+                bottom_.value_.store(b + 1, std::memory_order_relaxed);
+            }
+            return pt;
+        }
+        bottom_.value_.store(b + 1, std::memory_order_relaxed);
+        return nullptr;
+    }
+
+    //! Any thread - returns nullptr if the deque is empty or the steal lost a race
+    T* steal()
+    {
+        int64_t t = top_.value_.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        const int64_t b = bottom_.value_.load(std::memory_order_acquire);
+
+        if (t < b) {
+            T* pt = slots_[static_cast<size_t>(t) & node_mask].load(std::memory_order_relaxed);
+            if (top_.value_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+                return pt;
+            }
+        }
+        return nullptr;
+    }
+
+    bool empty() const
+    {
+        return bottom_.value_.load(std::memory_order_acquire) <= top_.value_.load(std::memory_order_acquire);
+    }
+};
+
+} //namespace thread_safe
+
+//-----------------------------------------------------------------------------
+//! Pool of threads handling Jobs, with per worker deques and work stealing
+/*!
+ * Same construct-start, destruct-stop interface as WorkPool.
+ *
+ * Differences from WorkPool
+ *  * Jobs pushed from one of the pool's own workers go to that worker's
+ *      local deque (LIFO) and are not subject to max_job_queue_size_, so a
+ *      job can never block on the pool it runs on.
+ *  * Jobs pushed from outside go to a shared injection queue and block
+ *      while max_job_queue_size_ jobs are pending.
+ *  * Idle workers take from the injection queue, then steal from random
+ *      victims, spin for a while and only then park.
+ *  * Any worker can handle any job, so a push wakes at most one parked
+ *      worker (notify_one) instead of all of them.
+ */
+template <typename Job, size_t DequeNBits = 10>
+class StealingWorkPool {
+    using ThisT          = StealingWorkPool<Job, DequeNBits>;
+    using WorkerFactoryT = std::function<std::thread(size_t)>;
+    using ThreadVectorT  = std::vector<std::thread>;
+    using DequeT         = thread_safe::StealingDeque<Job, DequeNBits>;
+    using JobQueueT      = Queue<Job*>;
+    using AtomicBoolT    = std::atomic<bool>;
+
+    struct Worker {
+        DequeT deque_;
+    };
+
+    using WorkerPointerT  = std::unique_ptr<Worker>;
+    using WorkerVectorT   = std::vector<WorkerPointerT>;
+    using LocalWorkerPair = std::pair<const ThisT*, Worker*>;
+
+    static constexpr const size_t spin_count  = 64;
+    static constexpr const size_t steal_count = 4;
+
+    const WorkPoolConfiguration config_;
+    AtomicBoolT                 running_;
+    std::atomic<size_t>         thr_cnt_;
+    std::atomic<size_t>         pending_cnt_;
+    std::atomic<size_t>         park_cnt_;
+    std::atomic<size_t>         push_wait_cnt_;
+    WorkerFactoryT              worker_factory_fnc_;
+    WorkerVectorT               wkr_vec_;
+    JobQueueT                   inject_q_;
+    std::mutex                  inject_mtx_;
+    std::mutex                  park_mtx_;
+    std::condition_variable     park_cnd_;
+    std::mutex                  push_mtx_;
+    std::condition_variable     push_cnd_;
+    ThreadVectorT               thr_vec_;
+    std::mutex                  thr_mtx_;
+#ifdef SOLID_HAS_STATISTICS
+    struct Statistic : solid::Statistic {
+        std::atomic<size_t>   max_worker_count_;
+        std::atomic<size_t>   max_jobs_in_queue_;
+        std::atomic<uint64_t> max_jobs_on_thread_;
+        std::atomic<uint64_t> min_jobs_on_thread_;
+        std::atomic<size_t>   local_push_count_;
+        std::atomic<size_t>   inject_push_count_;
+        std::atomic<size_t>   steal_count_;
+        std::atomic<size_t>   park_count_;
+        std::atomic<size_t>   wake_count_;
+
+        Statistic()
+            : max_worker_count_(0)
+            , max_jobs_in_queue_(0)
+            , max_jobs_on_thread_(0)
+            , min_jobs_on_thread_(-1)
+            , local_push_count_(0)
+            , inject_push_count_(0)
+            , steal_count_(0)
+            , park_count_(0)
+            , wake_count_(0)
+        {
+        }
+
+        std::ostream& print(std::ostream& _ros) const override
+        {
+            _ros << " max_worker_count_ = " << max_worker_count_;
+            _ros << " max_jobs_in_queue_ = " << max_jobs_in_queue_;
+            _ros << " max_jobs_on_thread_ = " << max_jobs_on_thread_;
+            _ros << " min_jobs_on_thread_ = " << min_jobs_on_thread_;
+            _ros << " local_push_count_ = " << local_push_count_;
+            _ros << " inject_push_count_ = " << inject_push_count_;
+            _ros << " steal_count_ = " << steal_count_;
+            _ros << " park_count_ = " << park_count_;
+            _ros << " wake_count_ = " << wake_count_;
+            return _ros;
+        }
+    } statistic_;
+#endif
+public:
+    template <class JobHandleFnc, typename... Args>
+    StealingWorkPool(
+        const size_t                 _start_wkr_cnt,
+        const WorkPoolConfiguration& _cfg,
+        JobHandleFnc                 _job_handler_fnc,
+        Args... _args)
+        : config_(_cfg)
+        , running_(true)
+        , thr_cnt_(0)
+        , pending_cnt_(0)
+        , park_cnt_(0)
+        , push_wait_cnt_(0)
+    {
+        doStart(
+            std::integral_constant<size_t, function_traits<JobHandleFnc>::arity>(),
+            _start_wkr_cnt,
+            _job_handler_fnc,
+            _args...);
+    }
+
+    template <class JobHandleFnc, typename... Args>
+    StealingWorkPool(
+        const WorkPoolConfiguration& _cfg,
+        JobHandleFnc                 _job_handler_fnc,
+        Args... _args)
+        : config_(_cfg)
+        , running_(true)
+        , thr_cnt_(0)
+        , pending_cnt_(0)
+        , park_cnt_(0)
+        , push_wait_cnt_(0)
+    {
+        doStart(
+            std::integral_constant<size_t, function_traits<JobHandleFnc>::arity>(),
+            0,
+            _job_handler_fnc,
+            _args...);
+    }
+
+    StealingWorkPool(const StealingWorkPool&) = delete;
+    StealingWorkPool& operator=(const StealingWorkPool&) = delete;
+
+    ~StealingWorkPool()
+    {
+        doStop();
+        solid_dbg(workpool_logger, Verbose, this);
+    }
+
+    template <class JT>
+    void push(const JT& _jb)
+    {
+        doPush(new Job(_jb));
+    }
+
+    template <class JT>
+    void push(JT&& _jb)
+    {
+        doPush(new Job(std::forward<JT>(_jb)));
+    }
+
+    void dumpStatistics() const;
+
+private:
+    static LocalWorkerPair& localWorker()
+    {
+        static thread_local LocalWorkerPair local_worker{nullptr, nullptr};
+        return local_worker;
+    }
+
+    void doPush(Job* _pjob);
+
+    void doPushInject(Job* _pjob);
+
+    void doWake();
+
+    Job* pop(Worker& _rworker, std::minstd_rand& _rrand);
+
+    Job* tryPop(Worker& _rworker, std::minstd_rand& _rrand);
+
+    void doStart(size_t _start_wkr_cnt, WorkerFactoryT&& _uworker_factory_fnc);
+
+    void doStop();
+
+    template <class JobHandlerFnc>
+    void doStart(
+        std::integral_constant<size_t, 1>,
+        const size_t  _start_wkr_cnt,
+        JobHandlerFnc _job_handler_fnc);
+
+    template <class JobHandlerFnc, typename... Args>
+    void doStart(
+        std::integral_constant<size_t, 2>,
+        const size_t  _start_wkr_cnt,
+        JobHandlerFnc _job_handler_fnc,
+        Args... _args);
+
+    template <class WorkerFnc>
+    void doRun(const size_t _idx, WorkerFnc _worker_fnc);
+}; //StealingWorkPool
+
+//-----------------------------------------------------------------------------
+template <typename Job, size_t DequeNBits>
+void StealingWorkPool<Job, DequeNBits>::doPush(Job* _pjob)
+{
+    const LocalWorkerPair& rlocal   = localWorker();
+    const bool             is_local = rlocal.first == this;
+
+    if (!is_local && pending_cnt_.load() >= config_.max_job_queue_size_) {
+        std::unique_lock<std::mutex> lock(push_mtx_);
+        push_wait_cnt_.fetch_add(1);
+        push_cnd_.wait(lock, [this]() { return pending_cnt_.load() < config_.max_job_queue_size_; });
+        push_wait_cnt_.fetch_sub(1);
+    }
+
+    //count the job before publishing it so that a thief never decrements below zero
+    const size_t qsz = pending_cnt_.fetch_add(1) + 1;
+
+    if (is_local && rlocal.second->deque_.push(_pjob)) {
+        solid_statistic_inc(statistic_.local_push_count_);
+    } else {
+        doPushInject(_pjob);
+        solid_statistic_inc(statistic_.inject_push_count_);
+    }
+
+    doWake();
+
+    const size_t thr_cnt = thr_cnt_.load();
+
+    if (thr_cnt < config_.max_worker_count_ && qsz > thr_cnt) {
+        //try_lock: workers may push while doStop holds thr_mtx_ joining them
+        std::unique_lock<std::mutex> lock(thr_mtx_, std::try_to_lock);
+        if (lock.owns_lock() && running_.load() && qsz > thr_vec_.size() && thr_vec_.size() < config_.max_worker_count_) {
+            thr_vec_.emplace_back(worker_factory_fnc_(thr_vec_.size()));
+            ++thr_cnt_;
+            solid_statistic_max(statistic_.max_worker_count_, thr_vec_.size());
+        }
+    }
+    solid_statistic_max(statistic_.max_jobs_in_queue_, qsz);
+}
+//-----------------------------------------------------------------------------
+template <typename Job, size_t DequeNBits>
+void StealingWorkPool<Job, DequeNBits>::doPushInject(Job* _pjob)
+{
+    std::lock_guard<std::mutex> lock(inject_mtx_);
+    inject_q_.push(_pjob);
+}
+//-----------------------------------------------------------------------------
+//NOTE:
+//      pending_cnt_ is incremented before park_cnt_ is read, while a parking
+//      worker increments park_cnt_ before reading pending_cnt_ (both seq_cst),
+//      so at least one of them sees the other. Locking park_mtx_ ensures the
+//      parking worker is either waiting or has not yet checked its predicate.
+template <typename Job, size_t DequeNBits>
+void StealingWorkPool<Job, DequeNBits>::doWake()
+{
+    if (park_cnt_.load() != 0) {
+        {
+            std::lock_guard<std::mutex> lock(park_mtx_);
+        }
+        park_cnd_.notify_one();
+        solid_statistic_inc(statistic_.wake_count_);
+    }
+}
+//-----------------------------------------------------------------------------
+template <typename Job, size_t DequeNBits>
+Job* StealingWorkPool<Job, DequeNBits>::tryPop(Worker& _rworker, std::minstd_rand& _rrand)
+{
+    Job* pjob = _rworker.deque_.pop();
+
+    if (pjob == nullptr) {
+        std::lock_guard<std::mutex> lock(inject_mtx_);
+        if (!inject_q_.empty()) {
+            pjob = inject_q_.front();
+            inject_q_.pop();
+        }
+    }
+
+    if (pjob == nullptr) {
+        const size_t thr_cnt = thr_cnt_.load();
+        for (size_t i = 0; i < steal_count * thr_cnt && pjob == nullptr; ++i) {
+            Worker& rvictim = *wkr_vec_[_rrand() % thr_cnt];
+            if (&rvictim != &_rworker) {
+                pjob = rvictim.deque_.steal();
+            }
+        }
+        if (pjob != nullptr) {
+            solid_statistic_inc(statistic_.steal_count_);
+        }
+    }
+
+    if (pjob != nullptr) {
+        const size_t sz = pending_cnt_.fetch_sub(1) - 1;
+        if (sz < config_.max_job_queue_size_ && push_wait_cnt_.load() != 0) {
+            {
+                std::lock_guard<std::mutex> lock(push_mtx_);
+            }
+            push_cnd_.notify_one();
+        }
+    }
+    return pjob;
+}
+//-----------------------------------------------------------------------------
+template <typename Job, size_t DequeNBits>
+Job* StealingWorkPool<Job, DequeNBits>::pop(Worker& _rworker, std::minstd_rand& _rrand)
+{
+    do {
+        for (size_t i = 0; i < spin_count; ++i) {
+            Job* pjob = tryPop(_rworker, _rrand);
+            if (pjob != nullptr) {
+                return pjob;
+            }
+            if (pending_cnt_.load() == 0) {
+                if (!running_.load()) {
+                    return nullptr;
+                }
+                std::this_thread::yield();
+            }
+        }
+
+        std::unique_lock<std::mutex> lock(park_mtx_);
+
+        park_cnt_.fetch_add(1);
+        park_cnd_.wait(lock, [this]() { return pending_cnt_.load() != 0 || !running_.load(); });
+        park_cnt_.fetch_sub(1);
+        solid_statistic_inc(statistic_.park_count_);
+    } while (true);
+}
+//-----------------------------------------------------------------------------
+template <typename Job, size_t DequeNBits>
+void StealingWorkPool<Job, DequeNBits>::doStart(size_t _start_wkr_cnt, WorkerFactoryT&& _uworker_factory_fnc)
+{
+    solid_dbg(workpool_logger, Verbose, this << " start " << _start_wkr_cnt << " " << config_.max_worker_count_ << ' ' << config_.max_job_queue_size_);
+    if (_start_wkr_cnt > config_.max_worker_count_) {
+        _start_wkr_cnt = config_.max_worker_count_;
+    }
+
+    //all the deques are created upfront so that thieves can index them without locking
+    wkr_vec_.reserve(config_.max_worker_count_);
+    for (size_t i = 0; i < config_.max_worker_count_; ++i) {
+        wkr_vec_.emplace_back(new Worker);
+    }
+
+    worker_factory_fnc_ = std::move(_uworker_factory_fnc);
+
+    {
+        std::unique_lock<std::mutex> lock(thr_mtx_);
+
+        for (size_t i = 0; i < _start_wkr_cnt; ++i) {
+            thr_vec_.emplace_back(worker_factory_fnc_(thr_vec_.size()));
+            ++thr_cnt_;
+            solid_statistic_max(statistic_.max_worker_count_, thr_vec_.size());
+        }
+    }
+}
+//-----------------------------------------------------------------------------
+template <typename Job, size_t DequeNBits>
+void StealingWorkPool<Job, DequeNBits>::doStop()
+{
+    bool expect = true;
+
+    if (running_.compare_exchange_strong(expect, false)) {
+    } else {
+        solid_assert(false); //doStop called multiple times
+        return;
+    }
+    {
+        std::unique_lock<std::mutex> lock(thr_mtx_);
+        {
+            std::lock_guard<std::mutex> lock(park_mtx_);
+        }
+        park_cnd_.notify_all();
+
+        for (auto& t : thr_vec_) {
+            t.join();
+        }
+        thr_vec_.clear();
+    }
+    solid_check(pending_cnt_.load() == 0, "pending jobs = " << pending_cnt_.load());
+    dumpStatistics();
+}
+//-----------------------------------------------------------------------------
+//NOTE:
+//      A worker exits only when the pool is stopping and there are no pending
+//      jobs left, so jobs in its own deque are either handled by itself or
+//      stolen by other workers before it returns.
+template <typename Job, size_t DequeNBits>
+template <class WorkerFnc>
+void StealingWorkPool<Job, DequeNBits>::doRun(const size_t _idx, WorkerFnc _worker_fnc)
+{
+    Worker&          rworker = *wkr_vec_[_idx];
+    std::minstd_rand rand(static_cast<std::minstd_rand::result_type>(_idx + 1));
+    uint64_t         job_count = 0;
+    Job*             pjob;
+
+    localWorker() = LocalWorkerPair(this, &rworker);
+
+    while ((pjob = pop(rworker, rand)) != nullptr) {
+        std::unique_ptr<Job> job_ptr(pjob);
+        _worker_fnc(*job_ptr);
+        solid_statistic_inc(job_count);
+    }
+
+    localWorker() = LocalWorkerPair(nullptr, nullptr);
+
+    solid_dbg(workpool_logger, Verbose, this << " worker exited after handling " << job_count << " jobs");
+    solid_statistic_max(statistic_.max_jobs_on_thread_, job_count);
+    solid_statistic_min(statistic_.min_jobs_on_thread_, job_count);
+}
+//-----------------------------------------------------------------------------
+template <typename Job, size_t DequeNBits>
+template <class JobHandlerFnc>
+void StealingWorkPool<Job, DequeNBits>::doStart(
+    std::integral_constant<size_t, 1>,
+    const size_t  _start_wkr_cnt,
+    JobHandlerFnc _job_handler_fnc)
+{
+    WorkerFactoryT worker_factory_fnc = [_job_handler_fnc, this](const size_t _idx) {
+        return std::thread(
+            [this, _idx](JobHandlerFnc _job_handler_fnc) {
+                doRun(_idx, [&_job_handler_fnc](Job& _rjob) { _job_handler_fnc(_rjob); });
+            },
+            _job_handler_fnc);
+    };
+
+    doStart(_start_wkr_cnt, std::move(worker_factory_fnc));
+}
+//-----------------------------------------------------------------------------
+template <typename Job, size_t DequeNBits>
+template <class JobHandlerFnc, typename... Args>
+void StealingWorkPool<Job, DequeNBits>::doStart(
+    std::integral_constant<size_t, 2>,
+    const size_t  _start_wkr_cnt,
+    JobHandlerFnc _job_handler_fnc,
+    Args... _args)
+{
+    WorkerFactoryT worker_factory_fnc = [_job_handler_fnc, this, _args...](const size_t _idx) {
+        return std::thread(
+            [this, _idx](JobHandlerFnc _job_handler_fnc, Args&&... _args) {
+                using SecondArgumentT = typename function_traits<JobHandlerFnc>::template argument<1>;
+                using ContextT        = typename std::remove_cv<typename std::remove_reference<SecondArgumentT>::type>::type;
+
+                ContextT ctx{std::forward<Args>(_args)...};
+
+                doRun(_idx, [&_job_handler_fnc, &ctx](Job& _rjob) { _job_handler_fnc(_rjob, std::ref(ctx)); });
+            },
+            _job_handler_fnc,
+            _args...);
+    };
+
+    doStart(_start_wkr_cnt, std::move(worker_factory_fnc));
+}
+//-----------------------------------------------------------------------------
+template <typename Job, size_t DequeNBits>
+void StealingWorkPool<Job, DequeNBits>::dumpStatistics() const
+{
+#ifdef SOLID_HAS_STATISTICS
+    solid_log(workpool_logger, Statistic, "StealingWorkpool " << this << " statistic:" << this->statistic_);
+#endif
+}
+
+//-----------------------------------------------------------------------------
+//-----------------------------------------------------------------------------
+
+struct FunctionStealingWorkPool : StealingWorkPool<std::function<void()>> {
+    using WorkPoolT = StealingWorkPool<std::function<void()>>;
+    FunctionStealingWorkPool(
+        const size_t                 _start_wkr_cnt,
+        const WorkPoolConfiguration& _cfg)
+        : WorkPoolT(
+              _start_wkr_cnt,
+              _cfg,
+              [](std::function<void()>& _rfnc) {
+                  _rfnc();
+              })
+    {
+    }
+
+    FunctionStealingWorkPool(
+        const WorkPoolConfiguration& _cfg)
+        : WorkPoolT(
+              0,
+              _cfg,
+              [](std::function<void()>& _rfnc) {
+                  _rfnc();
+              })
+    {
+    }
+};
+
+} //namespace solid
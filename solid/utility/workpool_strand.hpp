@@ -0,0 +1,289 @@
+// solid/utility/workpool_strand.hpp
+//
+// Copyright (c) 2018 Valentin Palade (vipalade @ gmail . com)
+//
+// This file is part of SolidFrame framework.
+//
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt.
+//
+
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <type_traits>
+#include <unordered_map>
+
+#include "solid/system/exception.hpp"
+#include "solid/system/log.hpp"
+#include "solid/system/statistic.hpp"
+#include "solid/utility/common.hpp"
+#include "solid/utility/functiontraits.hpp"
+#include "solid/utility/queue.hpp"
+#include "solid/utility/workpool.hpp"
+
+namespace solid {
+
+//-----------------------------------------------------------------------------
+//! Pool of threads handling Jobs serialized per Key
+/*!
+ * Jobs pushed with the same key are handled in FIFO order and never
+ * concurrently, while jobs with different keys are handled in parallel.
+ *
+ * Every key with queued jobs has a strand, which exists only while it has
+ * jobs. The underlying WorkPool only receives strands, at most one entry
+ * per strand at a time, so a worker never blocks waiting for a key held
+ * by another worker.
+ * A worker handles at most strand_batch_count jobs of a strand before
+ * giving other strands a chance.
+ *
+ * The underlying WorkPool queue is unbounded (it holds at most one entry
+ * per active key); max_job_queue_size_ bounds the total number of pending
+ * jobs and blocks push accordingly.
+ */
+template <typename Key, typename Job, class Hash = std::hash<Key>, size_t StripeNBits = 4>
+class StrandWorkPool {
+    static constexpr const size_t stripe_mask        = bits_to_mask(StripeNBits);
+    static constexpr const size_t stripe_count       = bits_to_count(StripeNBits);
+    static constexpr const size_t strand_batch_count = 16;
+
+    struct Strand;
+
+    using ThisT      = StrandWorkPool<Key, Job, Hash, StripeNBits>;
+    using StrandMapT = std::unordered_map<Key, Strand, Hash>;
+    using JobQueueT  = Queue<Job>;
+    using WorkPoolT  = WorkPool<Strand*>;
+
+    struct Strand {
+        JobQueueT job_q_;
+        Key       key_;
+
+        Strand(const Key& _key)
+            : key_(_key)
+        {
+        }
+    };
+
+    struct Stripe {
+        std::mutex mutex_;
+        StrandMapT strand_map_;
+    };
+
+    const WorkPoolConfiguration config_;
+    Hash                        hash_;
+    Stripe                      stripes_[stripe_count];
+    std::atomic<size_t>         pending_cnt_;
+    std::atomic<size_t>         push_wait_cnt_;
+    std::mutex                  push_mtx_;
+    std::condition_variable     push_cnd_;
+#ifdef SOLID_HAS_STATISTICS
+    struct Statistic : solid::Statistic {
+        std::atomic<size_t> max_pending_jobs_;
+        std::atomic<size_t> strand_create_count_;
+        std::atomic<size_t> strand_reschedule_count_;
+
+        Statistic()
+            : max_pending_jobs_(0)
+            , strand_create_count_(0)
+            , strand_reschedule_count_(0)
+        {
+        }
+
+        std::ostream& print(std::ostream& _ros) const override
+        {
+            _ros << " max_pending_jobs_ = " << max_pending_jobs_;
+            _ros << " strand_create_count_ = " << strand_create_count_;
+            _ros << " strand_reschedule_count_ = " << strand_reschedule_count_;
+            return _ros;
+        }
+    } statistic_;
+#endif
+    //must be the last member: it is destroyed first, joining the workers
+    WorkPoolT wp_;
+
+public:
+    template <class JobHandleFnc, typename... Args>
+    StrandWorkPool(
+        const size_t                 _start_wkr_cnt,
+        const WorkPoolConfiguration& _cfg,
+        JobHandleFnc                 _job_handler_fnc,
+        Args... _args)
+        : config_(_cfg)
+        , pending_cnt_(0)
+        , push_wait_cnt_(0)
+        , wp_(
+              _start_wkr_cnt,
+              WorkPoolConfiguration(_cfg.max_worker_count_),
+              makeHandler(std::integral_constant<size_t, function_traits<JobHandleFnc>::arity>(), _job_handler_fnc),
+              _args...)
+    {
+    }
+
+    template <class JobHandleFnc, typename... Args>
+    StrandWorkPool(
+        const WorkPoolConfiguration& _cfg,
+        JobHandleFnc                 _job_handler_fnc,
+        Args... _args)
+        : StrandWorkPool(0, _cfg, _job_handler_fnc, _args...)
+    {
+    }
+
+    ~StrandWorkPool()
+    {
+        //wait for all jobs so that no strand is rescheduled while wp_ stops
+        {
+            std::unique_lock<std::mutex> lock(push_mtx_);
+            push_wait_cnt_.fetch_add(1);
+            push_cnd_.wait(lock, [this]() { return pending_cnt_.load() == 0; });
+            push_wait_cnt_.fetch_sub(1);
+        }
+        solid_dbg(workpool_logger, Verbose, this);
+    }
+
+    template <class JT>
+    void push(const Key& _key, JT&& _jb);
+
+    void dumpStatistics() const;
+
+private:
+    Stripe& stripe(const Key& _key)
+    {
+        return stripes_[hash_(_key) & stripe_mask];
+    }
+
+    template <class JobHandlerFnc>
+    auto makeHandler(std::integral_constant<size_t, 1>, JobHandlerFnc _job_handler_fnc)
+    {
+        return [this, _job_handler_fnc](Strand* _pstrand) mutable {
+            doRun(*_pstrand, _job_handler_fnc);
+        };
+    }
+
+    template <class JobHandlerFnc>
+    auto makeHandler(std::integral_constant<size_t, 2>, JobHandlerFnc _job_handler_fnc)
+    {
+        using SecondArgumentT = typename function_traits<JobHandlerFnc>::template argument<1>;
+        using ContextT        = typename std::remove_cv<typename std::remove_reference<SecondArgumentT>::type>::type;
+
+        return [this, _job_handler_fnc](Strand* _pstrand, ContextT& _rctx) mutable {
+            doRun(*_pstrand, [&_job_handler_fnc, &_rctx](Job& _rjob) { _job_handler_fnc(_rjob, _rctx); });
+        };
+    }
+
+    template <class Fnc>
+    void doRun(Strand& _rstrand, Fnc&& _fnc);
+
+    Job doPop(Stripe& _rstripe, Strand& _rstrand);
+
+    void doJobDone();
+}; //StrandWorkPool
+
+//-----------------------------------------------------------------------------
+template <typename Key, typename Job, class Hash, size_t StripeNBits>
+template <class JT>
+void StrandWorkPool<Key, Job, Hash, StripeNBits>::push(const Key& _key, JT&& _jb)
+{
+    if (pending_cnt_.load() >= config_.max_job_queue_size_) {
+        std::unique_lock<std::mutex> lock(push_mtx_);
+        push_wait_cnt_.fetch_add(1);
+        push_cnd_.wait(lock, [this]() { return pending_cnt_.load() < config_.max_job_queue_size_; });
+        push_wait_cnt_.fetch_sub(1);
+    }
+
+    const size_t qsz     = pending_cnt_.fetch_add(1) + 1;
+    Stripe&      rstripe = stripe(_key);
+    Strand*      pstrand = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(rstripe.mutex_);
+
+        auto it = rstripe.strand_map_.find(_key);
+
+        if (it == rstripe.strand_map_.end()) {
+            it      = rstripe.strand_map_.emplace(_key, Strand(_key)).first;
+            pstrand = &it->second;
+            solid_statistic_inc(statistic_.strand_create_count_);
+        }
+
+        it->second.job_q_.push(Job(std::forward<JT>(_jb)));
+    }
+
+    if (pstrand != nullptr) {
+        //the strand cannot be erased before being handled once, so pstrand is valid
+        wp_.push(pstrand);
+    }
+    solid_statistic_max(statistic_.max_pending_jobs_, qsz);
+}
+//-----------------------------------------------------------------------------
+template <typename Key, typename Job, class Hash, size_t StripeNBits>
+template <class Fnc>
+void StrandWorkPool<Key, Job, Hash, StripeNBits>::doRun(Strand& _rstrand, Fnc&& _fnc)
+{
+    Stripe& rstripe = stripe(_rstrand.key_);
+
+    for (size_t i = 1;; ++i) {
+        {
+            Job job(doPop(rstripe, _rstrand));
+            _fnc(job);
+        }
+        doJobDone();
+
+        std::lock_guard<std::mutex> lock(rstripe.mutex_);
+
+        if (_rstrand.job_q_.empty()) {
+            //no other worker can reference the strand: it is scheduled only when created
+            rstripe.strand_map_.erase(rstripe.strand_map_.find(_rstrand.key_));
+            return;
+        }
+
+        if (i == strand_batch_count) {
+            break;
+        }
+    }
+
+    //strand still scheduled - give other strands a chance.
+    //Never blocks because the underlying WorkPool queue is unbounded.
+    solid_statistic_inc(statistic_.strand_reschedule_count_);
+    wp_.push(&_rstrand);
+}
+//-----------------------------------------------------------------------------
+//only the worker running the strand pops from its queue
+template <typename Key, typename Job, class Hash, size_t StripeNBits>
+Job StrandWorkPool<Key, Job, Hash, StripeNBits>::doPop(Stripe& _rstripe, Strand& _rstrand)
+{
+    std::lock_guard<std::mutex> lock(_rstripe.mutex_);
+    solid_assert(!_rstrand.job_q_.empty());
+    Job job(std::move(_rstrand.job_q_.front()));
+    _rstrand.job_q_.pop();
+    return job;
+}
+//-----------------------------------------------------------------------------
+template <typename Key, typename Job, class Hash, size_t StripeNBits>
+void StrandWorkPool<Key, Job, Hash, StripeNBits>::doJobDone()
+{
+    const size_t sz = pending_cnt_.fetch_sub(1) - 1;
+
+    if (sz < config_.max_job_queue_size_ && push_wait_cnt_.load() != 0) {
+        {
+            std::lock_guard<std::mutex> lock(push_mtx_);
+        }
+        if (sz == 0) {
+            //the destructor may be waiting too
+            push_cnd_.notify_all();
+        } else {
+            push_cnd_.notify_one();
+        }
+    }
+}
+//-----------------------------------------------------------------------------
+template <typename Key, typename Job, class Hash, size_t StripeNBits>
+void StrandWorkPool<Key, Job, Hash, StripeNBits>::dumpStatistics() const
+{
+#ifdef SOLID_HAS_STATISTICS
+    wp_.dumpStatistics();
+    solid_log(workpool_logger, Statistic, "StrandWorkPool " << this << " statistic:" << this->statistic_);
+#endif
+}
+
+} //namespace solid